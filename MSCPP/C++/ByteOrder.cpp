@@ -1,5 +1,7 @@
 #include "stdafx.h"
 
+#include "byte_order.h"
+
 
 namespace ByteOrder
 {
@@ -92,8 +94,107 @@ namespace ByteOrder
 		}
 	}
 
+	void byte_order_swap()
+	{
+		//  ð  ȯ (native   order  ƹ͵  ʴ´)
+		static_assert(Endian::byteswap(static_cast<uint32_t>(0x12345678)) == 0x78563412, "byteswap");
+		static_assert(Endian::from_big(Endian::to_big(static_cast<uint16_t>(0xABCD))) == 0xABCD, "round trip");
+
+		std::cout << "native : " << (Endian::Order::native == Endian::Order::little ? "little" : "big") << " endian\n";
+		std::cout << "kernel : " << Endian::kernel_name(Endian::active_kernel()) << "\n";
+
+		// htonl  Ҹ θ  迭 ü   (pshufb / vrev)
+		{
+			std::vector<uint32_t> values = { 0x12345678, 0xCAFEBABE, 0x00000001, 0xFF000000 };
+			Endian::to_big(values.data(), values.data(), values.size());
+
+			std::cout << std::hex << std::setfill('0');
+			for (const uint32_t v : values) {
+				std::cout << std::setw(8) << v << " ";
+			}
+			std::cout << std::dec << "\n";
+		}
+		/*
+		output:
+			native : little endian
+			kernel : avx2
+			78563412 bebafeca 01000000 000000ff
+		*/
+
+		system("pause");
+	}
+
+	//  ̾ƿ record (wire format, big endian, 36 byte)
+	//   magic(4) version(2) flags(2) sequence(8) price(4) quantity(8) symbol(8)
+	struct TradeRecord
+	{
+		static const uint32_t Magic = 0x54524431;      // "TRD1"
+		static const size_t WireSize = 36;
+
+		uint16_t version;
+		uint16_t flags;
+		uint64_t sequence;
+		int32_t price;                  // 1/100 
+		double quantity;
+		char symbol[8];
+
+		bool serialize(void* buffer, size_t size) const
+		{
+			Endian::BigEndianWriter w(buffer, size);
+			w.write(Magic).write(version).write(flags).write(sequence).write(price).write(quantity).write_bytes(symbol, sizeof(symbol));
+			return w.ok();
+		}
+
+		bool deserialize(const void* buffer, size_t size)
+		{
+			Endian::BigEndianReader r(buffer, size);
+			if (Magic != r.get<uint32_t>()) return false;
+			r.read(version).read(flags).read(sequence).read(price).read(quantity).read_bytes(symbol, sizeof(symbol));
+			return r.ok();
+		}
+	};
+
+	void byte_order_wire_format()
+	{
+		// ȣ buffer  ٷ  ٷ д´ (߰ 纻, Ҵ ,  ڶ ok() == false)
+		TradeRecord out = { 1, 0x0003, 1234567890123ULL, -1250, 0.5, "KRW/USD" };
+
+		uint8_t wire[TradeRecord::WireSize];
+		if (!out.serialize(wire, sizeof(wire))) return;
+
+		std::cout << std::hex << std::setfill('0');
+		for (size_t i = 0; i < sizeof(wire); ++i) {
+			std::cout << std::setw(2) << static_cast<int>(wire[i]) << (7 == i % 8 ? "\n" : " ");
+		}
+		std::cout << std::dec << "\n";
+
+		TradeRecord in = {};
+		if (in.deserialize(wire, sizeof(wire))) {
+			std::cout << "seq " << in.sequence << ", price " << in.price << ", qty " << in.quantity << ", " << in.symbol << "\n";
+		}
+
+		// ڶ buffer
+		std::cout << "short buffer : " << (out.serialize(wire, 20) ? "ok" : "fail") << "\n";
+		/*
+		output:
+			54 52 44 31 00 01 00 03
+			00 00 01 1f 71 fb 04 cb
+			ff ff fb 1e 3f e0 00 00
+			00 00 00 00 4b 52 57 2f
+			55 53 44 00
+			seq 1234567890123, price -1250, qty 0.5, KRW/USD
+			short buffer : fail
+		*/
+
+		system("pause");
+	}
+
 	void Test()
 	{
 		//byte_order();
+
+		//byte_order_swap();
+
+		//byte_order_wire_format();
 	}
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "stdafx.h"
 
+#include "delegate.h"
+
 namespace CallbackAndDelegate
 {
 
@@ -229,6 +231,8 @@ namespace CallbackAndDelegate
 		class Callback
 		{
 		public:
+			virtual ~Callback() {}     // Delegate deletes through the base pointer
+
 			virtual Return invoke(Param0 param0) = 0;
 		};
 
@@ -412,7 +416,7 @@ namespace CallbackAndDelegate
 				if (signal != 0)
 					signal(param);
 
-				for (int i = 0; i < delegate_list.size(); ++i) {
+				for (size_t i = 0; i < delegate_list.size(); ++i) {
 					delegate_list[i]->Invoke(param);
 				}
 			}
@@ -489,6 +493,91 @@ namespace CallbackAndDelegate
 	}
 
 
+	namespace DelegateInlineStorageStyle
+	{
+		// Delegates::Delegate (Libs/delegate.h)
+		//   - no Callback object on the heap, no virtual call: one stub function pointer
+		//   - callables up to InlineSize bytes live inside the delegate
+		//   - DELEGATE_BIND fixes the member function at compile time => the stub calls it directly
+
+		class CDPlayer
+		{
+		public:
+			void play() { std::cout << "play cd !!!" << std::endl; }
+			void stop() { std::cout << "stop cd !!!" << std::endl; }
+			int volume(int level) const { std::cout << "volume " << level << std::endl; return level; }
+		};
+
+		class Button
+		{
+		public:
+			typedef Delegates::Delegate<void()> Callback;
+
+			explicit Button(Callback callback) : m_callback(std::move(callback)) {}
+
+			void click() { m_callback(); }
+
+		private:
+			Callback m_callback;
+		};
+
+		int foo(int x)
+		{
+			std::cout << "foo(" << x << ")" << std::endl;
+			return x;
+		}
+
+		// non-owning: the caller's callable only has to outlive the call
+		int repeat(Delegates::function_ref<int(int)> f, int count)
+		{
+			int sum = 0;
+			for (int i = 0; i < count; ++i) sum += f(i);
+			return sum;
+		}
+
+		void Test()
+		{
+			CDPlayer cd;
+
+			Button playButton(DELEGATE_BIND(&CDPlayer::play, &cd));
+			Button stopButton(DELEGATE_BIND(&CDPlayer::stop, &cd));
+
+			playButton.click();
+			stopButton.click();
+
+			//member function + subclass instance : virtual dispatch is kept
+			DelegateAbstractInterfaceStyle::B b;
+			auto d1 = DELEGATE_BIND(&DelegateAbstractInterfaceStyle::A::foo, static_cast<DelegateAbstractInterfaceStyle::A*>(&b));
+			d1(300);
+
+			//const member function, static function, capturing lambda
+			auto d2 = DELEGATE_BIND(&CDPlayer::volume, &cd);
+			Delegates::Delegate<int(int)> d3(foo);
+			int offset = 10;
+			Delegates::Delegate<int(int)> d4([&cd, offset](int x) { return cd.volume(x + offset); });
+
+			d2(5);
+			d3(100);
+			d4(1);
+
+			std::cout << "repeat : " << repeat([offset](int i) { return i * offset; }, 4) << std::endl;
+
+			system("pause");
+
+			/*
+			output:
+				play cd !!!
+				stop cd !!!
+				B::foo(300)
+				volume 5
+				foo(100)
+				volume 11
+				repeat : 60
+			*/
+		}
+	}
+
+
 	void Test()
 	{
 		//CallbackStaticFunctionStyle::Test();
@@ -502,5 +591,7 @@ namespace CallbackAndDelegate
 		//DelegateAbstractInterfaceStyle::Test();
 		
 		//DelegateCSharpStyle::Test();
+
+		//DelegateInlineStorageStyle::Test();
 	}
 }
\ No newline at end of file
@@ -3,5 +3,6 @@
 #define ENUM_BEGIN(typ)	\
     enum typ {
 #define ENUM(nam) nam
+#define ENUM_VALUE(nam, val) nam = val
 #define ENUM_END(typ)	\
     };
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+// Third pass over an ENUM_BEGIN/ENUM/ENUM_END list (after EnumMacro.h declared the enum):
+// builds a compile-time perfect hash table (Libs/enum_reflect.h, C++17) instead of EnumToString.h's name array.
+//   typ##_ToString   : O(1), any values (ENUM_VALUE, sparse, flags), "" for unknown values
+//   typ##_FromString : O(1) hash + one compare instead of a linear strcmp scan
+// EnumReflect::to_string/from_string/flags_to_string/flags_from_string also work on typ.
+#include "enum_reflect.h"
+
+#undef ENUM_BEGIN
+#undef ENUM
+#undef ENUM_VALUE
+#undef ENUM_END
+
+#define ENUM_BEGIN(typ)	inline constexpr ::EnumReflect::Entry<typ> typ##_Entries[] = {
+#define ENUM(nam) { #nam, nam }
+#define ENUM_VALUE(nam, val) { #nam, nam }
+#define ENUM_END(typ)\
+			 };\
+			ENUM_REFLECT_TABLE(typ, typ##_Entries)\
+			inline std::string_view typ##_ToString(typ value) { return typ##_Reflect.to_string(value); }\
+			inline bool typ##_FromString(std::string_view value, typ &o_OutValue) {\
+				const std::optional<typ> found = typ##_Reflect.from_string(value);\
+				if(!found) return false; /*Enum value not found*/\
+				o_OutValue = *found;\
+				return true;\
+			}
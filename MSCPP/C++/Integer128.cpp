@@ -1,14 +1,111 @@
 ﻿#include "stdafx.h"
 
-
-
+#include "int128.h"
 
 
 namespace Integer128
 {
+	void int128_basic()
+	{
+		/*
+			# 128-bit 정수
+			: C++ 표준에는 128-bit 정수가 없다.
+			  GCC/Clang 은 __int128 확장을 제공하고, MSVC 는 _umul128 / _udiv128 intrinsic 만 제공한다.
+
+			- Wide::uint128 / Wide::int128 (Libs/int128.h)
+			: 저장은 uint64_t 두 개, 연산은 컴파일러에 맞는 가장 빠른 경로를 쓴다.
+			  builtin 정수처럼 2^128 으로 감싸며, 모든 연산자가 constexpr (MSVC C++17 이하의 곱셈/나눗셈 제외)
+		*/
+		{
+			const Wide::uint128 max = std::numeric_limits<Wide::uint128>::max();
+			std::cout << "uint128 max : " << max << "\n";
+			std::cout << "max + 1     : " << max + 1 << "\n";       // 0
+
+			const Wide::int128 min = std::numeric_limits<Wide::int128>::min();
+			std::cout << "int128 min  : " << min << "\n";
+			std::cout << "-7 / 2      : " << Wide::int128(-7) / 2 << ", -7 % 2 : " << Wide::int128(-7) % 2 << "\n";     // -3, -1
+			std::cout << "-8 >> 1     : " << (Wide::int128(-8) >> 1) << "\n";       // -4 (산술 shift)
+		}
+
+		// 2^64 를 넘는 계수 (나노초 누적)
+		{
+			Wide::uint128 total;
+			for (int i = 0; i < 4; ++i) total += Wide::umul(0xFFFFFFFFFFFFFFFFull, 1000000000ull);
+			std::cout << "total ns    : " << total << " (hi=" << total.high() << ")\n";
+		}
+
+#if INT128_HAS_BUILTIN || !INT128_HAS_MSVC_INTRINSICS || INT128_HAS_IS_CONSTANT_EVALUATED
+		// 컴파일 시간 계산
+		{
+			constexpr Wide::uint128 TenPow30 = Wide::uint128(1000000000000000ull) * 1000000000000000ull;
+			static_assert(TenPow30 / 1000000000000000ull == Wide::uint128(1000000000000000ull), "10^30 / 10^15");
+			static_assert(TenPow30.high() == 54210108624ull, "10^30 >> 64");
+			std::cout << "10^30       : " << TenPow30 << "\n";
+		}
+#endif
+	}
+
+	void fixed_point()
+	{
+		/*
+			# 고정 소수점
+			: 64-bit 고정 소수점끼리 곱하면 중간값이 128-bit 가 된다.
+			  double 로 바꾸면 53 bit 밖에 남지 않으므로 금액/비율 계산에서는 128-bit 중간값이 필요하다.
+
+			- Wide::umul(a, b)       : 64 x 64 -> 128 (mul 한 번 / _umul128)
+			- Wide::mul_div(a, b, c) : a * b / c, 중간값이 넘치지 않는다
+		*/
+		{
+			// 소수점 아래 8 자리 (1.0 == 100000000)
+			const uint64_t Scale = 100000000ull;
+			const uint64_t price = 123456789012345678ull;      // 1234567890.12345678
+			const uint64_t rate = 105250000ull;                 // 1.0525
+
+			const uint64_t naive = price * rate / Scale;        // price * rate 가 2^64 를 넘어서 틀린 값
+			const uint64_t exact = Wide::mul_div(price, rate, Scale);
+			std::cout << "naive       : " << naive << "\n";
+			std::cout << "mul_div     : " << exact << "\n";        // 129938270435493826 (1299382704.35493826)
+		}
+	}
+
+	void string_format()
+	{
+		/*
+			# 10 진수 변환
+			: 자리마다 v % 10, v / 10 을 하면 128-bit 나눗셈을 39 번까지 한다.
+			  Wide::to_chars 는 10^19 단위로 잘라서(128/64 나눗셈 최대 2 번) 64-bit 조각만 찍는다.
+			  from_chars 는 19 자리씩 uint64_t 로 모은 뒤 128-bit 에 곱해 더한다.
+
+			- 결과는 std::to_chars / std::from_chars 와 같은 모양 (ptr, std::errc)
+		*/
+		{
+			char buf[64];
+			const Wide::uint128 v = Wide::uint128::make(0x0123456789ABCDEFull, 0xFEDCBA9876543210ull);
+			const Wide::to_chars_result r = Wide::to_chars(buf, buf + sizeof(buf), v);
+			std::cout << "to_chars    : " << std::string(buf, r.ptr) << "\n";
+
+			Wide::uint128 back;
+			const std::string text(buf, r.ptr);
+			const Wide::from_chars_result p = Wide::from_chars(text.data(), text.data() + text.size(), back);
+			std::cout << "round trip  : " << (std::errc() == p.ec && back == v ? "ok" : "fail") << "\n";
+
+			const std::string tooBig = "340282366920938463463374607431768211456";       // 2^128
+			Wide::uint128 out;
+			if (std::errc::result_out_of_range == Wide::from_chars(tooBig.data(), tooBig.data() + tooBig.size(), out).ec) {
+				std::cout << "2^128       : result_out_of_range\n";
+			}
+
+			Wide::int128 negative;
+			const std::string text2 = "-98765432109876543210987654321";
+			Wide::from_chars(text2.data(), text2.data() + text2.size(), negative);
+			std::cout << "int128      : " << Wide::to_string(negative) << "\n";
+		}
+	}
 
 	void Test()
 	{
+		//int128_basic();
+		//fixed_point();
 		//string_format();
 	}
 }
\ No newline at end of file
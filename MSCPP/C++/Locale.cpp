@@ -1,5 +1,7 @@
 ﻿#include "stdafx.h"
 
+#include "locale_snapshot.h"
+
 
 namespace Locale
 {
@@ -1689,6 +1691,105 @@ namespace Locale
 	}
 
 
+	// 숫자 표기만 바꾼 numpunct : 1.000.000,00 (독일)
+	template<typename charT>
+	struct GermanNumPunct : public std::numpunct<charT>
+	{
+	protected:
+		virtual charT do_decimal_point() const { return ','; }
+		virtual charT do_thousands_sep() const { return '.'; }
+		virtual std::string do_grouping() const { return "\003"; }
+	};
+
+	// 처음 3 자리 뒤로는 2 자리씩 : 10,00,000.00 (네팔/인도)
+	template<typename charT>
+	struct NepaliNumPunct : public std::numpunct<charT>
+	{
+	protected:
+		virtual std::string do_grouping() const { return "\003\002"; }
+	};
+
+	void locale_snapshot()
+	{
+		/*
+			imbue 된 stream 은 값을 쓸 때마다 locale 에서 numpunct/num_put facet 을 찾아 가상 함수로 부르고,
+			stream 을 만들거나 imbue 할 때마다 std::locale 참조 카운트를 건드린다.
+			여러 스레드가 같은 locale 로 숫자를 찍으면 이 부분이 경합 지점이 된다.
+
+			LocaleSnapshot::capture() 는 decimal point / grouping / 대소문자 표를 한 번만 복사한다.
+			이후 format / parse / to_lower 는 그 표만 읽는다 (facet 호출, lock 없음).
+		*/
+		{
+			std::locale german(std::locale::classic(), new GermanNumPunct<char>());
+			std::locale nepali(std::locale::classic(), new NepaliNumPunct<char>());
+
+			const LocaleSnapshot::Table de = LocaleSnapshot::capture(german);
+			const LocaleSnapshot::Table ne = LocaleSnapshot::capture(nepali);
+
+			char buf[64];
+			size_t n = LocaleSnapshot::format(buf, sizeof(buf), 1000000.0, 2, de);
+			std::cout << "de       : " << std::string(buf, n) << "\n";
+
+			std::ostringstream os;
+			os.imbue(german);
+			os << std::fixed << std::setprecision(2) << 1000000.0;
+			std::cout << "de(imbue): " << os.str() << "\n";
+
+			n = LocaleSnapshot::format(buf, sizeof(buf), 1000000.0, 2, ne);
+			std::cout << "ne       : " << std::string(buf, n) << "\n";
+
+			n = LocaleSnapshot::format(buf, sizeof(buf), -1234567890LL, de);
+			std::cout << "de int   : " << std::string(buf, n) << "\n";
+
+			long long i = 0;
+			double d = 0;
+			if (LocaleSnapshot::parse(std::string("-1.234.567"), i, de) && LocaleSnapshot::parse(std::string("1.234,5"), d, de)) {
+				std::cout << "de parse : " << i << ", " << d << "\n";
+			}
+			if (!LocaleSnapshot::parse(std::string("1..234"), i, de)) {
+				std::cout << "de parse : \"1..234\" rejected\n";       // thousands_sep 는 숫자 사이에만
+			}
+			/*
+			output:
+				de       : 1.000.000,00
+				de(imbue): 1.000.000,00
+				ne       : 10,00,000.00
+				de int   : -1.234.567.890
+				de parse : -1234567, 1234.5
+				de parse : "1..234" rejected
+			*/
+		}
+
+		// 대소문자 : locale_cpp_facets() 의 try_lower 를 표로
+		{
+			const LocaleSnapshot::Table& c = LocaleSnapshot::classic();
+
+			const wchar_t letters[] = { L'S', L'B', L'a' };
+			for (const wchar_t letter : letters) {
+				wchar_t lower;
+				if (LocaleSnapshot::try_lower(letter, lower, c)) {
+					std::wcout << "Lower case form of \'" << letter << "' is " << lower << "\n";
+				}
+				else {
+					std::wcout << '\'' << letter << "' has no lower case form\n";
+				}
+			}
+
+			std::wstring str = L"HELLo, wORLD!";
+			LocaleSnapshot::to_lower(&str[0], &str[0] + str.size(), c);
+			std::wcout << "Lowercase form of the string is '" << str << "'\n";
+			/*
+			output:
+				Lower case form of 'S' is s
+				Lower case form of 'B' is b
+				'a' has no lower case form
+				Lowercase form of the string is 'hello, world!'
+			*/
+		}
+
+		system("pause");
+	}
+
 	void Test()
 	{		
 		//locale_is();
@@ -1712,5 +1813,7 @@ namespace Locale
 		//multiple_locales_cpp();
 
 		//locale_user_define_facet();
+
+		//locale_snapshot();
 	}
 }
\ No newline at end of file
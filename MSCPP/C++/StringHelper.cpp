@@ -1,27 +1,26 @@
 #include "stdafx.h"
 
 
+#include "string_engine.h"
+
+
 namespace StringHelper
 {
 	std::string Format(const char *format, ...)
 	{
+		// one vsnprintf into a stack buffer (short results stay in SSO),
+		// a second one only when the result does not fit
+		std::string result;
+
 		va_list args;
-		
+
 		va_start(args, format);
 
-		size_t len = vsnprintf(NULL, 0, format, args);
-		
-		va_end(args);
+		StringEngine::vformat_to(result, format, args);
 
-		std::vector<char> vec(len + 1);
-		
-		va_start(args, format);
-		
-		vsnprintf(&vec[0], len + 1, format, args);
-		
 		va_end(args);
 
-		return &vec[0];
+		return result;
 	}
 
 	void string_format()
@@ -140,7 +139,7 @@ namespace StringHelper
 			int delLen = strlen(delimiters);
 
 			if ( (count + 1) < stringCount
-				 && '\0' != delimiters) {
+				 && '\0' != *delimiters) {
 				memcpy(joinedString + tgtBegin, delimiters, delLen);
 				tgtBegin += delLen;
 			}
@@ -764,7 +763,7 @@ namespace StringHelper
 	}
 
 
-	void string_trim_left_right(std::string& inputString, std::string& deleteString, __out std::string& trimedString)
+	void string_trim_left_right(const std::string& inputString, const std::string& deleteString, __out std::string& trimedString)
 	{
 		trimedString = inputString;
 
@@ -772,14 +771,14 @@ namespace StringHelper
 		trimedString.erase(0, inputString.find_first_not_of(deleteString));
 	}
 
-	void string_trim_right(std::string& inputString, std::string& deleteString, __out std::string& trimedString)
+	void string_trim_right(const std::string& inputString, const std::string& deleteString, __out std::string& trimedString)
 	{
 		trimedString = inputString;
 
 		trimedString.erase(inputString.find_last_not_of(deleteString) + 1);
 	}
 
-	void string_trim_left(std::string& inputString, std::string& deleteString, __out std::string& trimedString)
+	void string_trim_left(const std::string& inputString, const std::string& deleteString, __out std::string& trimedString)
 	{
 		trimedString = inputString;
 
@@ -946,6 +945,89 @@ namespace StringHelper
 		*/
 	}
 
+	//=============================================================================================
+	// string_view engine (Libs/string_engine.h)
+	//   tokens/trim results are views into the input => no std::string per token
+	//   replace_all / join / format_to size the output once and reuse its capacity
+	//=============================================================================================
+	void string_view_engine()
+	{
+		// split
+		{
+			std::string input("1:2::3");
+
+			for (StringEngine::string_view token : StringEngine::split(input, ':')) {
+				std::cout << token << ",";
+			}
+			std::cout << std::endl;
+			// output: 1,2,,3,
+
+			for (StringEngine::string_view token : StringEngine::split(input, ':', StringEngine::EmptyTokens::Skip)) {
+				std::cout << token << ",";
+			}
+			std::cout << std::endl;
+			// output: 1,2,3,
+
+			for (StringEngine::string_view token : StringEngine::split("key::value::end", "::")) {
+				std::cout << token << ",";
+			}
+			std::cout << std::endl;
+			// output: key,value,end,
+
+			std::vector<StringEngine::string_view> tokenList;     // reuse across calls => no allocation once grown
+			StringEngine::split_any(" first, second\tthird ", " ,\t", StringEngine::EmptyTokens::Skip).to(tokenList);
+			std::cout << tokenList.size() << ": " << tokenList[0] << "|" << tokenList[1] << "|" << tokenList[2] << std::endl;
+			// output: 3: first|second|third
+		}
+
+		// trim
+		{
+			std::cout << "[" << StringEngine::trim(" 2018-1-12 12:22:45 ") << "]" << std::endl;
+			std::cout << "[" << StringEngine::trim_left("xxabcxx", "x") << "]" << std::endl;
+			std::cout << "[" << StringEngine::trim_right("xxabcxx", "x") << "]" << std::endl;
+			// output:
+			//	[2018-1-12 12:22:45]
+			//	[abcxx]
+			//	[xxabc]
+		}
+
+		// replace all
+		{
+			std::string result;
+			size_t count = StringEngine::replace_all("test message test", "test", "wawawa", result);
+			std::cout << count << ": " << result << std::endl;
+			// output: 2: wawawa message wawawa
+		}
+
+		// join
+		{
+			std::vector<std::string> words = { "first", "second", "third" };
+
+			std::string joined;
+			StringEngine::join(words, ", ", joined);
+			std::cout << joined << std::endl;
+			// output: first, second, third
+
+			std::cout << StringEngine::join(StringEngine::split("a b  c", ' ', StringEngine::EmptyTokens::Skip), "-") << std::endl;
+			// output: a-b-c
+		}
+
+		// format into a reused buffer
+		{
+			std::string line;
+			for (int i = 0; i < 3; ++i) {
+				StringEngine::format_to(line, "%s => %d", "apples", i);
+				std::cout << line << std::endl;
+			}
+			// output:
+			//	apples => 0
+			//	apples => 1
+			//	apples => 2
+		}
+
+		system("pause");
+	}
+
 	void Test()
 	{
 		//string_format();
@@ -969,5 +1051,7 @@ namespace StringHelper
 		//string_replace();
 
 		//string_data_to_string();
+
+		//string_view_engine();
 	}
 }//StringHelper
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include <thread>
 #include <condition_variable>
 
+#include "ring_queue.h"
+
 
 namespace Thread
 {
@@ -147,7 +149,7 @@ namespace Thread
 		*/
 	}
 
-	void thread_with_ConditionVariable()
+	void thread_with_ConditionVariable(LockFree::HandOff handoff = LockFree::HandOff::Lock)
 	{
 		/*
 			std::condition_variable
@@ -184,7 +186,7 @@ namespace Thread
 			worker.join();
 		}
 
-		{
+		if (handoff == LockFree::HandOff::Lock) {
 			std::mutex m;
 			std::condition_variable cv;
 			std::queue<int> q;
@@ -221,6 +223,137 @@ namespace Thread
 
 			consumer.join();
 		}
+		else {
+			// 같은 producer/consumer를 lock-free SPSC ring으로 (mutex/condition_variable 없음)
+			//  - 비었을 때 consumer는 잠깐 spin 후 futex 대기, producer는 consumer가 잠들어 있을 때만 깨움
+			//  - close() == stop 플래그: 남은 요소를 다 꺼낸 뒤 pop()이 false
+			LockFree::BlockingSpscRing<int> q(16);
+
+			std::thread consumer([&] {
+				int v;
+				while (q.pop(v)) {
+					std::cout << "consume " << v << "\n";
+				}
+			});
+
+			// producer
+			for (int i = 0; i < 5; ++i) {
+				q.push(i);
+			}
+
+			q.close();
+
+			consumer.join();
+		}
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// hand-off 벤치마크: mutex + condition_variable 큐 vs lock-free ring
+	//   - 처리량(ops/sec)과 hand-off 지연(push 시각 ~ pop 시각)의 p99
+	//---------------------------------------------------------------------------------------------
+	template<typename T>
+	class MutexQueue
+	{
+	public:
+		using value_type = T;
+
+		explicit MutexQueue(size_t /*capacity*/) {}
+
+		bool push(T v)
+		{
+			{
+				std::lock_guard<std::mutex> lk(_m);
+				if (_closed) return false;
+				_q.push(std::move(v));
+			}
+			_cv.notify_one();
+			return true;
+		}
+
+		bool pop(T& out)
+		{
+			std::unique_lock<std::mutex> lk(_m);
+			_cv.wait(lk, [&] { return _closed || !_q.empty(); });
+			if (_q.empty()) return false;
+
+			out = std::move(_q.front());
+			_q.pop();
+			return true;
+		}
+
+		void close()
+		{
+			{
+				std::lock_guard<std::mutex> lk(_m);
+				_closed = true;
+			}
+			_cv.notify_all();
+		}
+
+	private:
+		std::mutex _m;
+		std::condition_variable _cv;
+		std::queue<T> _q;
+		bool _closed = false;
+	};
+
+	template<typename Queue>
+	void benchmark_handoff(const char* name, int producers, int consumers)
+	{
+		const int PerProducer = 1000000 / producers;
+		const int SampleEvery = 16;     // 지연 샘플링 간격
+
+		using Clock = std::chrono::steady_clock;
+		auto now_ns = [] {
+			return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+		};
+
+		Queue q(1024);
+		std::vector<std::vector<int64_t>> latencies(consumers);
+
+		auto t0 = Clock::now();
+
+		std::vector<std::thread> threads;
+		for (int c = 0; c < consumers; ++c) {
+			threads.emplace_back([&, c] {
+				int64_t pushed_at;
+				uint64_t n = 0;
+				while (q.pop(pushed_at)) {
+					if (++n % SampleEvery == 0) latencies[c].push_back(now_ns() - pushed_at);
+				}
+			});
+		}
+
+		std::vector<std::thread> senders;
+		for (int p = 0; p < producers; ++p) {
+			senders.emplace_back([&] {
+				for (int i = 0; i < PerProducer; ++i) q.push(now_ns());    // 요소 = push 시각
+			});
+		}
+
+		for (auto& t : senders) t.join();
+		q.close();
+		for (auto& t : threads) t.join();
+
+		double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+		std::vector<int64_t> all;
+		for (auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+		std::sort(all.begin(), all.end());
+		int64_t p99 = all.empty() ? 0 : all[all.size() * 99 / 100];
+
+		std::cout << "[" << name << "] " << producers << "P" << consumers << "C : "
+		          << std::fixed << std::setprecision(2) << (double)PerProducer * producers / sec / 1e6 << " M ops/s"
+		          << ", p99 hand-off " << p99 << " ns\n";
+	}
+
+	void benchmark_handoff()
+	{
+		benchmark_handoff<MutexQueue<int64_t>>("mutex+cv  ", 1, 1);
+		benchmark_handoff<LockFree::BlockingSpscRing<int64_t>>("SpscRing  ", 1, 1);
+
+		benchmark_handoff<MutexQueue<int64_t>>("mutex+cv  ", 4, 4);
+		benchmark_handoff<LockFree::BlockingMpmcQueue<int64_t>>("MpmcQueue ", 4, 4);
 	}
 
 	void thread_with_ConditionVariableAny()
@@ -303,6 +436,10 @@ namespace Thread
 
 		//thread_with_ConditionVariable();
 
+		//thread_with_ConditionVariable(LockFree::HandOff::Ring);
+
+		//benchmark_handoff();
+
 		//c_run_time_thread();
 	}
 }//Thread
\ No newline at end of file
@@ -56,7 +56,7 @@ namespace ThreadLocalStorage
 
 	UINT32 WINAPI StaticTLSThreadFunc(void* param)
 	{
-		tls_i = (int)param;
+		tls_i = (int)(uintptr_t)param;
 		printf("Load static TLS value - Value:%d, ThreadID:%d\n"
 			  , tls_i, GetCurrentThreadId());
 
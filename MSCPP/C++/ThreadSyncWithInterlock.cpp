@@ -4,11 +4,13 @@
 
 #include <thread>
 
+#include "ring_queue.h"
+
 namespace ThreadSyncWithInterLock
 {
 
     // Interlocked 테스트
-    void thread_sync_with_interlock()
+    void thread_sync_with_interlock(LockFree::HandOff handoff = LockFree::HandOff::Lock)
     {
         /*
             📚 std::thread + Interlocked 동기화 패턴 정리 (Win32)
@@ -148,7 +150,7 @@ namespace ThreadSyncWithInterLock
 
         // (4) Interlocked + busy flag 로 아주 단순한 producer-like 패턴
         //     (실제 프로덕션에서는 condition_variable 이나 이벤트를 쓰는 게 맞음)
-        {
+        if (handoff == LockFree::HandOff::Lock) {
             std::cout << "\n[TEST 4] busy flag sample\n";
 
             volatile long busy = 0;   // 0: idle, 1: busy
@@ -192,6 +194,43 @@ namespace ThreadSyncWithInterLock
             pt.join();
             ct.join();
         }
+        else {
+            // busy 플래그 대신 SPSC ring: 점유/해제 없이 producer는 tail, consumer는 head만 원자적으로 갱신
+            // (busy 플래그 방식은 consumer가 늦으면 값을 놓치지만 ring은 모든 값을 순서대로 전달)
+            std::cout << "\n[TEST 4] SPSC ring sample\n";
+
+            LockFree::SpscRing<int> q(8);
+
+            auto producer = [&]() {
+                for (int i = 0; i < 5; ++i) {
+                    while (!q.try_push(i)) {
+                        // 가득 참: 대기
+                    }
+                    std::cout << "  producer set " << i << "\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            };
+
+            auto consumer = [&]() {
+                int count = 0;
+                while (count < 5) {
+                    int v;
+                    if (q.try_pop(v)) {
+                        std::cout << "  consumer got " << v << "\n";
+                        ++count;
+                    }
+                    else {
+                        // 너무 타이트하지 않게
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+            };
+
+            std::thread pt(producer);
+            std::thread ct(consumer);
+            pt.join();
+            ct.join();
+        }
 
         std::cout << "\n[Press any key...]\n";
         system("pause");
@@ -200,5 +239,7 @@ namespace ThreadSyncWithInterLock
     void Test()
     {
         thread_sync_with_interlock();
+
+        //thread_sync_with_interlock(LockFree::HandOff::Ring);
     }
 }
\ No newline at end of file
@@ -3,6 +3,11 @@
 
 #include <Windows.h>
 
+#include <thread>
+
+#include "timestamp.h"
+#include "tz_table.h"
+
 
 namespace Time
 {
@@ -82,13 +87,17 @@ namespace Time
 
     std::string getTimeStamp()
     {
-        std::time_t now = std::time(nullptr);
+        // "YYYY-MM-DD HH:MM:" 는 스레드별로 캐시되어 분이 바뀔 때만 gmtime_s + 포맷 (Libs/timestamp.h)
+        char buf[Timestamp::BufferSize];
+        if (0 == Timestamp::format_now(buf, sizeof(buf), Timestamp::Precision::Seconds)) return "<gmtime_s failed>";
 
-        std::tm tm_utc{};
-        if (!safe_gmtime(now, tm_utc)) return "<gmtime_s failed>";
+        return std::string(buf);
+    }
 
-        // put_time은 구현/설정에 따라 C++11에서 애매할 수 있어 strftime로 통일
-        return format_tm(tm_utc, "%Y-%m-%d %H:%M:%S");
+    // 할당 없는 버전 (logging hot path): 호출자 buffer에 쓰고 길이('\0' 제외) 반환, 실패 시 0
+    size_t getTimeStamp(char* buf, size_t size, Timestamp::Precision precision = Timestamp::Precision::Seconds)
+    {
+        return Timestamp::format_now(buf, size, precision);
     }
 
     //=============================================================================================
@@ -102,6 +111,36 @@ namespace Time
 
     //=============================================================================================
 
+    void cached_timestamp()
+    {
+        // 호출자 buffer에 바로 쓰므로 std::string / heap 할당 없음
+        char buf[Timestamp::BufferSize];
+
+        getTimeStamp(buf, sizeof(buf), Timestamp::Precision::Milliseconds);
+        std::cout << "UTC (ms) : " << buf << "\n";
+
+        getTimeStamp(buf, sizeof(buf), Timestamp::Precision::Microseconds);
+        std::cout << "UTC (us) : " << buf << "\n";
+
+        getTimeStamp(buf, sizeof(buf), Timestamp::Precision::Nanoseconds);
+        std::cout << "UTC (ns) : " << buf << "\n";
+
+        Timestamp::format_now(buf, sizeof(buf), Timestamp::Precision::Milliseconds, Timestamp::Zone::Local);
+        std::cout << "Local(ms): " << buf << "\n";
+
+        /*
+        output:
+            UTC (ms) : 2024-05-01 03:12:45.123
+            UTC (us) : 2024-05-01 03:12:45.123456
+            UTC (ns) : 2024-05-01 03:12:45.123456789
+            Local(ms): 2024-05-01 12:12:45.123
+        */
+
+        system("pause");
+    }
+
+    //=============================================================================================
+
     void utc_time_2_time_t()
     {
         std::time_t now = std::time(nullptr);
@@ -936,6 +975,7 @@ namespace Time
 		system("pause");
 	}
 
+#if defined(_WIN32)
 	//=============================================================================================
     // UTC 시간 + 대상 TimeZone의 로컬시간을 tm으로 변환해서 출력
     //=============================================================================================
@@ -1063,6 +1103,7 @@ namespace Time
 		std::cout << "\n==== RESTORED ====\n";
 		print_current_windows_tz_info();
 	}
+#endif // _WIN32
 
 
 	//=============================================================================================
@@ -1121,7 +1162,91 @@ namespace Time
 		system("pause");
 	}
 
+	//---------------------------------------------------------------------------------------------
+	// TZif 전이 표 기반 변환 (Libs/tz_table.h)
+	//   - 고정 offset 이 아니므로 DST 가 반영되고, TZ 환경 변수/CRT 전역 상태를 건드리지 않는다
+	//   - Zone 은 불변이므로 같은 Zone 을 여러 스레드가 나눠서 대량 변환해도 된다
+	//---------------------------------------------------------------------------------------------
+	static void print_time_in_zone_by_table_utc_now(const char* label, const char* zoneName)
+	{
+		auto zone = TzTable::ZoneCache::instance().get(zoneName);
+		if (!zone) {
+			std::cout << "[" << label << "] cannot load zone: " << zoneName
+				<< " (root=" << TzTable::ZoneCache::instance().root() << ")\n";
+			return;
+		}
 
+		const std::int64_t utcNow = (std::int64_t)std::time(nullptr);
+
+		std::tm local{};
+		if (!safe_gmtime((std::time_t)zone->to_local(utcNow), local)) {
+			std::cout << "[" << label << "] gmtime_s failed\n";
+			return;
+		}
+
+		print_tm(label, local);
+		std::cout << "    " << zone->type_at(utcNow).abbreviation << ", offset=" << zone->offset_at(utcNow) << "s\n";
+	}
+
+	void time_zone_table()
+	{
+		print_time_in_zone_by_table_utc_now("Seoul (Korea)   ", "Asia/Seoul");
+		print_time_in_zone_by_table_utc_now("New York (US)   ", "America/New_York");
+		print_time_in_zone_by_table_utc_now("Stockholm (SE)  ", "Europe/Stockholm");
+
+		// 대량 변환 : 1분 간격 이벤트 1년치를 스레드별 구간으로 나눠 local 로
+		auto zone = TzTable::ZoneCache::instance().get("Europe/Stockholm");
+		if (!zone) {
+			system("pause");
+			return;
+		}
+
+		const std::int64_t begin = 1704067200;     // 2024-01-01 00:00:00 UTC
+		std::vector<std::int64_t> utc(366 * 24 * 60);
+		for (size_t i = 0; i < utc.size(); ++i) {
+			utc[i] = begin + (std::int64_t)i * 60;
+		}
+		std::vector<std::int64_t> local(utc.size());
+
+		const size_t threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+		const size_t chunk = (utc.size() + threadCount - 1) / threadCount;
+
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < threadCount; ++t) {
+			const size_t first = (std::min)(utc.size(), t * chunk);
+			const size_t count = (std::min)(utc.size() - first, chunk);
+			threads.emplace_back([&, first, count]() {
+				zone->to_local(utc.data() + first, local.data() + first, count);
+			});
+		}
+		for (auto& th : threads) th.join();
+
+		// 2024-03-31 01:00 UTC 에 CET(+1) -> CEST(+2)
+		const size_t springForward = (size_t)((1711846800 - begin) / 60);
+		std::cout << "converted " << local.size() << " timestamps with " << threadCount << " threads\n";
+		std::cout << "  offset before DST : " << (local[springForward - 1] - utc[springForward - 1]) << "s\n";
+		std::cout << "  offset after DST  : " << (local[springForward] - utc[springForward]) << "s\n";
+		std::cout << "  back to UTC       : " << (zone->to_utc(local[springForward]) == utc[springForward] ? "ok" : "mismatch") << "\n";
+
+		/*
+		output:
+			Seoul (Korea)    : 2024-05-01 12:12:45
+			    KST, offset=32400s
+			New York (US)    : 2024-04-30 23:12:45
+			    EDT, offset=-14400s
+			Stockholm (SE)   : 2024-05-01 05:12:45
+			    CEST, offset=7200s
+			converted 527040 timestamps with 8 threads
+			  offset before DST : 3600s
+			  offset after DST  : 7200s
+			  back to UTC       : ok
+		*/
+
+		system("pause");
+	}
+
+
+#if defined(_WIN32)
     //=============================================================================================
     // 현재 UTC 시간 + 대상 TimeZone의 로컬시간을 SYSTEMTIME으로 변환해서 출력
     //=============================================================================================
@@ -1180,6 +1305,7 @@ namespace Time
 
         system("pause");
     }
+#endif // _WIN32
 
 	//=============================================================================================
     // CRT(MSVC C Runtime) 기반 "현재 시스템 TZ" 정보 추출
@@ -1208,6 +1334,7 @@ namespace Time
         system("pause");
     }
 
+#if defined(_WIN32)
 	//=============================================================================================
     // Win32로 "현재 시스템 TZ" 정보 출력
 	//=============================================================================================
@@ -1217,6 +1344,7 @@ namespace Time
 
         system("pause");
     }
+#endif // _WIN32
 
     //=============================================================================================
 
@@ -1226,6 +1354,8 @@ namespace Time
 
         utc_time();
 
+        cached_timestamp();
+
         utc_time_2_time_t();
 
         utc_tm_2_time_t();
@@ -1242,14 +1372,22 @@ namespace Time
 
 		time_zone_change();
 
+#if defined(_WIN32)
 		time_zone_change_by_win32();
+#endif
 
 		time_zone_to_utc();
 
+		time_zone_table();
+
+#if defined(_WIN32)
 		time_zone_to_utc_by_win32();
+#endif
 
 		print_current_tz_info();
 
+#if defined(_WIN32)
 		print_current_tz_info_by_win32();
+#endif
 	}
 }
\ No newline at end of file
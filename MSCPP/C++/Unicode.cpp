@@ -3,6 +3,8 @@
 #include <Windows.h>
 #include <atlstr.h> // for MFC CString
 
+#include "utf_transcode.h"
+
 
 //#pragma execution_character_set( "utf-8" )
 
@@ -474,88 +476,16 @@ namespace Unicode
 		std::locale::global(std::locale(""));
 	}
 
+	//   byte   ڵ(overlong/ΰƮ ˻ , Windows  U+10000 ̻ )
+	// Libs/utf_transcode.h  ٲ :   ڿ ִ ǹ̴ ״
 	std::wstring utf8_to_wstr(const std::string& src)
 	{
-		std::wstring	wstr;
-		wchar_t			wc = 0;
-		int				bytes = 0;
-		unsigned char	c;
-
-		for (size_t i = 0; i < src.size(); i++) {
-			c = (unsigned char)src[i];
-
-			if (c <= 0x7f) { //first byte
-				if (bytes) {
-					return (std::wstring());
-				}
-				wstr.push_back((wchar_t)c);
-			}
-			else if (c <= 0xbf) { //second/third/etc byte
-				if (bytes) {
-					wc = ((wc << 6) | (c & 0x3f));
-					bytes--;
-					if (!bytes) {
-						wstr.push_back(wc);
-					}
-				}
-				else {
-					return (std::wstring());
-				}
-			}
-			else if (c <= 0xdf) { //second byte
-				bytes = 1;
-				wc = c & 0x1f;
-			}
-			else if (c <= 0xef) { //third byte
-				bytes = 2;
-				wc = c & 0x0f;
-			}
-			else if (c <= 0xf7) { //fourth byte
-				bytes = 3;
-				wc = c & 0x07;
-			}
-			else {
-				return (std::wstring());
-			}
-		}
-		
-		if (bytes) {
-			return (std::wstring());
-		}
-
-		return (wstr);
+		return Utf::to_wstring(src);
 	}
 
 	std::string wstr_to_utf8(const std::wstring &src)
 	{
-		std::string		str;
-		wchar_t 	w;
-
-		for (size_t i = 0; i < src.size(); i++) {
-			w = src[i];
-			if (w <= 0x7f) {
-				str.push_back((char)w);
-			}
-			else if (w <= 0x7ff) {
-				str.push_back(0xc0 | ((w >> 6) & 0x1f));
-				str.push_back(0x80 | (w & 0x3f));
-			}
-			else if (w <= 0xffff) {
-				str.push_back(0xe0 | ((w >> 12) & 0x0f));
-				str.push_back(0x80 | ((w >> 6) & 0x3f));
-				str.push_back(0x80 | (w & 0x3f));
-			}
-			else if (w <= 0x10ffff) {
-				str.push_back(0xf0 | ((w >> 18) & 0x07));
-				str.push_back(0x80 | ((w >> 12) & 0x3f));
-				str.push_back(0x80 | ((w >> 6) & 0x3f));
-				str.push_back(0x80 | (w & 0x3f));
-			}
-			else {
-				return (std::string());
-			}
-		}
-		return (str);
+		return Utf::to_utf8(src);
 	}
 
 	void string_convert_unicode_utf8()
@@ -585,6 +515,39 @@ namespace Unicode
 		*/
 	}
 
+	void string_convert_unicode_utf8_portable()
+	{
+		// Win32 API / wstring_convert  ȯ (Libs/utf_transcode.h)
+		//   ̴   Ⱦ Ȯ  => ۸    ϸ鼭 ȯ
+		std::wstring input(L"ڵ ڿ \U0001F600");
+
+		std::string utf8 = Utf::to_utf8(input);
+		std::wstring unicode = Utf::to_wstring(utf8);
+
+		std::cout << "kernel : " << Utf::kernel_name(Utf::active_kernel()) << std::endl;
+		std::cout << "UTF-8 bytes : " << utf8.size() << ", round trip : " << (unicode == input ? "ok" : "mismatch") << std::endl;
+
+		//  ۸ ѱ 
+		std::u16string utf16(Utf::utf16_length_from_utf8(utf8.data(), utf8.size()), u'\0');
+		Utf::Result r = Utf::convert_utf8_to_utf16(utf8.data(), utf8.size(), &utf16[0], utf16.size());
+		std::cout << "UTF-16 units : " << r.written << " (" << Utf::to_string(r.error) << ")" << std::endl;
+
+		// ߸ Է ġ  ˷ش
+		const char broken[] = "abc\xED\xA0\x80" "def";     // UTF-8  ڵ ΰƮ
+		r = Utf::validate_utf8(broken, sizeof(broken) - 1);
+		std::cout << "broken : " << Utf::to_string(r.error) << " at " << r.read << std::endl;
+
+		system("pause");
+
+		/*
+		output:
+			kernel : avx2
+			UTF-8 bytes : 27, round trip : ok
+			UTF-16 units : 11 (ok)
+			broken : invalid surrogate at 3
+		*/
+	}
+
 	void utf8_file_io_c_style()
 	{
 		// utf8 write
@@ -674,6 +637,65 @@ namespace Unicode
 	}
 
 
+	void utf8_file_io_chunked()
+	{
+		// locale / ccs=UTF-8  byte  а . chunk 迡 ɸ ڴ Decoder/Encoder   ִٰ ̾ δ
+		const std::wstring info = L"ڵ ׽Ʈ . \U0001F600";
+
+		//utf8 write
+		{
+			std::ofstream out("utf8-chunked.txt", std::ios::binary);
+			out.write("\xEF\xBB\xBF", 3);     // BOM
+
+			Utf::Utf8Encoder<wchar_t> encoder;
+			std::string chunk;
+			for (size_t i = 0; i < info.size(); i += 4) {
+				chunk.clear();
+				encoder.encode(info.data() + i, (std::min)(info.size() - i, (size_t)4), chunk);
+				out.write(chunk.data(), chunk.size());
+			}
+			chunk.clear();
+			encoder.finish(chunk);
+			out.write(chunk.data(), chunk.size());
+
+			std::wcout << L"utf8 write file - size:" << info.size() << " string:" << info << std::endl;
+		}
+		//utf8 read
+		{
+			std::ifstream in("utf8-chunked.txt", std::ios::binary);
+
+			Utf::Utf8Decoder<wchar_t> decoder;
+			std::wstring text;
+			char buffer[7];     // Ϻη ۰ : ѱ 3 byte  chunk 迡 ɸ
+			bool first = true;
+			while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+				const char* p = buffer;
+				size_t n = (size_t)in.gcount();
+				if (first) {
+					Utf::skip_bom(p, n);
+					first = false;
+				}
+
+				Utf::Result r = decoder.decode(p, n, text);
+				if (!r.ok()) {
+					std::cout << "utf8 read error : " << Utf::to_string(r.error) << " at " << r.read << std::endl;
+					break;
+				}
+			}
+			decoder.finish(text);
+
+			std::wcout << L"utf8 read file - size:" << text.size() << " string:" << text << std::endl;
+		}
+
+		/*
+		output:
+			utf8 write file - size:16 string:ڵ ׽Ʈ . (U+1F600)
+			utf8 read file - size:16 string:ڵ ׽Ʈ . (U+1F600)
+		*/
+
+		system("pause");
+	}
+
 	void Test()
 	{
 		//print_unicode();
@@ -688,8 +710,12 @@ namespace Unicode
 
 		//string_convert_unicode_utf8();
 
+		//string_convert_unicode_utf8_portable();
+
 		//utf8_file_io_c_style();
 
 		//utf8_file_io_stl_style();
+
+		//utf8_file_io_chunked();
 	}
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include <boost/thread.hpp> // C++11 thread_group 대체시 std::thread + vector로 가능
 
+#include "treiber_stack.h"
+#include "dcas.h"
+
 
 namespace ABAProblem 
 {
@@ -21,45 +24,29 @@ namespace ABAProblem
 	};
 
 
-	// Lock - free stack 예제(ABA Problem 발생 가능)
+	// Lock - free stack 예제
+	//   예전 구현은 Obj::next를 직접 연결하는 intrusive stack이라 ABA 문제에 취약했음
+	//     Pop : ret_ptr = top, next_ptr = ret_ptr->next 를 읽은 뒤 CAS(top, ret_ptr, next_ptr)
+	//           => 그 사이 다른 스레드가 A pop, B pop/delete, A push 하면 top==A 라서 CAS가 성공하고
+	//              이미 해제된 B가 top이 됨
+	//   지금은 LockFree::TreiberStack(hazard pointer) 위에 구현
+	//     - 스택 노드는 내부에서 할당, pop한 노드는 아무도 보호하지 않을 때 해제(retire)
+	//     - 보호 중인 노드 주소는 재사용되지 않으므로 top==ret_ptr 이면 실제로 같은 노드 => ABA 없음
 	class Stack {
 	public:
-		std::atomic<Obj*> top_ptr;
-		
 		// Pops the top object and returns a pointer to it.
-		// (ABA 문제에 취약)
 		Obj* Pop() {
-			while (true) {
-				Obj* ret_ptr = top_ptr;			// 현재 top 값 로드
-				if (!ret_ptr) return nullptr;	// 스택 비어있으면 nullptr 반환
-
-				// 주의: 실제로는 다른 스레드가 ret_ptr을 pop해버릴 수도 있음(ABA!)
-				Obj* next_ptr = ret_ptr->next;
-				
-				// top_ptr이 여전히 ret_ptr일 때만 next_ptr로 교체
-				// (ABA 상황에서는 top_ptr==ret_ptr이지만, 중간에 pop/push가 교차될 수 있음)
-				if (top_ptr.compare_exchange_weak(ret_ptr, next_ptr)) {
-					return ret_ptr; // 성공적으로 pop
-				}
-
-				// 실패시 다시 시도 (다른 스레드가 스택을 변경함)
-			}
+			Obj* obj_ptr = nullptr;
+			return _stack.pop(obj_ptr) ? obj_ptr : nullptr;	// 스택 비어있으면 nullptr 반환
 		}
 
 		// Pushes the object specified by obj_ptr to stack.
-		// (ABA 문제에 취약)
 		void Push(Obj* obj_ptr) {
-			while (true) {
-				Obj* next_ptr = top_ptr;       // 현재 top 값 로드
-				obj_ptr->next = next_ptr;      // 새 노드의 next를 현재 top에 연결
-
-				// top_ptr이 변하지 않았을 때만 새 노드로 교체 (CAS)
-				if (top_ptr.compare_exchange_weak(next_ptr, obj_ptr)) {
-					return; // 성공적으로 push
-				}
-				// 실패시 다시 시도 (다른 스레드가 스택을 변경함)
-			}
+			_stack.push(obj_ptr);
 		}
+
+	private:
+		LockFree::TreiberStack<Obj*, LockFree::HazardPointers> _stack;
 	};
 
 
@@ -98,6 +85,36 @@ namespace ABAProblem
 			*/
 		}
 
+		// tagged pointer(포인터 + tag) head의 lock-free 여부
+		//   - is_lock_free()는 실행 시점 결과라서 lock 기반으로 바뀌어도 빌드는 통과함
+		//   - is_always_lock_free(컴파일 타임 상수)로 static_assert 해야 조용한 lock 전환을 막을 수 있음
+		{
+			using TaggedPtr = LockFree::TaggedPtr<Obj>;
+
+			std::atomic<TaggedPtr> std_head;
+			LockFree::TaggedHead<Obj> head;
+
+			static_assert(LockFree::TaggedHead<Obj>::is_always_lock_free, "TaggedHead must be lock-free");
+#if defined(__cpp_lib_atomic_is_always_lock_free)
+			static_assert(std::atomic<B>::is_always_lock_free, "8-byte struct should be lock-free");
+#endif
+
+			std::cout << std::boolalpha
+				<< "std::atomic<TaggedPtr> is lock free? "
+				<< std_head.is_lock_free() << '\n'
+				<< "TaggedHead(" << LockFree::TaggedHead<Obj>::name() << ") is always lock free? "
+				<< LockFree::TaggedHead<Obj>::is_always_lock_free << '\n'
+				<< "TaggedHead lock free? "
+				<< head.is_lock_free() << '\n';
+
+			/*
+			출력 (x86-64):
+				std::atomic<TaggedPtr> is lock free? false		// MSVC, -mcx16 없는 GCC/Clang
+				TaggedHead(dwcas) is always lock free? true
+				TaggedHead lock free? true
+			*/
+		}
+
 		system("pause");
 	}
 
@@ -144,8 +161,11 @@ namespace ABAProblem
 			boost::thread th2([&stack]() {
 				Obj* o1 = stack.Pop(); // pop A, top->B->C
 				Obj* o2 = stack.Pop(); // pop B, top->C
-				delete o2;             // B 삭제 (A/B/C 중 B 해제)
-				stack.Push(o1);        // push A, top->A->C (ABA 문제 시현)
+				stack.Push(o1);        // push A, top->A->C (예전 구현에서는 ABA 문제 시현, 지금은 새 노드로 push)
+
+				// 예전 예제는 여기서 B를 delete => th1이 읽던 B->next가 해제된 메모리
+				// Obj 소유권은 스택이 아니라 호출자에게 있으므로 아래에서 일괄 해제
+				(void)o2;
 			});
 
 			boost::thread_group tg;
@@ -155,6 +175,7 @@ namespace ABAProblem
 			tg.join_all();
 
 			delete obj1;
+			delete obj2;
 			delete obj3;
 
 			system("pause");
@@ -4,6 +4,9 @@
 #include <future>
 #include <thread>
 
+#include "ring_queue.h"
+#include "task.h"
+
 
 namespace AsyncAndFuture
 {
@@ -128,21 +131,41 @@ namespace AsyncAndFuture
 
     class CustomThreadPool {
     public:
-        CustomThreadPool(size_t num_threads) : stop(false) {
+        // handoff == Ring: 작업 큐를 lock-free MPMC ring(용량 RingCapacity, 가득 차면 submit이 대기)으로 교체
+        CustomThreadPool(size_t num_threads, LockFree::HandOff handoff = LockFree::HandOff::Lock) : stop(false), idle(0), slab(Tasks::StateSlab::create()) {
+            if (handoff == LockFree::HandOff::Ring) {
+                // alignas(64) 멤버 => 정렬 할당. 인자는 참조로 전달되므로 값으로 넘겨 RingCapacity 를 ODR-use 하지 않는다
+                ring_tasks = LockFree::make_cache_aligned<LockFree::BlockingMpmcQueue<Tasks::Task>>(size_t(RingCapacity));
+
+                for (size_t i = 0; i < num_threads; ++i) {
+                    workers.emplace_back([this] {
+                        Tasks::Task task;
+                        while (this->ring_tasks->pop(task)) {   // close() 후 남은 작업을 다 꺼내면 false
+                            task(); // 실제 작업 실행
+                        }
+                    });
+                }
+                return;
+            }
+
             for (size_t i = 0; i < num_threads; ++i) {
                 workers.emplace_back([this] {
                     while (true) {
-                        std::function<void()> task;
+                        Tasks::Task task;
                         {
                             std::unique_lock<std::mutex> lock(this->queue_mutex);
 
-                            this->condition.wait(lock, [this] { return this->stop || !this->tasks.empty(); });
+                            // idle: 잠든 워커 수 (0이면 submit이 notify를 생략)
+                            while (!this->stop && this->tasks.empty()) {
+                                ++this->idle;
+                                this->condition.wait(lock);
+                                --this->idle;
+                            }
 
                             if (this->stop && this->tasks.empty())
                                 return;
 
-                            task = std::move(this->tasks.front());
-                            this->tasks.pop();
+                            task = this->tasks.pop();
                         }
                         task(); // 실제 작업 실행
                     }
@@ -162,18 +185,86 @@ namespace AsyncAndFuture
             );
 
             std::future<return_type> fut = task_ptr->get_future();
+
+            enqueue([task_ptr] { (*task_ptr)(); });
+            return fut;
+        }
+
+        // submit과 같지만 할당 없는 경로: 작업은 Tasks::Task(48 byte inline)에,
+        // 결과 공유 상태는 풀의 slab에서 => 작업당 heap 할당 0회 (slab이 자라는 처음만 제외)
+        template<class F, class... Args>
+        auto schedule(F&& f, Args&&... args)
+            -> Tasks::Future<typename std::result_of<F(Args...)>::type>
+        {
+            using return_type = typename std::result_of<F(Args...)>::type;
+
+            auto bound = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+
+            Tasks::Promise<return_type> promise(slab.get());
+            Tasks::Future<return_type> fut = promise.get_future();
+
+            enqueue(Tasks::Job<return_type, decltype(bound)>{ std::move(promise), std::move(bound) });
+            return fut;
+        }
+
+        // range의 원소마다 fn(원소)를 작업 하나로 등록 (lock 1회 + wake-up 1회), 모두 끝나면 준비되는 Future 하나 반환
+        //   - range는 Future가 준비될 때까지 살아 있어야 한다 (원소를 iterator로 참조)
+        //   - 예외는 처음 하나만 Future로 전달
+        template<class Range, class F>
+        Tasks::Future<void> submit_bulk(Range& range, F fn)
+        {
+            using std::begin;
+            using std::end;
+            using Iterator = decltype(begin(range));
+
+            const size_t count = static_cast<size_t>(std::distance(begin(range), end(range)));
+            Tasks::Promise<void> done(slab.get());
+            Tasks::Future<void> fut = done.get_future();
+            if (count == 0) {
+                done.set_value();
+                return fut;
+            }
+
+            BulkGroup<F>* group = BulkGroup<F>::create(slab.get(), std::move(done), std::move(fn), count);
+
+            if (ring_tasks) {
+                size_t pushed = 0;
+                for (Iterator it = begin(range); it != end(range); ++it, ++pushed) {
+                    if (!ring_tasks->push(Tasks::Task([group, it] { group->run(*it); }))) {
+                        group->abandon(count - pushed);
+                        throw std::runtime_error("ThreadPool has stopped!");
+                    }
+                }
+                return fut;
+            }
+
+            bool wake;
             {
                 std::unique_lock<std::mutex> lock(queue_mutex);
-                if (stop)
+                if (stop) {
+                    group->abandon(count);
                     throw std::runtime_error("ThreadPool has stopped!");
+                }
 
-                tasks.emplace([task_ptr] { (*task_ptr)(); });
+                for (Iterator it = begin(range); it != end(range); ++it)
+                    tasks.push(Tasks::Task([group, it] { group->run(*it); }));
+                wake = idle > 0;
+            }
+            if (wake) {
+                if (count > 1) condition.notify_all();
+                else condition.notify_one();
             }
-            condition.notify_one();
             return fut;
         }
 
         ~CustomThreadPool() {
+            if (ring_tasks) {
+                ring_tasks->close();    // 대기 중인 워커를 깨우고, 남은 작업 처리 후 종료시킴
+                for (std::thread& worker : workers)
+                    worker.join();
+                return;
+            }
+
             {
                 std::unique_lock<std::mutex> lock(queue_mutex);
                 stop = true;
@@ -184,15 +275,90 @@ namespace AsyncAndFuture
         }
 
     private:
+        // submit_bulk 한 번의 작업 묶음 (slab에서 할당, 마지막 작업이 Future를 채우고 스스로 해제)
+        template<class F>
+        struct BulkGroup {
+            Tasks::Promise<void> done;
+            F fn;
+            std::atomic<size_t> remaining;
+            std::atomic<bool> failed;
+            std::exception_ptr error;
+            Tasks::StateSlab* slab;
+
+            static BulkGroup* create(Tasks::StateSlab* slab, Tasks::Promise<void>&& done, F&& fn, size_t count) {
+                void* p = Tasks::StateSlab::allocate(slab, sizeof(BulkGroup));
+                return ::new (p) BulkGroup{ std::move(done), std::move(fn), { count }, { false }, nullptr, slab };
+            }
+
+            template<class T>
+            void run(T&& item) {
+                try {
+                    fn(std::forward<T>(item));
+                }
+                catch (...) {
+                    if (!failed.exchange(true))
+                        error = std::current_exception();
+                }
+                finish(1);
+            }
+
+            // 등록하지 못한 작업 n개를 실패로 처리
+            void abandon(size_t n) {
+                if (!failed.exchange(true))
+                    error = std::make_exception_ptr(std::runtime_error("ThreadPool has stopped!"));
+                finish(n);
+            }
+
+            void finish(size_t n) {
+                if (remaining.fetch_sub(n, std::memory_order_acq_rel) != n)
+                    return;
+
+                if (error) done.set_exception(error);
+                else done.set_value();
+
+                Tasks::StateSlab* owner = slab;
+                this->~BulkGroup();
+                Tasks::StateSlab::deallocate(owner, this, sizeof(BulkGroup));
+            }
+        };
+
+        void enqueue(Tasks::Task&& task) {
+            if (ring_tasks) {
+                if (!ring_tasks->push(std::move(task)))
+                    throw std::runtime_error("ThreadPool has stopped!");
+                return;
+            }
+
+            bool wake;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex);
+                if (stop)
+                    throw std::runtime_error("ThreadPool has stopped!");
+
+                tasks.push(std::move(task));
+                wake = idle > 0;
+            }
+            if (wake)
+                condition.notify_one();
+        }
+
         std::vector<std::thread> workers;
-        std::queue<std::function<void()>> tasks;
+        Tasks::TaskQueue tasks;
 
         std::mutex queue_mutex;
         std::condition_variable condition;
         bool stop;
+        size_t idle;
+
+        static const size_t RingCapacity = 1024;
+        LockFree::CacheAlignedPtr<LockFree::BlockingMpmcQueue<Tasks::Task>> ring_tasks;   // Ring 모드에서만 사용
+
+        // schedule/submit_bulk 의 공유 상태용 (풀이 먼저 사라져도 남은 Future가 반납될 때 해제)
+        struct SlabRelease { void operator()(Tasks::StateSlab* s) const { s->release(); } };
+        std::unique_ptr<Tasks::StateSlab, SlabRelease> slab;
     };
 
-    void async_future_with_CustomThreadPool()
+    void async_future_with_CustomThreadPool(LockFree::HandOff handoff = LockFree::HandOff::Lock)
     {
         /*
             📚 CustomThreadPool + future + timeout 실전 예제
@@ -207,7 +373,7 @@ namespace AsyncAndFuture
         */
 
         {
-            CustomThreadPool pool(2); // 스레드 2개짜리 풀
+            CustomThreadPool pool(2, handoff); // 스레드 2개짜리 풀
 
             std::vector<std::future<int>> results;
             for (int i = 0; i < 4; ++i) {
@@ -236,10 +402,59 @@ namespace AsyncAndFuture
         system("pause");
     }
 
+    void custom_thread_pool_schedule(LockFree::HandOff handoff = LockFree::HandOff::Lock)
+    {
+        /*
+            📚 할당 없는 작업 제출: schedule / submit_bulk
+
+              - submit: make_shared<packaged_task> + bind + std::function + std::future 공유 상태
+                => 작업 하나에 heap 할당 여러 번 + 매번 notify(잠든 워커가 없어도)
+              - schedule: 작업은 Tasks::Task(48 byte까지 inline), 결과 공유 상태는 풀의 slab에서
+                => 작업당 heap 할당 없음, Tasks::Future는 get/wait/wait_for 지원 (예외도 get에서 다시 던짐)
+              - submit_bulk(range, fn): 원소마다 작업 하나, lock 1회 + wake-up 1회로 등록
+                => 모두 끝나면 준비되는 Tasks::Future<void> 하나
+              - 잠든 워커가 없으면 notify 자체를 생략 (바쁜 풀에서는 syscall 없음)
+        */
+        {
+            CustomThreadPool pool(2, handoff);
+
+            std::vector<Tasks::Future<int>> results;
+            for (int i = 0; i < 4; ++i) {
+                results.emplace_back(pool.schedule([](int x) { return x * x; }, i + 1));
+            }
+            for (size_t i = 0; i < results.size(); ++i) {
+                std::cout << "Task " << i << " result: " << results[i].get() << std::endl;
+            }
+
+            std::vector<int> values(1000);
+            for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+
+            std::atomic<long long> sum(0);
+            Tasks::Future<void> all = pool.submit_bulk(values, [&sum](int v) { sum += v; });
+            all.get();
+            std::cout << "submit_bulk sum: " << sum << std::endl;     // 499500
+
+            Tasks::Future<int> failing = pool.schedule([]() -> int { throw std::runtime_error("작업 실패"); });
+            try {
+                failing.get();
+            }
+            catch (const std::exception& e) {
+                std::cout << "exception: " << e.what() << std::endl;
+            }
+        }
+
+        system("pause");
+    }
+
 	void Test()
 	{
         async_future_with_CustomThreadPool();
 
+        //custom_thread_pool_schedule();
+        //custom_thread_pool_schedule(LockFree::HandOff::Ring);
+
+        //async_future_with_CustomThreadPool(LockFree::HandOff::Ring);
+
         async_future_with_Timeout();
 
         async_and_future_what();
@@ -4,6 +4,8 @@
 #include <ppl.h>
 #include <concurrent_unordered_map.h>
 
+#include "treiber_stack.h"
+
 
 namespace CAS
 {
@@ -93,73 +95,20 @@ namespace CAS
 		Obj* next;
 	};
 
+	// lock-free 스택 : LockFree::TreiberStack (Libs/treiber_stack.h)
+	//   - push : new_node->next = head 후 CAS(head, new_node->next, new_node)로 교체, 실패하면 갱신된 head로 재시도
+	//   - pop  : head를 hazard pointer로 보호한 뒤 next를 읽고 CAS, 떼어 낸 노드는 바로 delete 하지 않고 retire
+	//            => 다른 스레드가 아직 읽고 있는 노드를 해제(use-after-free)하거나 재사용된 주소로 CAS가 성공(ABA)하지 않음
+	//   참고: 예전 구현은 pop한 노드를 해제하지 않아(누수) 안전을 대신했음
 	template<class T>
-	struct node
-	{
-		T data;
-		node* next;
-		node(const T& data) : data(data), next(nullptr) {}
-	};
-
-	template<class T>
-	class stack
-	{
-	protected:
-		std::atomic<node<T>*> head;
-
-	public:
-
-		// 스택에 값 푸시
-		void push(const T& data)
-		{
-			node<T>* new_node = new node<T>(data);
-
-			// 현재 head 값을 new_node->next에 저장
-			new_node->next = head.load(std::memory_order_relaxed);
-
-			// head가 new_node->next와 동일하다면 new_node를 head로 원자적으로 교체
-			// 만약 중간에 다른 스레드가 값을 바꿨으면, new_node->next를 새 head로 갱신 후 다시 시도
-			while ( !std::atomic_compare_exchange_weak_explicit(
-															&head,
-															&new_node->next,
-															new_node,
-															std::memory_order_release,
-															std::memory_order_relaxed) );
-			// 반복문 내부는 비어 있음(성공할 때까지 계속 시도)
-			// 참고: 이 코드는 아래 버전들에서 thread-safe가 아님:
-			// GCC 4.8.3 이전, clang 2014-05-05 이전, MSVC 2014-03-17 이전. (멤버 함수 버전 권장)
-		}
-
-		// 스택에서 값 pop
-		bool pop(T& data)
-		{
-			node<T>* ret_node = head.load(std::memory_order_acquire);
-			if (nullptr == ret_node) {
-				return false;
-			}
-
-			node<T>* next = ret_node->next;
-
-			if (!std::atomic_compare_exchange_weak_explicit(
-														&head,
-														&ret_node,
-														next,
-														std::memory_order_release,
-														std::memory_order_relaxed)) {
-				return false;
-			}
-
-			data = ret_node->data;
-			return true;
-		}
-	};
+	using stack = LockFree::TreiberStack<T, LockFree::HazardPointers>;
 
 	void stack_by_std_automic()
 	{
 		/*
 			📚 stack_by_std_automic
 			  - std::atomic과 CAS를 사용한 lock-free 스택 구현 예제
-			  - 멀티스레드 환경에서도 락 없이 안전하게 push/pop이 가능(단, ABA 문제는 방지 못함)
+			  - 멀티스레드 환경에서도 락 없이 안전하게 push/pop이 가능(hazard pointer로 노드 회수 => ABA 방지)
 			  - 반복문 안에서 CAS를 통해 top 포인터를 교체, 값 변화와 반환을 단계별로 출력
 		*/ 
 		{
@@ -195,6 +144,62 @@ namespace CAS
 
 	//=============================================================================================
 
+	// 회수 정책(hazard pointer / epoch)별 Treiber stack 처리량 측정
+	//   - 정확성(유실/중복/누수) 스트레스 테스트는 tests/test_treiber_stack_reclamation.cpp (ctest, ASan/TSan 빌드 가능)
+	template<typename Reclaimer>
+	void benchmark_treiber_stack(const char* name, int threadCount, int pairsPerThread)
+	{
+		LockFree::TreiberStack<uint64_t, Reclaimer> st;
+		for (int i = 0; i < 1024; ++i) st.push(uint64_t(i));
+
+		std::atomic<bool> go(false);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&st, &go, pairsPerThread]() {
+				while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+				uint64_t v = 0;
+				for (int i = 0; i < pairsPerThread; ++i) {
+					st.push(v + i);
+					st.pop(v);
+				}
+			});
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		go.store(true, std::memory_order_release);
+		for (auto& th : threads) th.join();
+		auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		const double ops = 2.0 * threadCount * pairsPerThread;
+		std::cout << "[bench] " << std::left << std::setw(18) << name
+			<< " threads=" << threadCount
+			<< " " << std::fixed << std::setprecision(2) << (ops / elapsed / 1e6) << " Mops/s"
+			<< std::endl;
+	}
+
+	void treiber_stack_reclamation()
+	{
+		/*
+			📚 Treiber stack + 안전한 메모리 회수
+
+			  - pop에서 떼어 낸 노드를 바로 delete 하면
+				• 같은 노드의 next를 읽던 다른 스레드 => use-after-free
+				• 해제된 주소가 new로 재사용되어 다시 head가 됨 => CAS가 잘못 성공(ABA)
+			  - Hazard Pointers  : 읽을 노드를 slot에 공개, 어떤 slot에도 없는 노드만 해제
+								   미회수 노드 수에 상한이 있음(bounded memory)
+			  - Epoch Reclamation: guard 구간 단위로 epoch 공개, 2 epoch 지난 노드를 일괄 해제
+								   읽기 비용이 작지만 guard 안에서 멈춘 스레드가 있으면 회수도 멈춤
+		*/
+		const int threadCount = (std::max)(2u, std::thread::hardware_concurrency());
+
+		benchmark_treiber_stack<LockFree::HazardPointers>("HazardPointers", threadCount, 1000000);
+		benchmark_treiber_stack<LockFree::EpochReclamation>("EpochReclamation", threadCount, 1000000);
+
+		system("pause");
+	}
+
+	//=============================================================================================
+
 	void std_automic_advance()
 	{
 		/*
@@ -281,6 +286,8 @@ namespace CAS
 
 		stack_by_std_automic();
 
+		treiber_stack_reclamation();
+
 		std_automic_advance();
 
 		CAS_what();
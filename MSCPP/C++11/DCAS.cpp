@@ -3,6 +3,10 @@
 
 #include <boost/thread.hpp>
 
+#include "reclamation.h"
+#include "dcas.h"
+#include "backoff.h"
+
 
 namespace DCAS
 {
@@ -39,22 +43,19 @@ namespace DCAS
     };
 
     // 포인터+버전 구조체 (DCAS 효과를 내기 위한 tagged pointer)
-    struct TaggedPtr {
-        Node* ptr;
-        uint64_t tag; // 버전/세대
-
-        // 동등성 비교 지원
-        bool operator==(const TaggedPtr& rhs) const {
-            return ptr == rhs.ptr && tag == rhs.tag;
-        }
-    };
+    //   {Node* ptr; uint64_t tag;} 16 byte, 동등성 비교(ptr/tag) 지원
+    using TaggedPtr = LockFree::TaggedPtr<Node>;
 
     // 원자적 tagged pointer
-    std::atomic<TaggedPtr> atomic_head;
+    //   std::atomic<TaggedPtr>는 -mcx16 없는 GCC/Clang, MSVC 등에서 내부 lock으로 바뀌므로
+    //   cmpxchg16b / casp 를 직접 쓰는 head를 사용 (DWCAS가 없는 대상은 포인터 상위 비트에 tag를 넣는 방식)
+    LockFree::TaggedHead<Node> atomic_head;
+    static_assert(LockFree::TaggedHead<Node>::is_always_lock_free, "tagged head must be lock-free");
 
     void dcas_push(int value) 
     {
         Node* new_node = new Node(value);
+        LockFree::ExponentialBackoff backoff;
         TaggedPtr old_head = atomic_head.load(std::memory_order_acquire);
         while (true) {
             new_node->next = old_head.ptr;
@@ -63,12 +64,19 @@ namespace DCAS
             if (atomic_head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_acquire))
                 break;
             // 실패 시 old_head가 최신값으로 자동 갱신됨
+            // 경합 중이므로 바로 재시도하지 않고 잠깐 쉰다(exponential backoff)
+            backoff.pause();
         }
     }
 
+    // tag는 ABA(같은 주소가 다시 head가 됨)를 막지만, 떼어 낸 노드의 해제 시점까지는 해결하지 못함
+    //  => 다른 스레드가 old_head.ptr->next를 읽는 중에 delete 되면 use-after-free
+    //  => hazard pointer로 head 노드를 보호하고, 떼어 낸 노드는 retire 해서 안전할 때 해제
     bool dcas_pop(int& value) 
     {
-        TaggedPtr old_head = atomic_head.load(std::memory_order_acquire);
+        LockFree::HazardPointers::Guard guard;
+        LockFree::ExponentialBackoff backoff;
+        TaggedPtr old_head = guard.protect(atomic_head, [](const TaggedPtr& h) { return h.ptr; });
 
         while (true) {
             if (old_head.ptr == nullptr)
@@ -78,16 +86,21 @@ namespace DCAS
             TaggedPtr new_head = { node->next, old_head.tag + 1 };
             if (atomic_head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_acquire)) {
                 value = node->value;
-                delete node;
+                guard.clear();
+                LockFree::HazardPointers::retire(node);
                 return true;
             }
+
+            // 실패 시 잠깐 쉰 뒤 갱신된 head를 다시 보호
+            backoff.pause();
+            old_head = guard.protect(atomic_head, [](const TaggedPtr& h) { return h.ptr; });
         }
     }
 
     void DCAS_with_stack()
     {
         // 초기화
-        atomic_head = TaggedPtr{ nullptr, 0 };
+        atomic_head.store(TaggedPtr{ nullptr, 0 });
 
         // push 테스트
         dcas_push(10);
@@ -107,11 +120,67 @@ namespace DCAS
         */
     }
 
+    //=============================================================================================
+
+    // tagged head 구현별 경합 비용: 모든 스레드가 같은 head의 tag를 CAS로 증가
+    template<template<typename> class Head>
+    void benchmark_tagged_head(int threadCount, int casPerThread)
+    {
+        Head<Node> head(TaggedPtr{ nullptr, 0 });
+
+        std::atomic<bool> go(false);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&head, &go, casPerThread]() {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (int i = 0; i < casPerThread; ++i) {
+                    TaggedPtr old_head = head.load(std::memory_order_acquire);
+                    while (!head.compare_exchange_weak(old_head, TaggedPtr{ old_head.ptr, old_head.tag + 1 },
+                        std::memory_order_acq_rel, std::memory_order_acquire));
+                }
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& th : threads) th.join();
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "[bench] " << std::left << std::setw(12) << Head<Node>::name()
+            << " always_lock_free=" << std::boolalpha << Head<Node>::is_always_lock_free
+            << " lock_free=" << head.is_lock_free()
+            << " threads=" << threadCount
+            << " " << std::fixed << std::setprecision(2) << (double(threadCount) * casPerThread / elapsed / 1e6) << " Mcas/s"
+            << " (tag=" << head.load().tag << ")"
+            << std::endl;
+    }
+
+    void benchmark_tagged_heads()
+    {
+        const int threadCount = (std::max)(2u, std::thread::hardware_concurrency());
+
+        for (int n = 1; n <= threadCount; n *= 2) {
+#if LOCKFREE_HAS_DWCAS
+            benchmark_tagged_head<LockFree::DwcasTaggedHead>(n, 1000000);
+#endif
+            benchmark_tagged_head<LockFree::PackedTaggedHead>(n, 1000000);
+            benchmark_tagged_head<LockFree::LockedTaggedHead>(n, 1000000);
+        }
+        /*
+        출력 예시 (x86-64, GCC, -mcx16 없음):
+            dwcas        always_lock_free=true  lock_free=true  ...
+            packed       always_lock_free=true  lock_free=true  ...
+            std::atomic  always_lock_free=false lock_free=false ...   <= libatomic 내부 lock
+        */
+    }
+
 
 	void Test()
 	{
         DCAS_with_stack();
 
+        //benchmark_tagged_heads();
+
         DCAS_what();
 	}
 }//DCAS
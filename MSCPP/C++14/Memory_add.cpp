@@ -2,6 +2,10 @@
 
 
 #include <mutex>
+#include <thread>
+#include <vector>
+
+#include "object_pool.h"
 
 
 namespace Memory_AddFeature
@@ -431,12 +435,46 @@ namespace Memory_AddFeature
 		system("pause");
 	}
 
+	//---------------------------------------------------------------------------------------------
+	// 위 ObjectPool 은 Acquire/Release 마다 mutex 를 잡는다.
+	// Pooling::ObjectPool (Libs/object_pool.h) 은 스레드별 magazine 에서 꺼내고 넣으므로
+	// 보통은 잠금도 atomic 도 없고, 다른 스레드에서 반환해도 그 스레드의 magazine 으로 간다.
+	// PooledPtr/PoolDeleter 모양은 같다.
+
+	void thread_caching_object_pool()
+	{
+		Pooling::PoolOptions options;
+		options.magazine_size = 32;
+		options.high_water = 8;        // depot 에 full magazine 이 8 개 넘게 쌓이면 빈 64 KB chunk 를 돌려준다
+		Pooling::ObjectPool<Event> jobPool(options);
+
+		// 생산자가 만들고 소비자가 반환
+		std::vector<Pooling::ObjectPool<Event>::PooledPtr> jobs;
+		for (int i = 0; i < 1000; ++i) jobs.push_back(jobPool.Acquire(1, 1000 + i));
+
+		std::thread consumer([&jobs] {
+			for (auto& job : jobs) {
+				job->Execute();
+				job.reset();           // 이 스레드의 magazine 으로 반환
+			}
+		});                            // 스레드가 끝나면 magazine 은 풀의 depot 으로
+		consumer.join();
+
+		std::cout << "chunks: " << jobPool.chunk_count() << "\n";
+		jobPool.trim();
+		std::cout << "chunks after trim: " << jobPool.chunk_count() << "\n";
+
+		system("pause");
+	}
+
 	//=============================================================================================
 
 	void Test()
 	{
 		object_pool_with_unique_ptr();
 
+		//thread_caching_object_pool();
+
 		unique_ptr_with_deleter();
 
 		make_unique_with_memory_leak();
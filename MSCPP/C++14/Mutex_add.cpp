@@ -4,6 +4,8 @@
 #include <thread>
 #include <shared_mutex>
 
+#include "rw_lock.h"
+
 
 namespace Mutex_AddFeature
 {
@@ -102,9 +104,82 @@ namespace Mutex_AddFeature
 	}
 
 
+	// SharedData 와 같은 모양, std::shared_timed_mutex 대신 Sync::DistributedSharedMutex
+	class DistributedSharedData
+	{
+	public:
+		int Read() const
+		{
+			std::shared_lock<Sync::DistributedSharedMutex> lock(m_); // 공유(읽기) 락 : 자기 slot 만 증가
+			return value_;
+		}
+
+		bool TryWriteFor(int v, std::chrono::milliseconds timeout)
+		{
+			std::unique_lock<Sync::DistributedSharedMutex> lock(m_, std::defer_lock);
+			if (!lock.try_lock_for(timeout)) // timeout 안에 reader 가 다 빠지지 않으면 writer flag 를 내리고 실패
+				return false;
+
+			value_ = v;
+			return true;
+		}
+
+		// 테스트용: 읽기 락을 오래 잡고 있는 reader
+		void HoldRead(std::chrono::milliseconds hold)
+		{
+			std::shared_lock<Sync::DistributedSharedMutex> lock(m_);
+			std::this_thread::sleep_for(hold);
+		}
+
+	private:
+		mutable Sync::DistributedSharedMutex m_;
+		int value_ = 0;
+	};
+
+	void distributed_shared_timed_mutex()
+	{
+		/*
+			📚	Sync::DistributedSharedMutex (Libs/rw_lock.h) 의 시간 제한 잠금
+			  - std::shared_timed_mutex 와 같은 함수 : try_lock_for/until, try_lock_shared_for/until
+			  - reader 수를 스레드별 slot(cache line 하나씩)에 나눠 세므로 읽기끼리 cache line 을 공유하지 않는다
+			  - writer 우선 : writer 가 기다리는 동안 새 reader 는 물러난다
+			    => timed writer 가 시간 안에 못 잡으면 flag 를 내리고, 물러났던 reader 를 깨운다
+		*/
+		{
+			using namespace std::chrono_literals;
+
+			DistributedSharedData data;
+			data.TryWriteFor(100, 10ms);
+
+			// 읽기 락을 오래 잡는 스레드(경합 유도)
+			std::thread holder([&] {
+				data.HoldRead(150ms);
+				std::cout << "[H] released read lock\n";
+			});
+
+			std::this_thread::sleep_for(5ms);
+
+			std::thread writer([&] {
+				bool ok = data.TryWriteFor(200, 30ms); // reader 가 150ms 동안 잡고 있으므로 TIMEOUT
+				std::cout << "[W] TryWriteFor(200) => " << (ok ? "OK" : "TIMEOUT") << "\n";
+
+				bool ok2 = data.TryWriteFor(300, 300ms);
+				std::cout << "[W] TryWriteFor(300) => " << (ok2 ? "OK" : "TIMEOUT") << "\n";
+			});
+
+			holder.join();
+			writer.join();
+			std::cout << "[R] value=" << data.Read() << "\n";
+
+			system("pause");
+		}
+	}
+
+
 	void Test()
 	{
 		std_shared_timed_mutex();
+		//distributed_shared_timed_mutex();
 	}
 
 }//Mutex_AddFeature
\ No newline at end of file
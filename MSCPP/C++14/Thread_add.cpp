@@ -2,6 +2,9 @@
 
 #include <thread>
 #include <mutex>
+#include <vector>
+
+#include "thread_counters.h"
 
 namespace Thread_AddFutures
 {
@@ -51,9 +54,60 @@ namespace Thread_AddFutures
 		system("pause");
 	}
 
+	void thread_counter_registry()
+	{
+		/*
+			📚 thread_local 로 만든 스레드별 counter (Libs/thread_counters.h)
+
+			  - 여러 스레드가 std::atomic<uint64_t> 하나에 fetch_add 하면 그 cache line 이 코어 사이를 오간다
+			  - Metrics::Registry 는 스레드마다 cache line 정렬된 자기 page 에 더하고(load + store),
+			    snapshot() 이 살아 있는 스레드의 값을 모아 더한다
+			  - 끝난 스레드의 값은 thread_local 소멸자에서 registry 의 retired 합으로 옮겨지므로 사라지지 않는다
+			  - counter / histogram 은 스레드가 도는 중에도 이름으로 등록할 수 있다 (같은 이름 = 같은 counter)
+		*/
+		{
+			Metrics::Registry registry;
+			const Metrics::Counter requests = registry.counter("requests");
+			const Metrics::Histogram latency = registry.histogram("latency_us", Metrics::Registry::exponential_bounds(10, 10, 3));
+
+			std::vector<std::thread> workers;
+			for (int t = 0; t < 4; ++t) {
+				workers.emplace_back([&registry, &requests, &latency, t] {
+					const Metrics::Counter errors = registry.counter("errors");     // 스레드 안에서 등록
+					for (int i = 0; i < 1000; ++i) {
+						requests.add();
+						latency.record(static_cast<uint64_t>(i * (t + 1)));
+						if (i % 100 == 0) errors.add();
+					}
+				});
+			}
+			for (std::thread& w : workers) w.join();
+
+			const Metrics::Snapshot snapshot = registry.snapshot();
+			std::cout << "threads : live " << snapshot.live_threads << ", retired " << snapshot.retired_threads << std::endl;
+			for (const Metrics::CounterValue& c : snapshot.counters)
+				std::cout << c.name << " : " << c.value << std::endl;
+			for (const Metrics::HistogramValue& h : snapshot.histograms) {
+				std::cout << h.name << " : count " << h.count << ", sum " << h.sum << ", buckets";
+				for (uint64_t b : h.buckets) std::cout << " " << b;
+				std::cout << std::endl;
+			}
+
+			/*
+				출력:
+				threads : live 0, retired 4
+				requests : 4000
+				errors : 40
+				latency_us : count 4000, sum 4995000, buckets 24 188 1874 1914
+			*/
+		}
+	}
+
 	void Test()
 	{
 		thread_local_tls();
+
+		//thread_counter_registry();
 	}
 
 }//Thread_AddFutures
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <mutex>
 
+#include "event_hub.h"
+
 
 namespace Memory_AddFeature
 {
@@ -130,9 +132,62 @@ namespace Memory_AddFeature
 
 	//=============================================================================================
 
+	void event_hub_with_weak_targets()
+	{
+		/*
+			📚 위 CallbackHub 를 여러 스레드에서 쓰려면
+			  - FireAll 중에 RegisterCallback 이 vector 를 바꾸면 안 된다 => 보통 mutex 로 감싼다
+			  - weak 캡처 콜백은 fire 할 때마다 lock() (atomic 참조 카운트 증감) 하고,
+			    죽은 객체의 콜백은 지워지지 않고 계속 쌓인다
+
+			  Events::EventHub (Libs/event_hub.h)
+			  - 구독자 배열은 바꿀 때 복사해서 통째로 교체 (RCU / copy-on-write)
+			    => fire 는 잠금 없이 현재 배열을 읽기만 한다
+			  - subscribe(shared_ptr, &T::Method) : 약한 참조로 보관, 만료된 구독자는 모아서 한꺼번에 제거
+			  - fire_parallel(pool, ...) : 구독자가 아주 많으면 thread pool 로 나눠 호출
+		*/
+
+		class MyObj {
+		public:
+			explicit MyObj(int id) : id_(id) {}
+
+			void OnEvent(int value) {
+				std::cout << "[MyObj#" << id_ << "] OnEvent(" << value << ")\n";
+			}
+
+		private:
+			int id_;
+		};
+
+		Events::HubOptions options;
+		options.prune_batch = 1;            // 데모: 만료된 구독자를 바로 정리
+		Events::EventHub<int> hub(options);
+
+		hub.subscribe([](int value) { std::cout << "[lambda] " << value << "\n"; });
+
+		auto obj = std::make_shared<MyObj>(7);
+		hub.subscribe(obj, &MyObj::OnEvent);    // this 를 직접 잡지 않는다 (weak)
+
+		std::cout << "== Fire while alive ==\n";
+		hub.fire(1);
+		std::cout << "subscribers: " << hub.size() << "\n";    // 2
+
+		obj.reset();
+
+		std::cout << "== Fire after destruction ==\n";
+		hub.fire(2);                            // MyObj 는 건너뛰고, 이번 fire 끝에서 제거
+		std::cout << "subscribers: " << hub.size() << "\n";    // 1
+
+		system("pause");
+	}
+
+	//=============================================================================================
+
 	void Test()
 	{
 		enable_shared_from_this_with_weak_from_this();
+
+		//event_hub_with_weak_targets();
 	}
 
 }//Memory_AddFeature
\ No newline at end of file
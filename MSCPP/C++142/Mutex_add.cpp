@@ -4,6 +4,8 @@
 #include <thread>
 #include <shared_mutex>
 
+#include "rw_lock.h"
+
 
 namespace Mutex_AddFeature
 {
@@ -79,9 +81,128 @@ namespace Mutex_AddFeature
 	}
 
 
+	// SharedValue 와 같은 모양, std::shared_mutex 대신 Sync::DistributedSharedMutex
+	class DistributedSharedValue
+	{
+	public:
+		int Read() const
+		{
+			std::shared_lock<Sync::DistributedSharedMutex> lock(m_); // 자기 slot 만 증가
+			return value_;
+		}
+
+		void Write(int v)
+		{
+			std::unique_lock<Sync::DistributedSharedMutex> lock(m_); // writer flag + 모든 slot 이 0 이 될 때까지
+			value_ = v;
+		}
+
+	private:
+		mutable Sync::DistributedSharedMutex m_;
+		int value_ = 0;
+	};
+
+	void distributed_shared_mutex()
+	{
+		/*
+			📚	std::shared_mutex 의 한계
+			  - lock_shared / unlock_shared 마다 mutex 안의 reader 수를 atomic 으로 증감
+			  - 읽기만 하는 스레드도 같은 cache line 에 "쓰기" => 코어가 늘수록 line 이 핑퐁하고 읽기가 늘지 않음
+
+			📚	Sync::DistributedSharedMutex (Libs/rw_lock.h)
+			  * reader
+			    - reader 수를 cache line 하나씩 떨어진 slot 여러 개에 나눠 센다(스레드마다 자기 slot)
+				- writer flag 만 읽고 자기 slot 만 쓰므로 reader 끼리는 line 을 공유하지 않음
+			  * writer
+				- writer flag 를 세우고 모든 slot 이 0 이 되기를 기다림 (쓰기는 std::shared_mutex 보다 비싸다)
+				- flag 가 선 뒤 오는 reader 는 물러남 => writer 우선, reader 가 많아도 writer 가 굶지 않음
+			  * std::shared_lock / std::unique_lock 에 그대로 사용 (try_lock_for 등 timed 함수 포함)
+		*/
+		{
+			DistributedSharedValue data;
+			data.Write(100);
+
+			std::atomic<bool> stop{ false };
+			std::atomic<long long> reads{ 0 };
+
+			auto reader = [&]()
+			{
+				long long count = 0;
+				while (!stop.load(std::memory_order_relaxed))
+				{
+					if (data.Read() < 100) std::cout << "unexpected\n";
+					++count;
+				}
+				reads += count;
+			};
+
+			std::vector<std::thread> readers;
+			for (int i = 0; i < 4; ++i) readers.emplace_back(reader);
+
+			for (int i = 0; i < 100; ++i)
+			{
+				data.Write(100 + i);
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			stop = true;
+			for (std::thread& t : readers) t.join();
+
+			std::cout << "[distributed] reads=" << reads << ", last=" << data.Read() << "\n";
+		}
+	}
+
+	void seqlock_shared_value()
+	{
+		/*
+			📚	seqlock : Sync::SharedValue<T> (Libs/rw_lock.h)
+			  - 작은 POD snapshot 용. 읽기는 공유 메모리에 아무것도 쓰지 않는다(lock 없음)
+			  - 읽기 : sequence 확인 => 값 복사 => sequence 재확인, 쓰는 도중이었으면 다시 읽음
+			  - 쓰기 : sequence 홀수 => 값 => 짝수 (writer 끼리는 mutex)
+			  - 읽은 값은 항상 한 번의 쓰기 결과 전체 (필드가 섞이지 않음)
+		*/
+		{
+			struct Quote
+			{
+				double bid;
+				double ask;
+				long long serial;
+			};
+
+			Sync::SharedValue<Quote> quote(Quote{ 99.5, 100.5, 0 });
+			std::atomic<bool> stop{ false };
+			std::atomic<long long> torn{ 0 };
+
+			auto reader = [&]()
+			{
+				while (!stop.load(std::memory_order_relaxed))
+				{
+					const Quote q = quote.load();
+					if (q.ask - q.bid != 1.0) ++torn;        // bid/ask 는 항상 같이 바뀐다
+				}
+			};
+
+			std::thread r1(reader);
+			std::thread r2(reader);
+
+			for (int i = 1; i <= 1000; ++i)
+			{
+				quote.update([i](Quote& q) { q.bid = 99.5 + i; q.ask = 100.5 + i; q.serial = i; });
+			}
+			stop = true;
+			r1.join();
+			r2.join();
+
+			const Quote last = quote.load();
+			std::cout << "[seqlock] serial=" << last.serial << ", bid=" << last.bid << ", torn=" << torn << ", version=" << quote.version() << "\n";
+		}
+	}
+
+
 	void Test()
 	{
 		std_shared_mutex();
+		//distributed_shared_mutex();
+		//seqlock_shared_value();
 	}
 
 }//Mutex
\ No newline at end of file
@@ -4,6 +4,14 @@
 #include <string_view>
 #include <optional>
 
+#include "enum_reflect.h"
+
+// C++/Colors.h 와 같은 방식 : 같은 목록을 매크로만 바꿔 두 번 펼친다 (enum 선언 => 컴파일 시간 hash 표)
+#include "../C++/EnumMacro.h"
+#include "../C++/ColorEnums.h"
+#include "../C++/EnumReflect.h"
+#include "../C++/ColorEnums.h"
+
 
 namespace STL_Improvements
 {
@@ -54,9 +62,71 @@ namespace STL_Improvements
         }
     }
 
+    // 값이 띄엄띄엄인 enum, flag enum 은 { 이름, 값 } 표를 직접 적는다
+    enum class HttpStatus : int { Ok = 200, Created = 201, MovedPermanently = 301, NotFound = 404, InternalError = 500, Success = 200 };
+
+    inline constexpr EnumReflect::Entry<HttpStatus> HttpStatus_Entries[] = {
+        { "Ok", HttpStatus::Ok }, { "Created", HttpStatus::Created }, { "MovedPermanently", HttpStatus::MovedPermanently },
+        { "NotFound", HttpStatus::NotFound }, { "InternalError", HttpStatus::InternalError }, { "Success", HttpStatus::Success },
+    };
+    ENUM_REFLECT_TABLE(HttpStatus, HttpStatus_Entries)
+
+    enum class FileAccess : unsigned { None = 0, Read = 1 << 0, Write = 1 << 1, Execute = 1 << 2, ReadWrite = Read | Write };
+
+    inline constexpr EnumReflect::Entry<FileAccess> FileAccess_Entries[] = {
+        { "None", FileAccess::None }, { "Read", FileAccess::Read }, { "Write", FileAccess::Write },
+        { "Execute", FileAccess::Execute }, { "ReadWrite", FileAccess::ReadWrite },
+    };
+    ENUM_REFLECT_TABLE(FileAccess, FileAccess_Entries)
+
+    void constexpr_enum_reflection()
+    {
+        /*
+            📚 enum <-> 문자열 변환 (C++/EnumToString.h 대신 Libs/enum_reflect.h)
+
+              - ColorEnum_FromString : 이름 배열 strcmp 선형 탐색 => 컴파일 시간 최소 완전 해시 + 이름 한 번 비교 (O(1))
+              - ColorEnum_ToString   : 값으로 배열 index (범위 검사 없음, 0 부터 연속만) => 범위 검사 + 띄엄띄엄/flag 값 지원
+              - 표는 constexpr 로 만들어지므로 static_assert 안에서도 쓸 수 있다
+              - 같은 값의 별칭(Success == Ok)은 먼저 선언한 이름으로 출력
+        */
+        {
+            static_assert(EnumReflect::to_string(HttpStatus::NotFound) == "NotFound");
+            static_assert(*EnumReflect::from_string<HttpStatus>("Created") == HttpStatus::Created);
+
+            ColorEnum color = RED;
+            if (ColorEnum_FromString("GREEN", color))
+                std::cout << "ColorEnum: " << ColorEnum_ToString(color) << " = " << color << std::endl;
+
+            std::cout << "HttpStatus 200: " << EnumReflect::to_string(HttpStatus::Success) << std::endl;
+            std::cout << "HttpStatus 418: [" << EnumReflect::to_string(static_cast<HttpStatus>(418)) << "]" << std::endl;
+
+            std::string text;
+            EnumReflect::flags_to_string(static_cast<FileAccess>(1 | 4), text);
+            std::cout << "FileAccess 5: " << text << std::endl;
+            EnumReflect::flags_to_string(FileAccess::ReadWrite, text);
+            std::cout << "FileAccess 3: " << text << std::endl;
+
+            FileAccess access = FileAccess::None;
+            if (EnumReflect::flags_from_string("Write | Execute", access))
+                std::cout << "\"Write | Execute\": " << static_cast<unsigned>(access) << std::endl;
+
+            /*
+                출력:
+                ColorEnum: GREEN = 2
+                HttpStatus 200: Ok
+                HttpStatus 418: []
+                FileAccess 5: Read|Execute
+                FileAccess 3: ReadWrite
+                "Write | Execute": 6
+            */
+        }
+    }
+
     void Test()
     {
         STL_improvements();
+
+        //constexpr_enum_reflection();
     }
 
 }//STL_Improvements
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include <coroutine>
 #include <thread>
 #include <chrono>
+#include <ranges>
+#include <memory_resource>
+
+#include "generator.h"
 
 
 namespace Coroutine
@@ -629,6 +633,68 @@ namespace Coroutine
 
     //=============================================================================================
 
+    //---------------------------------------------------------------------------------------------
+    // 템플릿 Generator<T> (Libs/generator.h)
+    //   - 위의 Generator 는 int 전용 + next()/value() 뿐이라 range-for, std::ranges 에 쓸 수 없고
+    //     다른 Generator 를 통째로 yield 할 수도 없다.
+    //---------------------------------------------------------------------------------------------
+
+    struct TreeNode
+    {
+        int key;
+        TreeNode* left = nullptr;
+        TreeNode* right = nullptr;
+    };
+
+    // 재귀 전위 순회 : co_yield elements_of(자식) => 가장 안쪽 coroutine 이 직접 resume 된다 (원소당 O(1))
+    Coro::Generator<const TreeNode&> preorder(const TreeNode* node)
+    {
+        if (nullptr == node) co_return;
+
+        co_yield *node;                                         // 참조로 yield (복사 없음)
+        co_yield Coro::elements_of(preorder(node->left));
+        co_yield Coro::elements_of(preorder(node->right));
+    }
+
+    // std::allocator_arg + allocator 를 첫 인자로 넘기면 coroutine frame 을 그 allocator 로 잡는다
+    Coro::Generator<int> iota(std::allocator_arg_t, std::pmr::polymorphic_allocator<std::byte>, int from, int to)
+    {
+        for (int i = from; i < to; ++i) co_yield i;
+    }
+
+    void templated_generator_use()
+    {
+        // 트리 : 4 ( 2 ( 1, 3 ), 6 ( 5, 7 ) )
+        TreeNode n1{ 1 }, n3{ 3 }, n5{ 5 }, n7{ 7 };
+        TreeNode n2{ 2, &n1, &n3 }, n6{ 6, &n5, &n7 };
+        TreeNode root{ 4, &n2, &n6 };
+
+        for (const TreeNode& node : preorder(&root)) {
+            std::cout << node.key << " ";
+        }
+        std::cout << std::endl; // 출력: 4 2 1 3 6 5 7
+
+        // Generator 는 std::ranges::view => 파이프라인에 그대로
+        for (int key : preorder(&root)
+                        | std::views::transform([](const TreeNode& n) { return n.key; })
+                        | std::views::filter([](int k) { return k % 2 == 1; })
+                        | std::views::take(3)) {
+            std::cout << key << " ";
+        }
+        std::cout << std::endl; // 출력: 1 3 5
+
+        // frame 을 stack buffer 에서
+        std::byte buffer[1024];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+        int sum = 0;
+        for (int i : iota(std::allocator_arg, &arena, 1, 11)) sum += i;
+        std::cout << sum << std::endl; // 출력: 55
+
+        system("pause");
+    }
+
+    //=============================================================================================
+
     //---------------------------------------------------------------------------------------------
     // 1) return_void() 함수를 사용한 경우
     //---------------------------------------------------------------------------------------------
@@ -1090,6 +1156,8 @@ namespace Coroutine
         
         co_return_use();
 
+        //templated_generator_use();
+
         co_yield_use();
 
         coroutine_to_non_awaiter_use();
@@ -7,22 +7,194 @@
 #include <thread>
 #include <stop_token>
 
+#include "ring_queue.h"
+
 
 namespace TaskWithThreadPool
 {
 
+//--------------------------------------------------------------------------------------------------
+// Chase-Lev work-stealing deque
+//   - owner 워커만 bottom 쪽에서 push/take(LIFO), 다른 워커(thief)는 top 쪽에서 steal(FIFO)
+//   - 요소는 coroutine_handle의 address(void*) => 슬롯 하나를 원자적으로 읽고 쓸 수 있다.
+//   - 참고: Lê, Pop, Cohen, Nardelli "Correct and Efficient Work-Stealing for Weak Memory Models"
+//--------------------------------------------------------------------------------------------------
+inline constexpr size_t CacheLineSize = 64;     // false sharing 방지용 패딩 단위
+
+class ChaseLevDeque {
+public:
+    explicit ChaseLevDeque(size_t capacity = 256)   // capacity는 2의 거듭제곱
+        : _top(0), _bottom(0), _array(new Array(capacity)) {}
+
+    ~ChaseLevDeque() {
+        delete _array.load(std::memory_order_relaxed);
+        for (auto* a : _retired) delete a;
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    void push(void* p) {
+        // owner 전용: bottom에 추가
+        int64_t b = _bottom.load(std::memory_order_relaxed);
+        int64_t t = _top.load(std::memory_order_acquire);
+        Array* a = _array.load(std::memory_order_relaxed);
+
+        if (b - t > (int64_t)a->mask) a = grow(a, t, b);    // 가득 찼으면 2배로 확장
+
+        a->put(b, p);
+        _bottom.store(b + 1, std::memory_order_release);    // 요소 기록 -> bottom 공개 순서 보장
+    }
+
+    void* take() {
+        // owner 전용: bottom에서 꺼냄(LIFO, 캐시가 따뜻한 최근 작업부터)
+        int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = _array.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);    // bottom 예약 <-> thief의 top 읽기 순서 보장
+        int64_t t = _top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            _bottom.store(b + 1, std::memory_order_relaxed);    // 비어 있음: 예약 취소
+            return nullptr;
+        }
+
+        void* p = a->get(b);
+        if (t == b) {
+            // 마지막 1개 => thief와 top CAS로 경쟁
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                p = nullptr;    // thief가 가져감
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return p;
+    }
+
+    void* steal() {
+        // thief 전용: top에서 꺼냄(FIFO, 가장 오래된 작업부터)
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+
+        Array* a = _array.load(std::memory_order_acquire);
+        void* p = a->get(t);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;     // 다른 thief/owner에게 짐 => 호출자가 다른 victim을 시도
+        return p;
+    }
+
+    bool empty() const noexcept {
+        int64_t b = _bottom.load(std::memory_order_acquire);
+        int64_t t = _top.load(std::memory_order_acquire);
+        return b <= t;
+    }
+
+private:
+    struct Array {
+        explicit Array(size_t cap) : mask(cap - 1), slots(new std::atomic<void*>[cap]) {}
+
+        void  put(int64_t i, void* p) noexcept { slots[(size_t)i & mask].store(p, std::memory_order_relaxed); }
+        void* get(int64_t i) const noexcept { return slots[(size_t)i & mask].load(std::memory_order_relaxed); }
+
+        size_t mask;                                    // capacity - 1
+        std::unique_ptr<std::atomic<void*>[]> slots;    // 원형 버퍼
+    };
+
+    Array* grow(Array* old, int64_t t, int64_t b) {
+        Array* a = new Array((old->mask + 1) * 2);
+        for (int64_t i = t; i < b; ++i) a->put(i, old->get(i));
+
+        _retired.push_back(old);
+        // thief가 아직 old 배열을 읽고 있을 수 있으므로 즉시 delete 하지 않고 소멸자에서 해제
+        // (크기가 2배씩 커지므로 보관 메모리는 현재 배열 크기를 넘지 않는다)
+
+        _array.store(a, std::memory_order_release);
+        return a;
+    }
+
+    alignas(CacheLineSize) std::atomic<int64_t> _top;       // thief들이 경쟁하는 위치
+    alignas(CacheLineSize) std::atomic<int64_t> _bottom;    // owner만 기록하는 위치
+    std::atomic<Array*> _array;                             // 현재 원형 버퍼
+    std::vector<Array*> _retired;                           // 확장 후 남은 이전 버퍼들(owner만 접근)
+};
+
+//--------------------------------------------------------------------------------------------------
+// HandleQueue: coroutine handle 주소(void*)를 담는 원형 버퍼 FIFO (외부 락으로 보호)
+//   - std::queue<std::function<void()>>와 달리 작업마다 할당하지 않는다(가득 찼을 때만 2배 확장)
+//--------------------------------------------------------------------------------------------------
+class HandleQueue {
+public:
+    bool empty() const noexcept { return _head == _tail; }
+    size_t size() const noexcept { return _tail - _head; }
+
+    void push(void* p) {
+        if (size() == _buf.size()) grow();
+        _buf[_tail++ & (_buf.size() - 1)] = p;
+    }
+
+    void* pop() noexcept {
+        return _buf[_head++ & (_buf.size() - 1)];  // 호출자가 !empty() 확인
+    }
+
+private:
+    void grow() {
+        std::vector<void*> buf(std::max<size_t>(64, _buf.size() * 2));    // 크기는 항상 2의 거듭제곱
+        for (size_t i = _head; i < _tail; ++i) buf[i - _head] = _buf[i & (_buf.size() - 1)];
+        _tail -= _head;
+        _head = 0;
+        _buf.swap(buf);
+    }
+
+    std::vector<void*> _buf;    // 원형 버퍼
+    size_t _head = 0;           // 다음에 꺼낼 위치(단조 증가)
+    size_t _tail = 0;           // 다음에 넣을 위치(단조 증가)
+};
+
 //--------------------------------------------------------------------------------------------------
 // 간단한 스레드 풀
+//   - SharedQueue  : 전역 큐 1개 + mutex/condition_variable (기존 방식)
+//   - WorkStealing : 워커별 Chase-Lev deque + LIFO slot + random-victim stealing
+//   - RingQueue    : 전역 lock-free MPMC ring(LockFree::BlockingMpmcQueue) + spin 후 futex 대기
+//                    ring이 가득 찼을 때와 우선순위 작업만 mutex 큐(spill)로 보낸다.
+//   - high_priority: 모든 모드에서 별도의 우선순위 lane으로 들어가고 워커가 가장 먼저 꺼낸다.
 //--------------------------------------------------------------------------------------------------
 class SimpleThreadPool {
 public:
-    explicit SimpleThreadPool(size_t n = std::thread::hardware_concurrency())
+    enum class Mode {
+        SharedQueue,    // 모든 워커가 락 하나를 두고 경쟁
+        WorkStealing,   // 워커별 큐, 비었을 때만 다른 워커에게서 훔쳐 옴
+        RingQueue,      // SharedQueue와 같은 전역 큐 구조지만 락 없는 ring으로 hand-off
+    };
+
+    explicit SimpleThreadPool(size_t n = std::thread::hardware_concurrency(), Mode mode = Mode::SharedQueue)
         : _stop(false) // 스레드풀 종료 플래그 초기화(false = 실행중)
+        , _mode(mode)
     {
         if (n == 0) n = 4; // worker 벡터 capacity 확보(재할당 줄이기)
+
+        if (_mode == Mode::WorkStealing) {
+            _locals.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                _locals.emplace_back(std::make_unique<WorkerLocal>());
+                _locals.back()->rng = (uint32_t)(i * 0x9E3779B9u) | 1u;  // 워커마다 다른 xorshift seed
+            }
+            // 모든 WorkerLocal을 만든 뒤에 스레드를 띄운다 (steal 시 다른 워커의 WorkerLocal 참조)
+        }
+        else if (_mode == Mode::RingQueue) {
+            _ring = std::make_unique<LockFree::BlockingMpmcQueue<void*>>(RingCapacity);
+        }
+
         _workers.reserve(n);
         for (size_t i = 0; i < n; ++i) {
-            _workers.emplace_back([this] { worker_loop(); });
+            if (_mode == Mode::WorkStealing) {
+                _workers.emplace_back([this, i] { ws_worker_loop(i); });
+            }
+            else if (_mode == Mode::RingQueue) {
+                _workers.emplace_back([this] { ring_worker_loop(); });
+            }
+            else {
+                _workers.emplace_back([this] { worker_loop(); });
+            }
             // 워커 스레드 생성 및 처리할 로직 설정
             // worker_loop()에서 큐의 job을 처리
         }
@@ -31,6 +203,8 @@ public:
     ~SimpleThreadPool() { shutdown(); }
     // 스레드풀 객체 파괴 시 안전하게 종료
 
+    Mode mode() const noexcept { return _mode; }
+
     void shutdown() {
         bool expected = false;
         if (!_stop.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return;
@@ -38,20 +212,40 @@ public:
 
         _cv.notify_all(); // 대기 중인 워커들 깨움(종료 유도)
 
+        if (_ring) _ring->close();  // ring에서 대기 중인 워커들 깨움
+
+        {
+            std::lock_guard lk(_park_mtx);
+            ++_wake_epoch;
+        }
+        _park_cv.notify_all(); // park 중인 work-stealing 워커들 깨움
+
         for (auto& t : _workers) if (t.joinable()) t.join();
         // 모든 워커 스레드 join (종료까지 대기)
 
         _workers.clear(); // 워커 요소 모두 제거
     }
 
-    void schedule(std::coroutine_handle<> h, bool /*high_priority*/ = false) {
+    void schedule(std::coroutine_handle<> h, bool high_priority = false) {
         // 외부에서 "코루틴 재개(resume)" 작업을 스레드풀에 넣는 함수
 
         if (!h) return;
+
+        if (_mode == Mode::WorkStealing) {
+            ws_schedule(h.address(), high_priority);
+            return;
+        }
+
+        if (_mode == Mode::RingQueue) {
+            ring_schedule(h.address(), high_priority);
+            return;
+        }
+
         {
             std::lock_guard lk(_mtx); // 큐 보호 락
 
-            _q.push([h]() mutable { h.resume(); }); // 큐에 "resume job" 등록
+            if (high_priority) _hq.push(h.address());   // 우선순위 lane
+            else               _q.push(h.address());    // 큐에 "resume job" 등록(handle 주소만 => 할당 없음)
         }
         _cv.notify_one(); // 워커 하나 깨워서 job 처리
     }
@@ -62,50 +256,319 @@ private:
         // 워커 스레드 메인 루프: 큐에서 job을 pop해 실행
         while (!_stop.load(std::memory_order_acquire)) {
 
-            std::function<void()> job; // 실행할 작업(콜러블)
+            void* job = nullptr; // 실행할 작업(재개할 coroutine handle 주소)
             {
                 std::unique_lock lk(_mtx); // 큐 보호 락
 
                 _cv.wait(lk, [&] {
                     // 작업이 생기거나 stop될 때까지 대기
-                    return _stop.load(std::memory_order_acquire) || !_q.empty(); 
+                    return _stop.load(std::memory_order_acquire) || !_hq.empty() || !_q.empty();
                 });
 
-                if (_stop.load(std::memory_order_acquire) && _q.empty()) break;
+                if (_stop.load(std::memory_order_acquire) && _hq.empty() && _q.empty()) break;
                 // 종료 플래그가 켜지고 큐도 비었으면 루프 탈출(스레드 종료)
 
-                job = std::move(_q.front()); // job 가져오기
-                _q.pop();
+                auto& q = !_hq.empty() ? _hq : _q;  // 우선순위 lane부터 꺼냄
+                job = q.pop(); // job 가져오기
             }
 
-            job(); // job 실행 (반드시 락 밖에서 실행 !!!, 데드락 방지 !!!)
+            std::coroutine_handle<>::from_address(job).resume(); // job 실행 (반드시 락 밖에서 실행 !!!, 데드락 방지 !!!)
+        }
+    }
+
+    //==============================================================================================
+    // RingQueue 모드
+    //==============================================================================================
+    static constexpr size_t RingCapacity = 4096;
+
+    void ring_schedule(void* p, bool high_priority) {
+        if (!high_priority && _ring->try_push(p)) return;   // 대부분 여기서 끝(락/시스템 콜 없음)
+
+        // 우선순위 작업 또는 ring이 가득 참 => spill 큐(_hq/_q)에 넣음
+        {
+            std::lock_guard lk(_mtx);
+            if (high_priority) _hq.push(p);
+            else               _q.push(p);
+            _spill_size.fetch_add(1, std::memory_order_release);
+        }
+        _ring->try_push(nullptr);
+        // 잠든 워커를 깨우기 위한 빈 항목. ring이 가득 찼다면 워커들이 바쁜 중이고 매 작업마다 spill을 확인한다.
+    }
+
+    void* pop_spill() {
+        if (_spill_size.load(std::memory_order_acquire) == 0) return nullptr;
+
+        std::lock_guard lk(_mtx);
+        if (_hq.empty() && _q.empty()) return nullptr;
+        _spill_size.fetch_sub(1, std::memory_order_relaxed);
+        return !_hq.empty() ? _hq.pop() : _q.pop();     // 우선순위 lane부터
+    }
+
+    void ring_worker_loop() {
+        for (;;) {
+            void* job = pop_spill();                // 우선순위/넘친 작업을 먼저
+            if (!job && !_ring->pop(job)) break;    // close 후 ring이 비면 종료
+            if (!job) continue;                     // 깨우기용 빈 항목
+
+            std::coroutine_handle<>::from_address(job).resume();
+        }
+
+        while (void* job = pop_spill()) {
+            std::coroutine_handle<>::from_address(job).resume();    // 종료 직전 spill에 남은 작업 처리
         }
     }
 
+    //==============================================================================================
+    // WorkStealing 모드
+    //==============================================================================================
+    static constexpr uint32_t LifoBudget = 16;         // LIFO slot 연속 실행 상한(deque 작업 기아 방지)
+    static constexpr uint32_t GlobalCheckInterval = 61; // 이 주기마다 전역 inject 큐를 먼저 확인(공정성)
+    static constexpr int SpinRounds = 64;               // park 전에 일을 다시 찾아보는 횟수
+
+    struct alignas(CacheLineSize) WorkerLocal {
+        ChaseLevDeque deque;                    // 이 워커의 작업 deque
+        std::atomic<void*> lifo{ nullptr };     // 같은 워커에서 발생한 resume을 바로 이어서 실행할 slot
+        uint32_t rng = 1;                       // victim 선택용 xorshift 상태
+        uint32_t lifo_streak = 0;               // LIFO slot 연속 실행 횟수
+        uint32_t tick = 0;                      // 처리한 작업 수(전역 큐 확인 주기용)
+    };
+
+    struct WorkerTls {
+        const SimpleThreadPool* pool = nullptr; // 현재 스레드가 속한 풀
+        size_t index = 0;                       // 풀 안에서의 워커 번호
+    };
+    static thread_local WorkerTls _tls;     // 워커 스레드 식별(풀 밖 스레드는 pool == nullptr)
+
+    WorkerLocal* current_local() const noexcept {
+        return _tls.pool == this ? _locals[_tls.index].get() : nullptr;
+    }
+
+    void ws_schedule(void* p, bool high_priority) {
+        if (high_priority) {
+            {
+                std::lock_guard lk(_inject_mtx);
+                _prio.push(p);
+                _prio_size.fetch_add(1, std::memory_order_release);
+            }
+            wake_one();
+            return;
+        }
+
+        if (WorkerLocal* self = current_local()) {
+            // 같은 워커 안에서 발생한 resume => LIFO slot에 넣어 다음 차례에 바로 실행
+            void* prev = self->lifo.exchange(p, std::memory_order_acq_rel);
+            if (!prev) return;          // slot만 채운 경우: 이 워커가 곧 실행하므로 깨울 필요 없음
+
+            self->deque.push(prev);     // 밀려난 이전 slot 작업은 deque로(다른 워커가 훔쳐갈 수 있음)
+            wake_one();
+            return;
+        }
+
+        {
+            // 풀 밖(타이머 스레드, 메인 스레드 등)에서 들어온 작업 => 전역 inject 큐
+            std::lock_guard lk(_inject_mtx);
+            _inject.push(p);
+            _inject_size.fetch_add(1, std::memory_order_release);
+        }
+        wake_one();
+    }
+
+    void* pop_shared(HandleQueue& q, std::atomic<size_t>& size) {
+        if (size.load(std::memory_order_acquire) == 0) return nullptr;  // 락 없이 빠르게 비었는지 확인
+
+        std::lock_guard lk(_inject_mtx);
+        if (q.empty()) return nullptr;
+        void* p = q.pop();
+        size.fetch_sub(1, std::memory_order_release);
+        return p;
+    }
+
+    void* steal_from_others(WorkerLocal& self, size_t index) {
+        const size_t n = _locals.size();
+        if (n <= 1) return nullptr;
+
+        // xorshift32로 임의의 victim부터 한 바퀴 순회
+        self.rng ^= self.rng << 13;
+        self.rng ^= self.rng >> 17;
+        self.rng ^= self.rng << 5;
+        const size_t start = self.rng % n;
+
+        for (size_t k = 0; k < n; ++k) {
+            size_t v = (start + k) % n;
+            if (v == index) continue;
+
+            WorkerLocal& victim = *_locals[v];
+            if (void* p = victim.deque.steal()) return p;
+
+            if (victim.lifo.load(std::memory_order_relaxed)) {
+                // victim이 오래 걸리는 작업을 실행 중이면 LIFO slot에 갇힌 작업도 가져온다
+                if (void* p = victim.lifo.exchange(nullptr, std::memory_order_acq_rel)) return p;
+            }
+        }
+        return nullptr;
+    }
+
+    void* find_work(WorkerLocal& self, size_t index) {
+        // 1) 우선순위 lane
+        if (void* p = pop_shared(_prio, _prio_size)) return p;
+
+        // 2) 주기적으로 전역 inject 큐를 먼저 확인 (로컬 작업만 계속 돌면 외부 작업이 굶는 것 방지)
+        if (++self.tick % GlobalCheckInterval == 0) {
+            if (void* p = pop_shared(_inject, _inject_size)) return p;
+        }
+
+        // 3) LIFO slot (budget 초과 시 한 번 건너뛰어 deque 작업에도 차례를 준다)
+        if (self.lifo_streak < LifoBudget) {
+            if (self.lifo.load(std::memory_order_relaxed)) {
+                if (void* p = self.lifo.exchange(nullptr, std::memory_order_acq_rel)) {
+                    ++self.lifo_streak;
+                    return p;
+                }
+            }
+        }
+        self.lifo_streak = 0;
+
+        // 4) 내 deque
+        if (void* p = self.deque.take()) return p;
+
+        // 5) budget 때문에 건너뛴 LIFO slot
+        if (void* p = self.lifo.exchange(nullptr, std::memory_order_acq_rel)) return p;
+
+        // 6) 전역 inject 큐
+        if (void* p = pop_shared(_inject, _inject_size)) return p;
+
+        // 7) 다른 워커에게서 훔쳐 옴
+        return steal_from_others(self, index);
+    }
+
+    bool has_any_work() const noexcept {
+        if (_prio_size.load(std::memory_order_acquire) || _inject_size.load(std::memory_order_acquire)) return true;
+        for (auto& w : _locals) {
+            if (!w->deque.empty() || w->lifo.load(std::memory_order_acquire)) return true;
+        }
+        return false;
+    }
+
+    void wake_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // 작업 공개 <-> _sleepers 확인 순서 보장 (park()의 fence와 짝: lost wake-up 방지)
+
+        if (_sleepers.load(std::memory_order_relaxed) == 0) return;    // 자는 워커가 없으면 락/notify 생략
+        {
+            std::lock_guard lk(_park_mtx);
+            ++_wake_epoch;
+        }
+        _park_cv.notify_one();
+    }
+
+    void park() {
+        std::unique_lock lk(_park_mtx);
+        _sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (_stop.load(std::memory_order_acquire) || has_any_work()) {
+            // sleeper로 등록한 뒤 다시 확인 => 그 사이 들어온 작업을 놓치지 않음
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const uint64_t epoch = _wake_epoch;
+        _park_cv.wait(lk, [&] { return _stop.load(std::memory_order_acquire) || _wake_epoch != epoch; });
+        _sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void ws_worker_loop(size_t index) {
+        _tls = WorkerTls{ this, index };
+        WorkerLocal& self = *_locals[index];
+
+        int idle = 0;
+        for (;;) {
+            if (void* p = find_work(self, index)) {
+                idle = 0;
+                std::coroutine_handle<>::from_address(p).resume(); // job 실행 (락 밖)
+                continue;
+            }
+
+            if (_stop.load(std::memory_order_acquire) && !has_any_work()) break;
+            // 종료 플래그가 켜지고 남은 작업도 없으면 루프 탈출
+
+            if (++idle < SpinRounds) {
+                std::this_thread::yield();  // 곧 작업이 들어올 가능성이 높으므로 잠깐 양보 후 재시도
+                continue;
+            }
+
+            idle = 0;
+            park();                         // 작업이 들어오거나 stop될 때까지 대기
+        }
+
+        _tls = WorkerTls{};
+    }
+
     std::atomic<bool> _stop;                // 종료 여부(워커 루프 종료 조건)
+    const Mode _mode;                       // 스케줄링 방식(생성 시 고정)
     std::mutex _mtx;                        // 큐 보호용 뮤텍스
     std::condition_variable _cv;            // 큐 변화/종료 알림
-    std::queue<std::function<void()>> _q;   // 작업 큐(람다/함수)
+    HandleQueue _hq;                        // 우선순위 작업 큐(SharedQueue 모드, RingQueue 모드의 spill)
+    HandleQueue _q;                         // 작업 큐(coroutine handle 주소)
     std::vector<std::thread> _workers;      // 워커 스레드 객체들
+
+    std::unique_ptr<LockFree::BlockingMpmcQueue<void*>> _ring;     // 작업 ring(RingQueue 모드)
+    alignas(CacheLineSize) std::atomic<size_t> _spill_size{ 0 };   // _hq/_q에 들어간 작업 수(RingQueue 모드)
+
+    std::vector<std::unique_ptr<WorkerLocal>> _locals;  // 워커별 deque/LIFO slot(WorkStealing 모드)
+    std::mutex _inject_mtx;                             // _prio/_inject 보호
+    HandleQueue _prio;                                  // 우선순위 lane(WorkStealing 모드)
+    HandleQueue _inject;                                // 풀 밖에서 들어온 작업(WorkStealing 모드)
+    alignas(CacheLineSize) std::atomic<size_t> _prio_size{ 0 };    // 락 없이 비었는지 확인용
+    alignas(CacheLineSize) std::atomic<size_t> _inject_size{ 0 };
+
+    std::mutex _park_mtx;                   // park/wake 보호
+    std::condition_variable _park_cv;       // 잠든 워커 깨움
+    uint64_t _wake_epoch = 0;               // wake 요청 카운터(_park_mtx 보호)
+    alignas(CacheLineSize) std::atomic<int> _sleepers{ 0 };        // park 중인 워커 수
 };
 
+thread_local SimpleThreadPool::WorkerTls SimpleThreadPool::_tls{};
+
+static const char* mode_name(SimpleThreadPool::Mode mode) {
+    // 벤치마크 출력용(폭 맞춤)
+    switch (mode) {
+    case SimpleThreadPool::Mode::SharedQueue:  return "SharedQueue ";
+    case SimpleThreadPool::Mode::WorkStealing: return "WorkStealing";
+    case SimpleThreadPool::Mode::RingQueue:    return "RingQueue   ";
+    }
+    return "?";
+}
+
 static SimpleThreadPool& globalPool() {
     static SimpleThreadPool p(4);   // 전역 기본 풀(4워커)
     return p;                       // 싱글턴처럼 사용
 }
 
 //--------------------------------------------------------------------------------------------------
-// TimerService (dedicated timer thread => no worker occupancy)
+// TimerHandle: 등록한 타이머를 취소(cancel)하기 위한 핸들
 //--------------------------------------------------------------------------------------------------
-class TimerService {
+struct TimerHandle {
+    void* node = nullptr;   // 타이머 노드(HeapTimerService는 사용 안 함)
+    uint64_t id = 0;        // 등록 번호(0 = 빈 핸들). 노드가 재사용되어도 이전 핸들과 구분된다.
+
+    explicit operator bool() const noexcept { return id != 0; }
+};
+
+//--------------------------------------------------------------------------------------------------
+// HeapTimerService (priority_queue 기반, 비교용)
+//   - insert O(log n), cancel은 lazy(실행 시점에 건너뜀) => 취소된 타이머도 만료 시각까지 heap에 남는다.
+//   - 대기 중인 번호만 _pending에 둔다 => 이미 실행된 타이머의 cancel은 false, 기록도 heap 크기를 넘지 않는다.
+//--------------------------------------------------------------------------------------------------
+class HeapTimerService {
 public:
     // steady_clock::now() 값은 시스템 시간 변경과 무관하게 계속 앞으로만 증가
     using Clock = std::chrono::steady_clock;    // monotonic 증가 시계 (타임아웃 체크 목적)
     using TimePoint = Clock::time_point;        // 시간 포인트 타입
 
-    TimerService() : _stop(false), _th([this] { run(); }) {}
+    HeapTimerService() : _stop(false), _th([this] { run(); }) {}
 
-    ~TimerService() {
+    ~HeapTimerService() {
         {
             std::lock_guard lk(_mtx);
             _stop = true; // 타이머 스레드 종료 설정
@@ -115,9 +578,16 @@ public:
     }
 
     template<class Rep, class Period>
-    void schedule_after(std::chrono::duration<Rep, Period> d, std::function<void()> cb) {
+    TimerHandle schedule_after(std::chrono::duration<Rep, Period> d, std::function<void()> cb) {
         // "지금으로부터 d 후 실행" 등록 API
-        schedule_at(Clock::now() + std::chrono::duration_cast<Clock::duration>(d), std::move(cb));
+        return schedule_at(Clock::now() + std::chrono::duration_cast<Clock::duration>(d), std::move(cb));
+    }
+
+    bool cancel(TimerHandle h) {
+        // heap 중간 요소는 O(1)로 뺄 수 없으므로 대기 목록에서만 빼 두고 pop 시점에 건너뜀
+        if (!h) return false;
+        std::lock_guard lk(_mtx);
+        return _pending.erase(h.id) != 0;  // 이미 실행됐거나 취소된 번호면 false
     }
 
 private:
@@ -134,13 +604,17 @@ private:
         }
     };
 
-    void schedule_at(TimePoint tp, std::function<void()> cb) {
+    TimerHandle schedule_at(TimePoint tp, std::function<void()> cb) {
         // 특정 시각에 실행되는 이벤트 등록
+        TimerHandle h;
         {
             std::lock_guard lk(_mtx);
+            h.id = _seq;
+            _pending.insert(_seq);
             _pq.push(Item{ tp, std::move(cb), _seq++ });    // pq에 아이템 push
         }
         _cv.notify_one();   // 타이머 스레드 깨움
+        return h;
     }
 
     void run() {
@@ -167,6 +641,8 @@ private:
             auto item = std::move(_pq.top());
             _pq.pop();
 
+            if (!_pending.erase(item.seq)) continue;  // 취소된 타이머
+
             lk.unlock();    // 콜백은 락 밖에서 실행(중요!)
             item.cb();      // 등록된 콜백 수행
             lk.lock();      // 다시 락 획득하여 루프 계속
@@ -176,9 +652,296 @@ private:
     std::mutex _mtx;                // pq 보호
     std::condition_variable _cv;    // 이벤트 등록/stop 알림
     std::priority_queue<Item, std::vector<Item>, Cmp> _pq;  // 이벤트 우선순위 큐(가장 빠른 것 top)
+    std::unordered_set<uint64_t> _pending;                  // 아직 실행/취소되지 않은 번호(lazy cancel)
     bool _stop;                     // 타이머 스레드 종료 플래그
     std::thread _th;                // 타이머 스레드
-    uint64_t _seq = 0;              // tie-break용 시퀀스
+    uint64_t _seq = 1;              // tie-break용 시퀀스(= TimerHandle::id, 0은 빈 핸들)
+};
+
+//--------------------------------------------------------------------------------------------------
+// TimerService (hierarchical timing wheel, dedicated timer thread => no worker occupancy)
+//   - 1 tick = 1ms, 4단계 wheel (256 + 64 + 64 + 64 slot => 약 18.6시간 범위)
+//   - insert/cancel O(1): 만료 tick으로 slot을 계산해 intrusive list에 연결/해제
+//   - 만료 처리: tick 단위로 slot 하나를 통째로 떼어 내 배치로 실행
+//     상위 wheel은 하위 wheel이 한 바퀴 돌 때마다 slot 하나를 하위로 내려보낸다(cascade)
+//   - WaitAsync 타임아웃처럼 "거의 발생하지 않고 대부분 취소되는" 타이머에 적합
+//--------------------------------------------------------------------------------------------------
+class TimerService {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Tick = std::chrono::milliseconds;     // wheel 해상도
+
+    TimerService() : _origin(Clock::now()), _th([this] { run(); }) {}
+
+    ~TimerService() {
+        {
+            std::lock_guard lk(_mtx);
+            _stop = true; // 타이머 스레드 종료 설정
+        }
+        _cv.notify_one(); // 타이머 스레드 깨움
+        if (_th.joinable()) _th.join(); // 타이머 스레드 종료 대기
+    }
+
+    template<class Rep, class Period>
+    TimerHandle schedule_after(std::chrono::duration<Rep, Period> d, std::function<void()> cb) {
+        // "지금으로부터 d 후 실행" 등록 API
+        return schedule_at(Clock::now() + std::chrono::duration_cast<Clock::duration>(d), std::move(cb));
+    }
+
+    TimerHandle schedule_at(TimePoint tp, std::function<void()> cb) {
+        const uint64_t expire = to_tick_ceil(tp);   // 만료 tick(올림 => 절대 일찍 실행되지 않음)
+
+        TimerHandle h;
+        bool wake = false;
+        {
+            std::lock_guard lk(_mtx);
+
+            Node* n = alloc_node();
+            n->expire = expire;
+            n->id = _seq++;
+            n->cb = std::move(cb);
+            add_to_wheel(n);
+            ++_count;
+
+            h = TimerHandle{ n, n->id };
+            wake = expire < _wake_tick; // 타이머 스레드가 잡아 둔 기상 시각보다 빠르면 깨움
+        }
+        if (wake) _cv.notify_one();
+        return h;
+    }
+
+    bool cancel(TimerHandle h) {
+        // O(1): 노드를 slot 리스트에서 떼어 내고 free list로 반환
+        if (!h) return false;
+
+        std::function<void()> cb;   // 캡처 파괴는 락 밖에서
+        {
+            std::lock_guard lk(_mtx);
+
+            Node* n = static_cast<Node*>(h.node);
+            if (n->id != h.id || !n->pprev) return false;  // 이미 실행/취소됨(노드가 재사용된 경우 포함)
+
+            unlink(n);
+            --_count;
+            cb = std::move(n->cb);
+            free_node(n);
+        }
+        return true;
+    }
+
+private:
+    static constexpr int Levels = 4;
+    static constexpr int Level0Bits = 8;                            // level 0: 256 slot (256ms)
+    static constexpr int LevelNBits = 6;                            // level 1~3: 64 slot
+    static constexpr uint64_t Level0Size = 1ull << Level0Bits;
+    static constexpr uint64_t LevelNSize = 1ull << LevelNBits;
+    static constexpr uint64_t Level0Mask = Level0Size - 1;
+    static constexpr uint64_t LevelNMask = LevelNSize - 1;
+    static constexpr uint64_t MaxSpan = 1ull << (Level0Bits + (Levels - 1) * LevelNBits);   // wheel 전체 범위(tick)
+    static constexpr uint64_t NoWake = ~0ull;
+    static constexpr size_t NodeChunk = 1024;                       // 노드 풀 확장 단위
+
+    struct Node {
+        Node* next = nullptr;           // 같은 slot의 다음 노드
+        Node** pprev = nullptr;         // 나를 가리키는 포인터의 주소(O(1) unlink, nullptr = 미연결)
+        uint64_t expire = 0;            // 만료 tick
+        uint64_t id = 0;                // TimerHandle::id (0 = free)
+        int level = 0;                  // 연결된 wheel 단계
+        std::function<void()> cb;       // 실행할 콜백
+    };
+
+    static constexpr int shift_of(int level) { return level == 0 ? 0 : Level0Bits + (level - 1) * LevelNBits; }
+
+    Node*& slot(int level, uint64_t index) {
+        return level == 0 ? _wheel0[index] : _wheelN[level - 1][index];
+    }
+
+    uint64_t to_tick_ceil(TimePoint tp) const {
+        if (tp <= _origin) return 0;
+        auto d = tp - _origin;
+        auto t = std::chrono::duration_cast<Tick>(d);
+        if (t < d) ++t;
+        return (uint64_t)t.count();
+    }
+
+    uint64_t to_tick_floor(TimePoint tp) const {
+        if (tp <= _origin) return 0;
+        return (uint64_t)std::chrono::duration_cast<Tick>(tp - _origin).count();
+    }
+
+    TimePoint to_time(uint64_t tick) const { return _origin + Tick(tick); }
+
+    Node* alloc_node() {
+        if (!_free) {
+            // 노드를 청크 단위로 할당해 free list에 연결(노드 메모리는 서비스 수명 동안 유지)
+            _chunks.emplace_back(std::make_unique<Node[]>(NodeChunk));
+            Node* chunk = _chunks.back().get();
+            for (size_t i = 0; i < NodeChunk; ++i) {
+                chunk[i].next = _free;
+                _free = &chunk[i];
+            }
+        }
+        Node* n = _free;
+        _free = n->next;
+        n->next = nullptr;
+        return n;
+    }
+
+    void free_node(Node* n) {
+        n->id = 0;
+        n->pprev = nullptr;
+        n->next = _free;
+        _free = n;
+    }
+
+    void add_to_wheel(Node* n) {
+        // 현재 tick으로부터의 거리로 wheel 단계를 고르고, 만료 tick의 해당 비트로 slot을 고른다
+        uint64_t expire = std::max(n->expire, _current);
+        uint64_t delta = expire - _current;
+
+        int level = 0;
+        if (delta >= MaxSpan) {
+            expire = _current + MaxSpan - 1;    // 범위를 넘으면 최상위 wheel 끝에 두었다가 cascade 때 재배치
+            delta = MaxSpan - 1;
+        }
+        while (level < Levels - 1 && delta >= (1ull << shift_of(level + 1))) ++level;
+
+        const uint64_t mask = level == 0 ? Level0Mask : LevelNMask;
+        Node*& head = slot(level, (expire >> shift_of(level)) & mask);
+
+        n->level = level;
+        n->next = head;
+        if (head) head->pprev = &n->next;
+        n->pprev = &head;
+        head = n;
+        ++_level_count[level];
+    }
+
+    void unlink(Node* n) {
+        *n->pprev = n->next;
+        if (n->next) n->next->pprev = n->pprev;
+        n->next = nullptr;
+        n->pprev = nullptr;
+        --_level_count[n->level];
+    }
+
+    void cascade(int level, uint64_t index) {
+        // 상위 wheel slot 하나를 통째로 떼어 현재 tick 기준으로 하위 wheel에 재배치
+        Node* n = slot(level, index);
+        slot(level, index) = nullptr;
+        while (n) {
+            Node* next = n->next;
+            n->pprev = nullptr;
+            n->next = nullptr;
+            --_level_count[level];
+            add_to_wheel(n);
+            n = next;
+        }
+    }
+
+    void process_tick(std::vector<std::function<void()>>& batch) {
+        const uint64_t index = _current & Level0Mask;
+        if (index == 0) {
+            // level 0이 한 바퀴 돌았다 => 상위 wheel에서 다음 구간을 내려받음
+            for (int level = 1; level < Levels; ++level) {
+                const uint64_t i = (_current >> shift_of(level)) & LevelNMask;
+                cascade(level, i);
+                if (i != 0) break;  // 이 단계가 아직 한 바퀴를 다 돌지 않았으면 위로는 올라가지 않음
+            }
+        }
+
+        // 이번 tick slot의 타이머를 모두 떼어 배치에 담는다
+        Node* n = _wheel0[index];
+        _wheel0[index] = nullptr;
+        while (n) {
+            Node* next = n->next;
+            --_level_count[0];
+            --_count;
+            batch.push_back(std::move(n->cb));
+            free_node(n);
+            n = next;
+        }
+
+        ++_current;
+    }
+
+    void advance(uint64_t target, std::vector<std::function<void()>>& batch) {
+        // _current ~ target tick 까지 처리
+        while (_current <= target) {
+            if (_count == 0) {
+                _current = target + 1;  // 빈 wheel은 바로 점프
+                return;
+            }
+
+            if (_level_count[0] == 0 && (_current & Level0Mask) != 0) {
+                // level 0이 비었으면 다음 cascade 경계까지 한 번에 건너뜀
+                const uint64_t boundary = (_current | Level0Mask) + 1;
+                if (boundary > target) {
+                    _current = target + 1;
+                    return;
+                }
+                _current = boundary;
+                continue;
+            }
+
+            process_tick(batch);
+        }
+    }
+
+    uint64_t next_wake_tick() {
+        // level 0에서 가장 가까운 비어있지 않은 slot, 없으면 다음 cascade 경계
+        if (_level_count[0] != 0) {
+            for (uint64_t t = _current; t < _current + Level0Size; ++t) {
+                if (_wheel0[t & Level0Mask]) return t;
+                if (t != _current && (t & Level0Mask) == 0) return t;  // cascade 경계
+            }
+        }
+        return (_current & Level0Mask) == 0 ? _current : (_current | Level0Mask) + 1;
+    }
+
+    void run() {
+        std::vector<std::function<void()>> batch;   // tick 처리 중 만료된 콜백(재사용 버퍼)
+
+        std::unique_lock lk(_mtx);
+        while (!_stop) {
+            advance(to_tick_floor(Clock::now()), batch);
+
+            if (!batch.empty()) {
+                _wake_tick = 0;     // 처리 중에는 등록 쪽에서 깨울 필요 없음
+                lk.unlock();        // 콜백은 락 밖에서 실행(중요!)
+                for (auto& cb : batch) cb();
+                batch.clear();
+                lk.lock();
+                continue;
+            }
+
+            if (_count == 0) {
+                _wake_tick = NoWake;
+                _cv.wait(lk);                               // 새 타이머 또는 stop까지 대기
+            }
+            else {
+                _wake_tick = next_wake_tick();
+                _cv.wait_until(lk, to_time(_wake_tick));    // 다음 만료 tick까지 대기
+            }
+            _wake_tick = 0;
+        }
+    }
+
+    const TimePoint _origin;                                    // tick 0 시각
+    std::mutex _mtx;                                            // wheel 보호
+    std::condition_variable _cv;                                // 이른 타이머 등록/stop 알림
+    std::array<Node*, Level0Size> _wheel0{};                    // level 0 slot
+    std::array<std::array<Node*, LevelNSize>, Levels - 1> _wheelN{};  // level 1~3 slot
+    std::array<size_t, Levels> _level_count{};                  // 단계별 노드 수
+    uint64_t _current = 0;                                      // 다음에 처리할 tick
+    uint64_t _wake_tick = 0;                                    // 타이머 스레드가 깨어날 tick(NoWake = 무한 대기)
+    size_t _count = 0;                                          // 등록된 타이머 수
+    uint64_t _seq = 1;                                          // TimerHandle::id 발급용
+    Node* _free = nullptr;                                      // 노드 free list
+    std::vector<std::unique_ptr<Node[]>> _chunks;               // 노드 청크 소유
+    bool _stop = false;                                         // 타이머 스레드 종료 플래그
+    std::thread _th;                                            // 타이머 스레드(마지막에 초기화)
 };
 
 static TimerService& globalTimer() {
@@ -186,6 +949,133 @@ static TimerService& globalTimer() {
     return t;
 }
 
+//--------------------------------------------------------------------------------------------------
+// FramePool: 코루틴 프레임/대기 슬롯용 size-class 메모리 풀
+//   - 64, 128, ... , 4096 bytes 7단계 (그보다 큰 프레임은 일반 operator new)
+//   - 스레드별 free list(락 없음) + size class별 depot(배치 단위로만 락)
+//     코루틴은 A 스레드에서 생성되고 B 워커에서 파괴되는 경우가 많으므로,
+//     해제한 스레드의 캐시로 돌려두고 넘치면 배치째 depot에 넘겨 다른 스레드가 가져가게 한다.
+//   - 블록은 64KB chunk에서 잘라 쓰며 OS로 반환하지 않는다(최대 사용량만큼 유지)
+//--------------------------------------------------------------------------------------------------
+class FramePool {
+public:
+    static void* allocate(size_t size) {
+        const int c = size_class(size);
+        if (c < 0) return ::operator new(size);     // 너무 큰 프레임은 일반 힙
+        return cache().pop(c);
+    }
+
+    static void deallocate(void* p, size_t size) noexcept {
+        const int c = size_class(size);
+        if (c < 0) { ::operator delete(p); return; }
+        cache().push(c, p);
+    }
+
+private:
+    static constexpr int ClassCount = 7;                // 64 << 0 ... 64 << 6 (= 4096)
+    static constexpr size_t MinBlock = 64;
+    static constexpr size_t ChunkSize = 64 * 1024;
+    static constexpr size_t BatchSize = 32;             // 캐시 <-> depot 이동 단위(블록 수)
+
+    struct Block {
+        Block* next;            // 같은 배치(또는 캐시) 안의 다음 블록
+        Block* next_batch;      // depot에서 다음 배치(배치의 첫 블록만 사용)
+        size_t count;           // 배치 블록 수(배치의 첫 블록만 사용)
+    };
+
+    static int size_class(size_t size) noexcept {
+        size_t block = MinBlock;
+        for (int c = 0; c < ClassCount; ++c, block <<= 1) {
+            if (size <= block) return c;
+        }
+        return -1;
+    }
+
+    struct Depot {
+        std::mutex mtx;
+        Block* batches = nullptr;   // 반환된 배치들의 스택
+    };
+
+    static Depot& depot(int c) {
+        static Depot* d = new Depot[ClassCount];
+        // 일부러 파괴하지 않는다: 정적 객체(전역 풀 등) 파괴 중 종료되는 워커도 캐시를 반환할 수 있어야 함
+        return d[c];
+    }
+
+    class ThreadCache {
+    public:
+        ~ThreadCache() {
+            // 스레드 종료: 남은 블록을 모두 depot으로 반환
+            for (int c = 0; c < ClassCount; ++c) {
+                while (_count[c] > 0) flush(c, std::min(_count[c], BatchSize));
+            }
+        }
+
+        void* pop(int c) {
+            if (!_free[c]) refill(c);
+            Block* b = _free[c];
+            _free[c] = b->next;
+            --_count[c];
+            return b;
+        }
+
+        void push(int c, void* p) noexcept {
+            Block* b = static_cast<Block*>(p);
+            b->next = _free[c];
+            _free[c] = b;
+            if (++_count[c] >= 2 * BatchSize) flush(c, BatchSize);   // 넘치면 한 배치를 depot으로
+        }
+
+    private:
+        void refill(int c) {
+            Depot& d = depot(c);
+            {
+                std::lock_guard lk(d.mtx);
+                if (Block* batch = d.batches) {
+                    d.batches = batch->next_batch;
+                    _free[c] = batch;
+                    _count[c] = batch->count;
+                    return;
+                }
+            }
+
+            // depot도 비었으면 새 chunk를 잘라 캐시에 채움
+            const size_t block = MinBlock << c;
+            char* chunk = static_cast<char*>(::operator new(ChunkSize));
+            for (size_t off = 0; off + block <= ChunkSize; off += block) {
+                Block* b = reinterpret_cast<Block*>(chunk + off);
+                b->next = _free[c];
+                _free[c] = b;
+                ++_count[c];
+            }
+        }
+
+        void flush(int c, size_t n) noexcept {
+            Block* head = _free[c];
+            Block* tail = head;
+            for (size_t i = 1; i < n; ++i) tail = tail->next;
+            _free[c] = tail->next;
+            _count[c] -= n;
+
+            tail->next = nullptr;
+            head->count = n;
+
+            Depot& d = depot(c);
+            std::lock_guard lk(d.mtx);
+            head->next_batch = d.batches;
+            d.batches = head;
+        }
+
+        Block* _free[ClassCount] = {};
+        size_t _count[ClassCount] = {};
+    };
+
+    static ThreadCache& cache() {
+        static thread_local ThreadCache tc;
+        return tc;
+    }
+};
+
 //--------------------------------------------------------------------------------------------------
 // Exceptions
 //--------------------------------------------------------------------------------------------------
@@ -223,43 +1113,56 @@ struct ContinuationSlot {
     std::atomic<int> win{ -1 };
     // 먼저 처리될 것인지 기록(-1=미결정). await_resume에서 이 값을 보고 예외/정상 결정
 
-    void set(std::coroutine_handle<> h) noexcept {
-        awaiting_addr.store(h.address(), std::memory_order_release);
-        // 대기 코루틴 주소 저장(나중에 resume해야 함)
-    }
+    ContinuationSlot* prev = nullptr;   // SharedState의 waiter 리스트 연결(wait_mtx 보호)
+    ContinuationSlot* next = nullptr;
+    bool linked = false;                // waiter 리스트에 연결되어 있는지
+
+    void (*arrive)(ContinuationSlot*) = nullptr;
+    // WhenAll/WhenAny용: 설정되어 있으면 완료 시 대기 코루틴을 깨우는 대신 호출(그룹 카운트다운)
 
-    std::coroutine_handle<> take() noexcept {
-        void* p = awaiting_addr.exchange(nullptr, std::memory_order_acq_rel);
-        // exchange로 "한 번만" 주소를 가져감 (나머지 경쟁자는 nullptr 받음)
+    std::atomic<uint32_t> refs{ 1 };
+    // new로 만든 슬롯(WaitAsync)의 참조 수: 타이머 콜백이 awaiter보다 늦게 끝날 수 있으므로 참조로 수명 관리
+    // (co_await의 슬롯은 awaiter 안에 직접 두므로 사용하지 않음)
 
-        return p ? std::coroutine_handle<>::from_address(p) : std::coroutine_handle<>{};
+    static inline void* const FiredMark = reinterpret_cast<void*>(uintptr_t(1));
+    // 승자가 이미 정해졌음을 표시(awaiting 공개 전에 이벤트가 먼저 발생한 경우)
+
+    static void* operator new(size_t size) { return FramePool::allocate(size); }
+    static void operator delete(void* p, size_t size) noexcept { FramePool::deallocate(p, size); }
+
+    void add_ref() noexcept { refs.fetch_add(1, std::memory_order_relaxed); }
+    void release() noexcept {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+
+    bool publish(std::coroutine_handle<> h) noexcept {
+        // 완료/timeout/cancel 등록을 모두 마친 뒤 마지막에 대기 코루틴 주소를 공개
+        // => 등록 도중에는 누구도 resume할 수 없으므로 awaiter 멤버(타이머 핸들 등)를 안전하게 기록 가능
+        // false: 등록 도중 이미 승자가 정해짐 => suspend하지 말고 그대로 진행
+        void* expected = nullptr;
+        return awaiting_addr.compare_exchange_strong(expected, h.address(), std::memory_order_acq_rel, std::memory_order_acquire);
     }
 
     bool try_fire(WaitWin w, std::coroutine_handle<>& out) noexcept {
-        auto h = take();                                // 내가 continuation을 가져갈 수 있나?
-        if (!h) return false;                           // 이미 다른 이벤트가 가져감(패배)
-        win.store((int)w, std::memory_order_release);   // 승자 기록
-        out = h;                                        // resume할 handle 반환
+        int expected = -1;
+        if (!win.compare_exchange_strong(expected, (int)w, std::memory_order_acq_rel)) return false;
+        // 승자 기록은 한 번만 (나머지 경쟁자는 패배)
+
+        void* p = awaiting_addr.exchange(FiredMark, std::memory_order_acq_rel);
+        if (!p) return false;   // 아직 공개 전: publish()가 실패하면서 등록한 쪽이 그대로 진행
+
+        out = std::coroutine_handle<>::from_address(p);  // resume할 handle 반환
         return true;                                    // 성공(처리 가능)
     }
 };
 
-//--------------------------------------------------------------------------------------------------
-// Result storage helper (so SharedState<T> is unified for void/non-void)
-//--------------------------------------------------------------------------------------------------
-template<typename T>
-struct state_result {
-    std::optional<T> result;        // non-void의 경우 결과 저장 공간
-};
-
-template<>
-struct state_result<void> {};       // void는 결과 저장 필드 없음
-
 //==================================================================================================
-// SharedState<T>: unified
+// SharedState: 완료/예외/대기자 상태
+//   - promise_type이 상속 => 코루틴 프레임 안에 함께 존재(별도 make_shared 할당 없음)
+//   - intrusive refcount: 코루틴 자신(final_suspend까지) + Task 복사본들
+//     마지막 참조가 사라질 때 코루틴 프레임을 파괴(결과도 프레임 안의 promise에 있음)
 //==================================================================================================
-template<typename T>
-struct SharedState : state_result<T> {
+struct SharedState {
     SimpleThreadPool* pool = nullptr;           // 이 Task가 사용할 풀(없으면 globalPool)
 
     std::exception_ptr ex;                      // 코루틴에서 던진 예외 저장
@@ -268,39 +1171,36 @@ struct SharedState : state_result<T> {
     std::mutex done_mtx;                        // condition_variable 보호용 mutex
     std::condition_variable done_cv;            // Wait()에서 block/unblock 용
 
-    std::mutex wait_mtx;                                    // waiters 벡터 보호
-    std::vector<std::shared_ptr<ContinuationSlot>> waiters; // co_await/WaitAsync 대기자들
+    std::mutex wait_mtx;                                    // waiters 리스트 보호
+    ContinuationSlot* waiters = nullptr;                    // co_await/WaitAsync 대기자들(intrusive list)
     std::atomic<bool> completed_flag{ false };              // "이미 완료됨" 빠른 경로 플래그(늦게 등록된 waiter 처리)
 
+    std::atomic<uint32_t> refs{ 1 };            // 참조 수(코루틴 자신이 1개 보유)
+
+    void add_ref() noexcept { refs.fetch_add(1, std::memory_order_relaxed); }
+    bool release() noexcept { return refs.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+    // true: 마지막 참조 => 호출자가 코루틴 프레임을 파괴
+
     void notify_all_waiters_completed() {
         completed_flag.store(true, std::memory_order_release);
 
-        std::vector<std::shared_ptr<ContinuationSlot>> local;
-        {
-            std::lock_guard lk(wait_mtx);
-            local.swap(waiters);    // waiters를 로컬로 빼서 락 짧게
-        }
-
         SimpleThreadPool* p = pool ? pool : &globalPool();  // 사용할 풀 선택
 
+        // 슬롯은 대기자(awaiter)의 것이므로 락 안에서 끊어낸 뒤 깨운다(깨어난 대기자가 슬롯을 파괴할 수 있음)
         // ALWAYS schedule (no inline resume)
-        for (auto& s : local) {
-            std::coroutine_handle<> ch;
-            if (s && s->try_fire(WaitWin::Completed, ch)) {
-                p->schedule(ch, false);     // inline resume 금지: 항상 스케줄링
-            }
+        std::lock_guard lk(wait_mtx);
+        while (ContinuationSlot* s = waiters) {
+            unlink(s);
+            fire_completed(s, p);
         }
     }
 
-    void add_waiter(const std::shared_ptr<ContinuationSlot>& s) {
+    void add_waiter(ContinuationSlot* s) {
         SimpleThreadPool* p = pool ? pool : &globalPool();  // 사용할 풀 선택
 
         if (completed_flag.load(std::memory_order_acquire)) {
             // 이미 완료된 상태면 waiter 등록 없이 즉시 깨움
-            std::coroutine_handle<> ch;
-            if (s && s->try_fire(WaitWin::Completed, ch)) {
-                p->schedule(ch, false);
-            }
+            fire_completed(s, p);
             return;
         }
 
@@ -308,14 +1208,42 @@ struct SharedState : state_result<T> {
 
         if (completed_flag.load(std::memory_order_acquire)) {
             // 락 획득 후 재확인(완료와 경합 방지)
-            std::coroutine_handle<> ch;
-            if (s && s->try_fire(WaitWin::Completed, ch)) {
-                p->schedule(ch, false);
-            }
+            fire_completed(s, p);
+            return;
+        }
+
+        s->prev = nullptr;      // 아직 미완료면 대기자 목록에 추가
+        s->next = waiters;
+        if (waiters) waiters->prev = s;
+        waiters = s;
+        s->linked = true;
+    }
+
+    void remove_waiter(ContinuationSlot* s) {
+        // timeout/cancel이 먼저 처리된 WaitAsync: 대상이 완료되기 전에 슬롯을 리스트에서 제거
+        std::lock_guard lk(wait_mtx);
+        if (s->linked) unlink(s);
+    }
+
+private:
+    static void fire_completed(ContinuationSlot* s, SimpleThreadPool* p) {
+        if (s->arrive) {
+            s->arrive(s);               // WhenAll/WhenAny: 그룹에 도착만 알림(마지막/첫 도착만 대기 코루틴을 깨움)
             return;
         }
 
-        waiters.push_back(s);   // 아직 미완료면 대기자 목록에 추가
+        std::coroutine_handle<> ch;
+        if (s->try_fire(WaitWin::Completed, ch)) {
+            p->schedule(ch, false);     // inline resume 금지: 항상 스케줄링
+        }
+    }
+
+    void unlink(ContinuationSlot* s) noexcept {
+        if (s->prev) s->prev->next = s->next;
+        else         waiters = s->next;
+        if (s->next) s->next->prev = s->prev;
+        s->prev = s->next = nullptr;
+        s->linked = false;
     }
 };
 
@@ -326,78 +1254,91 @@ template<typename T>
 class Task {
 public:
     struct promise_type;                                        // 코루틴 promise 선언
-    using state_type = SharedState<T>;                          // 공유 상태 타입
-    using handle_type = std::coroutine_handle<promise_type>;    // 코루틴 핸들 타입(실제로는 promise 내부에서만 사용)
+    using handle_type = std::coroutine_handle<promise_type>;    // 코루틴 핸들 타입(promise = 공유 상태)
 
     static constexpr auto InfiniteTimeout = std::chrono::steady_clock::duration::max();
     // WaitAsync에서 무한 타임아웃을 표현하는 값(Timeout.Infinite 유사)
 
     Task() = default;       // 빈 Task
-    explicit Task(std::shared_ptr<state_type> st) : _st(std::move(st)) {}
-    // shared-state를 받아 Task 생성 (copyable의 핵심)
+    explicit Task(handle_type h) noexcept : _h(h) {}
+    // 참조 1개를 넘겨받아 Task 생성 (get_return_object에서 add_ref 후 호출)
 
     // COPYABLE
-    Task(const Task&) = default;            // shared_ptr 복사 => multi-consumer 가능
-    Task& operator=(const Task&) = default;
+    Task(const Task& other) noexcept : _h(other._h) {   // 참조 +1 => multi-consumer 가능
+        if (_h) _h.promise().add_ref();
+    }
+    Task& operator=(const Task& other) noexcept {
+        Task tmp(other);
+        std::swap(_h, tmp._h);
+        return *this;
+    }
+
+    Task(Task&& other) noexcept : _h(std::exchange(other._h, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        Task tmp(std::move(other));
+        std::swap(_h, tmp._h);
+        return *this;
+    }
 
-    Task(Task&&) noexcept = default;        // move도 기본
-    Task& operator=(Task&&) noexcept = default;
+    ~Task() { reset(); }
 
-    bool valid() const noexcept { return (bool)_st; }   // shared-state가 있으면 유효
+    bool valid() const noexcept { return (bool)_h; }    // 코루틴을 참조하고 있으면 유효
 
     // Wait (blocking)
     void wait() const {
-        if (!_st) throw std::runtime_error("invalid Task"); // 상태 없으면 오류
+        if (!_h) throw std::runtime_error("invalid Task"); // 상태 없으면 오류
 
-        std::unique_lock lk(_st->done_mtx); // condition_variable 대기용 락
-        _st->done_cv.wait(lk, [&] {         // 완료될 때까지 block
-            return _st->completed.load(std::memory_order_acquire); 
+        auto& st = _h.promise();
+        std::unique_lock lk(st.done_mtx);   // condition_variable 대기용 락
+        st.done_cv.wait(lk, [&] {           // 완료될 때까지 block
+            return st.completed.load(std::memory_order_acquire); 
         });
 
-        if (_st->ex) std::rethrow_exception(_st->ex); // 코루틴 예외를 동기 호출자에게 재throw
+        if (st.ex) std::rethrow_exception(st.ex); // 코루틴 예외를 동기 호출자에게 재throw
     }
 
     // Result: returns const-ref (multi-consumer, avoids copy requirement)
     template<typename U = T, typename std::enable_if<!std::is_void_v<U>, int>::type = 0>
     const U& Result() const {
         wait();                     // 완료까지 대기
-        if (!_st->result.has_value()) throw std::runtime_error("Task has no result");
-        return *_st->result;        // 결과를 const-ref로 반환(복사 비용 회피)
+        auto& pr = _h.promise();
+        if (!pr.result.has_value()) throw std::runtime_error("Task has no result");
+        return *pr.result;          // 결과를 const-ref로 반환(복사 비용 회피)
     }
 
     // co_await (multi awaiters)
     auto operator co_await() const noexcept {
         struct awaiter {
-            std::shared_ptr<state_type> st; // shared-state를 캡쳐(수명 보장)
+            Task task;              // 기다리는 동안 참조 보유(수명 보장)
+            ContinuationSlot slot{};    // awaiter(= 대기 코루틴 프레임) 안에 직접 둠 => 할당 없음
 
             bool await_ready() noexcept {
                 // 완료됐다면 suspend 없이 즉시 진행
-                return st->completed.load(std::memory_order_acquire);
+                return task._h.promise().completed.load(std::memory_order_acquire);
             }
 
-            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
                 // 미완료면 continuation 등록
-                auto slot = std::make_shared<ContinuationSlot>();
-                slot->set(awaiting);                                // 현재 awaiting 코루틴 저장
-                st->add_waiter(slot);                               // shared-state에 waiter로 등록
-                return std::noop_coroutine();                       // "내가 직접 재개하지 않음" 을 의미
+                task._h.promise().add_waiter(&slot);                // 공유 상태에 waiter로 등록
+                return slot.publish(awaiting);                      // 현재 awaiting 코루틴 공개(등록 중 완료됐으면 suspend 취소)
             }
 
             decltype(auto) await_resume() {
                 // 재개된 뒤 호출. 결과/예외를 호출자에게 전달
-                if (st->ex) std::rethrow_exception(st->ex);
+                auto& pr = task._h.promise();
+                if (pr.ex) std::rethrow_exception(pr.ex);
 
                 if constexpr (std::is_void_v<T>) {
                     return; // void는 반환값 없음
                 }
                 else {
-                    if (!st->result.has_value()) throw std::runtime_error("Task has no result");
-                    return (const T&)(*st->result); // const T& 반환
+                    if (!pr.result.has_value()) throw std::runtime_error("Task has no result");
+                    return (const T&)(*pr.result); // const T& 반환
                 }
             }
         };
 
-        return awaiter{ _st };      // awaiter 생성 반환
+        return awaiter{ *this };    // awaiter 생성 반환
     }
 
     // WaitAsync(timeout, token) -> Task<T>
@@ -413,60 +1354,96 @@ public:
     }
 
 private:
+    void reset() noexcept {
+        // 참조 반환. 마지막 참조면(코루틴은 이미 final_suspend에서 참조를 반환함) 프레임 파괴
+        if (_h && _h.promise().release()) _h.destroy();
+        _h = {};
+    }
+
     Task<T> waitAsyncImpl(std::chrono::steady_clock::duration timeout, std::stop_token token) const {
         // WaitAsync는 “코루틴”으로 구현됨: 완료/timeout/cancel 경쟁 후 결과를 co_return
-        auto st = _st;  // shared-state 캡쳐
-        if (!st) throw std::runtime_error("invalid Task");
+        Task src = *this;   // 대상 Task 참조 보유
+        if (!src._h) throw std::runtime_error("invalid Task");
+
+        struct TimeoutFire {
+            ContinuationSlot* slot;     // 타이머가 참조 1개 보유(콜백 끝에서 반환)
+            SimpleThreadPool* pool;
+
+            void operator()() const {
+                std::coroutine_handle<> ch;
+                if (slot->try_fire(WaitWin::Timeout, ch)) {
+                    pool->schedule(ch, false); // 타임아웃 승자면 awaiting을 깨움(스케줄링)
+                }
+                slot->release();
+            }
+        };
+
+        struct CancelFire {
+            ContinuationSlot* slot;     // stop_callback은 WaiterAwaiter 파괴 전에 해제되므로 참조 불필요
+            SimpleThreadPool* pool;
+
+            void operator()() const noexcept {
+                std::coroutine_handle<> ch;
+                if (slot->try_fire(WaitWin::Canceled, ch)) {
+                    pool->schedule(ch, false);  // 취소 승자면 awaiting을 깨움(스케줄링)
+                }
+            }
+        };
 
         struct WaiterAwaiter {
-            std::shared_ptr<state_type> st;                 // 기다릴 대상 상태
+            promise_type& st;                               // 기다릴 대상 상태(src가 참조 보유)
             std::chrono::steady_clock::duration timeout;
             std::stop_token token;
 
-            std::shared_ptr<ContinuationSlot> slot;         // 경쟁 제어용 슬롯(once-only resume)
-            std::optional<std::stop_callback<std::function<void()>>> stopcb;
+            ContinuationSlot* slot = nullptr;               // 경쟁 제어용 슬롯(once-only resume, FramePool에서 할당)
+            std::optional<std::stop_callback<CancelFire>> stopcb{};
             // stop_token 취소 콜백 RAII. WaiterAwaiter가 살아있는 동안만 등록 유지.
+            TimerHandle timer{};                            // 타임아웃 타이머(완료/취소가 먼저면 await_resume에서 cancel)
+
+            ~WaiterAwaiter() {
+                stopcb.reset();             // 취소 콜백 해제(실행 중이면 끝날 때까지 대기) 후
+                if (slot) slot->release();  // 슬롯 참조 반환
+            }
 
             bool await_ready() noexcept {
                 // 이미 완료라면 suspend 없이 바로 끝냄
-                return st->completed.load(std::memory_order_acquire);
+                return st.completed.load(std::memory_order_acquire);
             }
 
-            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+            bool await_suspend(std::coroutine_handle<> awaiting) {
                 // 아직 미완료면 completion/timeout/cancel 경쟁 등록
-                slot = std::make_shared<ContinuationSlot>();
-                slot->set(awaiting);            // 현재 awaiting 코루틴 저장
-                st->add_waiter(slot);           // 완료 시 깨울 waiter 등록
+                slot = new ContinuationSlot();
 
-                SimpleThreadPool* pool = st->pool ? st->pool : &globalPool();
+                SimpleThreadPool* pool = st.pool ? st.pool : &globalPool();
 
                 // timeout
                 if (timeout != Task::InfiniteTimeout) {
-                    globalTimer().schedule_after(timeout, [slot = slot, pool] {
-                        std::coroutine_handle<> ch;
-                        if (slot && slot->try_fire(WaitWin::Timeout, ch)) {
-                            pool->schedule(ch, false); // 타임아웃 승자면 awaiting을 깨움(스케줄링)
-                        }
-                    });
+                    slot->add_ref();
+                    timer = globalTimer().schedule_after(timeout, TimeoutFire{ slot, pool });
                 }
 
                 // cancel
                 if (token.stop_possible()) {
-                    stopcb.emplace(token, std::function<void()>([slot = slot, pool] {
-                        std::coroutine_handle<> ch;
-                        if (slot && slot->try_fire(WaitWin::Canceled, ch)) {
-                            pool->schedule(ch, false);  // 취소 승자면 awaiting을 깨움(스케줄링)
-                        }
-                    }));
+                    stopcb.emplace(token, CancelFire{ slot, pool });
                 }
 
-                return std::noop_coroutine();   // 실제 재개는 completion/timeout/cancel에서 수행
+                st.add_waiter(slot);                // 완료 시 깨울 waiter 등록
+
+                return slot->publish(awaiting);
+                // 현재 awaiting 코루틴을 마지막에 공개 => 실제 재개는 completion/timeout/cancel에서 수행
+                // 등록 도중 이미 승자가 정해졌으면 suspend하지 않고 바로 await_resume으로 진행
             }
 
             void await_resume() {
                 // 깨어난 뒤, 누가 승자인지에 따라 예외/정상 처리
                 int w = slot ? slot->win.load(std::memory_order_acquire) : (int)WaitWin::Completed;
 
+                if (w != (int)WaitWin::Completed) st.remove_waiter(slot);
+                // timeout/cancel이 먼저 => 대상 Task의 waiter 리스트에서 슬롯 제거
+
+                if (w != (int)WaitWin::Timeout && globalTimer().cancel(timer)) slot->release();
+                // 완료/취소가 먼저 => 더 이상 필요 없는 타이머를 wheel에서 즉시 제거(O(1)), 타이머 몫의 참조 반환
+
                 if (w == (int)WaitWin::Timeout)  throw TaskTimeoutException("WaitAsync timeout");
                 if (w == (int)WaitWin::Canceled) throw TaskCanceledException("WaitAsync canceled");
                 
@@ -474,46 +1451,51 @@ private:
             }
         };
 
-        co_await WaiterAwaiter{ st, timeout, token }; // 경쟁 await(완료/timeout/cancel 중 하나)
+        WaiterAwaiter waiter{ src._h.promise(), timeout, token };
+        // 집합 초기화한 임시 awaiter를 바로 co_await 하면 GCC 12에서 멤버가 두 번 파괴되므로 이름 있는 변수로 둔다
+        co_await waiter;    // 경쟁 await(완료/timeout/cancel 중 하나)
 
         // Completed won
-        if (st->ex) std::rethrow_exception(st->ex); // 원본 Task의 예외가 있으면 재throw
+        auto& st = src._h.promise();
+        if (st.ex) std::rethrow_exception(st.ex); // 원본 Task의 예외가 있으면 재throw
 
         if constexpr (std::is_void_v<T>) {
             co_return;  // void는 값 없이 종료
         }
         else {
-            if (!st->result.has_value()) throw std::runtime_error("Task has no result");
-            co_return *st->result;
+            if (!st.result.has_value()) throw std::runtime_error("Task has no result");
+            co_return *st.result;
             // 값을 “복사”해서 WaitAsync Task의 promise.result에 저장
         }
     }
 
 private:
-    std::shared_ptr<state_type> _st; // Task의 핵심: 공유 상태를 소유(shared_ptr)
+    friend class WhenGroup;     // WhenAll/WhenAny가 공유 상태에 도착 슬롯을 등록
+
+    handle_type _h; // Task의 핵심: 코루틴(= 공유 상태) 참조(intrusive refcount)
 
 public:
     //=============================================================================================
     // promise_type (IMPORTANT: no return_value/return_void defined here!)
     //=============================================================================================
-    struct promise_type : public promise_return_base<T, promise_type> {
+    struct promise_type : public promise_return_base<T, promise_type>, public SharedState {
         // promise_return_base가 T에 따라 return_value 또는 return_void를 제공.
+        // SharedState(결과 외의 완료/예외/대기자 상태)를 상속 => 프레임과 상태가 한 번의 할당으로 끝남
 
-        std::shared_ptr<state_type> st; // 공유 상태(결과/예외/대기자/완료 플래그)
-
-        promise_type() 
-            : st(std::make_shared<state_type>()) {
-            // 기본 생성: shared-state 생성
-        }
+        promise_type() = default;
 
         template<typename... Args>
-        promise_type(SimpleThreadPool& p, Args&&...)
-            : st(std::make_shared<state_type>()) {
-            st->pool = &p;      // 생성자 인자로 풀을 주입하면 그 풀 사용
+        promise_type(SimpleThreadPool& p, Args&&...) {
+            pool = &p;      // 생성자 인자로 풀을 주입하면 그 풀 사용
         }
 
+        // 코루틴 프레임 할당: 스레드별 size-class 풀 (steady state에서 일반 힙 할당 없음)
+        static void* operator new(size_t size) { return FramePool::allocate(size); }
+        static void operator delete(void* p, size_t size) noexcept { FramePool::deallocate(p, size); }
+
         Task get_return_object() {
-            return Task{ st };  // 호출자에게 copyable Task 반환(shared_ptr 공유)
+            add_ref();          // 호출자에게 넘겨줄 참조
+            return Task{ handle_type::from_promise(*this) };   // copyable Task 반환
         }
 
         // Start automatically on pool
@@ -532,34 +1514,29 @@ public:
             // initial_suspend에서 깨어난 뒤 특별히 할 일 없음
         };
 
-        start_awaiter initial_suspend() noexcept { return start_awaiter{ st->pool }; }
+        start_awaiter initial_suspend() noexcept { return start_awaiter{ pool }; }
         // 코루틴 생성 직후 initial_suspend에서 start_awaiter가 사용됨.
         // 결과적으로 코루틴 본문은 "바로 실행”이 아니라 “풀에 스케줄 후 실행".
 
-        // Final: publish completion, publish result (for non-void), wake waiters, destroy frame
+        // Final: publish completion, wake waiters, drop own reference (destroy frame if last)
         struct final_awaiter {
             bool await_ready() noexcept { return false; }
             // final_suspend에서도 항상 await_suspend를 타서 “신호/깨우기/파괴”를 수행
 
             std::coroutine_handle<> await_suspend(handle_type h) noexcept {
-                auto& pr = h.promise();     // promise 참조
-                auto st = pr.st;            // shared-state 복사(로컬로 들고있어 수명 보장)
-
-                // publish result into shared-state (multi-consumer)
-                if constexpr (!std::is_void_v<T>) {
-                    // pr.result is from promise_return_base<T,...>
-                    if (pr.result.has_value()) {
-                        st->result = std::move(pr.result); // shared-state에 결과를 옮김(한 번만)
-                    }
-                }
+                auto& pr = h.promise();     // promise 참조(결과는 promise_return_base::result에 그대로 둠)
 
                 // signal completion
-                st->completed.store(true, std::memory_order_release);   // 완료 플래그 publish
-                st->done_cv.notify_all();                               // Wait()로 block된 스레드들 깨움
-                st->notify_all_waiters_completed();                     // co_await/WaitAsync 대기자들 깨움
+                {
+                    std::lock_guard lk(pr.done_mtx);
+                    // wait()의 predicate 확인 ~ block 사이에 완료가 끼어들면 notify를 놓치므로 락 안에서 publish
+                    pr.completed.store(true, std::memory_order_release);   // 완료 플래그 publish
+                }
+                pr.done_cv.notify_all();                                // Wait()로 block된 스레드들 깨움
+                pr.notify_all_waiters_completed();                      // co_await/WaitAsync 대기자들 깨움
 
-                // destroy coroutine frame (state stays alive via shared_ptr)
-                h.destroy();                    // 코루틴 프레임 파괴(결과는 shared-state에 남아있음)
+                // 코루틴 자신의 참조 반환. Task가 남아 있으면 프레임(결과)은 마지막 Task가 파괴
+                if (pr.release()) h.destroy();
                 return std::noop_coroutine();   // continuation 없음
             }
 
@@ -571,16 +1548,181 @@ public:
         // 코루틴 종료 시 final_awaiter 실행
 
         void unhandled_exception() noexcept {
-            st->ex = std::current_exception();
-            // 예외를 shared-state에 저장(다중 consumer에서 재throw 가능)
+            ex = std::current_exception();
+            // 예외를 공유 상태에 저장(다중 consumer에서 재throw 가능)
         }
     };
 };
 
+//==================================================================================================
+// WhenAll / WhenAny
+//   - 대상 Task마다 도착 슬롯(ArriveSlot)을 waiter로 등록하고, 카운트다운 1개 + continuation 슬롯 1개로 대기
+//   - 개별 완료는 대기 코루틴을 깨우지 않고 카운트만 줄인다 => N개 fan-out 완료에 resume 1번
+//   - WhenAny: 처음 도착한 Task가 승자. 나머지는 stop_source로 협조적 취소 요청
+//==================================================================================================
+class WhenGroup {
+public:
+    enum class Kind { All, Any };
+
+    struct ArriveSlot : ContinuationSlot {
+        WhenGroup* group = nullptr;
+        size_t index = 0;
+    };
+
+    static constexpr size_t NoWinner = size_t(-1);
+
+    WhenGroup(Kind kind, SimpleThreadPool& pool, ArriveSlot* slots, size_t count)
+        : _kind(kind), _pool(&pool), _slots(slots), _count(count), _remaining(count) {}
+
+    template<typename T>
+    void attach(size_t index, const Task<T>& task) {
+        // 대상 Task에 도착 슬롯 등록(이미 완료됐으면 즉시 도착 처리)
+        ArriveSlot& s = _slots[index];
+        s.group = this;
+        s.index = index;
+        s.arrive = &WhenGroup::on_arrive;
+        task._h.promise().add_waiter(&s);
+    }
+
+    template<typename T>
+    void detach(size_t index, const Task<T>& task) {
+        // WhenAny의 패자: 아직 대상 waiter 리스트에 남은 슬롯 제거
+        // (도착 처리는 대상의 wait_mtx 안에서 실행되므로 제거 후에는 이 그룹을 건드리지 않음)
+        task._h.promise().remove_waiter(&_slots[index]);
+    }
+
+    size_t winner() const noexcept { return _winner.load(std::memory_order_acquire); }
+
+    // co_await group: 모두(All) 또는 하나(Any) 도착할 때까지 대기
+    bool await_ready() noexcept {
+        return _count == 0 || _done.win.load(std::memory_order_acquire) >= 0;
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        return _done.publish(awaiting);     // 등록 도중 이미 다 도착했으면 suspend 취소
+    }
+
+    void await_resume() noexcept {}
+
+private:
+    static void on_arrive(ContinuationSlot* s) {
+        auto* a = static_cast<ArriveSlot*>(s);
+        WhenGroup& g = *a->group;
+
+        if (g._kind == Kind::Any) {
+            size_t expected = NoWinner;
+            if (!g._winner.compare_exchange_strong(expected, a->index, std::memory_order_acq_rel)) return;
+            // 첫 도착만 승자
+        }
+        else if (g._remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;     // 마지막 도착만 대기 코루틴을 깨움
+        }
+
+        std::coroutine_handle<> ch;
+        if (g._done.try_fire(WaitWin::Completed, ch)) {
+            g._pool->schedule(ch, false);
+        }
+    }
+
+    Kind _kind;
+    SimpleThreadPool* _pool;                    // 대기 코루틴을 재개할 풀
+    ArriveSlot* _slots;                         // 대상 Task마다 1개(호출자 코루틴 프레임 또는 배열)
+    size_t _count;
+    std::atomic<size_t> _remaining;             // WhenAll 카운트다운
+    std::atomic<size_t> _winner{ NoWinner };    // WhenAny 승자 index
+    ContinuationSlot _done;                     // 대기 코루틴용 continuation 슬롯(1개)
+};
+
+template<typename T> struct when_all_value { using type = T; };
+template<> struct when_all_value<void> { using type = std::monostate; };
+// 가변 인자 WhenAll의 tuple 원소 타입(void Task는 std::monostate)
+
+template<typename T>
+typename when_all_value<T>::type when_all_get(const Task<T>& task) {
+    if constexpr (std::is_void_v<T>) {
+        task.wait();                // 이미 완료 => 예외만 재throw
+        return {};
+    }
+    else {
+        return task.Result();       // 결과 복사(원본 Task는 여전히 multi-consumer)
+    }
+}
+
+// WhenAll(range): 모두 완료되면 결과를 index 순서대로 모아 반환(예외는 index 순서상 첫 번째를 재throw)
+template<typename T>
+Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> WhenAll(SimpleThreadPool& pool, std::vector<Task<T>> tasks) {
+    std::unique_ptr<WhenGroup::ArriveSlot[]> slots(new WhenGroup::ArriveSlot[tasks.size()]);
+    WhenGroup group(WhenGroup::Kind::All, pool, slots.get(), tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) group.attach(i, tasks[i]);
+
+    co_await group;     // 마지막 완료가 단 한 번 재개
+
+    if constexpr (std::is_void_v<T>) {
+        for (auto& t : tasks) t.wait();
+    }
+    else {
+        std::vector<T> results;
+        results.reserve(tasks.size());
+        for (auto& t : tasks) results.push_back(t.Result());
+        co_return results;
+    }
+}
+
+template<typename T>
+auto WhenAll(std::vector<Task<T>> tasks) {
+    return WhenAll(globalPool(), std::move(tasks));
+}
+
+// WhenAll(tasks...): 결과를 tuple로 반환(슬롯은 코루틴 프레임 안에 둠 => 추가 할당 없음)
+template<typename... Ts>
+Task<std::tuple<typename when_all_value<Ts>::type...>> WhenAll(SimpleThreadPool& pool, Task<Ts>... tasks) {
+    std::array<WhenGroup::ArriveSlot, sizeof...(Ts)> slots;
+    WhenGroup group(WhenGroup::Kind::All, pool, slots.data(), sizeof...(Ts));
+    size_t i = 0;
+    (group.attach(i++, tasks), ...);
+
+    co_await group;
+
+    co_return std::tuple<typename when_all_value<Ts>::type...>{ when_all_get(tasks)... };
+}
+
+template<typename... Ts>
+auto WhenAll(Task<Ts>... tasks) {
+    return WhenAll(globalPool(), std::move(tasks)...);
+}
+
+// WhenAny(range): 처음 완료된 Task의 index 반환. cancel이 주어지면 승자가 정해진 뒤 request_stop()으로 패자 취소 요청
+template<typename T>
+Task<size_t> WhenAny(SimpleThreadPool& pool, std::vector<Task<T>> tasks, std::stop_source cancel = std::stop_source(std::nostopstate)) {
+    if (tasks.empty()) throw std::invalid_argument("WhenAny requires at least one task");
+
+    std::unique_ptr<WhenGroup::ArriveSlot[]> slots(new WhenGroup::ArriveSlot[tasks.size()]);
+    WhenGroup group(WhenGroup::Kind::Any, pool, slots.get(), tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        group.attach(i, tasks[i]);
+        if (group.winner() != WhenGroup::NoWinner) {
+            tasks.resize(i + 1);    // 이미 승자 결정: 나머지는 등록하지 않음
+            break;
+        }
+    }
+
+    co_await group;
+
+    for (size_t i = 0; i < tasks.size(); ++i) group.detach(i, tasks[i]);
+    if (cancel.stop_possible()) cancel.request_stop();  // 패자들에게 협조적 취소 요청
+
+    co_return group.winner();
+}
+
+template<typename T>
+Task<size_t> WhenAny(std::vector<Task<T>> tasks, std::stop_source cancel = std::stop_source(std::nostopstate)) {
+    return WhenAny(globalPool(), std::move(tasks), std::move(cancel));
+}
+
 //=================================================================================================
 // 테스트
 //=================================================================================================
-Task<void> task_with_fire_and_forget(SimpleThreadPool& pool, int id) {
+Task<void> task_with_fire_and_forget([[maybe_unused]] SimpleThreadPool& pool, int id) {
  
     std::cout << "[job " << id << "] start\n";
     std::this_thread::sleep_for(std::chrono::milliseconds(200));    // 대기
@@ -589,7 +1731,7 @@ Task<void> task_with_fire_and_forget(SimpleThreadPool& pool, int id) {
     co_return;              // void 코루틴 종료(return_void 호출됨)
 }
 
-Task<int> compute_async(SimpleThreadPool& pool, int x) {
+Task<int> compute_async([[maybe_unused]] SimpleThreadPool& pool, int x) {
 
     std::cout << "[compute_async] start x=" << x << "\n";
     std::this_thread::sleep_for(std::chrono::milliseconds(300));
@@ -623,6 +1765,197 @@ Task<void> multi_consumer(SimpleThreadPool& pool) {
     co_return;                                      // multi_consumer 종료
 }
 
+Task<int> delayed_value([[maybe_unused]] SimpleThreadPool& pool, int v, int ms, std::stop_token token = {}) {
+    for (int waited = 0; waited < ms; waited += 10) {
+        if (token.stop_requested()) {
+            std::cout << "[delayed_value] " << v << " canceled\n";   // WhenAny 패자: 협조적 취소
+            co_return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    co_return v;
+}
+
+Task<void> when_all_any(SimpleThreadPool& pool) {
+    std::vector<Task<int>> tasks;
+    for (int i = 1; i <= 4; ++i) tasks.push_back(delayed_value(pool, i, i * 10));
+
+    auto values = co_await WhenAll(pool, tasks);    // 4개 모두 완료 후 한 번만 재개
+    std::cout << "WhenAll(range): " << values[0] << ", " << values[1] << ", " << values[2] << ", " << values[3] << "\n";
+
+    auto [x, y] = co_await WhenAll(pool, delayed_value(pool, 5, 10), compute_async(pool, 3));
+    std::cout << "WhenAll(tasks...): " << x << ", " << y << "\n";
+
+    std::stop_source stop;
+    std::vector<Task<int>> racers{ delayed_value(pool, 100, 500, stop.get_token()), delayed_value(pool, 200, 30, stop.get_token()) };
+    size_t w = co_await WhenAny(pool, racers, stop);    // 먼저 끝난 쪽 index, 나머지는 취소 요청
+    std::cout << "WhenAny winner: index " << w << " value " << racers[w].Result() << "\n";
+
+    co_await WhenAll(pool, racers);     // 패자가 취소를 확인하고 끝날 때까지 대기
+}
+
+//=================================================================================================
+// 벤치마크: co_await resume 처리량 (SharedQueue vs WorkStealing, 워커 1..N)
+//=================================================================================================
+struct reschedule_awaiter {
+    SimpleThreadPool& pool;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) const { pool.schedule(h, false); }
+    // 풀에 다시 넣은 뒤에는 h를 건드리지 않는다(다른 워커가 이미 resume 중일 수 있음)
+    void await_resume() const noexcept {}
+};
+
+Task<void> resume_loop(SimpleThreadPool& pool, int iterations) {
+    for (int i = 0; i < iterations; ++i) {
+        co_await reschedule_awaiter{ pool };    // co_await 1회 = schedule 1회 + resume 1회
+    }
+    co_return;
+}
+
+void benchmark_co_await_resume() {
+    constexpr int TasksPerWorker = 16;      // 워커당 동시에 돌아가는 코루틴 수
+    constexpr int Iterations = 20000;       // 코루틴당 co_await 횟수
+
+    const size_t maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<size_t> workerCounts;   // 1, 2, 4, ... , hardware_concurrency
+    for (size_t n = 1; n < maxWorkers; n *= 2) workerCounts.push_back(n);
+    workerCounts.push_back(maxWorkers);
+
+    for (auto mode : { SimpleThreadPool::Mode::SharedQueue, SimpleThreadPool::Mode::RingQueue, SimpleThreadPool::Mode::WorkStealing }) {
+        const char* name = mode_name(mode);
+
+        for (size_t n : workerCounts) {
+            SimpleThreadPool pool(n, mode);
+
+            std::vector<Task<void>> tasks;
+            tasks.reserve(n * TasksPerWorker);
+
+            auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < n * TasksPerWorker; ++i) {
+                tasks.push_back(resume_loop(pool, Iterations));
+            }
+            for (auto& t : tasks) t.wait();
+            auto t1 = std::chrono::steady_clock::now();
+
+            pool.shutdown();
+
+            double sec = std::chrono::duration<double>(t1 - t0).count();
+            double resumes = (double)tasks.size() * (Iterations + 1);    // +1: initial_suspend 시작 resume
+            std::cout << "[" << name << "] workers=" << std::setw(2) << n
+                      << " : " << std::fixed << std::setprecision(2) << resumes / sec / 1e6 << " M resumes/s\n";
+        }
+    }
+}
+
+//=================================================================================================
+// 벤치마크: fan-out 지연 (Task를 하나씩 co_await vs WhenAll 한 번)
+//=================================================================================================
+Task<int> fan_leaf(SimpleThreadPool& pool, int v) {
+    co_await reschedule_awaiter{ pool };    // 한 번 양보해 대기자가 먼저 등록되게 함
+    co_return v;
+}
+
+Task<void> fan_out_one_by_one(SimpleThreadPool& pool, int width) {
+    std::vector<Task<int>> tasks;
+    tasks.reserve(width);
+    for (int i = 0; i < width; ++i) tasks.push_back(fan_leaf(pool, i));
+
+    for (auto& t : tasks) co_await t;   // 완료마다 대기 코루틴이 깨어날 수 있음(최대 width번)
+}
+
+Task<void> fan_out_when_all(SimpleThreadPool& pool, int width) {
+    std::vector<Task<int>> tasks;
+    tasks.reserve(width);
+    for (int i = 0; i < width; ++i) tasks.push_back(fan_leaf(pool, i));
+
+    co_await WhenAll(pool, std::move(tasks));   // 마지막 완료에서 한 번만 재개
+}
+
+void benchmark_fan_out() {
+    constexpr int Width = 1000;
+    constexpr int Rounds = 200;
+
+    SimpleThreadPool pool(std::max(2u, std::thread::hardware_concurrency()), SimpleThreadPool::Mode::WorkStealing);
+
+    auto run = [&](const char* name, Task<void> (*fan_out)(SimpleThreadPool&, int)) {
+        fan_out(pool, Width).wait();    // warm-up
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < Rounds; ++r) fan_out(pool, Width).wait();
+        auto t1 = std::chrono::steady_clock::now();
+
+        double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / Rounds;
+        std::cout << name << " fan-out " << Width << " : " << std::fixed << std::setprecision(1) << us << " us\n";
+    };
+
+    run("[one-by-one]", &fan_out_one_by_one);
+    run("[WhenAll   ]", &fan_out_when_all);
+}
+
+//=================================================================================================
+// 벤치마크: 타이머 insert / cancel / fire 처리량 (HeapTimerService vs TimerService(timing wheel))
+//=================================================================================================
+template<typename Service>
+void benchmark_timer_service(const char* name) {
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t Count = 200000;    // 초당 수십만 개의 짧은 타임아웃을 가정
+
+    auto rate = [](size_t n, Clock::duration d) {
+        return (double)n / std::chrono::duration<double>(d).count() / 1e6;
+    };
+
+    double insertRate = 0, cancelRate = 0, fireRate = 0;
+
+    // insert + cancel: WaitAsync 타임아웃처럼 등록 후 대부분 실행 전에 취소되는 패턴
+    {
+        Service svc;
+        std::vector<TimerHandle> handles;
+        handles.reserve(Count);
+
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < Count; ++i) {
+            handles.push_back(svc.schedule_after(std::chrono::milliseconds(5000 + i % 1000), [] {}));
+        }
+        auto t1 = Clock::now();
+        for (auto& h : handles) svc.cancel(h);
+        auto t2 = Clock::now();
+
+        insertRate = rate(Count, t1 - t0);
+        cancelRate = rate(Count, t2 - t1);
+    }
+
+    // fire: 같은 시각 근처에 몰린 타이머를 실제로 실행
+    {
+        Service svc;
+        std::atomic<size_t> fired{ 0 };
+        Clock::time_point first{}, last{};
+
+        auto deadline = Clock::now() + std::chrono::milliseconds(50);
+        for (size_t i = 0; i < Count; ++i) {
+            svc.schedule_after(deadline - Clock::now() + std::chrono::microseconds(i % 10000), [&] {
+                size_t n = fired.fetch_add(1, std::memory_order_acq_rel) + 1;
+                if (n == 1) first = Clock::now();
+                if (n == Count) last = Clock::now();
+            });
+        }
+        while (fired.load(std::memory_order_acquire) < Count) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        fireRate = rate(Count, last - first);
+    }
+
+    std::cout << "[" << name << "] insert " << std::fixed << std::setprecision(2) << insertRate << " M/s"
+              << ", cancel " << cancelRate << " M/s"
+              << ", fire " << fireRate << " M/s\n";
+}
+
+void benchmark_timer_backends() {
+    benchmark_timer_service<HeapTimerService>("heap ");
+    benchmark_timer_service<TimerService>("wheel");
+}
+
 //=================================================================================================
 // 테스트 엔트리
 //=================================================================================================
@@ -647,8 +1980,21 @@ void Test() {
         d.wait();                               // 동기(blocking)로 완료까지 대기
     }
 
+    {
+        auto w = when_all_any(pool);            // WhenAll / WhenAny
+        w.wait();
+    }
+
     std::this_thread::sleep_for(std::chrono::milliseconds(800));
     pool.shutdown();
+
+    //benchmark_co_await_resume();
+
+    //benchmark_fan_out();
+
+    //benchmark_timer_backends();
+
+    // co_await 경로의 힙 할당 0 회 검증은 tests/test_zero_alloc_co_await.cpp (전역 operator new 를 교체하므로 따로 빌드)
 }
 
 }//TaskWithThreadPool
\ No newline at end of file
@@ -40,11 +40,16 @@ static bool LoadPlugin(const wchar_t* dllName, PluginApi& outApi, HMODULE& outMo
     outMod = LoadLibraryW(dllName);
     if (!outMod) return false;
 
-    auto get_api = (plugin_get_api_fn)GetProcAddress(outMod, "plugin_get_api");
-    if (!get_api) { FreeLibrary(outMod); outMod = nullptr; return false; }
-
+    // 1.1 plugin ̸ ü ǥ, 1.0 plugin ̸ պκи (1.1 Լ pointer  nullptr  ´)
     PluginApi api{};
-    if (!get_api(&api)) { FreeLibrary(outMod); outMod = nullptr; return false; }
+    bool ok = false;
+    if (auto get_api_v = (plugin_get_api_v_fn)GetProcAddress(outMod, "plugin_get_api_v")) {
+        ok = get_api_v(&api, sizeof(api)) != 0;
+    }
+    else if (auto get_api = (plugin_get_api_fn)GetProcAddress(outMod, "plugin_get_api")) {
+        ok = get_api(&api) != 0;
+    }
+    if (!ok) { FreeLibrary(outMod); outMod = nullptr; return false; }
 
     outApi = api;
     return true;
@@ -90,6 +95,48 @@ static void TestStl(const char* tag,
     destroy_fn(h);
 }
 
+// ABI 1.1 :   ȣ ְ,    , ȣ heap  ޴´
+static void* host_alloc(void*, size_t bytes) { return std::malloc(bytes); }
+static void  host_free(void*, void* p) { std::free(p); }
+
+static void TestStlBatch(const char* tag, const PluginApi& api)
+{
+    std::cout << "\n[" << tag << "] batch / zero-copy (ABI 1.1)\n";
+
+    if (!api.stl_push_n || !api.stl_view_values || !api.stl_alloc_values || !api.stl_set_allocator || !api.stl_release) {
+        std::cout << "  not supported (plugin abi " << api.abi.abi_major << "." << api.abi.abi_minor << ")\n";
+        return;
+    }
+
+    StlHandle* h = api.stl_create(777);
+
+    const int input[] = { 10, 20, 30, 40, 50 };
+    api.stl_push_n(h, input, sizeof(input) / sizeof(input[0]));
+
+    //  push  ȿ
+    const int* data = nullptr;
+    size_t count = 0;
+    api.stl_view_values(h, &data, &count);
+    std::cout << "  view:";
+    for (size_t i = 0; i < count; ++i) std::cout << " " << data[i];
+    std::cout << " sum=" << api.stl_sum(h) << "\n";
+
+    // EXE  CRT heap  ޴´.  stl_release : ڵ Ҵ(host_free) ش
+    //   (Ҵڸ  ڵ buffer  stl_free  ѱ plugin CRT  free  EXE heap  ϰ )
+    StlAllocator host = { &host_alloc, &host_free, nullptr };
+    api.stl_set_allocator(h, &host);
+
+    int* copy = api.stl_alloc_values(h, &count);
+    std::cout << "  alloc_values count=" << count << "\n";
+    api.stl_release(h, copy);
+
+    char* name = api.stl_alloc_name(h);
+    std::cout << "  alloc_name=" << (name ? name : "(null)") << "\n";
+    api.stl_release(h, name);
+
+    api.stl_destroy(h);
+}
+
 int main()
 {
 #if defined(_DEBUG)
@@ -171,6 +218,8 @@ int main()
                 api.stl_create, api.stl_destroy, api.stl_set_name, api.stl_get_name,
                 api.stl_push, api.stl_count, api.stl_get_values, api.stl_sum);
 
+            TestStlBatch("Plugin", api);
+
             FreeLibrary(h);
         }
     }
@@ -1,14 +1,63 @@
-#include "stdafx.h"
+﻿#include "stdafx.h"
 #include "stl_core.h"
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <emmintrin.h>
+#define STL_CORE_HAS_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define STL_CORE_HAS_NEON 1
+#endif
+
 
 struct StlHandle
 {
     uint32_t seed{};
     std::string name;
     std::vector<int> values;
+    StlAllocator allocator{};   // alloc == nullptr => malloc/free
 };
 
+static void* handle_alloc(StlHandle* h, size_t bytes)
+{
+    return h->allocator.alloc ? h->allocator.alloc(h->allocator.user, bytes) : std::malloc(bytes);
+}
+
+// int 합은 2의 보수로 wrap (scalar 의 signed overflow UB 없이 SIMD 와 같은 결과)
+static int sum_values(const int* p, size_t n)
+{
+    uint32_t s = 0;
+    size_t i = 0;
+
+#if defined(STL_CORE_HAS_SSE2)
+    // 누산기 4 개 => add 의존 사슬을 끊는다 (16 int / iteration)
+    __m128i a0 = _mm_setzero_si128(), a1 = a0, a2 = a0, a3 = a0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = _mm_add_epi32(a0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+        a1 = _mm_add_epi32(a1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 4)));
+        a2 = _mm_add_epi32(a2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 8)));
+        a3 = _mm_add_epi32(a3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 12)));
+    }
+    __m128i a = _mm_add_epi32(_mm_add_epi32(a0, a1), _mm_add_epi32(a2, a3));
+    a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+    a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+    s = static_cast<uint32_t>(_mm_cvtsi128_si32(a));
+#elif defined(STL_CORE_HAS_NEON)
+    uint32x4_t a0 = vdupq_n_u32(0), a1 = a0, a2 = a0, a3 = a0;
+    const uint32_t* u = reinterpret_cast<const uint32_t*>(p);
+    for (; i + 16 <= n; i += 16) {
+        a0 = vaddq_u32(a0, vld1q_u32(u + i));
+        a1 = vaddq_u32(a1, vld1q_u32(u + i + 4));
+        a2 = vaddq_u32(a2, vld1q_u32(u + i + 8));
+        a3 = vaddq_u32(a3, vld1q_u32(u + i + 12));
+    }
+    s = vaddvq_u32(vaddq_u32(vaddq_u32(a0, a1), vaddq_u32(a2, a3)));
+#endif
+
+    for (; i < n; ++i) s += static_cast<uint32_t>(p[i]);
+    return static_cast<int>(s);
+}
+
 extern "C" StlHandle* stl_core_create(uint32_t seed)
 {
     auto* h = new (std::nothrow) StlHandle{};
@@ -54,7 +103,7 @@ extern "C" char* stl_core_alloc_name(StlHandle* h)
     if (!h) return nullptr;
 
     const size_t need = h->name.size() + 1;
-    char* p = (char*)std::malloc(need);
+    char* p = (char*)handle_alloc(h, need);
     if (!p) return nullptr;
 
 #ifdef _MSC_VER
@@ -92,14 +141,64 @@ extern "C" int stl_core_get_values(StlHandle* h, int* outArr, size_t outCount, s
     if (!outArr || outCount == 0) return 0; // size query
     if (outCount < need) return 1;          // insufficient
 
-    for (size_t i = 0; i < need; ++i) outArr[i] = h->values[i];
+    if (need) std::memcpy(outArr, h->values.data(), need * sizeof(int));
     return 0;
 }
 
 extern "C" int stl_core_sum(StlHandle* h)
 {
     if (!h) return 0;
-    int s = 0;
-    for (int x : h->values) s += x;
-    return s;
+    return sum_values(h->values.data(), h->values.size());
+}
+
+extern "C" int stl_core_set_allocator(StlHandle* h, const StlAllocator* allocator)
+{
+    if (!h) return -1;
+    if (allocator && (!allocator->alloc || !allocator->free)) return -1;
+    h->allocator = allocator ? *allocator : StlAllocator{};
+    return 0;
+}
+
+extern "C" int stl_core_push_n(StlHandle* h, const int* values, size_t count)
+{
+    if (!h) return -1;
+    if (!count) return 0;
+    if (!values) return -1;
+
+    try {
+        h->values.insert(h->values.end(), values, values + count);
+    }
+    catch (const std::bad_alloc&) {
+        return -2;
+    }
+    return 0;
+}
+
+extern "C" int stl_core_view_values(StlHandle* h, const int** outData, size_t* outCount)
+{
+    if (!h || !outData || !outCount) return -1;
+    *outData = h->values.data();
+    *outCount = h->values.size();
+    return 0;
+}
+
+extern "C" int* stl_core_alloc_values(StlHandle* h, size_t* outCount)
+{
+    if (outCount) *outCount = 0;
+    if (!h || h->values.empty()) return nullptr;
+
+    const size_t bytes = h->values.size() * sizeof(int);
+    int* p = (int*)handle_alloc(h, bytes);
+    if (!p) return nullptr;
+
+    std::memcpy(p, h->values.data(), bytes);
+    if (outCount) *outCount = h->values.size();
+    return p;
+}
+
+extern "C" void stl_core_release(StlHandle* h, void* p)
+{
+    if (!p) return;
+    if (h && h->allocator.free) h->allocator.free(h->allocator.user, p);
+    else std::free(p);
 }
@@ -1,4 +1,4 @@
-#pragma once
+﻿#pragma once
 
 #include <stddef.h>
 #include <stdint.h>
@@ -17,6 +17,9 @@ extern "C" {
 	int  stl_core_get_name(StlHandle* h, char* outBuf, size_t outBufBytes, size_t* outRequiredBytes);
 
 	char* stl_core_alloc_name(StlHandle* h);
+
+	// deprecated (ABI 1.0) : 핸들을 모르므로 항상 이 모듈의 std::free 로 해제한다
+	//   stl_core_set_allocator 를 설정한 핸들의 buffer 에 쓰면 안 된다 => stl_core_release 를 쓸 것
 	void  stl_core_free(char* p);
 
 	int     stl_core_push(StlHandle* h, int v);
@@ -25,6 +28,32 @@ extern "C" {
 
 	int     stl_core_sum(StlHandle* h);
 
+	// --- ABI 1.1 : batch / zero-copy ---
+
+	// 호출자 heap 할당자 : stl_core_alloc_name / stl_core_alloc_values 가 돌려주는 buffer 를 이것으로 잡는다
+	//   => 모듈마다 CRT 가 달라도 호출자 heap 에 놓인다 (설정 안 하면 malloc/free)
+	//   해제는 반드시 stl_core_release(h, p) : 핸들의 할당자 free 로 돌려준다 (stl_core_free 는 std::free 고정)
+	typedef struct StlAllocator
+	{
+		void* (*alloc)(void* user, size_t bytes);
+		void  (*free)(void* user, void* p);
+		void* user;
+	} StlAllocator;
+
+	int     stl_core_set_allocator(StlHandle* h, const StlAllocator* allocator);   // NULL => malloc/free 로 되돌림
+
+	int     stl_core_push_n(StlHandle* h, const int* values, size_t count);
+
+	// 내부 buffer 를 빌려준다 (복사 없음). 다음 변경(push/push_n/destroy) 전까지만 유효
+	int     stl_core_view_values(StlHandle* h, const int** outData, size_t* outCount);
+
+	// 크기 질의 없이 한 번에 복사 (StlAllocator 로 할당, 원소 0 개면 NULL)
+	int*    stl_core_alloc_values(StlHandle* h, size_t* outCount);
+
+	// stl_core_alloc_name / stl_core_alloc_values 결과를 핸들의 할당자로 해제 (할당자 유무와 관계없이 항상 이것으로)
+	//   할당한 뒤 stl_core_set_allocator 로 할당자를 바꿨다면 바꾸기 전 buffer 는 이전 할당자로 직접 해제해야 한다
+	void    stl_core_release(StlHandle* h, void* p);
+
 #ifdef __cplusplus
 }
 #endif
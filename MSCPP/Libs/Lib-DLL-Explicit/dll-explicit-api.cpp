@@ -21,10 +21,8 @@ static int32_t PLUGIN_CALL abi_check_impl(const AbiExpected* exp)
     return check_abi_compat(exp, &me);
 }
 
-extern "C" __declspec(dllexport)
-int PLUGIN_CALL plugin_get_api(PluginApi* outApi)
+static void fill_plugin_api(PluginApi* outApi)
 {
-    if (!outApi) return 0;
     std::memset(outApi, 0, sizeof(*outApi));
 
     fill_abi_info(&outApi->abi);
@@ -47,5 +45,28 @@ int PLUGIN_CALL plugin_get_api(PluginApi* outApi)
 
     outApi->abi_check_compat = &abi_check_impl;
 
+    // ABI 1.1
+    outApi->stl_set_allocator = &stl_core_set_allocator;
+    outApi->stl_push_n = &stl_core_push_n;
+    outApi->stl_view_values = &stl_core_view_values;
+    outApi->stl_alloc_values = &stl_core_alloc_values;
+    outApi->stl_release = &stl_core_release;
+}
+
+// 1.0 ȣƮ 1.0 ũ PluginApi  ѱǷ  պκи ä
+extern "C" __declspec(dllexport)
+int PLUGIN_CALL plugin_get_api(PluginApi* outApi)
+{
+    return plugin_get_api_v(outApi, PLUGIN_API_V1_0_SIZE);
+}
+
+extern "C" __declspec(dllexport)
+int PLUGIN_CALL plugin_get_api_v(PluginApi* outApi, size_t outApiBytes)
+{
+    if (!outApi || outApiBytes < PLUGIN_API_V1_0_SIZE) return 0;
+
+    PluginApi api;
+    fill_plugin_api(&api);
+    std::memcpy(outApi, &api, outApiBytes < sizeof(api) ? outApiBytes : sizeof(api));
     return 1;
 }
@@ -33,7 +33,7 @@ typedef struct PluginApi
     int        (PLUGIN_CALL* stl_set_name)(StlHandle* h, const char* nameUtf8);
     int        (PLUGIN_CALL* stl_get_name)(StlHandle* h, char* outBuf, size_t outBufBytes, size_t* outRequiredBytes);
     char* (PLUGIN_CALL* stl_alloc_name)(StlHandle* h);
-    void       (PLUGIN_CALL* stl_free)(char* p);
+    void       (PLUGIN_CALL* stl_free)(char* p);          // deprecated: 1.1 host => stl_release(h, p)
     int        (PLUGIN_CALL* stl_push)(StlHandle* h, int v);
     size_t(PLUGIN_CALL* stl_count)(StlHandle* h);
     int        (PLUGIN_CALL* stl_get_values)(StlHandle* h, int* outArr, size_t outCount, size_t* outRequiredCount);
@@ -42,8 +42,18 @@ typedef struct PluginApi
     // ABI check helper
     int32_t(PLUGIN_CALL* abi_check_compat)(const AbiExpected* exp);
 
+    // --- ABI 1.1 (append only: 1.0 layout above must not change) ---
+    int        (PLUGIN_CALL* stl_set_allocator)(StlHandle* h, const StlAllocator* allocator);
+    int        (PLUGIN_CALL* stl_push_n)(StlHandle* h, const int* values, size_t count);
+    int        (PLUGIN_CALL* stl_view_values)(StlHandle* h, const int** outData, size_t* outCount);
+    int*       (PLUGIN_CALL* stl_alloc_values)(StlHandle* h, size_t* outCount);
+    void       (PLUGIN_CALL* stl_release)(StlHandle* h, void* p);
+
 } PluginApi;
 
+// 1.0 PluginApi size: plugin_get_api writes only this prefix (older hosts pass a 1.0-sized struct)
+#define PLUGIN_API_V1_0_SIZE offsetof(PluginApi, stl_set_allocator)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -51,6 +61,11 @@ extern "C" {
     __declspec(dllexport) int PLUGIN_CALL plugin_get_api(PluginApi* outApi);
     typedef int (PLUGIN_CALL* plugin_get_api_fn)(PluginApi* outApi);
 
+    // ABI 1.1+: fills min(outApiBytes, sizeof(PluginApi)) bytes, pass sizeof(PluginApi)
+    //   missing in a 1.0 plugin => fall back to plugin_get_api (1.1 pointers stay null)
+    __declspec(dllexport) int PLUGIN_CALL plugin_get_api_v(PluginApi* outApi, size_t outApiBytes);
+    typedef int (PLUGIN_CALL* plugin_get_api_v_fn)(PluginApi* outApi, size_t outApiBytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,356 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file portable.h
+/// @brief 비-Windows(Linux/macOS) 빌드용 Win32/MSVC 대체 구현 (header-only)
+///
+///   CMake가 Windows가 아닐 때만 Libs/Portable 을 include 경로 맨 앞에 추가한다.
+///   같은 디렉터리의 windows.h, tchar.h, conio.h, io.h, process.h, SDKDDKVer.h, xstring 은
+///   이 파일을 포함하기만 하는 대체 헤더 (Windows.h 는 CMake가 빌드 디렉터리에 생성)
+///
+///   - _tmain / _TCHAR / _T()
+///   - SAL 주석 (__out 등)         : 빈 매크로
+///   - __declspec(thread)          : thread_local
+///   - localtime_s / gmtime_s / _mkgmtime / _putenv(_s) / getenv_s / _get_timezone 등 CRT TZ 변수
+///   - strcpy_s / strtok_s / _itoa_s / _strdup / _fcvt
+///   - LocalAlloc / LocalFree / ExitProcess / GetLastError
+///   - Sleep / GetCurrentThreadId / _beginthreadex / _endthreadex / WaitForSingleObject / CloseHandle
+///   - TlsAlloc / TlsGetValue / TlsSetValue / TlsFree    : pthread_key_t
+///   - SRWLOCK                                           : pthread_rwlock_t
+///   - Interlocked*                                      : __atomic builtin (Win32와 같은 full barrier)
+///
+///   데모 코드가 실제로 쓰는 만큼만 구현한다. 의미가 다른 부분은 각 함수 주석 참고.
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(_WIN32)
+	#error "Libs/Portable is for non-Windows builds only"
+#endif
+
+// libstdc++ 헤더는 __out 등을 매개변수 이름으로 쓴다
+// => SAL 매크로를 정의하기 전에 해당 헤더들을 먼저 포함해 둔다(이후 재포함은 include guard로 무시됨)
+#include <algorithm>
+#include <memory>
+#include <iostream>
+#include <ostream>
+#include <sstream>
+#include <fstream>
+#include <locale>
+#include <regex>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <chrono>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+#include <wchar.h>
+
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__)
+	#include <sys/syscall.h>
+#endif
+
+
+//=============================================================================================
+// 진입점 / 문자 타입 (MBCS 기준: TCHAR == char)
+//=============================================================================================
+#define _tmain      main
+typedef char        _TCHAR;
+typedef char        TCHAR;
+#ifndef _T
+	#define _T(x)   x
+#endif
+
+//=============================================================================================
+// SAL / MSVC 키워드
+//=============================================================================================
+#define __in
+#define __out
+#define __inout
+#define __in_opt
+#define __out_opt
+
+#define __declspec(x)           __portable_declspec_##x
+#define __portable_declspec_thread      thread_local
+#define __portable_declspec_noinline    __attribute__((noinline))
+#define __portable_declspec_dllexport   __attribute__((visibility("default")))
+#define __portable_declspec_dllimport
+
+#define __stdcall
+#define __cdecl
+#define WINAPI
+#define CALLBACK
+
+//=============================================================================================
+// Win32 기본 타입
+//=============================================================================================
+typedef int             BOOL;
+typedef unsigned char   BYTE;
+typedef unsigned short  WORD;
+typedef uint32_t        DWORD;
+typedef int32_t         LONG;
+typedef uint32_t        ULONG;
+typedef int64_t         LONGLONG;
+typedef int64_t         LONG64;
+typedef uint32_t        UINT;
+typedef uint32_t        UINT32;
+typedef uint64_t        UINT64;
+typedef void*           LPVOID;
+typedef char*           LPSTR;
+typedef const char*     LPCSTR;
+typedef void*           HANDLE;
+typedef int             errno_t;
+
+#ifndef TRUE
+	#define TRUE  1
+	#define FALSE 0
+#endif
+
+#define INFINITE            0xFFFFFFFFu
+#define WAIT_OBJECT_0       0u
+#define WAIT_FAILED         0xFFFFFFFFu
+
+//=============================================================================================
+// 시간 / 환경 변수
+//=============================================================================================
+// MSVC: 인자 순서가 (결과, 입력), 성공 시 0
+inline errno_t localtime_s(struct tm* out, const time_t* t) { return localtime_r(t, out) ? 0 : EINVAL; }
+inline errno_t gmtime_s(struct tm* out, const time_t* t) { return gmtime_r(t, out) ? 0 : EINVAL; }
+inline time_t _mkgmtime(struct tm* t) { return timegm(t); }
+inline void _tzset() { tzset(); }
+
+inline errno_t _putenv_s(const char* name, const char* value) { return setenv(name, value, 1) == 0 ? 0 : errno; }
+
+inline errno_t getenv_s(size_t* required, char* buf, size_t size, const char* name)
+{
+	const char* v = getenv(name);
+	*required = v ? strlen(v) + 1 : 0;
+	if (!v || !buf) return 0;
+	if (size < *required) return ERANGE;
+	memcpy(buf, v, *required);
+	return 0;
+}
+
+#define _putenv     putenv
+#define _daylight   daylight
+#define _timezone   timezone
+#define _tzname     tzname
+
+inline errno_t _get_daylight(int* hours) { *hours = daylight; return 0; }
+inline errno_t _get_timezone(long* seconds) { *seconds = timezone; return 0; }
+
+inline errno_t _get_tzname(size_t* returned, char* buf, size_t size, int index)
+{
+	const char* name = tzname[index ? 1 : 0];
+	*returned = strlen(name) + 1;
+	if (!buf) return 0;
+	if (size < *returned) return ERANGE;
+	memcpy(buf, name, *returned);
+	return 0;
+}
+
+inline void Sleep(DWORD ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+//=============================================================================================
+// 보안 강화 문자열 함수 (_s)
+//=============================================================================================
+inline errno_t strcpy_s(char* dst, size_t size, const char* src)
+{
+	if (!dst || !src || size == 0) return EINVAL;
+	const size_t n = strlen(src);
+	if (n >= size) { dst[0] = '\0'; return ERANGE; }
+	memcpy(dst, src, n + 1);
+	return 0;
+}
+
+template<size_t N>
+inline errno_t strcpy_s(char (&dst)[N], const char* src) { return strcpy_s(dst, N, src); }
+
+inline char* strtok_s(char* str, const char* delimiters, char** context) { return strtok_r(str, delimiters, context); }
+
+inline errno_t _itoa_s(int value, char* buf, size_t size, int radix)
+{
+	if (!buf || size == 0 || radix < 2 || radix > 36) return EINVAL;
+
+	char tmp[40];
+	size_t n = 0;
+	const bool neg = (radix == 10 && value < 0);
+	unsigned int u = neg ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+	do {
+		const unsigned int d = u % radix;
+		tmp[n++] = static_cast<char>(d < 10 ? '0' + d : 'a' + d - 10);
+		u /= radix;
+	} while (u);
+	if (neg) tmp[n++] = '-';
+
+	if (n + 1 > size) { buf[0] = '\0'; return ERANGE; }
+	for (size_t i = 0; i < n; ++i) buf[i] = tmp[n - 1 - i];
+	buf[n] = '\0';
+	return 0;
+}
+
+template<size_t N>
+inline errno_t _itoa_s(int value, char (&buf)[N], int radix) { return _itoa_s(value, buf, N, radix); }
+
+#define _strdup     strdup
+#define _fcvt       fcvt
+#define _stricmp    strcasecmp
+#define _strnicmp   strncasecmp
+
+//=============================================================================================
+// 스레드 (_beginthreadex / WaitForSingleObject 최소 구현)
+//=============================================================================================
+inline DWORD GetCurrentThreadId()
+{
+#if defined(__linux__)
+	return static_cast<DWORD>(syscall(SYS_gettid));
+#else
+	uint64_t tid = 0;
+	pthread_threadid_np(nullptr, &tid);
+	return static_cast<DWORD>(tid);
+#endif
+}
+
+namespace Portable
+{
+	struct ThreadHandle
+	{
+		pthread_t thread;
+		unsigned (*start)(void*);
+		void* arg;
+	};
+
+	inline void* thread_trampoline(void* p)
+	{
+		ThreadHandle* h = static_cast<ThreadHandle*>(p);
+		return reinterpret_cast<void*>(static_cast<uintptr_t>(h->start(h->arg)));
+	}
+}
+
+// 반환값은 HANDLE로 캐스팅해서 쓴다 (CREATE_SUSPENDED 등 flags는 지원하지 않음)
+inline uintptr_t _beginthreadex(void*, unsigned, unsigned (*start)(void*), void* arg, unsigned, unsigned* thrdaddr)
+{
+	Portable::ThreadHandle* h = new Portable::ThreadHandle{ pthread_t(), start, arg };
+	if (pthread_create(&h->thread, nullptr, &Portable::thread_trampoline, h) != 0) {
+		delete h;
+		return 0;
+	}
+	if (thrdaddr) *thrdaddr = 0;
+	return reinterpret_cast<uintptr_t>(h);
+}
+
+inline void _endthreadex(unsigned code) { pthread_exit(reinterpret_cast<void*>(static_cast<uintptr_t>(code))); }
+
+// _beginthreadex 로 만든 HANDLE만 지원, timeout은 INFINITE만 지원
+inline DWORD WaitForSingleObject(HANDLE handle, DWORD)
+{
+	Portable::ThreadHandle* h = static_cast<Portable::ThreadHandle*>(handle);
+	return pthread_join(h->thread, nullptr) == 0 ? WAIT_OBJECT_0 : WAIT_FAILED;
+}
+
+inline BOOL CloseHandle(HANDLE handle)
+{
+	delete static_cast<Portable::ThreadHandle*>(handle);
+	return TRUE;
+}
+
+//=============================================================================================
+// 동적 TLS (TlsAlloc 계열)
+//=============================================================================================
+#define TLS_OUT_OF_INDEXES  0xFFFFFFFFu
+
+inline DWORD TlsAlloc()
+{
+	pthread_key_t key;
+	if (pthread_key_create(&key, nullptr) != 0) return TLS_OUT_OF_INDEXES;
+	return static_cast<DWORD>(key);
+}
+
+inline LPVOID TlsGetValue(DWORD index) { return pthread_getspecific(static_cast<pthread_key_t>(index)); }
+inline BOOL TlsSetValue(DWORD index, LPVOID value) { return pthread_setspecific(static_cast<pthread_key_t>(index), value) == 0; }
+inline BOOL TlsFree(DWORD index) { return pthread_key_delete(static_cast<pthread_key_t>(index)) == 0; }
+
+#define ERROR_SUCCESS   0
+#define LPTR            0x0040      // LMEM_FIXED | LMEM_ZEROINIT
+
+typedef void* HLOCAL;
+
+inline DWORD GetLastError() { return static_cast<DWORD>(errno); }
+inline void ExitProcess(UINT code) { exit(static_cast<int>(code)); }
+
+// LocalAlloc(LPTR, n) 만 사용 => 0으로 채운 힙 블록
+inline HLOCAL LocalAlloc(UINT, size_t bytes) { return calloc(1, bytes); }
+inline HLOCAL LocalFree(HLOCAL mem) { free(mem); return nullptr; }
+
+//=============================================================================================
+// SRWLOCK (pthread_rwlock_t, 재귀 불가는 동일)
+//=============================================================================================
+struct SRWLOCK
+{
+	pthread_rwlock_t lock;
+};
+typedef SRWLOCK* PSRWLOCK;
+
+#define SRWLOCK_INIT    { PTHREAD_RWLOCK_INITIALIZER }
+
+inline void InitializeSRWLock(PSRWLOCK l) { pthread_rwlock_init(&l->lock, nullptr); }
+inline void AcquireSRWLockExclusive(PSRWLOCK l) { pthread_rwlock_wrlock(&l->lock); }
+inline void ReleaseSRWLockExclusive(PSRWLOCK l) { pthread_rwlock_unlock(&l->lock); }
+inline void AcquireSRWLockShared(PSRWLOCK l) { pthread_rwlock_rdlock(&l->lock); }
+inline void ReleaseSRWLockShared(PSRWLOCK l) { pthread_rwlock_unlock(&l->lock); }
+inline BOOL TryAcquireSRWLockExclusive(PSRWLOCK l) { return pthread_rwlock_trywrlock(&l->lock) == 0; }
+inline BOOL TryAcquireSRWLockShared(PSRWLOCK l) { return pthread_rwlock_tryrdlock(&l->lock) == 0; }
+
+//=============================================================================================
+// Interlocked (반환값 규칙은 Win32와 같음: Increment/Decrement는 새 값, 나머지는 이전 값)
+//   Win32의 LONG은 항상 32-bit지만 데모 코드가 volatile long 을 넘기기도 하므로(LP64에서 64-bit)
+//   정수 타입을 그대로 받는 template으로 둔다. 64 접미사 버전도 같은 구현.
+//=============================================================================================
+template<typename T>
+inline T InterlockedIncrement(T volatile* p) { return __atomic_add_fetch(p, 1, __ATOMIC_SEQ_CST); }
+
+template<typename T>
+inline T InterlockedDecrement(T volatile* p) { return __atomic_sub_fetch(p, 1, __ATOMIC_SEQ_CST); }
+
+template<typename T, typename U>
+inline T InterlockedExchange(T volatile* p, U v) { return __atomic_exchange_n(p, static_cast<T>(v), __ATOMIC_SEQ_CST); }
+
+template<typename T, typename U>
+inline T InterlockedExchangeAdd(T volatile* p, U v) { return __atomic_fetch_add(p, static_cast<T>(v), __ATOMIC_SEQ_CST); }
+
+template<typename T, typename U, typename V>
+inline T InterlockedCompareExchange(T volatile* p, U exchange, V comparand)
+{
+	T expected = static_cast<T>(comparand);
+	__atomic_compare_exchange_n(p, &expected, static_cast<T>(exchange), false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return expected;
+}
+
+#define InterlockedIncrement64          InterlockedIncrement
+#define InterlockedDecrement64          InterlockedDecrement
+#define InterlockedExchange64           InterlockedExchange
+#define InterlockedExchangeAdd64        InterlockedExchangeAdd
+#define InterlockedCompareExchange64    InterlockedCompareExchange
+
+inline void* InterlockedExchangePointer(void* volatile* p, void* v) { return __atomic_exchange_n(p, v, __ATOMIC_SEQ_CST); }
+
+inline void* InterlockedCompareExchangePointer(void* volatile* p, void* exchange, void* comparand)
+{
+	__atomic_compare_exchange_n(p, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+}
+
+inline void MemoryBarrier() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+//=============================================================================================
+// conio
+//=============================================================================================
+inline int _getch() { return getchar(); }
@@ -0,0 +1,4 @@
+﻿#pragma once
+
+// 비-Windows 빌드용 대체 헤더 (portable.h 참고)
+#include "portable.h"
@@ -10,7 +10,7 @@
 
 // ABI 메이저/마이너: 구조가 깨지면 major 올리고, 확장은 minor로
 #define ABI_MAJOR 1
-#define ABI_MINOR 0
+#define ABI_MINOR 1     // 1.1 : stl_core batch/zero-copy (push_n, view_values, alloc_values, StlAllocator)
 
 // CRT/빌드 플래그를 비트로 기록 (런타임에서 서로 비교 가능)
 enum AbiCrtFlags : uint32_t
@@ -0,0 +1,129 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file backoff.h
+/// @brief CAS 재시도 경합 완화 (header-only, C++14)
+///
+///   - detail::cpu_relax()  : spin 루프용 pause/yield 명령
+///   - detail::fast_rand()  : 스레드별 xorshift 난수 (backoff 지터, elimination slot 선택)
+///   - NoBackoff            : 실패 즉시 재시도 (기존 동작)
+///   - ExponentialBackoff   : 실패할 때마다 [1, limit] 범위 임의 횟수 spin, limit은 2배씩(상한 MaxSpins)
+///                            상한에 도달하면 yield 로 CPU를 양보(스레드 수 > 코어 수일 때)
+///   - make_cache_aligned<T>() : alignas(CacheLineSize) 멤버를 가진 큐/스택의 heap 할당 (CacheAlignedPtr<T>)
+///
+///   실패한 compare_exchange 직후 같은 cache line을 바로 다시 두드리지 않게 해서
+///   경합 구간의 cache line 핑퐁을 줄인다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+#endif
+
+
+namespace LockFree
+{
+	static const size_t CacheLineSize = 64;     // false sharing 방지용 정렬 단위
+
+	namespace detail
+	{
+		inline void cpu_relax()
+		{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__)
+			__asm__ __volatile__("yield");
+#else
+			std::this_thread::yield();
+#endif
+		}
+
+		inline uint32_t fast_rand()
+		{
+			static thread_local uint32_t state = 0;
+			if (0 == state) state = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&state) >> 4) | 1;
+
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+	}
+
+	struct NoBackoff
+	{
+		void pause() {}
+		void reset() {}
+	};
+
+	class ExponentialBackoff
+	{
+	public:
+		static const uint32_t MinSpins = 4;
+		static const uint32_t MaxSpins = 1024;
+
+		void pause()
+		{
+			if (_limit >= MaxSpins) {
+				std::this_thread::yield();
+			}
+
+			const uint32_t spins = 1 + detail::fast_rand() % _limit;
+			for (uint32_t i = 0; i < spins; ++i) detail::cpu_relax();
+
+			if (_limit < MaxSpins) _limit <<= 1;
+		}
+
+		void reset() { _limit = MinSpins; }
+
+	private:
+		uint32_t _limit = MinSpins;
+	};
+
+	//=============================================================================================
+	// cache line 정렬 타입의 heap 할당
+	//   C++14 의 new 는 alignof(std::max_align_t) 까지만 맞춰 준다 (GCC -Waligned-new, MSVC C4316)
+	//   line 하나 + 포인터 하나를 더 잡아 line 경계로 올리고, 원래 주소는 객체 바로 앞 word 에 둔다
+	//=============================================================================================
+	template<typename T>
+	struct CacheAlignedDelete
+	{
+		void operator()(T* p) const noexcept
+		{
+			if (!p) return;
+			void* raw = reinterpret_cast<void**>(p)[-1];
+			p->~T();
+			::operator delete(raw);
+		}
+	};
+
+	template<typename T>
+	using CacheAlignedPtr = std::unique_ptr<T, CacheAlignedDelete<T>>;
+
+	template<typename T, typename... Args>
+	CacheAlignedPtr<T> make_cache_aligned(Args&&... args)
+	{
+		static_assert(alignof(T) <= CacheLineSize, "make_cache_aligned: T is aligned beyond a cache line");
+
+		void* raw = ::operator new(sizeof(T) + sizeof(void*) + CacheLineSize - 1);
+		const uintptr_t at = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + CacheLineSize - 1) & ~static_cast<uintptr_t>(CacheLineSize - 1);
+		reinterpret_cast<void**>(at)[-1] = raw;
+
+		try {
+			return CacheAlignedPtr<T>(::new (reinterpret_cast<void*>(at)) T(std::forward<Args>(args)...));
+		}
+		catch (...) {
+			::operator delete(raw);
+			throw;
+		}
+	}
+}//LockFree
@@ -0,0 +1,596 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file byte_order.h
+/// @brief byte order 변환 (constexpr swap, SIMD 대량 swap, 고정 레이아웃 직렬화) (header-only, C++14)
+///
+///   Endian::Order          : C++20 이면 std::endian, 아니면 같은 이름(little / big / native)의 enum
+///   Endian::byteswap(v)    : constexpr (GCC/Clang 은 __builtin_bswap, 그 외는 shift => 컴파일러가 bswap 한 개로 만든다)
+///   to_big / from_big / to_little / from_little (v)
+///     - native 와 같은 order 면 그대로 (컴파일 시간에 결정)
+///
+///   대량 변환 : byteswap(in, out, n) / to_big(in, out, n) ... (uint16_t / uint32_t / uint64_t 배열, in == out 가능)
+///     kernel (실행 시점에 한 번 고르고, set_kernel 로 바꿀 수 있음)
+///       Avx2 / Ssse3 : x86 pshufb (GCC/Clang 은 target attribute, MSVC 는 그대로) => 빌드 옵션 필요 없음
+///       Neon         : AArch64 vrev16/32/64
+///       Scalar       : 원소마다 byteswap (htonl 한 번씩과 같음)
+///     정렬은 요구하지 않는다 (unaligned load/store)
+///
+///   고정 레이아웃 record 직렬화 : BigEndianWriter / BigEndianReader (LittleEndian* 도 있음)
+///     - 호출자 buffer(void*, size 또는 C++20 std::span<std::byte>) 위에서 바로 읽고 쓴다 (복사본/할당 없음)
+///     - write(v) / read(v) 는 정수, enum, float/double 을 지정 order 로 (연쇄 호출 가능)
+///     - write(values, n) / read(values, n) 은 배열을 대량 변환 kernel 로
+///     - 공간이 모자라면 그 호출부터 아무것도 하지 않고 ok() == false (예외 없음, 마지막에 한 번 확인)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSVC_LANG)
+#define BYTE_ORDER_CPLUSPLUS _MSVC_LANG
+#else
+#define BYTE_ORDER_CPLUSPLUS __cplusplus
+#endif
+
+#if BYTE_ORDER_CPLUSPLUS >= 202002L && defined(__has_include)
+#if __has_include(<bit>) && __has_include(<span>)
+#include <bit>
+#include <span>
+#endif
+#endif
+
+#if !defined(BYTE_ORDER_HAS_STD_ENDIAN)
+#if defined(__cpp_lib_endian)
+#define BYTE_ORDER_HAS_STD_ENDIAN 1
+#else
+#define BYTE_ORDER_HAS_STD_ENDIAN 0
+#endif
+#endif
+
+#if !defined(BYTE_ORDER_HAS_STD_SPAN)
+#if defined(__cpp_lib_span)
+#define BYTE_ORDER_HAS_STD_SPAN 1
+#else
+#define BYTE_ORDER_HAS_STD_SPAN 0
+#endif
+#endif
+
+#if !defined(BYTE_ORDER_HAS_X86)
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BYTE_ORDER_HAS_X86 1
+#else
+#define BYTE_ORDER_HAS_X86 0
+#endif
+#endif
+
+#if !defined(BYTE_ORDER_HAS_NEON)
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define BYTE_ORDER_HAS_NEON 1
+#else
+#define BYTE_ORDER_HAS_NEON 0
+#endif
+#endif
+
+#if BYTE_ORDER_HAS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BYTE_ORDER_TARGET_SSSE3
+#define BYTE_ORDER_TARGET_AVX2
+#else
+#define BYTE_ORDER_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define BYTE_ORDER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if BYTE_ORDER_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+
+namespace Endian
+{
+#if BYTE_ORDER_HAS_STD_ENDIAN
+	using Order = std::endian;
+#else
+	enum class Order
+	{
+		little = 0,
+		big = 1,
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		native = big,
+#else
+		native = little,        // MSVC 대상(x86/x64/ARM/ARM64 Windows)은 모두 little
+#endif
+	};
+#endif
+
+	enum class Kernel { Scalar, Ssse3, Avx2, Neon };
+
+	//=============================================================================================
+	// constexpr swap
+	//=============================================================================================
+	namespace detail
+	{
+		constexpr uint16_t bswap16(uint16_t v) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_bswap16(v);
+#else
+			return static_cast<uint16_t>((v >> 8) | (v << 8));
+#endif
+		}
+
+		constexpr uint32_t bswap32(uint32_t v) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_bswap32(v);
+#else
+			return (v >> 24) | ((v >> 8) & 0x0000FF00u) | ((v << 8) & 0x00FF0000u) | (v << 24);
+#endif
+		}
+
+		constexpr uint64_t bswap64(uint64_t v) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_bswap64(v);
+#else
+			return (static_cast<uint64_t>(bswap32(static_cast<uint32_t>(v))) << 32) | bswap32(static_cast<uint32_t>(v >> 32));
+#endif
+		}
+
+		// 크기별 부호 없는 표현
+		template<size_t Size> struct Bits;
+		template<> struct Bits<1> { typedef uint8_t type; static constexpr uint8_t swap(uint8_t v) noexcept { return v; } };
+		template<> struct Bits<2> { typedef uint16_t type; static constexpr uint16_t swap(uint16_t v) noexcept { return bswap16(v); } };
+		template<> struct Bits<4> { typedef uint32_t type; static constexpr uint32_t swap(uint32_t v) noexcept { return bswap32(v); } };
+		template<> struct Bits<8> { typedef uint64_t type; static constexpr uint64_t swap(uint64_t v) noexcept { return bswap64(v); } };
+
+		template<typename T>
+		using EnableIfInteger = typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type;
+	}
+
+	template<typename T, detail::EnableIfInteger<T> = 0>
+	constexpr T byteswap(T v) noexcept
+	{
+		typedef detail::Bits<sizeof(T)> B;
+		return static_cast<T>(B::swap(static_cast<typename B::type>(v)));
+	}
+
+	template<Order O, typename T, detail::EnableIfInteger<T> = 0>
+	constexpr T convert(T v) noexcept { return Order::native == O ? v : byteswap(v); }
+
+	template<typename T> constexpr T to_big(T v) noexcept { return convert<Order::big>(v); }
+	template<typename T> constexpr T from_big(T v) noexcept { return convert<Order::big>(v); }
+	template<typename T> constexpr T to_little(T v) noexcept { return convert<Order::little>(v); }
+	template<typename T> constexpr T from_little(T v) noexcept { return convert<Order::little>(v); }
+
+	namespace detail
+	{
+		//-----------------------------------------------------------------------------------------
+		// 대량 swap : 원소 크기(Size) 단위로 in[0..bytes) => out, 처리한 byte 수 반환 (나머지는 scalar)
+		//-----------------------------------------------------------------------------------------
+		template<size_t Size>
+		inline void swap_scalar(const uint8_t* in, uint8_t* out, size_t count) noexcept
+		{
+			typedef typename Bits<Size>::type U;
+			for (size_t i = 0; i < count; ++i) {
+				U v;
+				std::memcpy(&v, in + i * Size, Size);
+				v = Bits<Size>::swap(v);
+				std::memcpy(out + i * Size, &v, Size);
+			}
+		}
+
+#if BYTE_ORDER_HAS_X86
+		struct Ssse3
+		{
+			BYTE_ORDER_TARGET_SSSE3 static __m128i mask(size_t size) noexcept
+			{
+				switch (size) {
+				case 2: return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+				case 4: return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+				default: return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+				}
+			}
+
+			template<size_t Size>
+			BYTE_ORDER_TARGET_SSSE3 static size_t swap(const uint8_t* in, uint8_t* out, size_t bytes) noexcept
+			{
+				const __m128i m = mask(Size);
+				size_t i = 0;
+				for (; bytes - i >= 64; i += 64) {
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16));
+					const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 32));
+					const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 48));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(a, m));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 16), _mm_shuffle_epi8(b, m));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 32), _mm_shuffle_epi8(c, m));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 48), _mm_shuffle_epi8(d, m));
+				}
+				for (; bytes - i >= 16; i += 16) {
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(a, m));
+				}
+				return i;
+			}
+		};
+
+		struct Avx2
+		{
+			template<size_t Size>
+			BYTE_ORDER_TARGET_AVX2 static size_t swap(const uint8_t* in, uint8_t* out, size_t bytes) noexcept
+			{
+				const __m256i m = _mm256_broadcastsi128_si256(Ssse3::mask(Size));      // vpshufb 는 128-bit lane 안에서만 섞는다
+				size_t i = 0;
+				for (; bytes - i >= 128; i += 128) {
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+					const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32));
+					const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 64));
+					const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 96));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(a, m));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 32), _mm256_shuffle_epi8(b, m));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 64), _mm256_shuffle_epi8(c, m));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 96), _mm256_shuffle_epi8(d, m));
+				}
+				for (; bytes - i >= 32; i += 32) {
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(a, m));
+				}
+				return i;
+			}
+		};
+#endif // BYTE_ORDER_HAS_X86
+
+#if BYTE_ORDER_HAS_NEON
+		struct Neon
+		{
+			static uint8x16_t rev(uint8x16_t v, size_t size) noexcept
+			{
+				return 2 == size ? vrev16q_u8(v) : 4 == size ? vrev32q_u8(v) : vrev64q_u8(v);
+			}
+
+			template<size_t Size>
+			static size_t swap(const uint8_t* in, uint8_t* out, size_t bytes) noexcept
+			{
+				size_t i = 0;
+				for (; bytes - i >= 64; i += 64) {
+					const uint8x16x4_t v = vld1q_u8_x4(in + i);
+					uint8x16x4_t r;
+					r.val[0] = rev(v.val[0], Size);
+					r.val[1] = rev(v.val[1], Size);
+					r.val[2] = rev(v.val[2], Size);
+					r.val[3] = rev(v.val[3], Size);
+					vst1q_u8_x4(out + i, r);
+				}
+				for (; bytes - i >= 16; i += 16) {
+					vst1q_u8(out + i, rev(vld1q_u8(in + i), Size));
+				}
+				return i;
+			}
+		};
+#endif // BYTE_ORDER_HAS_NEON
+
+		//=========================================================================================
+		// kernel 선택
+		//=========================================================================================
+		inline Kernel detect_kernel() noexcept
+		{
+#if BYTE_ORDER_HAS_NEON
+			return Kernel::Neon;
+#elif BYTE_ORDER_HAS_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+			int r[4];
+			__cpuid(r, 0);
+			const int maxLeaf = r[0];
+			__cpuid(r, 1);
+			const bool ssse3 = 0 != (r[2] & (1 << 9));
+			const bool osxsave = 0 != (r[2] & (1 << 27));
+			const bool avx = 0 != (r[2] & (1 << 28));
+			bool avx2 = false;
+			if (maxLeaf >= 7 && osxsave && avx && 6 == (_xgetbv(0) & 6)) {     // OS 가 ymm 상태를 저장하는지
+				__cpuidex(r, 7, 0);
+				avx2 = 0 != (r[1] & (1 << 5));
+			}
+#else
+			__builtin_cpu_init();
+			const bool ssse3 = 0 != __builtin_cpu_supports("ssse3");
+			const bool avx2 = 0 != __builtin_cpu_supports("avx2");
+#endif
+			return avx2 ? Kernel::Avx2 : ssse3 ? Kernel::Ssse3 : Kernel::Scalar;
+#else
+			return Kernel::Scalar;
+#endif
+		}
+
+		inline std::atomic<int>& kernel_slot() noexcept
+		{
+			static std::atomic<int> slot(static_cast<int>(detect_kernel()));
+			return slot;
+		}
+	}
+
+	//=============================================================================================
+	// kernel
+	//=============================================================================================
+	inline Kernel best_kernel() noexcept
+	{
+		static const Kernel best = detail::detect_kernel();
+		return best;
+	}
+
+	inline Kernel active_kernel() noexcept { return static_cast<Kernel>(detail::kernel_slot().load(std::memory_order_relaxed)); }
+
+	inline bool is_supported(Kernel k) noexcept
+	{
+		const Kernel best = best_kernel();
+		return Kernel::Scalar == k || best == k || (Kernel::Ssse3 == k && Kernel::Avx2 == best);
+	}
+
+	// benchmark / 비교용. 지원하지 않는 kernel 이면 false (바꾸지 않음)
+	inline bool set_kernel(Kernel k) noexcept
+	{
+		if (!is_supported(k)) return false;
+		detail::kernel_slot().store(static_cast<int>(k), std::memory_order_relaxed);
+		return true;
+	}
+
+	inline const char* kernel_name(Kernel k) noexcept
+	{
+		switch (k) {
+		case Kernel::Scalar: return "scalar";
+		case Kernel::Ssse3: return "ssse3";
+		case Kernel::Avx2: return "avx2";
+		case Kernel::Neon: return "neon";
+		}
+		return "unknown";
+	}
+
+	namespace detail
+	{
+		// 원소 count 개(크기 Size)를 swap, in == out 가능
+		template<size_t Size>
+		inline void swap_bulk(const uint8_t* in, uint8_t* out, size_t count) noexcept
+		{
+			const size_t bytes = count * Size;
+			size_t done = 0;
+			switch (active_kernel()) {
+#if BYTE_ORDER_HAS_X86
+			case Kernel::Avx2: done = Avx2::swap<Size>(in, out, bytes); break;
+			case Kernel::Ssse3: done = Ssse3::swap<Size>(in, out, bytes); break;
+#endif
+#if BYTE_ORDER_HAS_NEON
+			case Kernel::Neon: done = Neon::swap<Size>(in, out, bytes); break;
+#endif
+			default: break;
+			}
+			swap_scalar<Size>(in + done, out + done, (bytes - done) / Size);
+		}
+
+		template<Order O, size_t Size>
+		inline void convert_bulk(const uint8_t* in, uint8_t* out, size_t count) noexcept
+		{
+			if (Order::native == O || 1 == Size) {
+				if (in != out) std::memmove(out, in, count * Size);
+				return;
+			}
+			swap_bulk<Size>(in, out, count);
+		}
+
+		template<typename T>
+		using EnableIfWide = typename std::enable_if<std::is_integral<T>::value && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8), int>::type;
+	}
+
+	//=============================================================================================
+	// 대량 변환 (uint16_t / uint32_t / uint64_t 와 같은 크기의 정수 배열)
+	//=============================================================================================
+	template<typename T, detail::EnableIfWide<T> = 0>
+	inline void byteswap(const T* in, T* out, size_t n) noexcept
+	{
+		detail::swap_bulk<sizeof(T)>(reinterpret_cast<const uint8_t*>(in), reinterpret_cast<uint8_t*>(out), n);
+	}
+
+	template<typename T, detail::EnableIfWide<T> = 0>
+	inline void byteswap(T* data, size_t n) noexcept { byteswap(data, data, n); }
+
+	template<Order O, typename T, detail::EnableIfWide<T> = 0>
+	inline void convert(const T* in, T* out, size_t n) noexcept
+	{
+		detail::convert_bulk<O, sizeof(T)>(reinterpret_cast<const uint8_t*>(in), reinterpret_cast<uint8_t*>(out), n);
+	}
+
+	template<typename T> inline void to_big(const T* in, T* out, size_t n) noexcept { convert<Order::big>(in, out, n); }
+	template<typename T> inline void from_big(const T* in, T* out, size_t n) noexcept { convert<Order::big>(in, out, n); }
+	template<typename T> inline void to_little(const T* in, T* out, size_t n) noexcept { convert<Order::little>(in, out, n); }
+	template<typename T> inline void from_little(const T* in, T* out, size_t n) noexcept { convert<Order::little>(in, out, n); }
+
+	namespace detail
+	{
+		// 정수 / enum / float / double => 같은 크기의 부호 없는 정수 bit
+		template<typename T>
+		using EnableIfField = typename std::enable_if<(std::is_arithmetic<T>::value || std::is_enum<T>::value) && !std::is_same<T, bool>::value
+			&& (1 == sizeof(T) || 2 == sizeof(T) || 4 == sizeof(T) || 8 == sizeof(T)), int>::type;
+
+		template<Order O, typename T>
+		inline void store(uint8_t* p, T v) noexcept
+		{
+			typedef Bits<sizeof(T)> B;
+			typename B::type u;
+			std::memcpy(&u, &v, sizeof(u));
+			u = Order::native == O ? u : B::swap(u);
+			std::memcpy(p, &u, sizeof(u));
+		}
+
+		template<Order O, typename T>
+		inline T load(const uint8_t* p) noexcept
+		{
+			typedef Bits<sizeof(T)> B;
+			typename B::type u;
+			std::memcpy(&u, p, sizeof(u));
+			u = Order::native == O ? u : B::swap(u);
+			T v;
+			std::memcpy(&v, &u, sizeof(v));
+			return v;
+		}
+	}
+
+	//=============================================================================================
+	// 호출자 buffer 위의 직렬화 (zero-copy)
+	//=============================================================================================
+	template<Order O>
+	class Writer
+	{
+	public:
+		Writer(void* data, size_t size) noexcept : _data(static_cast<uint8_t*>(data)), _size(size) {}
+#if BYTE_ORDER_HAS_STD_SPAN
+		explicit Writer(std::span<std::byte> bytes) noexcept : Writer(bytes.data(), bytes.size()) {}
+#endif
+
+		template<typename T, detail::EnableIfField<T> = 0>
+		Writer& write(T v) noexcept
+		{
+			if (uint8_t* p = reserve(sizeof(T))) detail::store<O>(p, v);
+			return *this;
+		}
+
+		Writer& write(bool v) noexcept { return write(static_cast<uint8_t>(v ? 1 : 0)); }
+
+		template<typename T, detail::EnableIfField<T> = 0>
+		Writer& write(const T* values, size_t n) noexcept
+		{
+			if (n > _size / sizeof(T)) {        // n * sizeof(T) overflow
+				_ok = false;
+				return *this;
+			}
+			if (uint8_t* p = reserve(n * sizeof(T))) {
+				detail::convert_bulk<O, sizeof(T)>(reinterpret_cast<const uint8_t*>(values), p, n);
+			}
+			return *this;
+		}
+
+		Writer& write_bytes(const void* bytes, size_t n) noexcept
+		{
+			if (uint8_t* p = reserve(n)) std::memcpy(p, bytes, n);
+			return *this;
+		}
+
+		// padding (0 으로 채움)
+		Writer& skip(size_t n) noexcept
+		{
+			if (uint8_t* p = reserve(n)) std::memset(p, 0, n);
+			return *this;
+		}
+
+		// 다음 n byte 를 직접 채울 자리 (공간이 없으면 nullptr, 이후 호출은 모두 무시)
+		uint8_t* reserve(size_t n) noexcept
+		{
+			if (!_ok || n > _size - _pos) {
+				_ok = false;
+				return nullptr;
+			}
+			uint8_t* p = _data + _pos;
+			_pos += n;
+			return p;
+		}
+
+		bool ok() const noexcept { return _ok; }
+		size_t position() const noexcept { return _pos; }
+		size_t remaining() const noexcept { return _size - _pos; }
+		const uint8_t* data() const noexcept { return _data; }
+
+	private:
+		uint8_t* _data;
+		size_t _size;
+		size_t _pos = 0;
+		bool _ok = true;
+	};
+
+	template<Order O>
+	class Reader
+	{
+	public:
+		Reader(const void* data, size_t size) noexcept : _data(static_cast<const uint8_t*>(data)), _size(size) {}
+#if BYTE_ORDER_HAS_STD_SPAN
+		explicit Reader(std::span<const std::byte> bytes) noexcept : Reader(bytes.data(), bytes.size()) {}
+#endif
+
+		// 실패하면 v 는 그대로 두고 ok() == false
+		template<typename T, detail::EnableIfField<T> = 0>
+		Reader& read(T& v) noexcept
+		{
+			if (const uint8_t* p = view(sizeof(T))) v = detail::load<O, T>(p);
+			return *this;
+		}
+
+		Reader& read(bool& v) noexcept
+		{
+			if (const uint8_t* p = view(1)) v = 0 != *p;
+			return *this;
+		}
+
+		// 실패하면 T{}
+		template<typename T, detail::EnableIfField<T> = 0>
+		T get() noexcept
+		{
+			T v{};
+			read(v);
+			return v;
+		}
+
+		template<typename T, detail::EnableIfField<T> = 0>
+		Reader& read(T* values, size_t n) noexcept
+		{
+			if (n > _size / sizeof(T)) {
+				_ok = false;
+				return *this;
+			}
+			if (const uint8_t* p = view(n * sizeof(T))) {
+				detail::convert_bulk<O, sizeof(T)>(p, reinterpret_cast<uint8_t*>(values), n);
+			}
+			return *this;
+		}
+
+		Reader& read_bytes(void* bytes, size_t n) noexcept
+		{
+			if (const uint8_t* p = view(n)) std::memcpy(bytes, p, n);
+			return *this;
+		}
+
+		Reader& skip(size_t n) noexcept
+		{
+			view(n);
+			return *this;
+		}
+
+		// 다음 n byte 를 복사 없이 (공간이 없으면 nullptr, 이후 호출은 모두 무시)
+		const uint8_t* view(size_t n) noexcept
+		{
+			if (!_ok || n > _size - _pos) {
+				_ok = false;
+				return nullptr;
+			}
+			const uint8_t* p = _data + _pos;
+			_pos += n;
+			return p;
+		}
+
+		bool ok() const noexcept { return _ok; }
+		size_t position() const noexcept { return _pos; }
+		size_t remaining() const noexcept { return _size - _pos; }
+
+	private:
+		const uint8_t* _data;
+		size_t _size;
+		size_t _pos = 0;
+		bool _ok = true;
+	};
+
+	typedef Writer<Order::big> BigEndianWriter;
+	typedef Reader<Order::big> BigEndianReader;
+	typedef Writer<Order::little> LittleEndianWriter;
+	typedef Reader<Order::little> LittleEndianReader;
+}//Endian
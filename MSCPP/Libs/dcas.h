@@ -0,0 +1,299 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file dcas.h
+/// @brief 이식 가능한 128-bit DCAS(double-width CAS)와 tagged pointer head (header-only, C++14)
+///
+///   std::atomic<{T*, uint64_t}>는 대상 CPU 옵션(-mcx16 등)이 없으면 libatomic/CRT 내부 lock으로
+///   조용히 바뀐다(is_lock_free() == false). lock-free 자료구조의 head로 쓰면 의미가 없어진다.
+///
+///   DWord / dwcas()           : 16-byte 정렬 2-word CAS
+///     - MSVC x64              : _InterlockedCompareExchange128
+///     - GCC/Clang x86-64      : inline lock cmpxchg16b
+///     - GCC/Clang ARM64 + LSE : inline caspal
+///     - GCC/Clang ARM64       : ldaxp/stlxp 재시도 루프
+///     - 그 외                 : LOCKFREE_HAS_DWCAS == 0
+///
+///   TaggedPtr<Node>           : {Node* ptr, uint64_t tag}
+///   DwcasTaggedHead<Node>     : DWord 위의 tagged head (tag 64-bit)
+///   PackedTaggedHead<Node>    : 64-bit 하나에 포인터(하위 48-bit) + tag(상위 16-bit), 32-bit 환경은 32/32
+///   LockedTaggedHead<Node>    : std::atomic<TaggedPtr<Node>> 그대로 (비교용, 대개 lock 사용)
+///   TaggedHead<Node>          : DWCAS가 있으면 DwcasTaggedHead, 없으면 PackedTaggedHead
+///
+///   모든 head는 is_always_lock_free 를 컴파일 타임 상수로 제공 (C++17 std::atomic::is_always_lock_free 대응)
+///   PackedTaggedHead의 16-bit tag는 65536번마다 한 바퀴 돈다. ABA 방지는 reclamation.h와 함께 쓸 것.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include <atomic>
+
+// -DLOCKFREE_HAS_DWCAS=0 으로 packed fallback을 강제할 수 있음
+#if !defined(LOCKFREE_HAS_DWCAS)
+	#if defined(_MSC_VER) && defined(_M_X64)
+		#define LOCKFREE_HAS_DWCAS 1
+	#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+		#define LOCKFREE_HAS_DWCAS 1
+	#else
+		#define LOCKFREE_HAS_DWCAS 0
+	#endif
+#endif
+
+#if LOCKFREE_HAS_DWCAS && defined(_MSC_VER)
+	#include <intrin.h>
+	#pragma intrinsic(_InterlockedCompareExchange128)
+#endif
+
+
+namespace LockFree
+{
+	struct alignas(16) DWord
+	{
+		uint64_t lo;
+		uint64_t hi;
+
+		bool operator==(const DWord& rhs) const { return lo == rhs.lo && hi == rhs.hi; }
+		bool operator!=(const DWord& rhs) const { return !(*this == rhs); }
+	};
+	static_assert(sizeof(DWord) == 16, "DWord must be 16 bytes");
+
+#if LOCKFREE_HAS_DWCAS
+	// *dst == expected 이면 desired로 교체하고 true, 아니면 expected에 현재값을 담고 false (seq_cst)
+	inline bool dwcas(DWord* dst, DWord& expected, const DWord& desired)
+	{
+	#if defined(_MSC_VER)
+		return 0 != _InterlockedCompareExchange128(reinterpret_cast<volatile long long*>(dst),
+			static_cast<long long>(desired.hi), static_cast<long long>(desired.lo),
+			reinterpret_cast<long long*>(&expected));
+	#elif defined(__x86_64__)
+		bool ok;
+		__asm__ __volatile__(
+			"lock cmpxchg16b %1\n\t"
+			"sete %0"
+			: "=q"(ok), "+m"(*dst), "+a"(expected.lo), "+d"(expected.hi)
+			: "b"(desired.lo), "c"(desired.hi)
+			: "cc", "memory");
+		return ok;
+	#elif defined(__ARM_FEATURE_ATOMICS)
+		// ARMv8.1 LSE: casp 계열은 연속한 짝수/홀수 레지스터 쌍이 필요
+		register uint64_t x0 __asm__("x0") = expected.lo;
+		register uint64_t x1 __asm__("x1") = expected.hi;
+		register uint64_t x2 __asm__("x2") = desired.lo;
+		register uint64_t x3 __asm__("x3") = desired.hi;
+		__asm__ __volatile__(
+			"caspal x0, x1, x2, x3, [%[p]]"
+			: "+r"(x0), "+r"(x1)
+			: "r"(x2), "r"(x3), [p] "r"(dst)
+			: "memory");
+		const bool ok = (x0 == expected.lo && x1 == expected.hi);
+		expected.lo = x0;
+		expected.hi = x1;
+		return ok;
+	#else
+		// ARMv8.0: exclusive pair load/store
+		uint64_t lo, hi;
+		uint32_t failed;
+		do {
+			__asm__ __volatile__("ldaxp %0, %1, [%2]" : "=&r"(lo), "=&r"(hi) : "r"(dst) : "memory");
+			if (lo != expected.lo || hi != expected.hi) {
+				__asm__ __volatile__("clrex" ::: "memory");
+				expected.lo = lo;
+				expected.hi = hi;
+				return false;
+			}
+			__asm__ __volatile__("stlxp %w0, %2, %3, [%1]"
+				: "=&r"(failed) : "r"(dst), "r"(desired.lo), "r"(desired.hi) : "memory");
+		} while (failed);
+		return true;
+	#endif
+	}
+
+	// 128-bit를 한 번에 읽는 명령이 없으므로 같은 값으로 CAS 해서 읽는다(쓰기 권한 필요)
+	inline DWord dwload(DWord* src)
+	{
+		DWord v = { 0, 0 };
+		dwcas(src, v, v);
+		return v;
+	}
+#endif
+
+	//=============================================================================================
+	// tagged pointer head
+	//=============================================================================================
+	template<typename Node>
+	struct TaggedPtr
+	{
+		Node* ptr;
+		uint64_t tag;   // 버전/세대
+
+		bool operator==(const TaggedPtr& rhs) const { return ptr == rhs.ptr && tag == rhs.tag; }
+		bool operator!=(const TaggedPtr& rhs) const { return !(*this == rhs); }
+	};
+
+#if LOCKFREE_HAS_DWCAS
+	template<typename Node>
+	class DwcasTaggedHead
+	{
+	public:
+		static constexpr bool is_always_lock_free = true;
+		static const char* name() { return "dwcas"; }
+
+		explicit DwcasTaggedHead(TaggedPtr<Node> init = TaggedPtr<Node>{ nullptr, 0 }) : _v(pack(init)) {}
+
+		bool is_lock_free() const { return true; }
+
+		TaggedPtr<Node> load(std::memory_order = std::memory_order_seq_cst) const
+		{
+			return unpack(dwload(&_v));
+		}
+
+		void store(TaggedPtr<Node> desired, std::memory_order = std::memory_order_seq_cst)
+		{
+			DWord cur = split_read();
+			while (!dwcas(&_v, cur, pack(desired)));
+		}
+
+		bool compare_exchange_weak(TaggedPtr<Node>& expected, TaggedPtr<Node> desired,
+			std::memory_order = std::memory_order_seq_cst, std::memory_order = std::memory_order_seq_cst)
+		{
+			return compare_exchange_strong(expected, desired);
+		}
+
+		bool compare_exchange_strong(TaggedPtr<Node>& expected, TaggedPtr<Node> desired,
+			std::memory_order = std::memory_order_seq_cst, std::memory_order = std::memory_order_seq_cst)
+		{
+			DWord e = pack(expected);
+			if (dwcas(&_v, e, pack(desired))) return true;
+			expected = unpack(e);
+			return false;
+		}
+
+	private:
+		static DWord pack(TaggedPtr<Node> t) { return DWord{ reinterpret_cast<uintptr_t>(t.ptr), t.tag }; }
+		static TaggedPtr<Node> unpack(DWord d) { return TaggedPtr<Node>{ reinterpret_cast<Node*>(static_cast<uintptr_t>(d.lo)), d.hi }; }
+
+		// 찢어진(torn) 값이어도 CAS가 실패하며 최신값으로 교정되므로 초기값으로만 사용
+		DWord split_read() const
+		{
+			const volatile uint64_t* p = reinterpret_cast<const volatile uint64_t*>(&_v);
+			return DWord{ p[0], p[1] };
+		}
+
+		mutable DWord _v;
+	};
+#endif
+
+	template<typename Node>
+	class PackedTaggedHead
+	{
+	public:
+		static constexpr bool is_always_lock_free = (ATOMIC_LLONG_LOCK_FREE == 2);
+		static const char* name() { return "packed"; }
+
+		static constexpr int PtrBits = (sizeof(void*) == 8) ? 48 : 32;
+		static constexpr int TagBits = 64 - PtrBits;
+		static constexpr uint64_t PtrMask = (uint64_t(1) << PtrBits) - 1;
+
+		explicit PackedTaggedHead(TaggedPtr<Node> init = TaggedPtr<Node>{ nullptr, 0 }) : _v(pack(init)) {}
+
+		bool is_lock_free() const { return _v.is_lock_free(); }
+
+		TaggedPtr<Node> load(std::memory_order order = std::memory_order_seq_cst) const
+		{
+			return unpack(_v.load(order));
+		}
+
+		void store(TaggedPtr<Node> desired, std::memory_order order = std::memory_order_seq_cst)
+		{
+			_v.store(pack(desired), order);
+		}
+
+		bool compare_exchange_weak(TaggedPtr<Node>& expected, TaggedPtr<Node> desired,
+			std::memory_order success = std::memory_order_seq_cst, std::memory_order failure = std::memory_order_seq_cst)
+		{
+			uint64_t e = pack(expected);
+			if (_v.compare_exchange_weak(e, pack(desired), success, failure)) return true;
+			expected = unpack(e);
+			return false;
+		}
+
+		bool compare_exchange_strong(TaggedPtr<Node>& expected, TaggedPtr<Node> desired,
+			std::memory_order success = std::memory_order_seq_cst, std::memory_order failure = std::memory_order_seq_cst)
+		{
+			uint64_t e = pack(expected);
+			if (_v.compare_exchange_strong(e, pack(desired), success, failure)) return true;
+			expected = unpack(e);
+			return false;
+		}
+
+	private:
+		// tag는 TagBits로 잘려서 저장된다(비교는 잘린 값끼리)
+		static uint64_t pack(TaggedPtr<Node> t)
+		{
+			const uint64_t p = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(t.ptr));
+			assert((p & ~PtrMask) == 0 && "pointer uses high bits (LA57, MTE/TBI tags?)");
+			return (t.tag << PtrBits) | (p & PtrMask);
+		}
+
+		static TaggedPtr<Node> unpack(uint64_t v)
+		{
+			return TaggedPtr<Node>{ reinterpret_cast<Node*>(static_cast<uintptr_t>(v & PtrMask)), v >> PtrBits };
+		}
+
+		std::atomic<uint64_t> _v;
+	};
+
+	template<typename Node>
+	class LockedTaggedHead
+	{
+	public:
+		// 16-byte std::atomic은 구현에 따라 lock을 쓴다. 실제 여부는 is_lock_free()로만 알 수 있음
+		static constexpr bool is_always_lock_free = false;
+		static const char* name() { return "std::atomic"; }
+
+		explicit LockedTaggedHead(TaggedPtr<Node> init = TaggedPtr<Node>{ nullptr, 0 }) : _v(init) {}
+
+		bool is_lock_free() const { return _v.is_lock_free(); }
+
+		TaggedPtr<Node> load(std::memory_order order = std::memory_order_seq_cst) const { return _v.load(order); }
+		void store(TaggedPtr<Node> desired, std::memory_order order = std::memory_order_seq_cst) { _v.store(desired, order); }
+
+		bool compare_exchange_weak(TaggedPtr<Node>& expected, TaggedPtr<Node> desired,
+			std::memory_order success = std::memory_order_seq_cst, std::memory_order failure = std::memory_order_seq_cst)
+		{
+			return _v.compare_exchange_weak(expected, desired, success, failure);
+		}
+
+		bool compare_exchange_strong(TaggedPtr<Node>& expected, TaggedPtr<Node> desired,
+			std::memory_order success = std::memory_order_seq_cst, std::memory_order failure = std::memory_order_seq_cst)
+		{
+			return _v.compare_exchange_strong(expected, desired, success, failure);
+		}
+
+	private:
+		std::atomic<TaggedPtr<Node>> _v;
+	};
+
+	// C++14: constexpr static 멤버를 참조(ODR-use)할 때 필요한 정의
+#if LOCKFREE_HAS_DWCAS
+	template<typename Node> constexpr bool DwcasTaggedHead<Node>::is_always_lock_free;
+#endif
+	template<typename Node> constexpr bool PackedTaggedHead<Node>::is_always_lock_free;
+	template<typename Node> constexpr bool LockedTaggedHead<Node>::is_always_lock_free;
+
+#if LOCKFREE_HAS_DWCAS
+	template<typename Node>
+	using TaggedHead = DwcasTaggedHead<Node>;
+#else
+	template<typename Node>
+	using TaggedHead = PackedTaggedHead<Node>;
+#endif
+
+	static_assert(TaggedHead<void>::is_always_lock_free, "TaggedHead must be lock-free on this target");
+#if defined(__cpp_lib_atomic_is_always_lock_free)
+	static_assert(std::atomic<uint64_t>::is_always_lock_free == PackedTaggedHead<void>::is_always_lock_free,
+		"PackedTaggedHead lock-freedom must follow std::atomic<uint64_t>");
+#endif
+}//LockFree
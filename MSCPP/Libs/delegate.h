@@ -0,0 +1,364 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file delegate.h
+/// @brief 내장 버퍼 delegate + 컴파일 시간 멤버 함수 바인딩 + function_ref (header-only, C++14)
+///
+///   Delegates::Delegate<R(Args...), InlineSize = 32>
+///     - 호출 가능한 객체를 소유한다 (move-only). InlineSize 이하 + nothrow move 면 내장 버퍼, 그보다 크면 heap
+///     - 호출 = stub 함수 pointer 한 번 (virtual 함수 표 / Callback 객체 heap 할당 없음)
+///     - Delegate<R(Args...)>::bind<T, &T::Method>(obj) / DELEGATE_BIND(&T::Method, obj)
+///         멤버 함수를 template 인자로 고정 => object pointer 만 저장, stub 안에서는 직접 호출 (inline 가능)
+///     - 비어 있는 Delegate 호출은 assert
+///
+///   Delegates::function_ref<R(Args...)>
+///     - 소유하지 않는 참조 (pointer 2 개, 복사 가능). 인자로 콜백을 받는 함수에 쓴다
+///     - 참조하는 호출 가능 객체보다 오래 살면 안 된다
+///
+///   비교 (C++/CallbackAndDelegate.cpp)
+///     DelegateAbstractInterfaceStyle::Delegate : Callback 파생 객체를 new + virtual invoke
+///     std::function                            : 작은 버퍼(libstdc++ 16 B, MSVC 56 B) 초과 시 heap, 복사 가능
+///////////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace Delegates
+{
+	// this + 멤버 함수 pointer(최대 16 B) + 여유 => 보통의 [this, x] 캡처 람다가 들어간다
+	static const size_t DefaultInlineSize = 4 * sizeof(void*);
+
+	template<typename Signature, size_t InlineSize = DefaultInlineSize>
+	class Delegate;
+
+	template<typename Signature>
+	class function_ref;
+
+	namespace detail
+	{
+		enum class Op { Move, Destroy };
+
+		template<size_t InlineSize>
+		union Storage
+		{
+			void* heap;
+			alignas(std::max_align_t) unsigned char buffer[InlineSize < sizeof(void*) ? sizeof(void*) : InlineSize];
+		};
+
+		template<typename F, typename R, typename... Args>
+		struct is_callable
+		{
+		private:
+			template<typename U>
+			static auto test(int) -> decltype(std::declval<U&>()(std::declval<Args>()...), std::true_type());
+			template<typename>
+			static std::false_type test(...);
+
+		public:
+			static constexpr bool value = decltype(test<F>(0))::value;
+		};
+
+		template<typename F, size_t InlineSize>
+		struct fits_inline : std::integral_constant<bool,
+			sizeof(F) <= sizeof(Storage<InlineSize>) &&
+			alignof(std::max_align_t) % alignof(F) == 0 &&
+			std::is_nothrow_move_constructible<F>::value>
+		{};
+	}
+
+	//=============================================================================================
+	// Delegate
+	//=============================================================================================
+	template<typename R, typename... Args, size_t InlineSize>
+	class Delegate<R(Args...), InlineSize>
+	{
+		using Storage = detail::Storage<InlineSize>;
+		using InvokeFn = R (*)(Storage&, Args&&...);
+		using ManageFn = void (*)(detail::Op, Storage& self, Storage* target);
+
+		template<typename F>
+		using EnableIfCallable = typename std::enable_if<
+			!std::is_same<typename std::decay<F>::type, Delegate>::value &&
+			detail::is_callable<typename std::decay<F>::type, R, Args...>::value>::type;
+
+	public:
+		Delegate() noexcept = default;
+		Delegate(std::nullptr_t) noexcept {}
+
+		template<typename F, typename = EnableIfCallable<F>>
+		Delegate(F&& f)
+		{
+			using Target = typename std::decay<F>::type;
+			emplace<Target>(std::forward<F>(f), detail::fits_inline<Target, InlineSize>());
+		}
+
+		Delegate(Delegate&& rhs) noexcept { move_from(rhs); }
+
+		Delegate& operator=(Delegate&& rhs) noexcept
+		{
+			if (this != &rhs) {
+				reset();
+				move_from(rhs);
+			}
+			return *this;
+		}
+
+		Delegate& operator=(std::nullptr_t) noexcept
+		{
+			reset();
+			return *this;
+		}
+
+		Delegate(const Delegate&) = delete;
+		Delegate& operator=(const Delegate&) = delete;
+
+		~Delegate() { reset(); }
+
+		R operator()(Args... args) const
+		{
+			assert(_invoke && "empty Delegate");
+			return _invoke(_storage, std::forward<Args>(args)...);
+		}
+
+		explicit operator bool() const noexcept { return _invoke != nullptr; }
+
+		void reset() noexcept
+		{
+			if (_manage) _manage(detail::Op::Destroy, _storage, nullptr);
+			_invoke = nullptr;
+			_manage = nullptr;
+		}
+
+		// F 를 heap 없이 내장 버퍼에 담을 수 있는가
+		template<typename F>
+		static constexpr bool fits_inline() noexcept { return detail::fits_inline<typename std::decay<F>::type, InlineSize>::value; }
+
+		//-----------------------------------------------------------------------------------------
+		// 컴파일 시간 바인딩 : 호출할 함수가 template 인자 => stub 안의 직접 호출
+		//-----------------------------------------------------------------------------------------
+		template<typename T, R (T::*Method)(Args...)>
+		static Delegate bind(T* object) noexcept
+		{
+			Delegate d;
+			d.store_pointer(object);
+			d._invoke = &method_stub<T, Method>;
+			return d;
+		}
+
+		template<typename T, R (T::*Method)(Args...) const>
+		static Delegate bind(const T* object) noexcept
+		{
+			Delegate d;
+			d.store_pointer(object);
+			d._invoke = &const_method_stub<T, Method>;
+			return d;
+		}
+
+		template<R (*Function)(Args...)>
+		static Delegate bind() noexcept
+		{
+			Delegate d;
+			d._invoke = &function_stub<Function>;
+			return d;
+		}
+
+	private:
+		//-----------------------------------------------------------------------------------------
+		// 저장
+		//-----------------------------------------------------------------------------------------
+		template<typename Target, typename F>
+		void emplace(F&& f, std::true_type /*inline*/)
+		{
+			::new (static_cast<void*>(_storage.buffer)) Target(std::forward<F>(f));
+			_invoke = &invoke_inline<Target>;
+			// 함수 pointer, [this] 람다 등은 memcpy 로 옮기고 소멸자도 없다
+			_manage = (std::is_trivially_copyable<Target>::value && std::is_trivially_destructible<Target>::value)
+				? nullptr : &manage_inline<Target>;
+		}
+
+		template<typename Target, typename F>
+		void emplace(F&& f, std::false_type /*heap*/)
+		{
+			_storage.heap = new Target(std::forward<F>(f));
+			_invoke = &invoke_heap<Target>;
+			_manage = &manage_heap<Target>;
+		}
+
+		template<typename P>
+		void store_pointer(P* p) noexcept
+		{
+			void* raw = const_cast<void*>(static_cast<const void*>(p));
+			memcpy(_storage.buffer, &raw, sizeof(raw));
+		}
+
+		static void* load_pointer(const Storage& s) noexcept
+		{
+			void* raw;
+			memcpy(&raw, s.buffer, sizeof(raw));
+			return raw;
+		}
+
+		void move_from(Delegate& rhs) noexcept
+		{
+			if (rhs._manage) rhs._manage(detail::Op::Move, rhs._storage, &_storage);
+			else memcpy(&_storage, &rhs._storage, sizeof(Storage));
+
+			_invoke = rhs._invoke;
+			_manage = rhs._manage;
+			rhs._invoke = nullptr;
+			rhs._manage = nullptr;
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// stub
+		//-----------------------------------------------------------------------------------------
+		template<typename Target>
+		static R invoke_inline(Storage& s, Args&&... args)
+		{
+			return static_cast<R>((*reinterpret_cast<Target*>(s.buffer))(std::forward<Args>(args)...));
+		}
+
+		template<typename Target>
+		static R invoke_heap(Storage& s, Args&&... args)
+		{
+			return static_cast<R>((*static_cast<Target*>(s.heap))(std::forward<Args>(args)...));
+		}
+
+		template<typename T, R (T::*Method)(Args...)>
+		static R method_stub(Storage& s, Args&&... args)
+		{
+			return (static_cast<T*>(load_pointer(s))->*Method)(std::forward<Args>(args)...);
+		}
+
+		template<typename T, R (T::*Method)(Args...) const>
+		static R const_method_stub(Storage& s, Args&&... args)
+		{
+			return (static_cast<const T*>(load_pointer(s))->*Method)(std::forward<Args>(args)...);
+		}
+
+		template<R (*Function)(Args...)>
+		static R function_stub(Storage&, Args&&... args)
+		{
+			return Function(std::forward<Args>(args)...);
+		}
+
+		template<typename Target>
+		static void manage_inline(detail::Op op, Storage& self, Storage* target)
+		{
+			Target* p = reinterpret_cast<Target*>(self.buffer);
+			if (op == detail::Op::Move) ::new (static_cast<void*>(target->buffer)) Target(std::move(*p));
+			p->~Target();
+		}
+
+		template<typename Target>
+		static void manage_heap(detail::Op op, Storage& self, Storage* target)
+		{
+			if (op == detail::Op::Move) target->heap = self.heap;
+			else delete static_cast<Target*>(self.heap);
+			self.heap = nullptr;
+		}
+
+	private:
+		mutable Storage _storage = Storage();  // 0 으로 초기화 (move_from 은 담긴 객체 크기와 상관없이 버퍼 전체를 memcpy)
+		InvokeFn _invoke = nullptr;
+		ManageFn _manage = nullptr;     // nullptr = 내장 버퍼의 trivially copyable 객체
+	};
+
+	//=============================================================================================
+	// DELEGATE_BIND(&T::Method, obj) : 시그니처를 멤버 함수 pointer 에서 추론
+	//   (C++14 에는 template<auto> 가 없어 함수 pointer 를 타입과 값으로 두 번 넘긴다)
+	//=============================================================================================
+	template<typename T, typename R, typename... Args>
+	struct MethodBinder
+	{
+		template<R (T::*Method)(Args...)>
+		static Delegate<R(Args...)> Bind(T* object) noexcept
+		{
+			return Delegate<R(Args...)>::template bind<T, Method>(object);
+		}
+	};
+
+	template<typename T, typename R, typename... Args>
+	struct ConstMethodBinder
+	{
+		template<R (T::*Method)(Args...) const>
+		static Delegate<R(Args...)> Bind(const T* object) noexcept
+		{
+			return Delegate<R(Args...)>::template bind<T, Method>(object);
+		}
+	};
+
+	template<typename T, typename R, typename... Args>
+	MethodBinder<T, R, Args...> make_binder(R (T::*)(Args...)) { return {}; }
+
+	template<typename T, typename R, typename... Args>
+	ConstMethodBinder<T, R, Args...> make_binder(R (T::*)(Args...) const) { return {}; }
+
+	#define DELEGATE_BIND(method, object) (::Delegates::make_binder(method).template Bind<method>(object))
+
+	//=============================================================================================
+	// function_ref : 소유하지 않는 호출 참조
+	//=============================================================================================
+	template<typename R, typename... Args>
+	class function_ref<R(Args...)>
+	{
+		union Bound
+		{
+			void* object;
+			R (*function)(Args...);
+		};
+
+		template<typename F>
+		using EnableIfCallable = typename std::enable_if<
+			!std::is_same<typename std::decay<F>::type, function_ref>::value &&
+			!std::is_function<typename std::remove_pointer<typename std::decay<F>::type>::type>::value &&
+			detail::is_callable<typename std::remove_reference<F>::type, R, Args...>::value>::type;
+
+	public:
+		template<typename F, typename = EnableIfCallable<F>>
+		function_ref(F&& f) noexcept
+			: _invoke(&invoke_object<typename std::remove_reference<F>::type>)
+		{
+			_bound.object = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+		}
+
+		function_ref(R (*function)(Args...)) noexcept
+			: _invoke(&invoke_function)
+		{
+			assert(function);
+			_bound.function = function;
+		}
+
+		function_ref(const function_ref&) noexcept = default;
+		function_ref& operator=(const function_ref&) noexcept = default;
+
+		R operator()(Args... args) const
+		{
+			return _invoke(_bound, std::forward<Args>(args)...);
+		}
+
+	private:
+		template<typename F>
+		static R invoke_object(Bound b, Args&&... args)
+		{
+			return static_cast<R>((*static_cast<F*>(b.object))(std::forward<Args>(args)...));
+		}
+
+		static R invoke_function(Bound b, Args&&... args)
+		{
+			return b.function(std::forward<Args>(args)...);
+		}
+
+	private:
+		Bound _bound;
+		R (*_invoke)(Bound, Args&&...);
+	};
+}//Delegates
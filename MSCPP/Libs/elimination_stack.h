@@ -0,0 +1,143 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file elimination_stack.h
+/// @brief elimination-backoff lock-free stack (Hendler, Shavit, Yerushalmi 2004) (header-only, C++14)
+///
+///   head CAS가 실패하면 바로 재시도하는 대신 elimination array로 간다.
+///   동시에 도착한 push와 pop은 head를 건드리지 않고 slot에서 노드를 직접 주고받는다.
+///   (push 직후 pop 한 것과 같으므로 LIFO 의미는 그대로)
+///
+///   slot 상태: nullptr(비어 있음) | Node*(push가 제안 중) | Taken(pop이 가져감, push가 비울 때까지)
+///     - push : nullptr -> node 로 제안, 잠깐 기다린 뒤 node -> nullptr 로 회수 시도
+///              회수 CAS가 실패하면 Taken => pop이 가져갔으므로 slot을 비우고 완료
+///     - pop  : node -> Taken 으로 CAS 성공 시 노드 소유권 획득(스택에 들어간 적 없는 노드라 바로 delete 가능)
+///     - Taken을 push가 비우기 전에는 다른 push가 그 slot을 쓰지 못하므로 해제된 주소 재사용(ABA)이 없다
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "treiber_stack.h"
+#include "backoff.h"
+
+
+namespace LockFree
+{
+	template<typename Node>
+	class EliminationArray
+	{
+	public:
+		static const size_t MaxWidth = 16;
+		static const int PushWaitSpins = 256;   // push가 짝을 기다리는 시간
+		static const int PopProbes = 8;         // pop이 제안을 찾아보는 횟수
+
+		EliminationArray()
+			: _width((std::max)(size_t(1), (std::min)(size_t(MaxWidth), size_t(std::thread::hardware_concurrency() / 2))))
+		{
+			for (auto& s : _slots) s.offer.store(nullptr, std::memory_order_relaxed);
+		}
+
+		// true: pop과 교환 성공(노드 소유권이 pop으로 넘어감), false: 짝이 없어서 회수함
+		bool offer_push(Node* node)
+		{
+			Slot& s = _slots[detail::fast_rand() % _width];
+
+			Node* expected = nullptr;
+			if (!s.offer.compare_exchange_strong(expected, node, std::memory_order_release, std::memory_order_relaxed)) {
+				return false;
+			}
+
+			for (int i = 0; i < PushWaitSpins; ++i) {
+				if (s.offer.load(std::memory_order_acquire) == taken()) {
+					s.offer.store(nullptr, std::memory_order_release);
+					return true;
+				}
+				detail::cpu_relax();
+			}
+
+			expected = node;
+			if (s.offer.compare_exchange_strong(expected, nullptr, std::memory_order_acquire, std::memory_order_acquire)) {
+				return false;
+			}
+			// 회수 직전에 pop이 가져감
+			s.offer.store(nullptr, std::memory_order_release);
+			return true;
+		}
+
+		// true: push가 제안한 노드를 가져옴(호출자가 값을 꺼낸 뒤 delete)
+		bool take_pop(Node*& node)
+		{
+			for (int i = 0; i < PopProbes; ++i) {
+				Slot& s = _slots[detail::fast_rand() % _width];
+				Node* n = s.offer.load(std::memory_order_acquire);
+				if (nullptr != n && taken() != n &&
+					s.offer.compare_exchange_strong(n, taken(), std::memory_order_acquire, std::memory_order_relaxed)) {
+					node = n;
+					return true;
+				}
+				detail::cpu_relax();
+			}
+			return false;
+		}
+
+	private:
+		static Node* taken() { return reinterpret_cast<Node*>(uintptr_t(1)); }
+
+		struct alignas(CacheLineSize) Slot
+		{
+			std::atomic<Node*> offer;
+		};
+
+		const size_t _width;
+		Slot _slots[MaxWidth];
+	};
+
+	template<typename T, typename Reclaimer = HazardPointers>
+	class EliminationStack : private TreiberStack<T, Reclaimer, NoBackoff>
+	{
+		using Base = TreiberStack<T, Reclaimer, NoBackoff>;
+		using Node = typename Base::Node;
+		using Attempt = typename Base::Attempt;
+
+	public:
+		using value_type = T;
+		using reclaimer_type = Reclaimer;
+		using Base::empty;
+
+		void push(const T& value) { push_node(new Node(value)); }
+		void push(T&& value) { push_node(new Node(std::move(value))); }
+
+		template<typename... Args>
+		void emplace(Args&&... args) { push_node(new Node(std::forward<Args>(args)...)); }
+
+		bool pop(T& out)
+		{
+			for (;;) {
+				Node* node;
+				const Attempt a = this->try_pop_node(node);
+				if (Attempt::Done == a) {
+					out = std::move(node->value);
+					Reclaimer::retire(node);
+					return true;
+				}
+				if (Attempt::Empty == a) return false;
+
+				if (_elimination.take_pop(node)) {
+					out = std::move(node->value);
+					delete node;
+					return true;
+				}
+			}
+		}
+
+	private:
+		void push_node(Node* node)
+		{
+			while (!this->try_push_node(node) && !_elimination.offer_push(node));
+		}
+
+		EliminationArray<Node> _elimination;
+	};
+}//LockFree
@@ -0,0 +1,392 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file enum_reflect.h
+/// @brief 컴파일 시간 최소 완전 해시(minimal perfect hash) enum <-> 문자열 변환 (header-only, C++17)
+///
+///   EnumReflect::make_table(entries)  =>  constexpr Table<E, N>
+///     - entries : { "이름", 값 } 배열. 값은 띄엄띄엄(sparse), 음수, flag(1 << n), 같은 값의 별칭 모두 가능
+///     - from_string(string_view) : 이름 hash => 표 한 칸 => 이름 한 번 비교, O(1)
+///     - to_string(E)             : 값 범위(max - min) 가 N 미만이면 바로 index, 아니면 값 hash, O(1)
+///                                  같은 값이 여러 이름이면 먼저 선언한 이름, 없는 값이면 빈 string_view
+///     - 표 구성은 hash-and-displace : key 를 N 개 bucket 으로 나누고 큰 bucket 부터 모든 key 가
+///       빈 칸에 들어가는 seed 를 찾는다. key 1 개짜리 bucket 은 남은 칸을 그대로 기록 (seed 탐색 없음)
+///
+///   ENUM_REFLECT_TABLE(Type, entries) : Type##_Reflect 표 + ADL hook enum_reflect(Type) 정의
+///     => EnumReflect::to_string / from_string / flags_to_string / flags_from_string 을 Type 에 쓸 수 있다
+///     (C++/EnumReflect.h 는 ENUM_BEGIN/ENUM/ENUM_END 목록을 이 표로 만든다)
+///
+///   비교 (C++/EnumToString.h)
+///     typ##_FromString : 이름 배열 strcmp 선형 탐색, typ##_ToString : 0 부터 연속인 값만
+///
+///   주의
+///     - 이름이 겹치면(또는 64 bit hash 가 겹치면) valid() == false => 매크로의 static_assert 로 컴파일 오류
+///     - enum 당 최대 65534 개. 수천 개 이상이면 MSVC 는 /constexpr:steps 를 늘려야 할 수 있다
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+
+namespace EnumReflect
+{
+	template<typename E>
+	struct Entry
+	{
+		std::string_view name;
+		E value;
+	};
+
+	namespace detail
+	{
+		using Index = uint16_t;
+		static constexpr Index NoIndex = 0xFFFF;
+		static constexpr int32_t MaxSeed = 1 << 16;
+
+		// 음수 값도 부호 확장된 bit 로 (min/max 차이는 modular 로 계산된다)
+		template<typename E>
+		constexpr uint64_t to_bits(E value) noexcept
+		{
+			return static_cast<uint64_t>(static_cast<std::underlying_type_t<E>>(value));
+		}
+
+		template<typename E>
+		constexpr E from_bits(uint64_t bits) noexcept
+		{
+			return static_cast<E>(static_cast<std::underlying_type_t<E>>(bits));
+		}
+
+		// splitmix64 finalizer
+		constexpr uint64_t mix(uint64_t h) noexcept
+		{
+			h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+			h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+			return h ^ (h >> 31);
+		}
+
+		// little-endian 8 byte. 펼쳐 쓴 식이라 컴파일러가 load 한 번으로 합친다 (constexpr 라 memcpy 불가)
+		constexpr uint64_t load_word(const char* p) noexcept
+		{
+			return static_cast<uint64_t>(static_cast<unsigned char>(p[0]))
+				| static_cast<uint64_t>(static_cast<unsigned char>(p[1])) << 8
+				| static_cast<uint64_t>(static_cast<unsigned char>(p[2])) << 16
+				| static_cast<uint64_t>(static_cast<unsigned char>(p[3])) << 24
+				| static_cast<uint64_t>(static_cast<unsigned char>(p[4])) << 32
+				| static_cast<uint64_t>(static_cast<unsigned char>(p[5])) << 40
+				| static_cast<uint64_t>(static_cast<unsigned char>(p[6])) << 48
+				| static_cast<uint64_t>(static_cast<unsigned char>(p[7])) << 56;
+		}
+
+		// 8 byte 씩 곱셈 한 번 (byte 마다 곱하는 FNV 보다 의존 사슬이 짧다) + finalizer
+		// 남은 꼬리는 마지막 8 byte 를 겹쳐 읽는다 (8 byte 미만 이름만 byte 단위)
+		constexpr uint64_t hash_name(std::string_view s) noexcept
+		{
+			const char* p = s.data();
+			const size_t n = s.size();
+			uint64_t h = 0x9E3779B97F4A7C15ull ^ n;
+			size_t i = 0;
+			for (; i + 8 <= n; i += 8) {
+				h = (h ^ load_word(p + i)) * 0xFF51AFD7ED558CCDull;
+				h ^= h >> 32;
+			}
+			if (i < n) {
+				if (n >= 8) {
+					h ^= load_word(p + n - 8);
+				}
+				else {
+					for (; i < n; ++i)
+						h ^= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+				}
+			}
+			return mix(h);
+		}
+
+		template<typename E>
+		constexpr uint64_t hash_value(E value) noexcept { return mix(to_bits(value)); }
+
+		// [0, n) 로 축소 : 나눗셈 대신 상위 32 bit 곱셈 (n <= 65535)
+		constexpr size_t reduce(uint64_t h, size_t n) noexcept
+		{
+			return static_cast<size_t>(((h >> 32) * n) >> 32);
+		}
+
+		// bucket 안 key 의 칸 : h 는 이미 섞여 있으므로 seed 마다 곱셈 한 번
+		constexpr size_t place(uint64_t h, int32_t seed, size_t n) noexcept
+		{
+			return reduce((h ^ (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull, n);
+		}
+
+		//=========================================================================================
+		// hash-and-displace 표 : N 칸, bucket 도 N 개
+		//=========================================================================================
+		template<size_t N>
+		struct PerfectHash
+		{
+			int32_t disp[N] = {};           // > 0 : bucket 의 seed, < 0 : -(칸 + 1) (key 1 개), 0 : 빈 bucket
+			Index slot_to_key[N] = {};      // 칸 => key index (NoIndex = 빈 칸)
+
+			constexpr Index find(uint64_t h) const noexcept
+			{
+				const int32_t d = disp[reduce(h, N)];
+				const size_t slot = d < 0 ? static_cast<size_t>(-(d + 1)) : place(h, d, N);
+				return slot_to_key[slot];
+			}
+		};
+
+		// keys[0, N) 를 배치. 같은 hash 가 두 번 나오면 keep_first ? 먼저 나온 것만 : 실패
+		template<size_t N>
+		constexpr bool build(PerfectHash<N>& ph, const uint64_t (&keys)[N], bool keep_first)
+		{
+			Index bucket_start[N + 1] = {};
+			Index bucket_size[N] = {};
+			Index bucket_keys[N] = {};
+			bool taken[N] = {};
+
+			for (size_t i = 0; i < N; ++i) {
+				ph.slot_to_key[i] = NoIndex;
+				++bucket_start[reduce(keys[i], N) + 1];
+			}
+			for (size_t b = 0; b < N; ++b)
+				bucket_start[b + 1] += bucket_start[b];
+			for (size_t i = 0; i < N; ++i) {
+				const size_t b = reduce(keys[i], N);
+				bucket_keys[bucket_start[b] + bucket_size[b]++] = static_cast<Index>(i);
+			}
+
+			// bucket 안의 중복 제거 (같은 hash 는 항상 같은 bucket)
+			size_t max_size = 0;
+			for (size_t b = 0; b < N; ++b) {
+				Index* members = bucket_keys + bucket_start[b];
+				size_t kept = 0;
+				for (size_t j = 0; j < bucket_size[b]; ++j) {
+					bool duplicate = false;
+					for (size_t k = 0; k < kept; ++k)
+						duplicate = duplicate || keys[members[k]] == keys[members[j]];
+					if (duplicate && !keep_first) return false;
+					if (!duplicate) members[kept++] = members[j];
+				}
+				bucket_size[b] = static_cast<Index>(kept);
+				if (kept > max_size) max_size = kept;
+			}
+
+			// 큰 bucket 부터 seed 탐색 (칸이 많이 비어 있을 때 어려운 bucket 을 먼저)
+			for (size_t size = max_size; size >= 2; --size) {
+				for (size_t b = 0; b < N; ++b) {
+					if (bucket_size[b] != size) continue;
+					const Index* members = bucket_keys + bucket_start[b];
+
+					int32_t seed = 1;
+					for (;; ++seed) {
+						if (seed > MaxSeed) return false;
+						bool fits = true;
+						for (size_t j = 0; j < size && fits; ++j) {
+							const size_t slot = place(keys[members[j]], seed, N);
+							fits = !taken[slot];
+							for (size_t k = 0; k < j && fits; ++k)
+								fits = place(keys[members[k]], seed, N) != slot;
+						}
+						if (fits) break;
+					}
+
+					for (size_t j = 0; j < size; ++j) {
+						const size_t slot = place(keys[members[j]], seed, N);
+						taken[slot] = true;
+						ph.slot_to_key[slot] = members[j];
+					}
+					ph.disp[b] = seed;
+				}
+			}
+
+			// key 1 개짜리 bucket 은 남은 칸을 앞에서부터
+			size_t free_slot = 0;
+			for (size_t b = 0; b < N; ++b) {
+				if (bucket_size[b] != 1) continue;
+				while (taken[free_slot]) ++free_slot;
+				taken[free_slot] = true;
+				ph.slot_to_key[free_slot] = bucket_keys[bucket_start[b]];
+				ph.disp[b] = -static_cast<int32_t>(free_slot) - 1;
+			}
+			return true;
+		}
+	}
+
+	//=============================================================================================
+	// Table
+	//=============================================================================================
+	template<typename E, size_t N>
+	class Table
+	{
+		static_assert(std::is_enum<E>::value, "EnumReflect::Table<E> : E must be an enum");
+		static_assert(N > 0, "EnumReflect::Table : no entries");
+
+		using Index = detail::Index;
+
+	public:
+		constexpr explicit Table(const Entry<E> (&entries)[N])
+		{
+			if (N >= detail::NoIndex) return;
+
+			uint64_t name_keys[N] = {};
+			uint64_t value_keys[N] = {};
+			_min = _max = static_cast<std::underlying_type_t<E>>(entries[0].value);
+			for (size_t i = 0; i < N; ++i) {
+				_entries[i] = entries[i];
+				name_keys[i] = detail::hash_name(entries[i].name);
+				value_keys[i] = detail::hash_value(entries[i].value);
+
+				const auto v = static_cast<std::underlying_type_t<E>>(entries[i].value);
+				if (v < _min) _min = v;
+				if (_max < v) _max = v;
+			}
+
+			_valid = detail::build(_names, name_keys, false);
+
+			// 값이 N 칸 안에 들어오면 hash 없이 바로 index
+			_dense = detail::to_bits(static_cast<E>(_max)) - detail::to_bits(static_cast<E>(_min)) < N;
+			if (_dense) {
+				for (size_t i = 0; i < N; ++i)
+					_by_value[i] = detail::NoIndex;
+				for (size_t i = 0; i < N; ++i) {
+					Index& slot = _by_value[offset(entries[i].value)];
+					if (slot == detail::NoIndex) slot = static_cast<Index>(i);
+				}
+			}
+			else {
+				_valid = detail::build(_values, value_keys, true) && _valid;
+			}
+		}
+
+		// 이름 중복/hash 충돌 없이 표를 만들었는가
+		constexpr bool valid() const noexcept { return _valid; }
+		constexpr bool dense() const noexcept { return _dense; }
+
+		constexpr size_t size() const noexcept { return N; }
+		constexpr const Entry<E>* begin() const noexcept { return _entries; }
+		constexpr const Entry<E>* end() const noexcept { return _entries + N; }
+
+		constexpr std::string_view to_string(E value) const noexcept
+		{
+			const Index i = index_of(value);
+			return i == detail::NoIndex ? std::string_view() : _entries[i].name;
+		}
+
+		constexpr std::optional<E> from_string(std::string_view name) const noexcept
+		{
+			const Index i = _names.find(detail::hash_name(name));
+			if (i != detail::NoIndex && _entries[i].name == name) return _entries[i].value;
+			return std::nullopt;
+		}
+
+		constexpr bool contains(E value) const noexcept { return index_of(value) != detail::NoIndex; }
+
+	private:
+		constexpr uint64_t offset(E value) const noexcept
+		{
+			return detail::to_bits(value) - detail::to_bits(static_cast<E>(_min));
+		}
+
+		constexpr Index index_of(E value) const noexcept
+		{
+			if (_dense) {
+				const uint64_t off = offset(value);
+				return off < N ? _by_value[off] : detail::NoIndex;
+			}
+			const Index i = _values.find(detail::hash_value(value));
+			return (i != detail::NoIndex && _entries[i].value == value) ? i : detail::NoIndex;
+		}
+
+	private:
+		Entry<E> _entries[N] = {};
+		detail::PerfectHash<N> _names;
+		detail::PerfectHash<N> _values;         // !_dense 일 때만
+		Index _by_value[N] = {};                // _dense 일 때만 : 값 - _min => entry
+		std::underlying_type_t<E> _min = {};
+		std::underlying_type_t<E> _max = {};
+		bool _dense = false;
+		bool _valid = false;
+	};
+
+	template<typename E, size_t N>
+	constexpr Table<E, N> make_table(const Entry<E> (&entries)[N])
+	{
+		return Table<E, N>(entries);
+	}
+
+	//=============================================================================================
+	// ADL hook enum_reflect(E) 로 표를 찾는 일반 함수
+	//=============================================================================================
+	template<typename E>
+	constexpr std::string_view to_string(E value) noexcept
+	{
+		return enum_reflect(value).to_string(value);
+	}
+
+	template<typename E>
+	constexpr std::optional<E> from_string(std::string_view name) noexcept
+	{
+		return enum_reflect(E{}).from_string(name);
+	}
+
+	// 이름 있는 값이면 그 이름(None, All 같은 조합 별칭 포함), 아니면 켜진 bit 마다 이름을 separator 로 이어 붙인다
+	// 이름 없는 bit 가 있으면 false (out 에는 이름 있는 bit 만)
+	template<typename E>
+	bool flags_to_string(E value, std::string& out, char separator = '|')
+	{
+		const auto& table = enum_reflect(value);
+		out.clear();
+
+		const std::string_view exact = table.to_string(value);
+		if (!exact.empty()) {
+			out.assign(exact.data(), exact.size());
+			return true;
+		}
+
+		bool complete = true;
+		for (uint64_t rest = detail::to_bits(value); rest != 0; rest &= rest - 1) {
+			const std::string_view name = table.to_string(detail::from_bits<E>(rest & (~rest + 1)));
+			if (name.empty()) {
+				complete = false;
+				continue;
+			}
+			if (!out.empty()) out += separator;
+			out.append(name.data(), name.size());
+		}
+		return complete;
+	}
+
+	// "Read | Write" => Read | Write. 앞뒤 공백 허용, 모르는 이름이나 빈 항목이 있으면 false (out 은 그대로)
+	template<typename E>
+	bool flags_from_string(std::string_view text, E& out, char separator = '|')
+	{
+		const auto& table = enum_reflect(E{});
+		uint64_t bits = 0;
+		for (;;) {
+			const size_t end = text.find(separator);
+			std::string_view token = text.substr(0, end);
+			while (!token.empty() && (token.front() == ' ' || token.front() == '\t')) token.remove_prefix(1);
+			while (!token.empty() && (token.back() == ' ' || token.back() == '\t')) token.remove_suffix(1);
+
+			const std::optional<E> flag = table.from_string(token);
+			if (!flag) return false;
+			bits |= detail::to_bits(*flag);
+
+			if (end == std::string_view::npos) break;
+			text.remove_prefix(end + 1);
+		}
+		out = detail::from_bits<E>(bits);
+		return true;
+	}
+}//EnumReflect
+
+//=================================================================================================
+// entries 배열 => Type##_Reflect 표 + enum_reflect(Type). enum 과 같은 namespace 에 둔다
+//=================================================================================================
+#define ENUM_REFLECT_TABLE(Type, entries) \
+	inline constexpr auto Type##_Reflect = ::EnumReflect::make_table(entries); \
+	static_assert(Type##_Reflect.valid(), "EnumReflect: duplicate name (or name hash collision) in " #Type); \
+	constexpr const auto& enum_reflect(Type) noexcept { return Type##_Reflect; }
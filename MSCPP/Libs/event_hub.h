@@ -0,0 +1,435 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file event_hub.h
+/// @brief RCU(copy-on-write) 구독자 배열 기반 multicast 이벤트 허브 (header-only, C++14)
+///
+///   Events::EventHub<Args...>
+///     - fire(args...)            : 현재 구독자 snapshot 을 epoch guard 안에서 읽고 모두 호출
+///                                  lock / CAS / 구독자별 atomic 없음 (wait-free read)
+///     - fire_parallel(pool, ...) : 구독자가 많으면 parallel_chunk 개씩 나눠 pool.submit_bulk 로 분산, 끝날 때까지 대기
+///                                  호출한 스레드도 chunk 를 처리하고, pool 작업 완료는 epoch guard 를 놓은 뒤에 기다린다
+///                                  (C++11/AsyncAndFuture.cpp 의 CustomThreadPool 처럼 submit_bulk(range, fn) => Future 인 실행기)
+///     - subscribe / unsubscribe  : 쓰기 mutex 안에서 배열을 복사해 바꾼 뒤 pointer 교체,
+///                                  이전 배열/떼어 낸 구독자는 LockFree::EpochReclamation 으로 retire (읽는 중이면 나중에 해제)
+///
+///   약한 참조 구독 (C++142/Memory_add.cpp 의 weak_from_this 패턴)
+///     subscribe(shared_ptr<T>, &T::Method) / subscribe(weak_ptr<void>, fn)
+///       - 호출할 때마다 weak_ptr::lock() 으로 살아 있는지 확인 (호출 중 객체가 파괴되지 않게)
+///       - lock() 에 실패한 구독자는 표시만 하고 건너뛴다. 표시된 수가 prune_batch 를 넘으면
+///         fire 하던 스레드가 배열을 한 번만 복사해 한꺼번에 제거 (만료될 때마다 복사하지 않는다)
+///
+///   범위 구독 (lock() 없이 객체 수명에 묶기)
+///     ScopedSubscription s = hub.subscribe_scoped(fn)
+///       - 소멸자에서 unsubscribe_and_wait : 떼어 낸 뒤 그 전에 시작된 fire 가 모두 끝날 때까지 대기(epoch grace period)
+///       - 객체의 마지막 멤버로 두면 소멸자가 돌기 전에 구독이 끝나므로 fire 는 구독자별 참조 카운트 없이 호출
+///       - 콜백(fire / fire_parallel 이 부르는 것, pool 작업자 포함) 안에서 ScopedSubscription 을 파괴하거나
+///         unsubscribe_and_wait 를 부르면 진행 중인 그 fire 를 기다리게 된다 => 그때는 unsubscribe 만
+///
+///   주의
+///     - unsubscribe 가 반환돼도 이미 시작된 fire 는 그 콜백을 한 번 더 부를 수 있다 (RCU).
+///       객체 수명에 묶인 콜백은 약한 참조 구독이나 범위 구독을 쓴다.
+///     - 허브를 파괴할 때는 fire 중인 스레드와 남은 ScopedSubscription 이 없어야 한다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "delegate.h"
+#include "reclamation.h"
+
+
+namespace Events
+{
+	using SubscriptionId = uint64_t;
+
+	struct HubOptions
+	{
+		size_t prune_batch = 64;        // 만료된 약한 구독자가 이만큼 쌓이면 일괄 제거
+		size_t parallel_chunk = 1024;   // fire_parallel 의 작업 하나당 구독자 수 (이하이면 호출한 스레드에서 바로)
+	};
+
+	namespace detail
+	{
+		// [first, last) 의 정수를 원소로 하는 range (submit_bulk 에 chunk 번호를 넘길 때 할당 없이)
+		class CountingIterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = size_t;
+			using difference_type = ptrdiff_t;
+			using pointer = const size_t*;
+			using reference = size_t;
+
+			CountingIterator() = default;
+			explicit CountingIterator(size_t value) noexcept : _value(value) {}
+
+			size_t operator*() const noexcept { return _value; }
+			CountingIterator& operator++() noexcept { ++_value; return *this; }
+			CountingIterator operator++(int) noexcept { CountingIterator old = *this; ++_value; return old; }
+
+			bool operator==(const CountingIterator& rhs) const noexcept { return _value == rhs._value; }
+			bool operator!=(const CountingIterator& rhs) const noexcept { return _value != rhs._value; }
+
+		private:
+			size_t _value = 0;
+		};
+
+		struct CountingRange
+		{
+			size_t first;
+			size_t last;
+
+			CountingIterator begin() const noexcept { return CountingIterator(first); }
+			CountingIterator end() const noexcept { return CountingIterator(last); }
+		};
+	}
+
+	//=============================================================================================
+	// ScopedSubscription : 소멸 시 unsubscribe_and_wait (move-only)
+	//=============================================================================================
+	class ScopedSubscription
+	{
+	public:
+		using UnsubscribeFn = void (*)(void* hub, SubscriptionId id);
+
+		ScopedSubscription() noexcept = default;
+		ScopedSubscription(void* hub, SubscriptionId id, UnsubscribeFn unsubscribe) noexcept
+			: _hub(hub), _id(id), _unsubscribe(unsubscribe)
+		{}
+
+		ScopedSubscription(ScopedSubscription&& rhs) noexcept
+			: _hub(rhs._hub), _id(rhs._id), _unsubscribe(rhs._unsubscribe)
+		{
+			rhs._hub = nullptr;
+		}
+
+		ScopedSubscription& operator=(ScopedSubscription&& rhs) noexcept
+		{
+			if (this != &rhs) {
+				reset();
+				_hub = rhs._hub;
+				_id = rhs._id;
+				_unsubscribe = rhs._unsubscribe;
+				rhs._hub = nullptr;
+			}
+			return *this;
+		}
+
+		ScopedSubscription(const ScopedSubscription&) = delete;
+		ScopedSubscription& operator=(const ScopedSubscription&) = delete;
+
+		~ScopedSubscription() { reset(); }
+
+		void reset()
+		{
+			if (_hub) _unsubscribe(_hub, _id);
+			_hub = nullptr;
+		}
+
+		// 구독은 남기고 소유만 놓는다
+		SubscriptionId release() noexcept
+		{
+			_hub = nullptr;
+			return _id;
+		}
+
+		SubscriptionId id() const noexcept { return _id; }
+		explicit operator bool() const noexcept { return _hub != nullptr; }
+
+	private:
+		void* _hub = nullptr;
+		SubscriptionId _id = 0;
+		UnsubscribeFn _unsubscribe = nullptr;
+	};
+
+	//=============================================================================================
+	// EventHub
+	//=============================================================================================
+	template<typename... Args>
+	class EventHub
+	{
+	public:
+		using Callback = Delegates::Delegate<void(Args...)>;
+
+		explicit EventHub(const HubOptions& options = HubOptions())
+			: _options(options)
+			, _snapshot(new Snapshot)
+		{}
+
+		EventHub(const EventHub&) = delete;
+		EventHub& operator=(const EventHub&) = delete;
+
+		~EventHub()
+		{
+			Snapshot* snap = _snapshot.load(std::memory_order_relaxed);
+			for (Subscriber* s : snap->subscribers) delete s;
+			delete snap;
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// 구독
+		//-----------------------------------------------------------------------------------------
+		SubscriptionId subscribe(Callback fn)
+		{
+			return add(new Subscriber(std::move(fn)));
+		}
+
+		// guard 가 만료되면 호출하지 않고 일괄 제거 대상이 된다
+		SubscriptionId subscribe(std::weak_ptr<void> guard, Callback fn)
+		{
+			Subscriber* s = new Subscriber(std::move(fn));
+			s->target = std::move(guard);
+			s->weak = true;
+			return add(s);
+		}
+
+		// 객체는 약한 참조로만 보관 (허브가 수명을 늘리지 않는다)
+		template<typename T>
+		SubscriptionId subscribe(const std::shared_ptr<T>& target, void (T::*method)(Args...))
+		{
+			T* object = target.get();
+			return subscribe(std::weak_ptr<void>(target), Callback([object, method](Args... args) {
+				(object->*method)(std::forward<Args>(args)...);
+			}));
+		}
+
+		ScopedSubscription subscribe_scoped(Callback fn)
+		{
+			return ScopedSubscription(this, subscribe(std::move(fn)), [](void* hub, SubscriptionId id) {
+				static_cast<EventHub*>(hub)->unsubscribe_and_wait(id);
+			});
+		}
+
+		// 반환 후에는 이 콜백이 불리고 있지도, 불리지도 않는다 (fire 밖에서만)
+		bool unsubscribe_and_wait(SubscriptionId id)
+		{
+			const bool removed = unsubscribe(id);
+			if (removed) LockFree::EpochReclamation::synchronize();
+			return removed;
+		}
+
+		bool unsubscribe(SubscriptionId id)
+		{
+			std::lock_guard<std::mutex> lock(_writeLock);
+			Snapshot* current = _snapshot.load(std::memory_order_relaxed);
+
+			Subscriber* removed = nullptr;
+			Snapshot* next = new Snapshot;
+			next->subscribers.reserve(current->subscribers.size());
+			for (Subscriber* s : current->subscribers) {
+				if (s->id == id) removed = s;
+				else next->subscribers.push_back(s);
+			}
+			if (!removed) {
+				delete next;
+				return false;
+			}
+
+			// 먼저 만료 표시를 한 fire 가 이미 센 것이면 빼 준다 (표시는 한 번만 성공)
+			if (removed->expired.exchange(true, std::memory_order_relaxed)) _expiredCount.fetch_sub(1, std::memory_order_relaxed);
+			publish(current, next);
+			LockFree::EpochReclamation::retire(removed);
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// 발행
+		//-----------------------------------------------------------------------------------------
+		void fire(const Args&... args)
+		{
+			LockFree::EpochReclamation::Guard guard;
+			const Snapshot* snap = guard.protect(_snapshot);
+			invoke_range(snap->subscribers.data(), snap->subscribers.data() + snap->subscribers.size(), args...);
+
+			prune_if_needed();
+		}
+
+		// executor.submit_bulk(range, fn) 가 Future(기본 생성 가능, .get() 으로 대기) 를 돌려주면 된다
+		//   작업자와 호출한 스레드가 chunk 번호(next)를 나눠 가진다. 호출한 스레드는 아무도 가져가지 않은 chunk 를 직접 처리하고
+		//   작업자가 이미 시작한 chunk 만 기다린 뒤 guard 를 놓는다 => pool 의 다른 작업이 synchronize() 에서
+		//   (ScopedSubscription 파괴 등) 이 guard 를 기다려도 막히지 않는다. 작업(Future) 완료는 guard 밖에서 기다린다.
+		template<typename Executor>
+		void fire_parallel(Executor& executor, const Args&... args)
+		{
+			const size_t chunk = (std::max)(_options.parallel_chunk, size_t(1));
+
+			Subscriber* const* first = nullptr;
+			size_t count = 0;
+			size_t chunks = 0;
+			std::atomic<size_t> next{ 0 };      // 다음에 가져갈 chunk 번호
+			std::atomic<size_t> done{ 0 };      // 끝난 chunk 수 (예외로 끝난 것 포함)
+			std::atomic<bool> failed{ false };
+			std::exception_ptr error;           // 처음 던져진 예외 (done 의 release 로 공개)
+
+			// chunk 하나를 가져가 처리, 남은 것이 없으면 false
+			auto run_one = [&]() -> bool {
+				const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+				if (i >= chunks) return false;
+				try {
+					invoke_range(first + i * chunk, first + (std::min)(count, (i + 1) * chunk), args...);
+				}
+				catch (...) {
+					if (!failed.exchange(true, std::memory_order_relaxed)) error = std::current_exception();
+				}
+				done.fetch_add(1, std::memory_order_release);
+				return true;
+			};
+			auto work = [&run_one](size_t) { run_one(); };
+
+			// submit_bulk 의 range 는 Future 보다 오래 살아야 한다 (pending.get() 은 guard 블록 밖)
+			detail::CountingRange range{ 0, 0 };
+			decltype(executor.submit_bulk(range, work)) pending;
+			{
+				LockFree::EpochReclamation::Guard guard;
+				const Snapshot* snap = guard.protect(_snapshot);
+				first = snap->subscribers.data();
+				count = snap->subscribers.size();
+
+				if (count <= chunk) {
+					invoke_range(first, first + count, args...);
+				}
+				else {
+					chunks = (count + chunk - 1) / chunk;
+					range = detail::CountingRange{ 0, chunks - 1 };  // 호출한 스레드가 적어도 하나는 처리
+					pending = executor.submit_bulk(range, work);
+
+					while (run_one()) {}
+					while (done.load(std::memory_order_acquire) < chunks) std::this_thread::yield();
+				}
+			}
+
+			// 남은 작업은 chunk 를 가져가지 못하고 끝난다 (next, chunks 를 읽으므로 반환 전에 대기)
+			if (chunks) pending.get();
+			if (error) std::rethrow_exception(error);
+
+			prune_if_needed();
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// 만료된 약한 구독자 일괄 제거 (제거한 수)
+		//-----------------------------------------------------------------------------------------
+		size_t prune()
+		{
+			std::lock_guard<std::mutex> lock(_writeLock);
+			return prune_locked();
+		}
+
+		size_t size() const
+		{
+			LockFree::EpochReclamation::Guard guard;
+			return guard.protect(_snapshot)->subscribers.size();
+		}
+
+		size_t expired_count() const noexcept { return _expiredCount.load(std::memory_order_relaxed); }
+
+	private:
+		struct Subscriber
+		{
+			explicit Subscriber(Callback&& f) : fn(std::move(f)) {}
+
+			SubscriptionId id = 0;
+			Callback fn;
+			std::weak_ptr<void> target;
+			bool weak = false;
+			std::atomic<bool> expired{ false };
+		};
+
+		// 한 번 공개되면 바뀌지 않는다 (바꿀 때는 복사본을 만들어 교체)
+		struct Snapshot
+		{
+			std::vector<Subscriber*> subscribers;
+		};
+
+		SubscriptionId add(Subscriber* s)
+		{
+			std::unique_ptr<Subscriber> owner(s);
+			std::lock_guard<std::mutex> lock(_writeLock);
+			Snapshot* current = _snapshot.load(std::memory_order_relaxed);
+
+			std::unique_ptr<Snapshot> next(new Snapshot);
+			next->subscribers.reserve(current->subscribers.size() + 1);
+			next->subscribers = current->subscribers;
+			next->subscribers.push_back(s);
+
+			s->id = ++_nextId;
+			owner.release();
+			publish(current, next.release());
+			return s->id;
+		}
+
+		void publish(Snapshot* current, Snapshot* next)
+		{
+			_snapshot.store(next, std::memory_order_release);
+			LockFree::EpochReclamation::retire(current);
+		}
+
+		void invoke_range(Subscriber* const* first, Subscriber* const* last, const Args&... args)
+		{
+			for (; first != last; ++first) {
+				Subscriber* s = *first;
+				if (!s->weak) {
+					s->fn(args...);
+					continue;
+				}
+
+				if (s->expired.load(std::memory_order_relaxed)) continue;
+				if (std::shared_ptr<void> alive = s->target.lock()) {
+					s->fn(args...);
+				}
+				else if (!s->expired.exchange(true, std::memory_order_relaxed)) {
+					_expiredCount.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		void prune_if_needed()
+		{
+			if (_expiredCount.load(std::memory_order_relaxed) < (std::max)(_options.prune_batch, size_t(1))) return;
+
+			// 다른 스레드가 구독/제거 중이면 다음 fire 에 맡긴다
+			std::unique_lock<std::mutex> lock(_writeLock, std::try_to_lock);
+			if (lock.owns_lock()) prune_locked();
+		}
+
+		size_t prune_locked()
+		{
+			Snapshot* current = _snapshot.load(std::memory_order_relaxed);
+
+			std::vector<Subscriber*> removed;
+			Snapshot* next = new Snapshot;
+			next->subscribers.reserve(current->subscribers.size());
+			for (Subscriber* s : current->subscribers) {
+				if (s->expired.load(std::memory_order_relaxed)) removed.push_back(s);
+				else next->subscribers.push_back(s);
+			}
+			if (removed.empty()) {
+				delete next;
+				return 0;
+			}
+
+			_expiredCount.fetch_sub(removed.size(), std::memory_order_relaxed);
+			publish(current, next);
+			for (Subscriber* s : removed) LockFree::EpochReclamation::retire(s);
+			return removed.size();
+		}
+
+	private:
+		const HubOptions _options;
+		std::atomic<Snapshot*> _snapshot;
+		std::atomic<size_t> _expiredCount{ 0 };
+
+		std::mutex _writeLock;
+		SubscriptionId _nextId = 0;
+	};
+}//Events
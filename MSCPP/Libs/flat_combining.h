@@ -0,0 +1,145 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file flat_combining.h
+/// @brief flat-combining stack (Hendler, Incze, Shavit, Tzafrir 2010) (header-only, C++14)
+///
+///   각 스레드는 요청(push/pop)을 publication record에 올려 두고,
+///   lock을 잡은 한 스레드(combiner)가 모든 요청을 순차 std::vector에 한꺼번에 적용한다.
+///     - 공유 데이터는 combiner 한 명만 만지므로 cache line 이동이 lock 한 번 + record 수준으로 줄어듦
+///     - 같은 배치 안의 push/pop은 combiner가 그대로 짝지어 처리
+///   record는 op마다 빈 slot을 CAS로 점유하므로 스레드 수 제한/등록이 없다.
+///   T는 기본 생성 + move 가능해야 한다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+#include <utility>
+
+#include "backoff.h"
+
+
+namespace LockFree
+{
+	template<typename T>
+	class FlatCombiningStack
+	{
+	public:
+		using value_type = T;
+
+		static const size_t Records = 64;
+
+		FlatCombiningStack() : _lock(false) {}
+
+		FlatCombiningStack(const FlatCombiningStack&) = delete;
+		FlatCombiningStack& operator=(const FlatCombiningStack&) = delete;
+
+		void push(const T& value) { T v(value); push(std::move(v)); }
+
+		void push(T&& value)
+		{
+			Record& r = claim();
+			r.value = std::move(value);
+			r.state.store(OpPush, std::memory_order_release);
+			wait_or_combine(r);
+			r.state.store(Free, std::memory_order_release);
+		}
+
+		bool pop(T& out)
+		{
+			Record& r = claim();
+			r.state.store(OpPop, std::memory_order_release);
+			wait_or_combine(r);
+			const bool ok = r.ok;
+			if (ok) out = std::move(r.value);
+			r.state.store(Free, std::memory_order_release);
+			return ok;
+		}
+
+		bool empty()
+		{
+			lock();
+			const bool e = _items.empty();
+			unlock();
+			return e;
+		}
+
+	private:
+		enum : uint32_t { Free, Claimed, OpPush, OpPop, Done };
+
+		struct alignas(CacheLineSize) Record
+		{
+			std::atomic<uint32_t> state{ Free };
+			bool ok = false;
+			T value{};
+		};
+
+		Record& claim()
+		{
+			size_t i = detail::fast_rand() % Records;
+			for (;;) {
+				for (size_t n = 0; n < Records; ++n, i = (i + 1) % Records) {
+					uint32_t expected = Free;
+					if (_records[i].state.load(std::memory_order_relaxed) == Free &&
+						_records[i].state.compare_exchange_strong(expected, Claimed, std::memory_order_acquire)) {
+						return _records[i];
+					}
+				}
+				std::this_thread::yield();  // record보다 동시 요청이 많음
+			}
+		}
+
+		void wait_or_combine(Record& r)
+		{
+			ExponentialBackoff backoff;
+			for (;;) {
+				if (r.state.load(std::memory_order_acquire) == Done) return;
+
+				if (try_lock()) {
+					combine();
+					unlock();
+					return;     // 내 요청도 이번 배치에 포함됨
+				}
+				backoff.pause();
+			}
+		}
+
+		void combine()
+		{
+			for (auto& r : _records) {
+				const uint32_t s = r.state.load(std::memory_order_acquire);
+				if (OpPush == s) {
+					_items.push_back(std::move(r.value));
+					r.state.store(Done, std::memory_order_release);
+				}
+				else if (OpPop == s) {
+					r.ok = !_items.empty();
+					if (r.ok) {
+						r.value = std::move(_items.back());
+						_items.pop_back();
+					}
+					r.state.store(Done, std::memory_order_release);
+				}
+			}
+		}
+
+		bool try_lock()
+		{
+			return !_lock.load(std::memory_order_relaxed) && !_lock.exchange(true, std::memory_order_acquire);
+		}
+
+		void lock()
+		{
+			ExponentialBackoff backoff;
+			while (!try_lock()) backoff.pause();
+		}
+
+		void unlock() { _lock.store(false, std::memory_order_release); }
+
+		alignas(CacheLineSize) std::atomic<bool> _lock;
+		std::vector<T> _items;          // combiner만 접근
+		Record _records[Records];
+	};
+}//LockFree
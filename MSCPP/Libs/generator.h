@@ -0,0 +1,359 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file generator.h
+/// @brief co_yield 로 값을 내는 지연 range Coro::Generator<T> (header-only, C++20)
+///
+///   std::generator(C++23) 와 같은 모양
+///     - Generator<T> 는 std::ranges::view (input_range), 반복자 = input iterator + std::default_sentinel_t
+///       => range-for, std::ranges 알고리즘, views::filter/transform/take 에 그대로 쓴다
+///     - reference : T 가 참조가 아니면 T&&, 참조면 T 그대로 (Generator<const Node&> 등)
+///       co_yield 는 값의 주소만 넘긴다 (복사 없음, lvalue 를 const 로 받는 경우만 한 번 복사)
+///
+///   co_yield Coro::elements_of(gen) : 다른 Generator(또는 임의의 range)의 원소를 그대로 낸다
+///     재귀 Generator 를 그냥 "for (x : child) co_yield x;" 로 쓰면 원소 하나가 깊이만큼 coroutine 을 거쳐 올라온다(O(depth)).
+///     elements_of 는 root 가 가장 안쪽(leaf) coroutine 을 직접 resume 하고,
+///     안쪽이 끝나면 final_suspend 에서 부모로 symmetric transfer 한다 => 원소당 O(1), 호출 스택도 깊어지지 않는다.
+///     안쪽에서 난 예외는 co_yield elements_of(...) 지점에서 다시 던져진다.
+///
+///   coroutine frame 할당
+///     Generator<T>                 : 첫 인자가 std::allocator_arg, alloc 이면 그 allocator 로 (type-erased, frame 뒤에 저장)
+///                                    아니면 operator new
+///     Generator<T, Allocator>      : 기본 생성한 Allocator (allocator_arg 로 넘기면 그것)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <coroutine>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+
+namespace Coro
+{
+	template<typename T, typename Allocator = void>
+	class Generator;
+
+	// co_yield elements_of(range) : range 의 원소를 하나씩 낸다 (Generator 면 재귀 위임)
+	template<typename Range, typename Allocator = std::allocator<std::byte>>
+	struct elements_of
+	{
+		[[no_unique_address]] Range range;
+		[[no_unique_address]] Allocator allocator = Allocator();
+	};
+
+	template<typename Range, typename Allocator = std::allocator<std::byte>>
+	elements_of(Range&&, Allocator = Allocator()) -> elements_of<Range&&, Allocator>;
+
+	namespace detail
+	{
+		//=========================================================================================
+		// frame 할당 : [frame | 해제 함수 | allocator] 를 한 번에 잡는다
+		//=========================================================================================
+		template<typename Allocator>
+		struct PromiseAllocator;
+
+		template<>
+		struct PromiseAllocator<void>
+		{
+			using Deallocate = void (*)(void* frame, size_t size) noexcept;
+
+			struct alignas(alignof(std::max_align_t)) Block
+			{
+				std::byte bytes[alignof(std::max_align_t)];
+			};
+
+			static constexpr size_t align(size_t n) noexcept { return (n + sizeof(Block) - 1) & ~(sizeof(Block) - 1); }
+
+			static void* operator new(size_t size)
+			{
+				void* frame = ::operator new(align(size) + sizeof(Deallocate));
+				store(frame, size, [](void* p, size_t) noexcept { ::operator delete(p); });
+				return frame;
+			}
+
+			template<typename Alloc, typename... Args>
+			static void* operator new(size_t size, std::allocator_arg_t, const Alloc& alloc, const Args&...)
+			{
+				return allocate_with(alloc, size);
+			}
+
+			// 멤버 함수 coroutine (첫 인자 = *this)
+			template<typename This, typename Alloc, typename... Args>
+			static void* operator new(size_t size, const This&, std::allocator_arg_t, const Alloc& alloc, const Args&...)
+			{
+				return allocate_with(alloc, size);
+			}
+
+			static void operator delete(void* frame, size_t size) noexcept
+			{
+				Deallocate deallocate;
+				std::memcpy(&deallocate, static_cast<std::byte*>(frame) + align(size), sizeof(deallocate));
+				deallocate(frame, size);
+			}
+
+		protected:
+			static void store(void* frame, size_t size, Deallocate deallocate) noexcept
+			{
+				std::memcpy(static_cast<std::byte*>(frame) + align(size), &deallocate, sizeof(deallocate));
+			}
+
+			template<typename Alloc>
+			static void* allocate_with(const Alloc& source, size_t size)
+			{
+				using Rebound = typename std::allocator_traits<Alloc>::template rebind_alloc<Block>;
+				static_assert(alignof(Rebound) <= sizeof(Block), "over-aligned allocators are not supported");
+
+				Rebound alloc(source);
+				const size_t offset = align(align(size) + sizeof(Deallocate));     // allocator 위치
+				const size_t blocks = (offset + sizeof(Rebound) + sizeof(Block) - 1) / sizeof(Block);
+
+				void* frame = std::allocator_traits<Rebound>::allocate(alloc, blocks);
+				::new (static_cast<std::byte*>(frame) + offset) Rebound(std::move(alloc));
+				store(frame, size, [](void* p, size_t n) noexcept {
+					const size_t at = align(align(n) + sizeof(Deallocate));
+					Rebound* stored = std::launder(reinterpret_cast<Rebound*>(static_cast<std::byte*>(p) + at));
+					Rebound a(std::move(*stored));
+					stored->~Rebound();
+					std::allocator_traits<Rebound>::deallocate(a, static_cast<Block*>(p), (at + sizeof(Rebound) + sizeof(Block) - 1) / sizeof(Block));
+				});
+				return frame;
+			}
+		};
+
+		template<typename Allocator>
+		struct PromiseAllocator : PromiseAllocator<void>
+		{
+			using PromiseAllocator<void>::operator new;
+
+			static void* operator new(size_t size) requires std::default_initializable<Allocator>
+			{
+				return allocate_with(Allocator(), size);
+			}
+		};
+
+		//=========================================================================================
+		// promise 공통 : yield 된 값 pointer 와 중첩(elements_of) 연결
+		//   root   : _active = 지금 resume 할 가장 안쪽 coroutine, _value = 반복자가 읽는 값
+		//   nested : _root / _parent 연결, 예외는 부모의 awaiter 로
+		//=========================================================================================
+		template<typename Yielded>
+		class PromiseBase
+		{
+		public:
+			using Pointer = std::add_pointer_t<Yielded>;
+
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept { return false; }
+
+				template<typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept
+				{
+					PromiseBase& promise = self.promise();
+					if (nullptr == promise._parent) return std::noop_coroutine();       // root 끝 => 반복자에게
+
+					promise._root->_active = promise._parentHandle;
+					return promise._parentHandle;                                       // symmetric transfer
+				}
+
+				void await_resume() const noexcept {}
+			};
+
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+
+			FinalAwaiter final_suspend() noexcept { return {}; }
+
+			std::suspend_always yield_value(Yielded value) noexcept
+			{
+				_root->_value = std::addressof(value);
+				return {};
+			}
+
+			// const lvalue 를 T&& 로 내야 할 때는 복사본을 awaiter(=frame) 에 두고 그 주소를 낸다
+			auto yield_value(const std::remove_reference_t<Yielded>& value)
+				requires std::is_rvalue_reference_v<Yielded> && std::constructible_from<std::remove_cvref_t<Yielded>, const std::remove_reference_t<Yielded>&>
+			{
+				struct CopyAwaiter
+				{
+					std::remove_cvref_t<Yielded> copy;
+					PromiseBase* root;
+
+					bool await_ready() const noexcept { return false; }
+					void await_suspend(std::coroutine_handle<>) noexcept { root->_value = std::addressof(copy); }
+					void await_resume() const noexcept {}
+				};
+				return CopyAwaiter{ value, _root };
+			}
+
+			template<typename T, typename Alloc, typename Unused>
+			auto yield_value(elements_of<Generator<T, Alloc>&&, Unused> nested) noexcept
+			{
+				static_assert(std::is_same_v<typename Generator<T, Alloc>::yielded, Yielded>, "elements_of: nested generator must yield the same reference type");
+				return NestedAwaiter<Generator<T, Alloc>>{ std::move(nested.range) };
+			}
+
+			template<typename T, typename Alloc, typename Unused>
+			auto yield_value(elements_of<Generator<T, Alloc>&, Unused> nested) noexcept
+			{
+				return yield_value(elements_of<Generator<T, Alloc>&&, Unused>{ std::move(nested.range), nested.allocator });
+			}
+
+			// Generator 가 아닌 range : 원소를 하나씩 내는 Generator 로 감싼다
+			template<std::ranges::input_range Range, typename Alloc>
+				requires std::convertible_to<std::ranges::range_reference_t<Range>, const std::remove_reference_t<Yielded>&>
+			auto yield_value(elements_of<Range, Alloc> r)
+			{
+				auto each = [](std::allocator_arg_t, Alloc, std::ranges::iterator_t<Range> it, std::ranges::sentinel_t<Range> end)
+					-> Generator<Yielded, Alloc> {
+					for (; it != end; ++it) co_yield *it;
+				};
+				return yield_value(elements_of(each(std::allocator_arg, r.allocator, std::ranges::begin(r.range), std::ranges::end(r.range))));
+			}
+
+			void await_transform() = delete;    // generator 안에서 co_await 금지
+			void return_void() const noexcept {}
+
+			void unhandled_exception()
+			{
+				if (nullptr == _parent) throw;      // root => resume 한 반복자에게
+				*_exception = std::current_exception();
+			}
+
+		protected:
+			template<typename, typename> friend class Coro::Generator;
+
+			template<typename Gen>
+			struct NestedAwaiter
+			{
+				Gen generator;
+				std::exception_ptr exception{};
+
+				bool await_ready() const noexcept { return !generator._handle; }
+
+				template<typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept
+				{
+					PromiseBase& current = self.promise();
+					PromiseBase& nested = generator._handle.promise();
+					nested._root = current._root;
+					nested._parent = &current;
+					nested._parentHandle = self;
+					nested._exception = &exception;
+					current._root->_active = generator._handle;
+					return generator._handle;           // 안쪽 coroutine 으로 바로 (반복자를 거치지 않음)
+				}
+
+				void await_resume()
+				{
+					if (exception) std::rethrow_exception(exception);
+				}
+			};
+
+			PromiseBase* _root = this;
+			std::coroutine_handle<> _active;            // root 에서만
+			Pointer _value = nullptr;                   // root 에서만
+
+			PromiseBase* _parent = nullptr;
+			std::coroutine_handle<> _parentHandle;
+			std::exception_ptr* _exception = nullptr;
+		};
+	}
+
+	//=============================================================================================
+	// Generator<T, Allocator>
+	//=============================================================================================
+	template<typename T, typename Allocator>
+	class Generator : public std::ranges::view_interface<Generator<T, Allocator>>
+	{
+	public:
+		using value_type = std::remove_cvref_t<T>;
+		using reference = std::conditional_t<std::is_reference_v<T>, T, T&&>;
+		using yielded = std::conditional_t<std::is_reference_v<reference>, reference, const reference&>;
+
+		struct promise_type : detail::PromiseBase<yielded>, detail::PromiseAllocator<Allocator>
+		{
+			Generator get_return_object() noexcept
+			{
+				const auto handle = std::coroutine_handle<promise_type>::from_promise(*this);
+				this->_active = handle;
+				return Generator(handle);
+			}
+		};
+
+		class iterator
+		{
+		public:
+			using value_type = Generator::value_type;
+			using difference_type = std::ptrdiff_t;
+
+			iterator(iterator&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+			iterator& operator=(iterator&& other) noexcept
+			{
+				_handle = std::exchange(other._handle, nullptr);
+				return *this;
+			}
+
+			reference operator*() const noexcept { return static_cast<reference>(*_handle.promise()._value); }
+
+			iterator& operator++()
+			{
+				_handle.promise()._active.resume();
+				return *this;
+			}
+
+			void operator++(int) { ++*this; }
+
+			friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return it._handle.done(); }
+
+		private:
+			friend class Generator;
+			explicit iterator(std::coroutine_handle<promise_type> handle) noexcept : _handle(handle) {}
+
+			std::coroutine_handle<promise_type> _handle;
+		};
+
+		Generator() noexcept = default;
+		Generator(Generator&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+
+		Generator& operator=(Generator&& other) noexcept
+		{
+			if (this != &other) {
+				if (_handle) _handle.destroy();
+				_handle = std::exchange(other._handle, nullptr);
+			}
+			return *this;
+		}
+
+		Generator(const Generator&) = delete;
+		Generator& operator=(const Generator&) = delete;
+
+		~Generator()
+		{
+			if (_handle) _handle.destroy();
+		}
+
+		// 한 번만 부른다 (input range)
+		iterator begin()
+		{
+			_handle.promise()._active.resume();
+			return iterator(_handle);
+		}
+
+		std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+	private:
+		template<typename> friend class detail::PromiseBase;
+
+		explicit Generator(std::coroutine_handle<promise_type> handle) noexcept : _handle(handle) {}
+
+		std::coroutine_handle<promise_type> _handle = nullptr;
+	};
+}//Coro
+
+template<typename T, typename Allocator>
+inline constexpr bool std::ranges::enable_view<Coro::Generator<T, Allocator>> = true;
@@ -0,0 +1,711 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file int128.h
+/// @brief 128-bit 정수 Wide::uint128 / Wide::int128 (header-only, C++14)
+///
+///   저장은 항상 uint64_t 두 개(lo, hi). 연산은 컴파일러가 가진 것 중 가장 빠른 경로로
+///     GCC/Clang (__SIZEOF_INT128__) : unsigned __int128 로 바꿔서 그대로 (mul = mul 한 번, div = __udivti3)
+///     MSVC x64                      : _umul128 / _udiv128 (VS2019+) intrinsic
+///     그 외 (MSVC x86/ARM ...)       : 32-bit 조각 곱셈 + Hacker's Delight divlu (128/64) 나눗셈
+///
+///   constexpr : 모든 연산자. 단 MSVC x64 + C++20 미만에서는 곱셈/나눗셈이 intrinsic 이라 constexpr 이 아니다
+///               (C++20 이면 std::is_constant_evaluated 로 컴파일 시간에는 portable 경로를 탄다)
+///   overflow 는 builtin 정수처럼 2^128 으로 감싼다. 0 으로 나누기, 범위 밖 shift(<0, >=128)는 정의되지 않음
+///
+///   to_chars / from_chars (10 진수)
+///     10^19 단위로 잘라서(128/64 나눗셈 최대 2 번) 64-bit 조각을 두 자리 표로 찍는다
+///     => 자리마다 128-bit %10 을 하는 단순 구현보다 훨씬 적은 나눗셈
+///     from_chars 는 19 자리씩 uint64_t 로 모은 뒤 acc * 10^k + chunk (overflow 검사)
+///     결과/오류는 std::to_chars 와 같은 모양 (ptr, std::errc)
+///
+///   고정 소수점용 : umul(a, b) (64x64 -> 128), mul_div(a, b, c) (= a * b / c, 중간값 128-bit)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#if defined(_MSVC_LANG)
+#define INT128_CPLUSPLUS _MSVC_LANG
+#else
+#define INT128_CPLUSPLUS __cplusplus
+#endif
+
+#if !defined(INT128_HAS_BUILTIN)
+#if defined(__SIZEOF_INT128__)
+#define INT128_HAS_BUILTIN 1
+#else
+#define INT128_HAS_BUILTIN 0
+#endif
+#endif
+
+#if !defined(INT128_HAS_MSVC_INTRINSICS)
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#define INT128_HAS_MSVC_INTRINSICS 1
+#else
+#define INT128_HAS_MSVC_INTRINSICS 0
+#endif
+#endif
+
+#if INT128_HAS_MSVC_INTRINSICS
+#include <intrin.h>
+#endif
+
+// 컴파일 시간 평가면 intrinsic 대신 portable 경로
+#if !defined(INT128_HAS_IS_CONSTANT_EVALUATED)
+#if INT128_CPLUSPLUS >= 202002L && defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#if defined(__cpp_lib_is_constant_evaluated)
+#define INT128_HAS_IS_CONSTANT_EVALUATED 1
+#else
+#define INT128_HAS_IS_CONSTANT_EVALUATED 0
+#endif
+#endif
+
+// 곱셈/나눗셈에 붙는 constexpr (MSVC x64 + C++17 이하만 빠진다)
+#if !INT128_HAS_BUILTIN && INT128_HAS_MSVC_INTRINSICS && !INT128_HAS_IS_CONSTANT_EVALUATED
+#define INT128_CONSTEXPR_MULDIV inline
+#else
+#define INT128_CONSTEXPR_MULDIV constexpr
+#endif
+
+
+namespace Wide
+{
+	class uint128;
+	class int128;
+
+	struct to_chars_result
+	{
+		char* ptr;
+		std::errc ec;
+	};
+
+	struct from_chars_result
+	{
+		const char* ptr;
+		std::errc ec;
+	};
+
+	namespace detail
+	{
+#if INT128_HAS_BUILTIN
+		__extension__ typedef unsigned __int128 builtin_u128;
+		__extension__ typedef __int128 builtin_i128;
+#endif
+
+		template<typename T>
+		using EnableIfInteger = typename std::enable_if<std::is_integral<T>::value, int>::type;
+
+		template<typename T>
+		constexpr bool is_negative(T v, std::true_type) noexcept { return v < 0; }
+		template<typename T>
+		constexpr bool is_negative(T, std::false_type) noexcept { return false; }
+		template<typename T>
+		constexpr bool is_negative(T v) noexcept { return is_negative(v, std::is_signed<T>()); }
+
+		constexpr int clz64(uint64_t v) noexcept        // v != 0
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_clzll(v);
+#else
+			int n = 0;
+			if (0 == (v >> 32)) { n += 32; v <<= 32; }
+			if (0 == (v >> 48)) { n += 16; v <<= 16; }
+			if (0 == (v >> 56)) { n += 8; v <<= 8; }
+			if (0 == (v >> 60)) { n += 4; v <<= 4; }
+			if (0 == (v >> 62)) { n += 2; v <<= 2; }
+			if (0 == (v >> 63)) { n += 1; }
+			return n;
+#endif
+		}
+
+		// 64 x 64 -> 128 (32-bit 조각 4 개)
+		constexpr uint64_t mul64_portable(uint64_t a, uint64_t b, uint64_t& hi) noexcept
+		{
+			const uint64_t a0 = a & 0xFFFFFFFFu, a1 = a >> 32;
+			const uint64_t b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+			const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+			const uint64_t middle = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+			hi = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+			return (middle << 32) | (p00 & 0xFFFFFFFFu);
+		}
+
+		// (u1:u0) / v, u1 < v 여야 한다 (Hacker's Delight, divlu)
+		constexpr uint64_t div128by64_portable(uint64_t u1, uint64_t u0, uint64_t v, uint64_t& r) noexcept
+		{
+			const uint64_t b = 1ull << 32;
+			const int s = clz64(v);
+			v <<= s;
+			const uint64_t vn1 = v >> 32, vn0 = v & 0xFFFFFFFFu;
+			const uint64_t un32 = (u1 << s) | (s ? u0 >> (64 - s) : 0);
+			const uint64_t un10 = u0 << s;
+			const uint64_t un1 = un10 >> 32, un0 = un10 & 0xFFFFFFFFu;
+
+			uint64_t q1 = un32 / vn1;
+			uint64_t rhat = un32 - q1 * vn1;
+			while (q1 >= b || q1 * vn0 > b * rhat + un1) {
+				--q1;
+				rhat += vn1;
+				if (rhat >= b) break;
+			}
+
+			const uint64_t un21 = un32 * b + un1 - q1 * v;
+			uint64_t q0 = un21 / vn1;
+			rhat = un21 - q0 * vn1;
+			while (q0 >= b || q0 * vn0 > b * rhat + un0) {
+				--q0;
+				rhat += vn1;
+				if (rhat >= b) break;
+			}
+
+			r = (un21 * b + un0 - q0 * v) >> s;
+			return q1 * b + q0;
+		}
+
+		INT128_CONSTEXPR_MULDIV uint64_t mul64(uint64_t a, uint64_t b, uint64_t& hi) noexcept
+		{
+#if INT128_HAS_BUILTIN
+			const builtin_u128 p = static_cast<builtin_u128>(a) * b;
+			hi = static_cast<uint64_t>(p >> 64);
+			return static_cast<uint64_t>(p);
+#elif INT128_HAS_MSVC_INTRINSICS && INT128_HAS_IS_CONSTANT_EVALUATED
+			if (std::is_constant_evaluated()) return mul64_portable(a, b, hi);
+			return _umul128(a, b, &hi);
+#elif INT128_HAS_MSVC_INTRINSICS
+			return _umul128(a, b, &hi);
+#else
+			return mul64_portable(a, b, hi);
+#endif
+		}
+
+		// (u1:u0) / v, u1 < v
+		INT128_CONSTEXPR_MULDIV uint64_t div128by64(uint64_t u1, uint64_t u0, uint64_t v, uint64_t& r) noexcept
+		{
+#if INT128_HAS_BUILTIN
+			const builtin_u128 u = (static_cast<builtin_u128>(u1) << 64) | u0;
+			r = static_cast<uint64_t>(u % v);
+			return static_cast<uint64_t>(u / v);
+#elif INT128_HAS_MSVC_INTRINSICS && _MSC_VER >= 1920 && INT128_HAS_IS_CONSTANT_EVALUATED
+			if (std::is_constant_evaluated()) return div128by64_portable(u1, u0, v, r);
+			return _udiv128(u1, u0, v, &r);
+#elif INT128_HAS_MSVC_INTRINSICS && _MSC_VER >= 1920
+			return _udiv128(u1, u0, v, &r);
+#else
+			return div128by64_portable(u1, u0, v, r);
+#endif
+		}
+	}
+
+	//=============================================================================================
+	// uint128
+	//=============================================================================================
+	class uint128
+	{
+	public:
+		constexpr uint128() noexcept : _lo(0), _hi(0) {}
+
+		// 음수는 builtin 처럼 부호 확장 (uint128(-1) == max)
+		template<typename T, detail::EnableIfInteger<T> = 0>
+		constexpr uint128(T v) noexcept : _lo(static_cast<uint64_t>(v)), _hi(detail::is_negative(v) ? ~0ull : 0) {}
+
+		static constexpr uint128 make(uint64_t hi, uint64_t lo) noexcept { return uint128(hi, lo, 0); }
+
+#if INT128_HAS_BUILTIN
+		constexpr uint128(detail::builtin_u128 v) noexcept : _lo(static_cast<uint64_t>(v)), _hi(static_cast<uint64_t>(v >> 64)) {}
+		constexpr detail::builtin_u128 builtin() const noexcept { return (static_cast<detail::builtin_u128>(_hi) << 64) | _lo; }
+#endif
+
+		constexpr uint64_t low() const noexcept { return _lo; }
+		constexpr uint64_t high() const noexcept { return _hi; }
+
+		constexpr explicit operator bool() const noexcept { return 0 != (_lo | _hi); }
+
+		template<typename T, detail::EnableIfInteger<T> = 0>
+		constexpr explicit operator T() const noexcept { return static_cast<T>(_lo); }
+
+		// builtin 과 같게 반올림 : 상위 64 bit 로 정규화하고 버린 bit 는 최하위 bit(sticky) 로
+		constexpr explicit operator double() const noexcept
+		{
+#if INT128_HAS_BUILTIN
+			return static_cast<double>(builtin());
+#else
+			if (0 == _hi) return static_cast<double>(_lo);
+			const int n = detail::clz64(_hi);
+			const uint128 top = *this << n;
+			const uint64_t sticky = 0 != top._lo ? 1 : 0;
+			const double scale = 0 == n ? 18446744073709551616.0 : static_cast<double>(1ull << (64 - n));
+			return static_cast<double>(top._hi | sticky) * scale;
+#endif
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// 산술
+		//-----------------------------------------------------------------------------------------
+		friend constexpr uint128 operator+(uint128 a, uint128 b) noexcept
+		{
+			const uint64_t lo = a._lo + b._lo;
+			return uint128(a._hi + b._hi + (lo < a._lo ? 1 : 0), lo, 0);
+		}
+
+		friend constexpr uint128 operator-(uint128 a, uint128 b) noexcept
+		{
+			return uint128(a._hi - b._hi - (a._lo < b._lo ? 1 : 0), a._lo - b._lo, 0);
+		}
+
+		friend INT128_CONSTEXPR_MULDIV uint128 operator*(uint128 a, uint128 b) noexcept
+		{
+#if INT128_HAS_BUILTIN
+			return uint128(a.builtin() * b.builtin());
+#else
+			uint64_t hi = 0;
+			const uint64_t lo = detail::mul64(a._lo, b._lo, hi);
+			return uint128(hi + a._lo * b._hi + a._hi * b._lo, lo, 0);
+#endif
+		}
+
+		// 몫과 나머지를 한 번에 (v != 0)
+		static INT128_CONSTEXPR_MULDIV uint128 divmod(uint128 u, uint128 v, uint128& remainder) noexcept
+		{
+#if INT128_HAS_BUILTIN
+			remainder = uint128(u.builtin() % v.builtin());
+			return uint128(u.builtin() / v.builtin());
+#else
+			uint64_t r = 0;
+			if (0 == v._hi) {
+				// 128 / 64 : 상위 64 bit 를 먼저 나누고 나머지를 이어서
+				const uint64_t qhi = u._hi / v._lo;
+				const uint64_t qlo = detail::div128by64(u._hi % v._lo, u._lo, v._lo, r);
+				remainder = uint128(0, r, 0);
+				return uint128(qhi, qlo, 0);
+			}
+
+			// 제수 >= 2^64 => 몫 < 2^64 (Hacker's Delight divllu : 정규화한 상위 64 bit 로 어림한 뒤 한 번 보정)
+			const int n = detail::clz64(v._hi);
+			const uint64_t v1 = (v << n)._hi;
+			const uint128 u1 = u >> 1;
+			uint64_t q = detail::div128by64(u1._hi, u1._lo, v1, r);
+			q >>= 63 - n;
+			if (0 != q) --q;
+			uint128 rem = u - uint128(q) * v;
+			if (rem >= v) {
+				++q;
+				rem = rem - v;
+			}
+			remainder = rem;
+			return uint128(q);
+#endif
+		}
+
+		friend INT128_CONSTEXPR_MULDIV uint128 operator/(uint128 a, uint128 b) noexcept
+		{
+			uint128 r;
+			return divmod(a, b, r);
+		}
+
+		friend INT128_CONSTEXPR_MULDIV uint128 operator%(uint128 a, uint128 b) noexcept
+		{
+			uint128 r;
+			divmod(a, b, r);
+			return r;
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// bit
+		//-----------------------------------------------------------------------------------------
+		friend constexpr uint128 operator&(uint128 a, uint128 b) noexcept { return uint128(a._hi & b._hi, a._lo & b._lo, 0); }
+		friend constexpr uint128 operator|(uint128 a, uint128 b) noexcept { return uint128(a._hi | b._hi, a._lo | b._lo, 0); }
+		friend constexpr uint128 operator^(uint128 a, uint128 b) noexcept { return uint128(a._hi ^ b._hi, a._lo ^ b._lo, 0); }
+		constexpr uint128 operator~() const noexcept { return uint128(~_hi, ~_lo, 0); }
+
+		friend constexpr uint128 operator<<(uint128 a, int n) noexcept
+		{
+			return 0 == n ? a
+				: n >= 64 ? uint128(a._lo << (n - 64), 0, 0)
+				: uint128((a._hi << n) | (a._lo >> (64 - n)), a._lo << n, 0);
+		}
+
+		friend constexpr uint128 operator>>(uint128 a, int n) noexcept
+		{
+			return 0 == n ? a
+				: n >= 64 ? uint128(0, a._hi >> (n - 64), 0)
+				: uint128(a._hi >> n, (a._lo >> n) | (a._hi << (64 - n)), 0);
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// 비교
+		//-----------------------------------------------------------------------------------------
+		friend constexpr bool operator==(uint128 a, uint128 b) noexcept { return a._lo == b._lo && a._hi == b._hi; }
+		friend constexpr bool operator!=(uint128 a, uint128 b) noexcept { return !(a == b); }
+		friend constexpr bool operator<(uint128 a, uint128 b) noexcept { return a._hi != b._hi ? a._hi < b._hi : a._lo < b._lo; }
+		friend constexpr bool operator>(uint128 a, uint128 b) noexcept { return b < a; }
+		friend constexpr bool operator<=(uint128 a, uint128 b) noexcept { return !(b < a); }
+		friend constexpr bool operator>=(uint128 a, uint128 b) noexcept { return !(a < b); }
+
+		//-----------------------------------------------------------------------------------------
+		// 단항 / 복합 대입
+		//-----------------------------------------------------------------------------------------
+		constexpr uint128 operator+() const noexcept { return *this; }
+		constexpr uint128 operator-() const noexcept { return uint128() - *this; }
+
+		constexpr uint128& operator++() noexcept { return *this = *this + 1; }
+		constexpr uint128& operator--() noexcept { return *this = *this - 1; }
+		constexpr uint128 operator++(int) noexcept { const uint128 old = *this; ++*this; return old; }
+		constexpr uint128 operator--(int) noexcept { const uint128 old = *this; --*this; return old; }
+
+		constexpr uint128& operator+=(uint128 v) noexcept { return *this = *this + v; }
+		constexpr uint128& operator-=(uint128 v) noexcept { return *this = *this - v; }
+		INT128_CONSTEXPR_MULDIV uint128& operator*=(uint128 v) noexcept { return *this = *this * v; }
+		INT128_CONSTEXPR_MULDIV uint128& operator/=(uint128 v) noexcept { return *this = *this / v; }
+		INT128_CONSTEXPR_MULDIV uint128& operator%=(uint128 v) noexcept { return *this = *this % v; }
+		constexpr uint128& operator&=(uint128 v) noexcept { return *this = *this & v; }
+		constexpr uint128& operator|=(uint128 v) noexcept { return *this = *this | v; }
+		constexpr uint128& operator^=(uint128 v) noexcept { return *this = *this ^ v; }
+		constexpr uint128& operator<<=(int n) noexcept { return *this = *this << n; }
+		constexpr uint128& operator>>=(int n) noexcept { return *this = *this >> n; }
+
+	private:
+		constexpr uint128(uint64_t hi, uint64_t lo, int) noexcept : _lo(lo), _hi(hi) {}
+
+		uint64_t _lo;
+		uint64_t _hi;
+	};
+
+	//=============================================================================================
+	// int128 (2 의 보수, 덧셈/뺄셈/곱셈/bit 연산은 uint128 과 같은 bit)
+	//=============================================================================================
+	class int128
+	{
+	public:
+		constexpr int128() noexcept : _v() {}
+
+		template<typename T, detail::EnableIfInteger<T> = 0>
+		constexpr int128(T v) noexcept : _v(v) {}
+
+		constexpr explicit int128(uint128 v) noexcept : _v(v) {}
+
+		static constexpr int128 make(int64_t hi, uint64_t lo) noexcept { return int128(uint128::make(static_cast<uint64_t>(hi), lo)); }
+
+#if INT128_HAS_BUILTIN
+		constexpr int128(detail::builtin_i128 v) noexcept : _v(static_cast<detail::builtin_u128>(v)) {}
+		constexpr detail::builtin_i128 builtin() const noexcept { return static_cast<detail::builtin_i128>(_v.builtin()); }
+#endif
+
+		constexpr uint64_t low() const noexcept { return _v.low(); }
+		constexpr int64_t high() const noexcept { return static_cast<int64_t>(_v.high()); }
+		constexpr bool negative() const noexcept { return high() < 0; }
+
+		constexpr explicit operator uint128() const noexcept { return _v; }
+		constexpr explicit operator bool() const noexcept { return static_cast<bool>(_v); }
+
+		template<typename T, detail::EnableIfInteger<T> = 0>
+		constexpr explicit operator T() const noexcept { return static_cast<T>(_v.low()); }
+
+		constexpr explicit operator double() const noexcept
+		{
+#if INT128_HAS_BUILTIN
+			return static_cast<double>(builtin());
+#else
+			return negative() ? -static_cast<double>(-_v) : static_cast<double>(_v);
+#endif
+		}
+
+		friend constexpr int128 operator+(int128 a, int128 b) noexcept { return int128(a._v + b._v); }
+		friend constexpr int128 operator-(int128 a, int128 b) noexcept { return int128(a._v - b._v); }
+		friend INT128_CONSTEXPR_MULDIV int128 operator*(int128 a, int128 b) noexcept { return int128(a._v * b._v); }
+
+		// 0 쪽으로 자르는 나눗셈, 나머지 부호 = 피제수 부호 (builtin 과 같음)
+		friend INT128_CONSTEXPR_MULDIV int128 operator/(int128 a, int128 b) noexcept
+		{
+			const uint128 q = a.magnitude() / b.magnitude();
+			return int128(a.negative() != b.negative() ? -q : q);
+		}
+
+		friend INT128_CONSTEXPR_MULDIV int128 operator%(int128 a, int128 b) noexcept
+		{
+			const uint128 r = a.magnitude() % b.magnitude();
+			return int128(a.negative() ? -r : r);
+		}
+
+		friend constexpr int128 operator&(int128 a, int128 b) noexcept { return int128(a._v & b._v); }
+		friend constexpr int128 operator|(int128 a, int128 b) noexcept { return int128(a._v | b._v); }
+		friend constexpr int128 operator^(int128 a, int128 b) noexcept { return int128(a._v ^ b._v); }
+		constexpr int128 operator~() const noexcept { return int128(~_v); }
+
+		friend constexpr int128 operator<<(int128 a, int n) noexcept { return int128(a._v << n); }
+
+		// 산술 shift (부호 bit 채움)
+		friend constexpr int128 operator>>(int128 a, int n) noexcept
+		{
+			return a.negative() ? int128(~(~a._v >> n)) : int128(a._v >> n);
+		}
+
+		friend constexpr bool operator==(int128 a, int128 b) noexcept { return a._v == b._v; }
+		friend constexpr bool operator!=(int128 a, int128 b) noexcept { return a._v != b._v; }
+		friend constexpr bool operator<(int128 a, int128 b) noexcept { return a.high() != b.high() ? a.high() < b.high() : a.low() < b.low(); }
+		friend constexpr bool operator>(int128 a, int128 b) noexcept { return b < a; }
+		friend constexpr bool operator<=(int128 a, int128 b) noexcept { return !(b < a); }
+		friend constexpr bool operator>=(int128 a, int128 b) noexcept { return !(a < b); }
+
+		constexpr int128 operator+() const noexcept { return *this; }
+		constexpr int128 operator-() const noexcept { return int128(-_v); }
+
+		constexpr int128& operator++() noexcept { return *this = *this + 1; }
+		constexpr int128& operator--() noexcept { return *this = *this - 1; }
+		constexpr int128 operator++(int) noexcept { const int128 old = *this; ++*this; return old; }
+		constexpr int128 operator--(int) noexcept { const int128 old = *this; --*this; return old; }
+
+		constexpr int128& operator+=(int128 v) noexcept { return *this = *this + v; }
+		constexpr int128& operator-=(int128 v) noexcept { return *this = *this - v; }
+		INT128_CONSTEXPR_MULDIV int128& operator*=(int128 v) noexcept { return *this = *this * v; }
+		INT128_CONSTEXPR_MULDIV int128& operator/=(int128 v) noexcept { return *this = *this / v; }
+		INT128_CONSTEXPR_MULDIV int128& operator%=(int128 v) noexcept { return *this = *this % v; }
+		constexpr int128& operator&=(int128 v) noexcept { return *this = *this & v; }
+		constexpr int128& operator|=(int128 v) noexcept { return *this = *this | v; }
+		constexpr int128& operator^=(int128 v) noexcept { return *this = *this ^ v; }
+		constexpr int128& operator<<=(int n) noexcept { return *this = *this << n; }
+		constexpr int128& operator>>=(int n) noexcept { return *this = *this >> n; }
+
+		// |v| (INT128_MIN 은 2^127 그대로)
+		constexpr uint128 magnitude() const noexcept { return negative() ? -_v : _v; }
+
+	private:
+		uint128 _v;
+	};
+
+	//=============================================================================================
+	// 고정 소수점용
+	//=============================================================================================
+	INT128_CONSTEXPR_MULDIV uint128 umul(uint64_t a, uint64_t b) noexcept
+	{
+		uint64_t hi = 0;
+		const uint64_t lo = detail::mul64(a, b, hi);
+		return uint128::make(hi, lo);
+	}
+
+	// a * b / c (c != 0). 몫이 64 bit 를 넘으면 하위 64 bit
+	INT128_CONSTEXPR_MULDIV uint64_t mul_div(uint64_t a, uint64_t b, uint64_t c) noexcept
+	{
+		const uint128 p = umul(a, b);
+		if (p.high() < c) {
+			uint64_t r = 0;
+			return detail::div128by64(p.high(), p.low(), c, r);
+		}
+		return static_cast<uint64_t>(p / c);
+	}
+
+	//=============================================================================================
+	// 10 진수 문자열
+	//=============================================================================================
+	namespace detail
+	{
+		static const uint64_t Pow10_19 = 10000000000000000000ull;
+
+		inline const char* two_digits(unsigned v) noexcept
+		{
+			static const char table[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+			return table + v * 2;
+		}
+
+		inline int digit_count(uint64_t v) noexcept
+		{
+			int n = 1;
+			for (; v >= 10000; v /= 10000) n += 4;
+			return v >= 1000 ? n + 3 : v >= 100 ? n + 2 : v >= 10 ? n + 1 : n;
+		}
+
+		// v 를 p[0..width) 에 오른쪽 정렬로 (앞은 0 으로 채움)
+		inline void write_digits(char* p, int width, uint64_t v) noexcept
+		{
+			char* o = p + width;
+			while (v >= 100) {
+				o -= 2;
+				const char* d = two_digits(static_cast<unsigned>(v % 100));
+				o[0] = d[0];
+				o[1] = d[1];
+				v /= 100;
+			}
+			if (v >= 10) {
+				o -= 2;
+				const char* d = two_digits(static_cast<unsigned>(v));
+				o[0] = d[0];
+				o[1] = d[1];
+			}
+			else {
+				*--o = static_cast<char>('0' + v);
+			}
+			while (o != p) *--o = '0';
+		}
+
+		// 128-bit 를 10^19 조각(최대 3 개, 상위부터)으로
+		inline int split_pow10_19(uint128 v, uint64_t (&chunks)[3]) noexcept
+		{
+			if (0 == v.high()) {
+				chunks[0] = v.low();
+				return 1;
+			}
+			uint64_t r = 0;
+			const uint64_t qhi = v.high() / Pow10_19;
+			const uint64_t q = div128by64(v.high() % Pow10_19, v.low(), Pow10_19, r);     // 몫 하위 64 bit
+			const uint128 top = uint128::make(qhi, q);
+			if (0 == top.high() && top.low() < Pow10_19) {
+				chunks[0] = top.low();
+				chunks[1] = r;
+				return 2;
+			}
+			// 10^38 이상 : 한 번 더
+			uint64_t r2 = 0;
+			const uint64_t q2 = div128by64(top.high(), top.low(), Pow10_19, r2);
+			chunks[0] = q2;
+			chunks[1] = r2;
+			chunks[2] = r;
+			return 3;
+		}
+
+		inline to_chars_result to_chars_unsigned(char* first, char* last, uint128 v) noexcept
+		{
+			uint64_t chunks[3] = {};
+			const int count = split_pow10_19(v, chunks);
+			const int lead = digit_count(chunks[0]);
+			const ptrdiff_t length = lead + 19 * (count - 1);
+			if (last - first < length) return { last, std::errc::value_too_large };
+
+			write_digits(first, lead, chunks[0]);
+			for (int i = 1; i < count; ++i) write_digits(first + lead + 19 * (i - 1), 19, chunks[i]);
+			return { first + length, std::errc() };
+		}
+
+		inline from_chars_result from_chars_unsigned(const char* first, const char* last, uint128& value) noexcept
+		{
+			static const uint64_t Pow10[20] = {
+				1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+				10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+				1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, Pow10_19,
+			};
+
+			const char* p = first;
+			uint128 acc;
+			bool overflow = false;
+			while (p != last && *p >= '0' && *p <= '9') {
+				// 19 자리씩 uint64_t 로
+				uint64_t chunk = 0;
+				int k = 0;
+				for (; k < 19 && p != last && *p >= '0' && *p <= '9'; ++k, ++p) chunk = chunk * 10 + static_cast<uint64_t>(*p - '0');
+
+				// acc = acc * 10^k + chunk (192-bit 중 상위가 남으면 overflow)
+				uint64_t hiHi = 0, loHi = 0;
+				const uint64_t hiLo = mul64(acc.high(), Pow10[k], hiHi);
+				const uint64_t loLo = mul64(acc.low(), Pow10[k], loHi);
+				const uint64_t hi = hiLo + loHi;
+				overflow = overflow || 0 != hiHi || hi < hiLo;
+				const uint128 next = uint128::make(hi, loLo) + chunk;
+				overflow = overflow || next < uint128::make(hi, loLo);
+				acc = next;
+			}
+			if (p == first) return { first, std::errc::invalid_argument };
+			if (overflow) return { p, std::errc::result_out_of_range };
+			value = acc;
+			return { p, std::errc() };
+		}
+	}
+
+	inline to_chars_result to_chars(char* first, char* last, uint128 v) noexcept
+	{
+		return detail::to_chars_unsigned(first, last, v);
+	}
+
+	inline to_chars_result to_chars(char* first, char* last, int128 v) noexcept
+	{
+		if (v.negative()) {
+			if (first == last) return { last, std::errc::value_too_large };
+			*first++ = '-';
+		}
+		return detail::to_chars_unsigned(first, last, v.magnitude());
+	}
+
+	// std::from_chars 와 같이 '+' 와 공백은 받지 않는다
+	inline from_chars_result from_chars(const char* first, const char* last, uint128& value) noexcept
+	{
+		return detail::from_chars_unsigned(first, last, value);
+	}
+
+	inline from_chars_result from_chars(const char* first, const char* last, int128& value) noexcept
+	{
+		const bool negative = first != last && '-' == *first;
+		uint128 m;
+		const from_chars_result r = detail::from_chars_unsigned(first + (negative ? 1 : 0), last, m);
+		if (std::errc::invalid_argument == r.ec) return { first, r.ec };
+		if (std::errc() != r.ec) return r;
+
+		const uint128 limit = uint128::make(0x8000000000000000ull, 0);     // 2^127
+		if (negative ? m > limit : m >= limit) return { r.ptr, std::errc::result_out_of_range };
+		value = int128(negative ? -m : m);
+		return r;
+	}
+
+	template<typename T>
+	inline std::string to_string(T v)
+	{
+		char buf[41];
+		const to_chars_result r = to_chars(buf, buf + sizeof(buf), v);
+		return std::string(buf, r.ptr);
+	}
+
+	inline std::ostream& operator<<(std::ostream& os, uint128 v)
+	{
+		char buf[41];
+		return os.write(buf, to_chars(buf, buf + sizeof(buf), v).ptr - buf);
+	}
+
+	inline std::ostream& operator<<(std::ostream& os, int128 v)
+	{
+		char buf[41];
+		return os.write(buf, to_chars(buf, buf + sizeof(buf), v).ptr - buf);
+	}
+}//Wide
+
+
+namespace std
+{
+	template<>
+	class numeric_limits<Wide::uint128>
+	{
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = false;
+		static constexpr bool is_integer = true;
+		static constexpr bool is_exact = true;
+		static constexpr bool is_modulo = true;
+		static constexpr int digits = 128;
+		static constexpr int digits10 = 38;
+		static constexpr int radix = 2;
+		static constexpr Wide::uint128 min() noexcept { return Wide::uint128(); }
+		static constexpr Wide::uint128 lowest() noexcept { return Wide::uint128(); }
+		static constexpr Wide::uint128 max() noexcept { return Wide::uint128::make(~0ull, ~0ull); }
+	};
+
+	template<>
+	class numeric_limits<Wide::int128>
+	{
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = true;
+		static constexpr bool is_exact = true;
+		static constexpr bool is_modulo = false;
+		static constexpr int digits = 127;
+		static constexpr int digits10 = 38;
+		static constexpr int radix = 2;
+		static constexpr Wide::int128 min() noexcept { return Wide::int128::make(INT64_MIN, 0); }
+		static constexpr Wide::int128 lowest() noexcept { return min(); }
+		static constexpr Wide::int128 max() noexcept { return Wide::int128::make(INT64_MAX, ~0ull); }
+	};
+}
@@ -0,0 +1,169 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file live_owners.h
+/// @brief 스레드별 항목(thread_local)을 owner(풀, registry) id 로 찾고, 먼저 파괴된 owner 의 항목을 정리 (header-only, C++14)
+///
+///   object_pool.h 의 thread cache, thread_counters.h 의 thread block 이 같이 쓴다.
+///
+///   live id 목록 (프로세스 하나, mutex)
+///     next_id()   : 새 owner id (1 부터, 다시 쓰지 않는다)
+///     insert(id)  : owner 생성자 끝에서
+///     erase(id)   : owner 소멸자 첫 줄에서. 반환 후에는 종료하는 스레드가 이 owner 로 detach 하지 않는다
+///
+///   ThreadItems<Item> : 스레드마다 Item* 목록 (Item 요구 사항 : uint64_t owner_id 멤버, void detach() noexcept)
+///     - last()        : 마지막으로 찾은 항목 { owner_id, item } (trivial => thread_local 초기화 guard 없이 fast path)
+///     - find(id)      : 목록에서 찾아 last 갱신
+///     - add(item)     : 이미 파괴된 owner 의 항목을 지운(prune) 뒤 추가
+///     - 스레드 종료   : owner 가 살아 있으면 live lock 안에서 item->detach(), 항목은 delete
+///     - dead()        : 이 스레드의 목록이 이미 소멸 (다른 thread_local 소멸자에서 불린 경우) => 새 항목을 만들지 않는다
+///
+///   live 목록은 thread_local 소멸자가 프로세스 종료 중에도 쓰므로 일부러 해제하지 않는다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+
+namespace LiveOwners
+{
+	namespace detail
+	{
+		struct Directory
+		{
+			std::mutex lock;
+			std::unordered_set<uint64_t> live;
+		};
+
+		inline Directory& directory()
+		{
+			static Directory* d = new Directory;
+			return *d;
+		}
+	}
+
+	inline uint64_t next_id()
+	{
+		static std::atomic<uint64_t> id{ 0 };
+		return ++id;
+	}
+
+	inline void insert(uint64_t id)
+	{
+		detail::Directory& d = detail::directory();
+		std::lock_guard<std::mutex> lock(d.lock);
+		d.live.insert(id);
+	}
+
+	inline void erase(uint64_t id)
+	{
+		detail::Directory& d = detail::directory();
+		std::lock_guard<std::mutex> lock(d.lock);
+		d.live.erase(id);
+	}
+
+	//=============================================================================================
+	// ThreadItems<Item>
+	//=============================================================================================
+	template<typename Item>
+	class ThreadItems
+	{
+	public:
+		struct Last
+		{
+			uint64_t owner_id;
+			Item* item;
+		};
+
+		static Last& last() noexcept
+		{
+			static thread_local Last l = { 0, nullptr };
+			return l;
+		}
+
+		static bool dead() noexcept { return dead_flag(); }
+
+		static ThreadItems& local()
+		{
+			static thread_local ThreadItems items;
+			return items;
+		}
+
+		Item* find(uint64_t owner_id) noexcept
+		{
+			for (Item* item : _items) {
+				if (item->owner_id == owner_id) {
+					last() = Last{ owner_id, item };
+					return item;
+				}
+			}
+			return nullptr;
+		}
+
+		// 메모리 부족이면 false (item 은 호출자가 정리)
+		bool add(Item* item) noexcept
+		{
+			prune();
+			try {
+				_items.push_back(item);
+			}
+			catch (...) {
+				return false;
+			}
+			last() = Last{ item->owner_id, item };
+			return true;
+		}
+
+		// add 한 직후 되돌릴 때 (delete 는 호출자)
+		void remove(Item* item) noexcept
+		{
+			_items.erase(std::remove(_items.begin(), _items.end(), item), _items.end());
+			if (last().item == item) last() = Last{ 0, nullptr };
+		}
+
+		~ThreadItems()
+		{
+			last() = Last{ 0, nullptr };
+			dead_flag() = true;
+
+			detail::Directory& d = detail::directory();
+			std::lock_guard<std::mutex> lock(d.lock);
+			for (Item* item : _items) {
+				if (d.live.count(item->owner_id)) item->detach();
+				delete item;
+			}
+		}
+
+	private:
+		ThreadItems() = default;
+		ThreadItems(const ThreadItems&) = delete;
+		ThreadItems& operator=(const ThreadItems&) = delete;
+
+		static bool& dead_flag() noexcept
+		{
+			static thread_local bool dead = false;
+			return dead;
+		}
+
+		// 이미 파괴된 owner 의 항목 정리 (새 항목을 만들 때만)
+		void prune() noexcept
+		{
+			detail::Directory& d = detail::directory();
+			std::lock_guard<std::mutex> lock(d.lock);
+			auto gone = std::remove_if(_items.begin(), _items.end(), [&](Item* item) {
+				if (d.live.count(item->owner_id)) return false;
+				if (last().item == item) last() = Last{ 0, nullptr };
+				delete item;
+				return true;
+			});
+			_items.erase(gone, _items.end());
+		}
+
+		std::vector<Item*> _items;
+	};
+}//LiveOwners
@@ -0,0 +1,382 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file locale_snapshot.h
+/// @brief locale 의 숫자 표기/대소문자 정보를 한 번 복사해 둔 평면(POD) 표로 포맷/파싱 (header-only, C++14)
+///
+///   imbue 된 stream 은 << / >> 할 때마다 use_facet(numpunct, num_put, ctype) 을 거쳐 가상 호출을 하고,
+///   std::locale 복사(getloc, stream 생성)는 전역 locale 의 참조 카운트/lock 을 건드린다.
+///   => 여러 스레드의 formatter 가 같은 locale 을 쓰면 그 자리에서 경합이 생긴다.
+///
+///   LocaleSnapshot::capture(loc)
+///     - numpunct<char> 의 decimal_point / thousands_sep / grouping
+///     - ctype<char> 의 tolower/toupper 256 개, ctype<wchar_t> 의 U+0000 ~ U+07FF (라틴/그리스/키릴)
+///     을 Table 하나에 복사한다. facet 호출은 여기서만 한다.
+///   LocaleSnapshot::classic() : "C" locale 표 (처음 한 번 capture)
+///
+///   Table 은 만든 뒤 읽기만 하므로 여러 스레드가 lock / 가상 호출 없이 같이 쓴다.
+///     format(buf, size, integer, t)            : 정수 + 자릿수 묶음(grouping)
+///     format(buf, size, double, precision, t)  : 고정 소수점 + grouping + decimal point
+///       - 호출자 buffer 에 쓰고 길이('\0' 없음)를 반환, buffer 가 작으면 0
+///       - C++17 <charconv> 가 있으면 std::to_chars, 없으면 직접 숫자를 쓰고 실수는 snprintf
+///     parse(first, last, value, t)             : 범위 전체가 숫자여야 true
+///       - thousands_sep 는 숫자 사이에서만 허용(묶음 폭은 검사하지 않음), decimal point 는 표의 것만 인정
+///       - 실수는 std::from_chars (C++17 미만은 classic locale stream 으로 대신 => 느림)
+///     to_lower / to_upper / try_lower          : 표 조회 (U+0800 이상 wchar_t 는 그대로 둔다)
+///
+///   locale 이 바뀌면(std::locale::global 등) 표를 다시 capture 해야 한다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#if defined(_MSVC_LANG)
+#define LOCALE_SNAPSHOT_CPLUSPLUS _MSVC_LANG
+#else
+#define LOCALE_SNAPSHOT_CPLUSPLUS __cplusplus
+#endif
+
+#if LOCALE_SNAPSHOT_CPLUSPLUS >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+// 정수/실수 to_chars, from_chars 가 모두 있을 때만 (GCC 11+, VS 2019 16.4+)
+#if !defined(LOCALE_SNAPSHOT_HAS_TO_CHARS)
+#if defined(__cpp_lib_to_chars)
+#define LOCALE_SNAPSHOT_HAS_TO_CHARS 1
+#else
+#define LOCALE_SNAPSHOT_HAS_TO_CHARS 0
+#endif
+#endif
+
+
+namespace LocaleSnapshot
+{
+	static const size_t MaxGroups = 8;              // grouping 문자열 앞 8 개까지 (그 뒤는 8 번째 값 반복)
+	static const size_t WideCaseSize = 0x800;       // wchar_t 대소문자 표 범위 [0, 0x800)
+	static const int MaxPrecision = 32;
+
+	//=============================================================================================
+	// 평면 표 (trivially copyable, 포인터 없음)
+	//=============================================================================================
+	struct Table
+	{
+		char decimal;                   // decimal_point()
+		char thousands;                 // thousands_sep()
+		uint8_t groupCount;             // 0 = 묶지 않음
+		bool repeatLast;                // 마지막 묶음 폭을 계속 반복할지 (grouping 이 CHAR_MAX / 음수로 끝나면 false)
+		uint8_t groups[MaxGroups];      // 오른쪽(일의 자리)부터 묶음 폭
+
+		char lower[256];                // ctype<char>, unsigned char 로 index
+		char upper[256];
+		wchar_t wideLower[WideCaseSize];
+		wchar_t wideUpper[WideCaseSize];
+	};
+
+	inline Table capture(const std::locale& loc = std::locale())
+	{
+		Table t;
+
+		const std::numpunct<char>& punct = std::use_facet<std::numpunct<char>>(loc);
+		t.decimal = punct.decimal_point();
+		t.thousands = punct.thousands_sep();
+		t.groupCount = 0;
+		t.repeatLast = true;
+		std::memset(t.groups, 0, sizeof(t.groups));
+		for (const char g : punct.grouping()) {
+			if (0 == g) break;                  // C localeconv 와 같이 0 은 문자열 끝(앞 값 반복)
+			if (g < 0 || CHAR_MAX == g) {
+				t.repeatLast = false;
+				break;
+			}
+			if (MaxGroups == t.groupCount) break;
+			t.groups[t.groupCount++] = static_cast<uint8_t>(g);
+		}
+
+		// 범위 버전 tolower/toupper 로 facet 가상 호출은 표마다 한 번
+		const std::ctype<char>& ctype = std::use_facet<std::ctype<char>>(loc);
+		for (int c = 0; c < 256; ++c) t.lower[c] = t.upper[c] = static_cast<char>(c);
+		ctype.tolower(t.lower, t.lower + 256);
+		ctype.toupper(t.upper, t.upper + 256);
+
+		const std::ctype<wchar_t>& wctype = std::use_facet<std::ctype<wchar_t>>(loc);
+		for (size_t c = 0; c < WideCaseSize; ++c) t.wideLower[c] = t.wideUpper[c] = static_cast<wchar_t>(c);
+		wctype.tolower(t.wideLower, t.wideLower + WideCaseSize);
+		wctype.toupper(t.wideUpper, t.wideUpper + WideCaseSize);
+
+		return t;
+	}
+
+	inline const Table& classic()
+	{
+		static const Table table = capture(std::locale::classic());
+		return table;
+	}
+
+	//=============================================================================================
+	// 대소문자
+	//=============================================================================================
+	inline char to_lower(char c, const Table& t) noexcept { return t.lower[static_cast<unsigned char>(c)]; }
+	inline char to_upper(char c, const Table& t) noexcept { return t.upper[static_cast<unsigned char>(c)]; }
+
+	inline wchar_t to_lower(wchar_t c, const Table& t) noexcept
+	{
+		const auto u = static_cast<std::make_unsigned<wchar_t>::type>(c);
+		return u < WideCaseSize ? t.wideLower[u] : c;
+	}
+
+	inline wchar_t to_upper(wchar_t c, const Table& t) noexcept
+	{
+		const auto u = static_cast<std::make_unsigned<wchar_t>::type>(c);
+		return u < WideCaseSize ? t.wideUpper[u] : c;
+	}
+
+	template<typename CharT>
+	inline void to_lower(CharT* first, CharT* last, const Table& t) noexcept
+	{
+		for (; first != last; ++first) *first = to_lower(*first, t);
+	}
+
+	template<typename CharT>
+	inline void to_upper(CharT* first, CharT* last, const Table& t) noexcept
+	{
+		for (; first != last; ++first) *first = to_upper(*first, t);
+	}
+
+	// 소문자 형태가 있으면 true (Locale::try_lower 와 같은 판정, facet 대신 표)
+	template<typename CharT>
+	inline bool try_lower(CharT c, CharT& lower, const Table& t) noexcept
+	{
+		lower = to_lower(c, t);
+		return lower != c;
+	}
+
+	namespace detail
+	{
+		inline size_t group_width(const Table& t, size_t k) noexcept
+		{
+			return t.groups[k < t.groupCount ? k : t.groupCount - 1];
+		}
+
+		// 숫자 d 개 사이에 들어갈 thousands_sep 개수
+		inline size_t separator_count(const Table& t, size_t d) noexcept
+		{
+			if (0 == t.groupCount) return 0;
+
+			size_t seps = 0, covered = 0;
+			for (size_t k = 0; k < t.groupCount || t.repeatLast; ++k) {
+				covered += group_width(t, k);
+				if (covered >= d) break;
+				++seps;
+			}
+			return seps;
+		}
+
+		// digits[0..d) 를 grouping 해서 out 에 쓴다 (뒤에서부터 묶음 단위 복사)
+		inline size_t write_grouped(const char* digits, size_t d, char* out, size_t size, const Table& t) noexcept
+		{
+			size_t seps = separator_count(t, d);
+			const size_t length = d + seps;
+			if (length > size) return 0;
+
+			char* o = out + length;
+			const char* s = digits + d;
+			for (size_t k = 0; seps > 0; --seps, ++k) {
+				const size_t g = group_width(t, k);
+				o -= g;
+				s -= g;
+				std::memcpy(o, s, g);
+				*--o = t.thousands;
+			}
+			std::memcpy(out, digits, static_cast<size_t>(s - digits));
+			return length;
+		}
+
+		inline size_t write_unsigned(unsigned long long v, char (&digits)[24]) noexcept
+		{
+#if LOCALE_SNAPSHOT_HAS_TO_CHARS
+			return static_cast<size_t>(std::to_chars(digits, digits + sizeof(digits), v).ptr - digits);
+#else
+			char* p = digits + sizeof(digits);
+			do {
+				*--p = static_cast<char>('0' + v % 10);
+				v /= 10;
+			} while (v);
+			const size_t n = static_cast<size_t>(digits + sizeof(digits) - p);
+			std::memmove(digits, p, n);
+			return n;
+#endif
+		}
+
+		template<typename Int>
+		using EnableIfInteger = typename std::enable_if<std::is_integral<Int>::value && !std::is_same<Int, bool>::value, int>::type;
+	}
+
+	//=============================================================================================
+	// 포맷
+	//=============================================================================================
+	template<typename Int, detail::EnableIfInteger<Int> = 0>
+	inline size_t format(char* buf, size_t size, Int value, const Table& t) noexcept
+	{
+		const bool negative = value < 0;
+		const unsigned long long magnitude = negative ? 0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+
+		char digits[24];
+		const size_t d = detail::write_unsigned(magnitude, digits);
+
+		size_t w = 0;
+		if (negative) {
+			if (0 == size) return 0;
+			buf[w++] = '-';
+		}
+		const size_t n = detail::write_grouped(digits, d, buf + w, size - w, t);
+		return n ? w + n : 0;
+	}
+
+	// 고정 소수점 (std::fixed + setprecision(precision) 과 같은 숫자)
+	inline size_t format(char* buf, size_t size, double value, int precision, const Table& t) noexcept
+	{
+		if (precision < 0 || precision > MaxPrecision) return 0;
+
+		char text[1 + 309 + 1 + MaxPrecision + 8];     // '-' + DBL_MAX 정수부 + '.' + 소수부
+		size_t n;
+#if LOCALE_SNAPSHOT_HAS_TO_CHARS
+		const std::to_chars_result r = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, precision);
+		if (std::errc() != r.ec) return 0;
+		n = static_cast<size_t>(r.ptr - text);
+#else
+		const int r = std::snprintf(text, sizeof(text), "%.*f", precision, value);
+		if (r < 0 || static_cast<size_t>(r) >= sizeof(text)) return 0;
+		n = static_cast<size_t>(r);
+#endif
+
+		const char* p = text;
+		const char* const end = text + n;
+		size_t w = 0;
+		if ('-' == *p) {
+			if (0 == size) return 0;
+			buf[w++] = '-';
+			++p;
+		}
+
+		const char* integerEnd = p;
+		while (integerEnd != end && *integerEnd >= '0' && *integerEnd <= '9') ++integerEnd;
+		if (integerEnd == p) {
+			// inf / nan
+			if (size - w < static_cast<size_t>(end - p)) return 0;
+			std::memcpy(buf + w, p, static_cast<size_t>(end - p));
+			return w + static_cast<size_t>(end - p);
+		}
+
+		const size_t g = detail::write_grouped(p, static_cast<size_t>(integerEnd - p), buf + w, size - w, t);
+		if (0 == g) return 0;
+		w += g;
+
+		if (integerEnd != end) {
+			// snprintf 는 C 전역 locale 의 소수점을 쓰므로 글자가 무엇이든 표의 것으로 바꾼다
+			const size_t fraction = static_cast<size_t>(end - integerEnd - 1);
+			if (size - w < 1 + fraction) return 0;
+			buf[w++] = t.decimal;
+			std::memcpy(buf + w, integerEnd + 1, fraction);
+			w += fraction;
+		}
+		return w;
+	}
+
+	//=============================================================================================
+	// 파싱
+	//=============================================================================================
+	template<typename Int, detail::EnableIfInteger<Int> = 0>
+	inline bool parse(const char* first, const char* last, Int& value, const Table& t) noexcept
+	{
+		bool negative = false;
+		if (first != last && ('-' == *first || '+' == *first)) {
+			negative = '-' == *first;
+			++first;
+		}
+		if (negative && !std::is_signed<Int>::value) return false;
+
+		unsigned long long magnitude = 0;
+		bool digit = false;         // 직전 글자가 숫자 (thousands_sep 는 숫자 사이에만)
+		for (; first != last; ++first) {
+			const char c = *first;
+			if (c >= '0' && c <= '9') {
+				const unsigned d = static_cast<unsigned>(c - '0');
+				if (magnitude > (ULLONG_MAX - d) / 10) return false;
+				magnitude = magnitude * 10 + d;
+				digit = true;
+			}
+			else if (c == t.thousands && t.groupCount && digit && first + 1 != last) {
+				digit = false;
+			}
+			else {
+				return false;
+			}
+		}
+		if (!digit) return false;
+
+		typedef typename std::make_unsigned<Int>::type Unsigned;
+		const unsigned long long max = static_cast<Unsigned>((std::numeric_limits<Int>::max)());
+		if (magnitude > max + (negative ? 1 : 0)) return false;
+
+		value = negative ? static_cast<Int>(-static_cast<long long>(magnitude - 1) - 1) : static_cast<Int>(magnitude);
+		return true;
+	}
+
+	inline bool parse(const char* first, const char* last, double& value, const Table& t)
+	{
+		// 표의 decimal point 를 '.' 로, thousands_sep 는 빼서 "C" 표기로 옮긴 뒤 변환
+		char text[128];
+		size_t n = 0;
+		bool digit = false;
+		for (const char* p = first; p != last; ++p) {
+			char c = *p;
+			if (c == t.decimal) {
+				c = '.';
+			}
+			else if (c == t.thousands && t.groupCount) {
+				if (!digit || p + 1 == last || p[1] < '0' || p[1] > '9') return false;
+				continue;
+			}
+			else if ('.' == c) {
+				return false;       // 이 locale 의 소수점이 아님
+			}
+			if (sizeof(text) == n) return false;
+			text[n++] = c;
+			digit = c >= '0' && c <= '9';
+		}
+
+		const char* begin = text;
+		if (n && '+' == text[0]) ++begin;
+		if (begin == text + n) return false;
+
+#if LOCALE_SNAPSHOT_HAS_TO_CHARS
+		const std::from_chars_result r = std::from_chars(begin, text + n, value);
+		return std::errc() == r.ec && text + n == r.ptr;
+#else
+		std::istringstream is(std::string(begin, static_cast<size_t>(text + n - begin)));
+		is.imbue(std::locale::classic());
+		double v;
+		is >> v;
+		if (is.fail() || is.peek() != std::char_traits<char>::eof()) return false;
+		value = v;
+		return true;
+#endif
+	}
+
+	template<typename T>
+	inline bool parse(const std::string& text, T& value, const Table& t)
+	{
+		return parse(text.data(), text.data() + text.size(), value, t);
+	}
+}//LocaleSnapshot
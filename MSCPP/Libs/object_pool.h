@@ -0,0 +1,701 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file object_pool.h
+/// @brief 스레드별 magazine + lock-free depot + 64 KB slab 객체 풀 (header-only, C++14)
+///
+///   Pooling::ObjectPool<T>
+///     - Acquire(args...) => PooledPtr (std::unique_ptr<T, PoolDeleter>), 소멸 시 풀로 반환
+///       (C++14/Memory_add.cpp 의 ObjectPool 과 같은 모양)
+///
+///   구조 (Bonwick "Magazines and Vmem", 2001)
+///     thread cache : 스레드마다 magazine 두 개(loaded, previous). magazine = slot pointer M 개짜리 배열
+///                    Acquire/Release 는 대부분 loaded 에서 pop/push 만 한다 (atomic 없음)
+///     depot        : arena 마다 full / empty magazine 의 lock-free stack (TaggedHead, ABA 방지)
+///                    thread cache 가 비거나 차면 magazine 통째로 교환 => 객체 M 개를 CAS 한 번에 옮긴다
+///     slab         : depot 도 비면 arena 의 64 KB chunk 에서 M 개를 한 번에 잘라 채운다 (chunk 할당만 mutex)
+///                    trim 으로 chunk 에 돌아온 slot 이 있으면 새로 자르기 전에 그것부터 쓴다
+///     해제된 객체는 해제한 스레드의 cache 로 간다 => 생산자/소비자 스레드가 달라도 magazine 단위로 돈다
+///
+///   PoolOptions
+///     magazine_size : M (기본 64)
+///     high_water    : arena depot 의 full magazine 이 이보다 많아지면 high_water / 2 개만 남기고 trim (0 = 자동 trim 안 함)
+///                     => 한 번 trim 한 뒤에는 full magazine 이 high_water / 2 개 넘게 더 쌓여야 다시 trim
+///     numa_arenas   : NUMA node 마다 arena 를 따로 두고, 스레드는 처음 쓸 때 있던 node 의 arena 를 쓴다
+///                     chunk 는 Windows 는 VirtualAllocExNuma, Linux 는 새 mmap 페이지 + first-touch 로 그 node 에 놓인다
+///
+///   trim()              : depot 의 full magazine 을 모두 chunk 로 돌려주고, slot 이 전부 돌아온 chunk 는 OS 에 돌려준다
+///   flush_thread_cache(): 이 스레드 cache 의 magazine 을 depot 으로 (스레드가 끝날 때는 자동)
+///
+///   풀을 파괴할 때는 빌려 간 객체가 모두 반환되어 있어야 하고, 다른 스레드가 사용 중이면 안 된다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+  #include <windows.h>
+#elif defined(__linux__)
+  #include <stdio.h>
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#else
+  #include <stdlib.h>
+#endif
+
+#include "backoff.h"
+#include "dcas.h"
+#include "live_owners.h"
+
+
+namespace Pooling
+{
+	struct PoolOptions
+	{
+		size_t magazine_size = 64;
+		size_t high_water = 0;
+		bool numa_arenas = false;
+	};
+
+	namespace detail
+	{
+		static const size_t ChunkSize = 64 * 1024;
+
+		//=========================================================================================
+		// NUMA / chunk 할당 (64 KB 정렬 => slot 주소로 chunk 를 찾는다)
+		//=========================================================================================
+		inline unsigned numa_node_count()
+		{
+			static const unsigned count = [] {
+#if defined(_WIN32)
+				ULONG highest = 0;
+				return GetNumaHighestNodeNumber(&highest) ? static_cast<unsigned>(highest) + 1 : 1u;
+#elif defined(__linux__)
+				unsigned n = 1;
+				if (FILE* f = fopen("/sys/devices/system/node/possible", "r")) {     // "0" 또는 "0-3"
+					unsigned lo = 0, hi = 0;
+					const int k = fscanf(f, "%u-%u", &lo, &hi);
+					n = (k == 2) ? hi + 1 : (k == 1) ? lo + 1 : 1;
+					fclose(f);
+				}
+				return n;
+#else
+				return 1u;
+#endif
+			}();
+			return count;
+		}
+
+		inline unsigned current_numa_node()
+		{
+#if defined(_WIN32)
+			PROCESSOR_NUMBER pn;
+			GetCurrentProcessorNumberEx(&pn);
+			USHORT node = 0;
+			return GetNumaProcessorNodeEx(&pn, &node) ? node : 0u;
+#elif defined(__linux__) && defined(SYS_getcpu)
+			unsigned cpu = 0, node = 0;
+			return syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 ? node : 0u;
+#else
+			return 0;
+#endif
+		}
+
+		// node < 0 : 아무 node
+		inline void* chunk_allocate(int node)
+		{
+#if defined(_WIN32)
+			// VirtualAlloc 는 allocation granularity(64 KB) 정렬
+			return node < 0
+				? VirtualAlloc(nullptr, ChunkSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE)
+				: VirtualAllocExNuma(GetCurrentProcess(), nullptr, ChunkSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, static_cast<DWORD>(node));
+#elif defined(__linux__)
+			// 새 익명 페이지 => 처음 쓰는 스레드의 node 에 놓인다 (first-touch)
+			(void)node;
+			void* raw = mmap(nullptr, ChunkSize * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw == MAP_FAILED) return nullptr;
+
+			const uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+			const uintptr_t base = (begin + ChunkSize - 1) & ~(ChunkSize - 1);
+			if (base != begin) munmap(raw, base - begin);
+			if (base + ChunkSize != begin + ChunkSize * 2) munmap(reinterpret_cast<void*>(base + ChunkSize), begin + ChunkSize - base);
+			return reinterpret_cast<void*>(base);
+#else
+			(void)node;
+			void* p = nullptr;
+			return posix_memalign(&p, ChunkSize, ChunkSize) == 0 ? p : nullptr;
+#endif
+		}
+
+		inline void chunk_free(void* p)
+		{
+#if defined(_WIN32)
+			VirtualFree(p, 0, MEM_RELEASE);
+#elif defined(__linux__)
+			munmap(p, ChunkSize);
+#else
+			free(p);
+#endif
+		}
+
+		//=========================================================================================
+		// magazine / depot
+		//=========================================================================================
+		struct Magazine
+		{
+			std::atomic<Magazine*> next{ nullptr };    // depot stack 연결
+			Magazine* all = nullptr;                    // 풀이 만든 전체 목록 (소멸 시 해제)
+			size_t count = 0;
+
+			void** slots() noexcept { return reinterpret_cast<void**>(this + 1); }
+		};
+
+		// magazine 은 풀이 살아 있는 동안 해제하지 않는다 => pop 에서 next 를 읽어도 안전, ABA 는 tag 로
+		class MagazineStack
+		{
+		public:
+			void push(Magazine* m) noexcept
+			{
+				LockFree::TaggedPtr<Magazine> top = _head.load(std::memory_order_relaxed);
+				for (;;) {
+					m->next.store(top.ptr, std::memory_order_relaxed);
+					if (_head.compare_exchange_weak(top, LockFree::TaggedPtr<Magazine>{ m, top.tag + 1 }, std::memory_order_release, std::memory_order_relaxed)) return;
+				}
+			}
+
+			Magazine* pop() noexcept
+			{
+				LockFree::TaggedPtr<Magazine> top = _head.load(std::memory_order_acquire);
+				while (top.ptr) {
+					Magazine* next = top.ptr->next.load(std::memory_order_relaxed);
+					if (_head.compare_exchange_weak(top, LockFree::TaggedPtr<Magazine>{ next, top.tag + 1 }, std::memory_order_acquire, std::memory_order_acquire)) return top.ptr;
+				}
+				return nullptr;
+			}
+
+		private:
+			LockFree::TaggedHead<Magazine> _head;
+		};
+
+		//=========================================================================================
+		// slab chunk / arena
+		//=========================================================================================
+		struct Arena;
+
+		// 아래 필드는 모두 owner->grow_lock
+		struct Chunk
+		{
+			Chunk* prev;
+			Chunk* next;
+			Arena* owner;
+			size_t carved;          // 잘라 낸 slot 수
+			void* free_list;        // trim 으로 돌아온 slot (slot 자체를 next 로 엮는다)
+			size_t free_count;      // free_list 길이. carved 와 같으면 chunk 전체가 비었다
+			Chunk* partial_prev;    // free_list 가 있는 chunk 목록 (Arena::partial)
+			Chunk* partial_next;
+		};
+
+		struct Arena
+		{
+			MagazineStack full;
+			char _pad0[LockFree::CacheLineSize];
+			MagazineStack empty;
+			char _pad1[LockFree::CacheLineSize];
+			std::atomic<size_t> full_count{ 0 };
+			std::atomic<bool> trimming{ false };
+			int node = -1;
+
+			std::mutex grow_lock;       // chunk 할당/잘라 내기/해제 (느린 경로만)
+			Chunk* chunks = nullptr;
+			Chunk* current = nullptr;
+			Chunk* partial = nullptr;   // free_list 가 있는 chunk (carve 가 새로 자르기 전에 쓴다)
+			size_t chunk_count = 0;
+		};
+
+		class PoolCore;
+
+		//=========================================================================================
+		// 스레드별 cache (live_owners.h 의 ThreadItems 항목)
+		//   스레드가 끝날 때 그 풀이 아직 살아 있으면 magazine 을 depot 으로 돌려준다.
+		//   풀이 먼저 파괴됐으면 magazine/slot 은 이미 해제됐으므로 cache 만 지운다.
+		//=========================================================================================
+		struct ThreadCache
+		{
+			uint64_t owner_id;                      // 풀 id
+			PoolCore* core;
+			Arena* arena;
+			Magazine* loaded;
+			Magazine* previous;
+			char _pad[LockFree::CacheLineSize];     // 다른 스레드의 cache 와 cache line 을 나누지 않게
+
+			inline void detach() noexcept;          // 스레드 종료 시 (live lock 안에서, 풀이 살아 있을 때만)
+		};
+
+		using ThreadCaches = LiveOwners::ThreadItems<ThreadCache>;
+
+		//=========================================================================================
+		// PoolCore : 크기/정렬만 아는 raw slot 풀 (ObjectPool<T> 가 생성/소멸을 얹는다)
+		//=========================================================================================
+		class PoolCore
+		{
+		public:
+			PoolCore(size_t slotSize, size_t slotAlign, const PoolOptions& options)
+				: _id(LiveOwners::next_id())
+				, _magazineSize((std::max)(options.magazine_size, size_t(1)))
+				, _highWater(options.high_water)
+			{
+				slotAlign = (std::max)(slotAlign, alignof(void*));
+				_slotSize = (((std::max)(slotSize, sizeof(void*)) + slotAlign - 1) / slotAlign) * slotAlign;
+				_firstSlot = ((sizeof(Chunk) + slotAlign - 1) / slotAlign) * slotAlign;
+				_slotsPerChunk = (ChunkSize - _firstSlot) / _slotSize;
+
+				const unsigned arenas = options.numa_arenas ? numa_node_count() : 1;
+				for (unsigned i = 0; i < arenas; ++i) {
+					_arenas.emplace_back(new Arena);
+					_arenas.back()->node = options.numa_arenas ? static_cast<int>(i) : -1;
+				}
+
+				LiveOwners::insert(_id);
+			}
+
+			~PoolCore()
+			{
+				LiveOwners::erase(_id);
+
+				Magazine* m = _allMagazines.load(std::memory_order_acquire);
+				while (m) {
+					Magazine* next = m->all;
+					m->~Magazine();
+					::operator delete(m);
+					m = next;
+				}
+
+				for (auto& arena : _arenas) {
+					Chunk* c = arena->chunks;
+					while (c) {
+						Chunk* next = c->next;
+						chunk_free(c);
+						c = next;
+					}
+				}
+			}
+
+			PoolCore(const PoolCore&) = delete;
+			PoolCore& operator=(const PoolCore&) = delete;
+
+			void* allocate()
+			{
+				ThreadCache* c = cache();
+				if (c) {
+					Magazine* m = c->loaded;
+					if (m->count) return m->slots()[--m->count];
+					if (void* p = allocate_slow(c)) return p;
+				}
+				else if (void* p = allocate_orphan()) {
+					return p;
+				}
+				throw std::bad_alloc();
+			}
+
+			void deallocate(void* p) noexcept
+			{
+				ThreadCache* c = cache();
+				if (!c) {
+					deallocate_orphan(p);
+					return;
+				}
+
+				Magazine* m = c->loaded;
+				if (m->count < _magazineSize) {
+					m->slots()[m->count++] = p;
+					return;
+				}
+				deallocate_slow(c, p);
+			}
+
+			void flush_thread_cache() noexcept
+			{
+				ThreadCache* c = cache();
+				if (!c) return;
+
+				for (Magazine** slot : { &c->loaded, &c->previous }) {
+					if (!(*slot)->count) continue;
+					Magazine* empty = c->arena->empty.pop();
+					if (!empty) empty = new_magazine();
+					if (!empty) continue;
+
+					push_full(*c->arena, *slot);
+					*slot = empty;
+				}
+			}
+
+			// 반환한 chunk 수
+			size_t trim() noexcept
+			{
+				size_t released = 0;
+				for (auto& arena : _arenas) released += trim_arena(*arena, 0);
+				return released;
+			}
+
+			size_t chunk_count() const
+			{
+				size_t n = 0;
+				for (auto& arena : _arenas) {
+					std::lock_guard<std::mutex> lock(arena->grow_lock);
+					n += arena->chunk_count;
+				}
+				return n;
+			}
+
+		private:
+			friend struct ThreadCache;      // detach
+
+			Chunk* chunk_of(void* p) const noexcept
+			{
+				return reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(p) & ~(ChunkSize - 1));
+			}
+
+			//-------------------------------------------------------------------------------------
+			// thread cache
+			//-------------------------------------------------------------------------------------
+			ThreadCache* cache() noexcept
+			{
+				const ThreadCaches::Last& last = ThreadCaches::last();
+				if (last.owner_id == _id) return last.item;
+				return attach();
+			}
+
+			ThreadCache* attach() noexcept
+			{
+				if (ThreadCaches::dead()) return nullptr;     // thread_local 소멸 중 (다른 thread_local 소멸자에서 반환)
+
+				ThreadCaches& caches = ThreadCaches::local();
+				if (ThreadCache* c = caches.find(_id)) return c;
+
+				Arena& arena = *_arenas[_arenas.size() > 1 ? current_numa_node() % _arenas.size() : 0];
+				Magazine* loaded = arena.empty.pop();
+				if (!loaded) loaded = new_magazine();
+				Magazine* previous = arena.empty.pop();
+				if (!previous) previous = new_magazine();
+
+				ThreadCache* c = (loaded && previous) ? new (std::nothrow) ThreadCache{ _id, this, &arena, loaded, previous, {} } : nullptr;
+				if (c && !caches.add(c)) {
+					delete c;
+					c = nullptr;
+				}
+				if (!c) {
+					if (loaded) arena.empty.push(loaded);
+					if (previous) arena.empty.push(previous);
+					return nullptr;
+				}
+				return c;
+			}
+
+			// 스레드 종료 시 (live lock 안에서, 풀이 살아 있을 때만)
+			void detach(ThreadCache* c) noexcept
+			{
+				for (Magazine* m : { c->loaded, c->previous }) {
+					if (m->count) push_full(*c->arena, m);
+					else c->arena->empty.push(m);
+				}
+			}
+
+			//-------------------------------------------------------------------------------------
+			// 느린 경로 : magazine 교환 / slab 에서 bulk refill
+			//-------------------------------------------------------------------------------------
+			void* allocate_slow(ThreadCache* c)
+			{
+				if (c->previous->count) {
+					std::swap(c->loaded, c->previous);
+					return c->loaded->slots()[--c->loaded->count];
+				}
+
+				Arena& arena = *c->arena;
+				if (Magazine* full = arena.full.pop()) {
+					arena.full_count.fetch_sub(1, std::memory_order_relaxed);
+					arena.empty.push(c->previous);
+					c->previous = c->loaded;
+					c->loaded = full;
+					return full->slots()[--full->count];
+				}
+
+				Magazine* m = c->loaded;
+				m->count = take_orphans(m->slots(), _magazineSize);
+				if (!m->count) m->count = carve(arena, m->slots(), _magazineSize);
+				return m->count ? m->slots()[--m->count] : nullptr;
+			}
+
+			void deallocate_slow(ThreadCache* c, void* p) noexcept
+			{
+				if (c->previous->count == 0) {
+					std::swap(c->loaded, c->previous);
+					c->loaded->slots()[c->loaded->count++] = p;
+					return;
+				}
+
+				Arena& arena = *c->arena;
+				Magazine* empty = arena.empty.pop();
+				if (!empty) empty = new_magazine();
+				if (!empty) {
+					deallocate_orphan(p);
+					return;
+				}
+
+				const size_t full = push_full(arena, c->previous);
+				c->previous = c->loaded;
+				c->loaded = empty;
+				empty->slots()[empty->count++] = p;
+
+				if (_highWater && full > _highWater) trim_arena(arena, _highWater / 2);
+			}
+
+			size_t push_full(Arena& arena, Magazine* m) noexcept
+			{
+				arena.full.push(m);
+				return arena.full_count.fetch_add(1, std::memory_order_relaxed) + 1;
+			}
+
+			Magazine* new_magazine() noexcept
+			{
+				void* raw = ::operator new(sizeof(Magazine) + _magazineSize * sizeof(void*), std::nothrow);
+				if (!raw) return nullptr;
+
+				Magazine* m = new (raw) Magazine;
+				Magazine* head = _allMagazines.load(std::memory_order_relaxed);
+				do {
+					m->all = head;
+				} while (!_allMagazines.compare_exchange_weak(head, m, std::memory_order_release, std::memory_order_relaxed));
+				return m;
+			}
+
+			// arena 의 chunk 에서 최대 n 개를 잘라 낸다
+			size_t carve(Arena& arena, void** out, size_t n) noexcept
+			{
+				std::lock_guard<std::mutex> lock(arena.grow_lock);
+
+				size_t got = 0;
+				while (got < n) {
+					// trim 으로 돌아온 slot 먼저
+					if (Chunk* c = arena.partial) {
+						while (got < n && c->free_list) {
+							out[got++] = c->free_list;
+							c->free_list = *static_cast<void**>(c->free_list);
+							--c->free_count;
+						}
+						if (!c->free_list) unlink_partial(arena, c);
+						continue;
+					}
+
+					Chunk* c = arena.current;
+					if (!c || c->carved == _slotsPerChunk) {
+						void* raw = chunk_allocate(arena.node);
+						if (!raw) break;
+
+						c = new (raw) Chunk{ nullptr, arena.chunks, &arena, 0, nullptr, 0, nullptr, nullptr };
+						if (arena.chunks) arena.chunks->prev = c;
+						arena.chunks = c;
+						arena.current = c;
+						++arena.chunk_count;
+					}
+
+					const size_t k = (std::min)(n - got, _slotsPerChunk - c->carved);
+					char* base = reinterpret_cast<char*>(c) + _firstSlot + c->carved * _slotSize;
+					for (size_t i = 0; i < k; ++i) out[got + i] = base + i * _slotSize;
+					c->carved += k;
+					got += k;
+				}
+				return got;
+			}
+
+			//-------------------------------------------------------------------------------------
+			// trim : depot 의 full magazine 을 keep 개만 남기고 꺼내 slot 을 각자의 chunk free_list 로 돌려준다
+			//   slot 이 전부 돌아온 chunk (current 제외) 는 바로 해제. 사용 중인 객체가 있는 chunk 는 남고,
+			//   돌아온 slot 은 carve 가 새 chunk 보다 먼저 쓴다 => 같은 magazine 을 다시 세지 않는다
+			//-------------------------------------------------------------------------------------
+			size_t trim_arena(Arena& arena, size_t keep) noexcept
+			{
+				if (arena.trimming.exchange(true, std::memory_order_acquire)) return 0;
+
+				size_t released = 0;
+				while (arena.full_count.load(std::memory_order_relaxed) > keep) {
+					Magazine* m = arena.full.pop();
+					if (!m) break;
+					arena.full_count.fetch_sub(1, std::memory_order_relaxed);
+
+					// 한 magazine 의 slot 은 대개 같은 arena 의 chunk => lock 은 owner 가 바뀔 때만 다시 잡는다
+					std::unique_lock<std::mutex> lock;
+					Arena* locked = nullptr;
+					for (size_t i = 0; i < m->count; ++i) {
+						void* p = m->slots()[i];
+						Chunk* c = chunk_of(p);
+						if (c->owner != locked) {
+							lock = std::unique_lock<std::mutex>(c->owner->grow_lock);
+							locked = c->owner;
+						}
+						released += return_slot(*locked, c, p);
+					}
+					m->count = 0;
+					arena.empty.push(m);
+				}
+
+				arena.trimming.store(false, std::memory_order_release);
+				return released;
+			}
+
+			// owner.grow_lock 안. chunk 를 해제했으면 1
+			size_t return_slot(Arena& owner, Chunk* c, void* p) noexcept
+			{
+				if (!c->free_list) {
+					c->partial_prev = nullptr;
+					c->partial_next = owner.partial;
+					if (owner.partial) owner.partial->partial_prev = c;
+					owner.partial = c;
+				}
+				*static_cast<void**>(p) = c->free_list;
+				c->free_list = p;
+				if (++c->free_count != c->carved || c == owner.current) return 0;
+
+				unlink_partial(owner, c);
+				if (c->prev) c->prev->next = c->next;
+				else owner.chunks = c->next;
+				if (c->next) c->next->prev = c->prev;
+				--owner.chunk_count;
+				chunk_free(c);
+				return 1;
+			}
+
+			// arena.grow_lock 안
+			static void unlink_partial(Arena& arena, Chunk* c) noexcept
+			{
+				if (c->partial_prev) c->partial_prev->partial_next = c->partial_next;
+				else arena.partial = c->partial_next;
+				if (c->partial_next) c->partial_next->partial_prev = c->partial_prev;
+				c->partial_prev = c->partial_next = nullptr;
+			}
+
+			//-------------------------------------------------------------------------------------
+			// orphan : thread cache 를 쓸 수 없을 때 (thread_local 소멸 중, 메모리 부족)
+			//   slot 자체를 next 로 엮은 mutex list
+			//-------------------------------------------------------------------------------------
+			void* allocate_orphan() noexcept
+			{
+				void* p = nullptr;
+				if (take_orphans(&p, 1)) return p;
+				return carve(*_arenas[0], &p, 1) ? p : nullptr;
+			}
+
+			void deallocate_orphan(void* p) noexcept
+			{
+				std::lock_guard<std::mutex> lock(_orphanLock);
+				*static_cast<void**>(p) = _orphans;
+				_orphans = p;
+				_hasOrphans.store(true, std::memory_order_relaxed);
+			}
+
+			size_t take_orphans(void** out, size_t n) noexcept
+			{
+				if (!_hasOrphans.load(std::memory_order_relaxed)) return 0;
+
+				std::lock_guard<std::mutex> lock(_orphanLock);
+				size_t got = 0;
+				while (_orphans && got < n) {
+					out[got++] = _orphans;
+					_orphans = *static_cast<void**>(_orphans);
+				}
+				_hasOrphans.store(_orphans != nullptr, std::memory_order_relaxed);
+				return got;
+			}
+
+		private:
+			const uint64_t _id;
+			const size_t _magazineSize;
+			const size_t _highWater;
+			size_t _slotSize;
+			size_t _firstSlot;
+			size_t _slotsPerChunk;
+
+			std::vector<std::unique_ptr<Arena>> _arenas;
+			std::atomic<Magazine*> _allMagazines{ nullptr };
+
+			std::mutex _orphanLock;
+			void* _orphans = nullptr;
+			std::atomic<bool> _hasOrphans{ false };
+		};
+
+		inline void ThreadCache::detach() noexcept
+		{
+			core->detach(this);
+		}
+	}
+
+	//=============================================================================================
+	// ObjectPool<T>
+	//=============================================================================================
+	template<class T>
+	class ObjectPool
+	{
+		static_assert(sizeof(T) <= detail::ChunkSize / 16, "ObjectPool: T is too large for 64 KB slabs");
+		static_assert(alignof(T) <= 4096, "ObjectPool: over-aligned T");
+
+	public:
+		// 풀에서 반환되는 unique_ptr 타입(커스텀 deleter 포함)
+		struct PoolDeleter
+		{
+			ObjectPool* pool = nullptr;
+
+			PoolDeleter() = default;
+			explicit PoolDeleter(ObjectPool* p) noexcept : pool(p) {}
+
+			void operator()(T* p) const noexcept
+			{
+				if (pool && p) pool->Release(p);
+			}
+		};
+
+		using PooledPtr = std::unique_ptr<T, PoolDeleter>;
+
+		explicit ObjectPool(const PoolOptions& options = PoolOptions())
+			: _core(sizeof(T), alignof(T), options)
+		{}
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		template<class... Args>
+		PooledPtr Acquire(Args&&... args)
+		{
+			void* slot = _core.allocate();
+			T* obj;
+			try {
+				obj = new (slot) T(std::forward<Args>(args)...);
+			}
+			catch (...) {
+				_core.deallocate(slot);
+				throw;
+			}
+			return PooledPtr(obj, PoolDeleter{ this });
+		}
+
+		void flush_thread_cache() noexcept { _core.flush_thread_cache(); }
+		size_t trim() noexcept { return _core.trim(); }
+		size_t chunk_count() const { return _core.chunk_count(); }
+
+	private:
+		void Release(T* p) noexcept
+		{
+			p->~T();
+			_core.deallocate(p);
+		}
+
+		detail::PoolCore _core;
+	};
+}//Pooling
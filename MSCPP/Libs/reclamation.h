@@ -0,0 +1,418 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file reclamation.h
+/// @brief lock-free 자료구조용 안전한 메모리 회수 (header-only, C++14)
+///
+///   CAS로 노드를 떼어 낸 직후 바로 delete 하면 같은 노드를 읽고 있던 다른 스레드가
+///   해제된 메모리에 접근하거나(use-after-free), 재사용된 주소 때문에 CAS가 잘못 성공한다(ABA).
+///   노드는 retire()로 넘기고, 아무도 참조하지 않는다고 확인된 뒤에 해제한다.
+///
+///   - HazardPointers   : 읽기 전에 포인터를 hazard slot에 공개, 해제 전 모든 slot을 검사
+///                        스레드당 동시에 살아 있는 Guard 는 SlotsPerThread 개까지 (넘으면 std::length_error)
+///                        미회수 노드 수 상한 = 스레드 수 x (2 x 전체 slot 수 + ScanSlack) => bounded memory
+///   - EpochReclamation : 전역 epoch + 스레드별 진입 epoch. 2 epoch이 지난 노드를 일괄 해제
+///                        읽기 비용이 더 싸지만 guard 안에서 멈춘 스레드가 있으면 회수가 멈춘다(unbounded)
+///
+///   공통 정책 인터페이스 (TreiberStack 등이 template 인자로 선택)
+///     typename Policy::Guard g;                  // 보호 구간(스코프)
+///     T* p = g.protect(atomic_ptr);               // 보호된 읽기
+///     U  v = g.protect(atomic_value, get_ptr);    // tagged pointer 등: get_ptr(v)로 보호할 포인터 추출
+///     Policy::retire(p);                          // 떼어 낸 노드 해제 예약
+///     Policy::collect();                          // (정지 상태에서) 회수 가능한 노드 즉시 해제
+///
+///   EpochReclamation::synchronize()               // 호출 시점에 guard 안에 있던 스레드가 모두 나올 때까지 대기 (RCU grace period)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+
+namespace LockFree
+{
+	// 타입을 지운 회수 대기 항목
+	struct Retired
+	{
+		void* ptr;
+		void (*deleter)(void*);
+		uint64_t epoch;             // EpochReclamation: retire 시점의 전역 epoch
+	};
+
+	template<typename T>
+	void delete_object(void* p) { delete static_cast<T*>(p); }
+
+	//=============================================================================================
+	// HazardPointers (Maged Michael, 2004)
+	//=============================================================================================
+	class HazardPointers
+	{
+	public:
+		static const int SlotsPerThread = 4;    // 스레드당 동시에 쓸 수 있는 Guard 수
+		static const size_t ScanSlack = 64;     // scan 임계값 여유(작은 스레드 수에서 scan이 너무 잦지 않게)
+
+		class Guard
+		{
+		public:
+			Guard() : _slot(local().acquire_slot()) {}
+			~Guard() { _slot->store(nullptr, std::memory_order_release); local().release_slot(); }
+
+			Guard(const Guard&) = delete;
+			Guard& operator=(const Guard&) = delete;
+
+			template<typename T>
+			T* protect(const std::atomic<T*>& src)
+			{
+				return protect(src, [](T* p) { return p; });
+			}
+
+			// Source: std::atomic<U> 또는 load(memory_order)를 제공하는 타입(TaggedHead 등)
+			template<typename Source, typename GetPtr>
+			auto protect(const Source& src, GetPtr get_ptr) -> decltype(src.load(std::memory_order_acquire))
+			{
+				auto v = src.load(std::memory_order_acquire);
+				for (;;) {
+					_slot->store(get_ptr(v), std::memory_order_seq_cst);
+					// 공개(store) 후 다시 읽어 여전히 같으면: scan이 이 slot을 반드시 보게 된다
+					auto w = src.load(std::memory_order_seq_cst);
+					if (w == v) return v;
+					v = w;
+				}
+			}
+
+			void clear() noexcept { _slot->store(nullptr, std::memory_order_release); }
+
+		private:
+			std::atomic<void*>* _slot;
+		};
+
+		template<typename T>
+		static void retire(T* p) { retire(p, &delete_object<T>); }
+
+		static void retire(void* p, void (*deleter)(void*))
+		{
+			ThreadState& ts = local();
+			ts.retired.push_back(Retired{ p, deleter, 0 });
+			if (ts.retired.size() >= scan_threshold()) scan(ts.retired);
+		}
+
+		static void collect() { scan(local().retired); }
+
+		// 현재 이 스레드가 들고 있는 미회수 노드 수(진단용)
+		static size_t pending() { return local().retired.size(); }
+
+	private:
+		struct Record
+		{
+			std::atomic<void*> hazards[SlotsPerThread];
+			std::atomic<bool> active;
+			Record* next;
+		};
+
+		struct Domain
+		{
+			std::atomic<Record*> head{ nullptr };
+			std::atomic<size_t> records{ 0 };
+
+			std::mutex orphan_mtx;
+			std::vector<Retired> orphans;   // 종료한 스레드가 남긴 미회수 노드
+		};
+
+		static Domain& domain()
+		{
+			static Domain* d = new Domain();
+			// 일부러 파괴하지 않는다: 정적 객체 파괴 중 종료되는 스레드도 record를 반납해야 함
+			return *d;
+		}
+
+		struct ThreadState
+		{
+			Record* rec;
+			int used = 0;
+			std::vector<Retired> retired;
+
+			ThreadState() : rec(acquire_record()) {}
+
+			~ThreadState()
+			{
+				scan(retired);
+				if (!retired.empty()) {
+					Domain& d = domain();
+					std::lock_guard<std::mutex> lk(d.orphan_mtx);
+					d.orphans.insert(d.orphans.end(), retired.begin(), retired.end());
+				}
+				rec->active.store(false, std::memory_order_release);  // record 재사용 허용
+			}
+
+			std::atomic<void*>* acquire_slot()
+			{
+				// Guard는 스코프 단위로 중첩되므로 스택처럼 사용
+				// 넘치면 이웃 record/메모리를 덮으므로 release 빌드에서도 검사 (Guard 생성 전이라 해제할 것 없음)
+				if (used >= SlotsPerThread) throw std::length_error("HazardPointers: more than SlotsPerThread nested guards");
+				return &rec->hazards[used++];
+			}
+
+			void release_slot() { --used; }
+		};
+
+		static ThreadState& local()
+		{
+			static thread_local ThreadState ts;
+			return ts;
+		}
+
+		static Record* acquire_record()
+		{
+			Domain& d = domain();
+
+			for (Record* r = d.head.load(std::memory_order_acquire); r; r = r->next) {
+				bool expected = false;
+				if (!r->active.load(std::memory_order_relaxed) &&
+					r->active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+					return r;   // 종료한 스레드의 record 재사용
+				}
+			}
+
+			Record* r = new Record();
+			for (auto& h : r->hazards) h.store(nullptr, std::memory_order_relaxed);
+			r->active.store(true, std::memory_order_relaxed);
+			r->next = d.head.load(std::memory_order_relaxed);
+			while (!d.head.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed));
+			d.records.fetch_add(1, std::memory_order_relaxed);
+			return r;
+		}
+
+		static size_t scan_threshold()
+		{
+			return 2 * domain().records.load(std::memory_order_relaxed) * SlotsPerThread + ScanSlack;
+		}
+
+		static void scan(std::vector<Retired>& retired)
+		{
+			Domain& d = domain();
+			{
+				std::unique_lock<std::mutex> lk(d.orphan_mtx, std::try_to_lock);
+				if (lk.owns_lock() && !d.orphans.empty()) {
+					retired.insert(retired.end(), d.orphans.begin(), d.orphans.end());   // 고아 노드 입양
+					d.orphans.clear();
+				}
+			}
+			if (retired.empty()) return;
+
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			std::vector<void*> hazards;
+			for (Record* r = d.head.load(std::memory_order_acquire); r; r = r->next) {
+				for (auto& h : r->hazards) {
+					if (void* p = h.load(std::memory_order_acquire)) hazards.push_back(p);
+				}
+			}
+			std::sort(hazards.begin(), hazards.end());
+
+			size_t kept = 0;
+			for (size_t i = 0; i < retired.size(); ++i) {
+				if (std::binary_search(hazards.begin(), hazards.end(), retired[i].ptr)) {
+					retired[kept++] = retired[i];       // 아직 누군가 보호 중
+				}
+				else {
+					retired[i].deleter(retired[i].ptr);
+				}
+			}
+			retired.resize(kept);
+		}
+	};
+
+	//=============================================================================================
+	// EpochReclamation (Keir Fraser, 2004)
+	//=============================================================================================
+	class EpochReclamation
+	{
+	public:
+		static const size_t CollectInterval = 64;  // retire 몇 번마다 epoch 전진/회수를 시도할지
+
+		class Guard
+		{
+		public:
+			Guard() { local().enter(); }
+			~Guard() { local().exit(); }
+
+			Guard(const Guard&) = delete;
+			Guard& operator=(const Guard&) = delete;
+
+			template<typename T>
+			T* protect(const std::atomic<T*>& src) { return src.load(std::memory_order_acquire); }
+
+			template<typename Source, typename GetPtr>
+			auto protect(const Source& src, GetPtr) -> decltype(src.load(std::memory_order_acquire))
+			{
+				return src.load(std::memory_order_acquire);
+			}
+			// guard 구간 안에서 읽은 노드는 구간이 끝날 때까지 해제되지 않으므로 별도 공개가 필요 없음
+
+			void clear() noexcept {}
+		};
+
+		template<typename T>
+		static void retire(T* p) { retire(p, &delete_object<T>); }
+
+		static void retire(void* p, void (*deleter)(void*))
+		{
+			ThreadState& ts = local();
+			ts.limbo.push_back(Retired{ p, deleter, domain().epoch.load(std::memory_order_acquire) });
+			if (++ts.retire_count % CollectInterval == 0) {
+				try_advance();
+				reclaim(ts.limbo);
+			}
+		}
+
+		static void collect()
+		{
+			// 정지 상태(다른 guard 없음)라면 두 번 전진으로 모두 회수 가능
+			for (int i = 0; i < 3; ++i) try_advance();
+			reclaim(local().limbo);
+		}
+
+		static size_t pending() { return local().limbo.size(); }
+
+		// epoch 이 두 번 전진하면 호출 전에 진입한 guard 는 모두 끝났다
+		// guard 안에서 부르면 자기 자신을 기다리므로 안 된다
+		static void synchronize()
+		{
+			Domain& d = domain();
+			const uint64_t target = d.epoch.load(std::memory_order_acquire) + 2;
+			while (d.epoch.load(std::memory_order_acquire) < target) {
+				try_advance();
+				if (d.epoch.load(std::memory_order_acquire) < target) std::this_thread::yield();
+			}
+		}
+
+	private:
+		struct Record
+		{
+			std::atomic<uint64_t> state{ 0 };  // (진입 epoch << 1) | 1, 0이면 guard 밖
+			std::atomic<bool> active{ true };
+			Record* next = nullptr;
+		};
+
+		struct Domain
+		{
+			std::atomic<uint64_t> epoch{ 1 };
+			std::atomic<Record*> head{ nullptr };
+
+			std::mutex orphan_mtx;
+			std::vector<Retired> orphans;
+		};
+
+		static Domain& domain()
+		{
+			static Domain* d = new Domain();
+			return *d;
+		}
+
+		struct ThreadState
+		{
+			Record* rec;
+			int depth = 0;                  // guard 중첩 깊이
+			size_t retire_count = 0;
+			std::vector<Retired> limbo;     // 아직 해제할 수 없는 노드(retire epoch 순)
+
+			ThreadState() : rec(acquire_record()) {}
+
+			~ThreadState()
+			{
+				try_advance();
+				reclaim(limbo);
+				if (!limbo.empty()) {
+					Domain& d = domain();
+					std::lock_guard<std::mutex> lk(d.orphan_mtx);
+					d.orphans.insert(d.orphans.end(), limbo.begin(), limbo.end());
+				}
+				rec->active.store(false, std::memory_order_release);
+			}
+
+			void enter()
+			{
+				if (depth++ > 0) return;
+				const uint64_t e = domain().epoch.load(std::memory_order_acquire);
+				rec->state.store((e << 1) | 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				// 진입 공개 후에 공유 포인터를 읽도록 보장(try_advance가 이 진입을 놓치지 않게)
+			}
+
+			void exit()
+			{
+				if (--depth > 0) return;
+				rec->state.store(0, std::memory_order_release);
+			}
+		};
+
+		static ThreadState& local()
+		{
+			static thread_local ThreadState ts;
+			return ts;
+		}
+
+		static Record* acquire_record()
+		{
+			Domain& d = domain();
+
+			for (Record* r = d.head.load(std::memory_order_acquire); r; r = r->next) {
+				bool expected = false;
+				if (!r->active.load(std::memory_order_relaxed) &&
+					r->active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+					return r;
+				}
+			}
+
+			Record* r = new Record();
+			r->next = d.head.load(std::memory_order_relaxed);
+			while (!d.head.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed));
+			return r;
+		}
+
+		static void try_advance()
+		{
+			// 모든 활성 스레드가 현재 epoch에 진입해 있을 때만 전진
+			Domain& d = domain();
+			uint64_t e = d.epoch.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			for (Record* r = d.head.load(std::memory_order_acquire); r; r = r->next) {
+				const uint64_t s = r->state.load(std::memory_order_acquire);
+				if ((s & 1) && (s >> 1) != e) return;
+			}
+			d.epoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+		}
+
+		static void reclaim(std::vector<Retired>& limbo)
+		{
+			Domain& d = domain();
+			{
+				std::unique_lock<std::mutex> lk(d.orphan_mtx, std::try_to_lock);
+				if (lk.owns_lock() && !d.orphans.empty()) {
+					limbo.insert(limbo.end(), d.orphans.begin(), d.orphans.end());
+					d.orphans.clear();
+				}
+			}
+
+			const uint64_t e = d.epoch.load(std::memory_order_acquire);
+
+			size_t kept = 0;
+			for (size_t i = 0; i < limbo.size(); ++i) {
+				if (limbo[i].epoch + 2 <= e) {
+					limbo[i].deleter(limbo[i].ptr);     // 2 epoch 전에 retire => 참조 중인 스레드 없음
+				}
+				else {
+					limbo[kept++] = limbo[i];
+				}
+			}
+			limbo.resize(kept);
+		}
+	};
+}//LockFree
@@ -0,0 +1,496 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file ring_queue.h
+/// @brief lock-free bounded ring queue (header-only, C++14)
+///
+///   - SpscRing<T>     : 생산자 1 / 소비자 1, head/tail을 서로 다른 cache line에 두고 상대 index를 캐시
+///   - MpmcQueue<T>    : Dmitry Vyukov의 bounded MPMC queue (cell마다 sequence 번호)
+///   - BlockingRing<Q> : 위 큐를 감싸는 blocking 래퍼 (잠깐 spin => futex 대기)
+///       Windows: WaitOnAddress / WakeByAddress*, Linux: futex, 그 외: 짧은 sleep polling
+///
+///   용량은 2의 거듭제곱으로 올림. T는 기본 생성 + move 대입 가능해야 한다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+
+#if defined(_WIN32)
+  #include <windows.h>
+  #pragma comment(lib, "Synchronization.lib")   // WaitOnAddress (Windows 8+)
+#elif defined(__linux__)
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #include <limits.h>
+  #include <time.h>
+#endif
+
+#include "backoff.h"     // CacheLineSize, detail::cpu_relax
+
+
+namespace LockFree
+{
+	// producer/consumer 예제들의 hand-off 방식 선택 (Lock: mutex/Interlocked 기반 기존 방식, Ring: 이 헤더의 lock-free ring)
+	enum class HandOff { Lock, Ring };
+
+	namespace detail
+	{
+		inline size_t round_up_pow2(size_t n)
+		{
+			size_t cap = 2;
+			while (cap < n) cap <<= 1;
+			return cap;
+		}
+
+		// word 값이 expected인 동안 잠든다(spurious wake-up 가능 => 호출자가 조건 재확인)
+		inline void futex_wait(std::atomic<uint32_t>& word, uint32_t expected)
+		{
+#if defined(_WIN32)
+			WaitOnAddress(&word, &expected, sizeof(expected), INFINITE);
+#elif defined(__linux__)
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+			if (word.load(std::memory_order_acquire) == expected) {
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+			}
+#endif
+		}
+
+		// futex_wait + 최대 timeout 까지만 (깨어나도 조건/시간은 호출자가 다시 확인)
+		inline void futex_wait_for(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout)
+		{
+			if (timeout <= std::chrono::nanoseconds::zero()) return;
+#if defined(_WIN32)
+			const DWORD ms = static_cast<DWORD>((std::min)(std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count() + 1, 0x7FFFFFFFLL));
+			WaitOnAddress(&word, &expected, sizeof(expected), ms);
+#elif defined(__linux__)
+			timespec ts;
+			ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+			ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+#else
+			if (word.load(std::memory_order_acquire) == expected) {
+				std::this_thread::sleep_for((std::min)(timeout, std::chrono::nanoseconds(50000)));
+			}
+#endif
+		}
+
+		inline void futex_wake_one(std::atomic<uint32_t>& word)
+		{
+#if defined(_WIN32)
+			WakeByAddressSingle(&word);
+#elif defined(__linux__)
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+			(void)word;
+#endif
+		}
+
+		inline void futex_wake_all(std::atomic<uint32_t>& word)
+		{
+#if defined(_WIN32)
+			WakeByAddressAll(&word);
+#elif defined(__linux__)
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+			(void)word;
+#endif
+		}
+	}
+
+	//=============================================================================================
+	// SpscRing<T>: single producer / single consumer
+	//   - producer만 _tail, consumer만 _head를 쓴다 => CAS 없이 load/store 한 번씩
+	//   - 상대편 index는 로컬 캐시(_head_cache / _tail_cache)로 읽어 cache line 왕복을 줄임
+	//=============================================================================================
+	template<typename T>
+	class SpscRing
+	{
+	public:
+		using value_type = T;
+
+		explicit SpscRing(size_t capacity)
+			: _mask(detail::round_up_pow2(capacity) - 1)
+			, _buf(new T[_mask + 1])
+		{}
+
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		size_t capacity() const noexcept { return _mask + 1; }
+
+		size_t size() const noexcept
+		{
+			// 다른 스레드가 동시에 바꾸므로 근사값
+			return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+		}
+
+		bool empty() const noexcept { return size() == 0; }
+
+		// producer 전용
+		template<typename U>
+		bool try_push(U&& v)
+		{
+			const size_t t = _tail.load(std::memory_order_relaxed);
+			if (t - _head_cache > _mask) {
+				_head_cache = _head.load(std::memory_order_acquire);
+				if (t - _head_cache > _mask) return false;     // full
+			}
+
+			_buf[t & _mask] = std::forward<U>(v);
+			_tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		// producer 전용: 들어가는 만큼 넣고 개수 반환 (tail publish 1번)
+		size_t try_push_n(const T* items, size_t n)
+		{
+			const size_t t = _tail.load(std::memory_order_relaxed);
+			size_t free = capacity() - (t - _head_cache);
+			if (free < n) {
+				_head_cache = _head.load(std::memory_order_acquire);
+				free = capacity() - (t - _head_cache);
+			}
+
+			const size_t k = (std::min)(n, free);
+			for (size_t i = 0; i < k; ++i) _buf[(t + i) & _mask] = items[i];
+			if (k) _tail.store(t + k, std::memory_order_release);
+			return k;
+		}
+
+		// consumer 전용
+		bool try_pop(T& out)
+		{
+			const size_t h = _head.load(std::memory_order_relaxed);
+			if (h == _tail_cache) {
+				_tail_cache = _tail.load(std::memory_order_acquire);
+				if (h == _tail_cache) return false;            // empty
+			}
+
+			out = std::move(_buf[h & _mask]);
+			_head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+
+		// consumer 전용: 최대 n개 꺼내고 개수 반환 (head publish 1번)
+		size_t try_pop_n(T* out, size_t n)
+		{
+			const size_t h = _head.load(std::memory_order_relaxed);
+			if (_tail_cache - h < n) _tail_cache = _tail.load(std::memory_order_acquire);
+
+			const size_t k = (std::min)(n, _tail_cache - h);
+			for (size_t i = 0; i < k; ++i) out[i] = std::move(_buf[(h + i) & _mask]);
+			if (k) _head.store(h + k, std::memory_order_release);
+			return k;
+		}
+
+	private:
+		const size_t _mask;
+		std::unique_ptr<T[]> _buf;
+
+		alignas(CacheLineSize) std::atomic<size_t> _tail{ 0 };     // producer가 씀
+		size_t _head_cache = 0;                                     // producer가 마지막으로 본 head
+
+		alignas(CacheLineSize) std::atomic<size_t> _head{ 0 };     // consumer가 씀
+		size_t _tail_cache = 0;                                     // consumer가 마지막으로 본 tail
+	};
+
+	//=============================================================================================
+	// MpmcQueue<T>: multi producer / multi consumer (Vyukov bounded queue)
+	//   - cell.seq == pos      : pos 번째 push가 쓸 수 있음
+	//   - cell.seq == pos + 1  : pos 번째 pop이 읽을 수 있음
+	//   - 위치 예약은 enqueue/dequeue 카운터 CAS 1번, 데이터 publish는 cell seq store
+	//=============================================================================================
+	template<typename T>
+	class MpmcQueue
+	{
+	public:
+		using value_type = T;
+
+		explicit MpmcQueue(size_t capacity)
+			: _mask(detail::round_up_pow2(capacity) - 1)
+			, _cells(new Cell[_mask + 1])
+		{
+			for (size_t i = 0; i <= _mask; ++i) _cells[i].seq.store(i, std::memory_order_relaxed);
+		}
+
+		MpmcQueue(const MpmcQueue&) = delete;
+		MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+		size_t capacity() const noexcept { return _mask + 1; }
+
+		size_t size() const noexcept
+		{
+			// 근사값(동시 push/pop 중에는 순간적으로 틀릴 수 있음)
+			const size_t e = _enqueue_pos.load(std::memory_order_acquire);
+			const size_t d = _dequeue_pos.load(std::memory_order_acquire);
+			return e > d ? e - d : 0;
+		}
+
+		bool empty() const noexcept { return size() == 0; }
+
+		template<typename U>
+		bool try_push(U&& v)
+		{
+			size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+			for (;;) {
+				Cell& c = _cells[pos & _mask];
+				const intptr_t diff = (intptr_t)c.seq.load(std::memory_order_acquire) - (intptr_t)pos;
+
+				if (diff == 0) {
+					if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						c.data = std::forward<U>(v);
+						c.seq.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false;                                   // full
+				}
+				else {
+					pos = _enqueue_pos.load(std::memory_order_relaxed);  // 다른 producer가 앞서감
+				}
+			}
+		}
+
+		// 연속으로 비어 있는 cell을 한 번의 CAS로 예약 => 들어간 개수 반환
+		size_t try_push_n(const T* items, size_t n)
+		{
+			size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+			for (;;) {
+				size_t k = 0;
+				while (k < n && k <= _mask && _cells[(pos + k) & _mask].seq.load(std::memory_order_acquire) == pos + k) ++k;
+
+				if (k == 0) {
+					const intptr_t diff = (intptr_t)_cells[pos & _mask].seq.load(std::memory_order_acquire) - (intptr_t)pos;
+					if (diff < 0) return 0;                         // full
+					pos = _enqueue_pos.load(std::memory_order_relaxed);
+					continue;
+				}
+
+				if (_enqueue_pos.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) {
+					for (size_t i = 0; i < k; ++i) {
+						Cell& c = _cells[(pos + i) & _mask];
+						c.data = items[i];
+						c.seq.store(pos + i + 1, std::memory_order_release);
+					}
+					return k;
+				}
+			}
+		}
+
+		bool try_pop(T& out)
+		{
+			size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+			for (;;) {
+				Cell& c = _cells[pos & _mask];
+				const intptr_t diff = (intptr_t)c.seq.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+
+				if (diff == 0) {
+					if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						out = std::move(c.data);
+						c.seq.store(pos + _mask + 1, std::memory_order_release);  // 한 바퀴 뒤 push에게 반환
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false;                                   // empty
+				}
+				else {
+					pos = _dequeue_pos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// 연속으로 채워진 cell을 한 번의 CAS로 예약 => 꺼낸 개수 반환
+		size_t try_pop_n(T* out, size_t n)
+		{
+			size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+			for (;;) {
+				size_t k = 0;
+				while (k < n && k <= _mask && _cells[(pos + k) & _mask].seq.load(std::memory_order_acquire) == pos + k + 1) ++k;
+
+				if (k == 0) {
+					const intptr_t diff = (intptr_t)_cells[pos & _mask].seq.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+					if (diff < 0) return 0;                         // empty
+					pos = _dequeue_pos.load(std::memory_order_relaxed);
+					continue;
+				}
+
+				if (_dequeue_pos.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) {
+					for (size_t i = 0; i < k; ++i) {
+						Cell& c = _cells[(pos + i) & _mask];
+						out[i] = std::move(c.data);
+						c.seq.store(pos + i + _mask + 1, std::memory_order_release);
+					}
+					return k;
+				}
+			}
+		}
+
+	private:
+		struct Cell {
+			std::atomic<size_t> seq;
+			T data;
+		};
+
+		const size_t _mask;
+		std::unique_ptr<Cell[]> _cells;
+
+		alignas(CacheLineSize) std::atomic<size_t> _enqueue_pos{ 0 };
+		alignas(CacheLineSize) std::atomic<size_t> _dequeue_pos{ 0 };
+	};
+
+	//=============================================================================================
+	// BlockingRing<Queue>: SpscRing / MpmcQueue를 blocking push/pop으로 감싼 래퍼
+	//   - 먼저 SpinCount번 재시도(대부분의 hand-off는 여기서 끝남)
+	//   - 그래도 안 되면 waiter 수를 올리고 epoch word에서 futex 대기
+	//   - 상대편은 성공 후 waiter가 있을 때만 epoch을 올리고 깨움 => 평소에는 syscall 없음
+	//   - close() 후 push는 실패, pop은 남은 요소를 모두 꺼낸 뒤 실패
+	//=============================================================================================
+	template<typename Queue>
+	class BlockingRing
+	{
+	public:
+		using value_type = typename Queue::value_type;
+
+		static const int SpinCount = 128;
+
+		explicit BlockingRing(size_t capacity) : _q(capacity) {}
+
+		Queue& queue() noexcept { return _q; }
+
+		template<typename U>
+		bool push(U&& v)
+		{
+			if (!block_until([&] { return _q.try_push(std::forward<U>(v)); }, _not_full, _push_waiters)) return false;
+			signal(_not_empty, _pop_waiters, false);
+			return true;
+		}
+
+		// 모두 넣을 때까지 대기. close되면 그때까지 넣은 개수 반환
+		size_t push_n(const value_type* items, size_t n)
+		{
+			size_t done = 0;
+			while (done < n) {
+				size_t k = 0;
+				if (!block_until([&] { return (k = _q.try_push_n(items + done, n - done)) != 0; }, _not_full, _push_waiters)) break;
+				done += k;
+				signal(_not_empty, _pop_waiters, k > 1);
+			}
+			return done;
+		}
+
+		bool pop(value_type& out)
+		{
+			if (!block_until([&] { return _q.try_pop(out); }, _not_empty, _pop_waiters)) return false;
+			signal(_not_full, _push_waiters, false);
+			return true;
+		}
+
+		// 1개 이상 꺼낼 때까지 대기 후 최대 n개 반환. close + empty면 0
+		size_t pop_n(value_type* out, size_t n)
+		{
+			size_t k = 0;
+			if (!block_until([&] { return (k = _q.try_pop_n(out, n)) != 0; }, _not_empty, _pop_waiters)) return 0;
+			signal(_not_full, _push_waiters, k > 1);
+			return k;
+		}
+
+		template<typename U>
+		bool try_push(U&& v)
+		{
+			if (_closed.load(std::memory_order_acquire) || !_q.try_push(std::forward<U>(v))) return false;
+			signal(_not_empty, _pop_waiters, false);
+			return true;
+		}
+
+		bool try_pop(value_type& out)
+		{
+			if (!_q.try_pop(out)) return false;
+			signal(_not_full, _push_waiters, false);
+			return true;
+		}
+
+		void close()
+		{
+			_closed.store(true, std::memory_order_seq_cst);
+			wake_all(_not_empty);
+			wake_all(_not_full);
+		}
+
+		bool closed() const noexcept { return _closed.load(std::memory_order_acquire); }
+
+	private:
+		template<typename TryOp>
+		bool block_until(TryOp&& op, std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& waiters)
+		{
+			const bool isPush = (&epoch == &_not_full);
+			// push는 close 즉시 실패, pop은 남은 요소를 다 꺼낸 뒤에 실패
+
+			for (int i = 0; i < SpinCount; ++i) {
+				if (isPush && _closed.load(std::memory_order_acquire)) return false;
+				if (op()) return true;
+				detail::cpu_relax();
+			}
+
+			for (;;) {
+				waiters.fetch_add(1, std::memory_order_seq_cst);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				// waiter 등록 ~ 재시도 사이에 상대편 publish가 끼면 상대편이 반드시 waiter를 본다(Dekker)
+
+				const uint32_t e = epoch.load(std::memory_order_acquire);
+				const bool closed = _closed.load(std::memory_order_acquire);
+
+				if (!(isPush && closed) && op()) {
+					waiters.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				}
+				if (closed) {
+					waiters.fetch_sub(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				detail::futex_wait(epoch, e);
+				waiters.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		void signal(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& waiters, bool all)
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (waiters.load(std::memory_order_relaxed) == 0) return;   // 잠든 상대가 없으면 syscall 생략
+
+			epoch.fetch_add(1, std::memory_order_release);
+			if (all) detail::futex_wake_all(epoch);
+			else     detail::futex_wake_one(epoch);
+		}
+
+		static void wake_all(std::atomic<uint32_t>& epoch)
+		{
+			epoch.fetch_add(1, std::memory_order_release);
+			detail::futex_wake_all(epoch);
+		}
+
+		Queue _q;
+
+		alignas(CacheLineSize) std::atomic<uint32_t> _not_empty{ 0 };  // push 성공 시 증가(pop 대기용 futex word)
+		std::atomic<uint32_t> _pop_waiters{ 0 };
+
+		alignas(CacheLineSize) std::atomic<uint32_t> _not_full{ 0 };   // pop 성공 시 증가(push 대기용 futex word)
+		std::atomic<uint32_t> _push_waiters{ 0 };
+
+		std::atomic<bool> _closed{ false };
+	};
+
+	template<typename T> using BlockingSpscRing = BlockingRing<SpscRing<T>>;
+	template<typename T> using BlockingMpmcQueue = BlockingRing<MpmcQueue<T>>;
+}//LockFree
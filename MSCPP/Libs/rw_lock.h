@@ -0,0 +1,339 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file rw_lock.h
+/// @brief 읽기 위주 공유 상태용 reader-writer lock (header-only, C++14)
+///
+///   std::shared_mutex 는 lock_shared 마다 reader 수(cache line 하나)를 모든 스레드가 갱신한다.
+///   => 읽기만 해도 코어 수만큼 그 cache line 이 핑퐁하고 읽기가 늘지 않는다.
+///
+///   - Sync::DistributedSharedMutex (BasicDistributedSharedMutex<MaxSlots>)
+///       reader 수를 cache line 하나씩 차지하는 slot 여러 개(코어 수를 2 의 거듭제곱으로 올림, 최대 MaxSlots)에 나눠 센다.
+///       스레드는 처음 쓸 때 round-robin 으로 받은 번호의 slot 만 건드리므로 읽기끼리는 line 을 공유하지 않는다.
+///       (unlock_shared 가 같은 slot 을 찾아야 하므로 "현재 CPU" 가 아니라 "스레드 번호" 로 고른다)
+///       writer : writer flag 를 세운 뒤 모든 slot 이 0 이 되기를 기다린다 (쓰기 비용 = slot 수만큼 읽기)
+///       writer 우선 : flag 가 서 있으면 새 reader 는 물러나서 기다린다 (reader 가 많아도 writer 가 굶지 않음)
+///       대기 : 잠깐 spin/yield => mutex + condition_variable 에서 잠든다 (깨울 상대가 없으면 notify 생략)
+///       std::shared_timed_mutex 와 같은 이름의 함수 (lock/try_lock/try_lock_for/until, *_shared)
+///       => std::shared_lock / std::unique_lock 에 그대로 쓴다. 재귀 잠금은 안 된다.
+///
+///   - Sync::SharedValue<T>  : seqlock (T 는 trivially copyable + 기본 생성 가능한 작은 POD)
+///       읽기 = sequence 번호 확인 + word 복사 + 재확인 (공유 메모리에 쓰지 않음, lock 없음, 쓰기와 겹치면 재시도)
+///       쓰기 = writer 끼리 mutex, sequence 홀수 => 값 => 짝수
+///       값이 커질수록(수백 byte 이상) 읽기 재시도가 늘어나므로 큰 구조체는 DistributedSharedMutex 를 쓴다.
+///
+///   slot 배열이 cache line 정렬(alignas)이므로 heap 에 만들 때는 C++17(aligned new) 이 필요하다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "backoff.h"     // CacheLineSize, detail::cpu_relax
+
+
+namespace Sync
+{
+	using LockFree::CacheLineSize;
+
+	namespace detail
+	{
+		// 스레드마다 고정된 번호 (처음 쓸 때 round-robin)
+		inline uint32_t thread_slot() noexcept
+		{
+			static std::atomic<uint32_t> next(0);
+			static thread_local const uint32_t slot = next.fetch_add(1, std::memory_order_relaxed);
+			return slot;
+		}
+
+		// 코어 수를 2 의 거듭제곱으로 올림, [1, max]
+		inline size_t slot_count(size_t max) noexcept
+		{
+			const size_t cores = std::thread::hardware_concurrency();
+			size_t n = 1;
+			while (n < cores && n < max) n <<= 1;
+			return n;
+		}
+	}
+
+	//=============================================================================================
+	// DistributedSharedMutex
+	//=============================================================================================
+	template<size_t MaxSlots = 64>
+	class BasicDistributedSharedMutex
+	{
+		static_assert(MaxSlots > 0 && 0 == (MaxSlots & (MaxSlots - 1)), "MaxSlots must be a power of two");
+
+	public:
+		static const uint32_t SpinCount = 128;      // 잠들기 전 spin(절반) + yield(절반)
+
+		BasicDistributedSharedMutex() : _mask(detail::slot_count(MaxSlots) - 1) {}
+
+		BasicDistributedSharedMutex(const BasicDistributedSharedMutex&) = delete;
+		BasicDistributedSharedMutex& operator=(const BasicDistributedSharedMutex&) = delete;
+
+		size_t slots() const noexcept { return _mask + 1; }
+
+		//-----------------------------------------------------------------------------------------
+		// 쓰기 (배타)
+		//-----------------------------------------------------------------------------------------
+		void lock()
+		{
+			wait([this] { return claim(); });
+			wait([this] { return drained(); });
+		}
+
+		bool try_lock()
+		{
+			if (!claim()) return false;
+			if (drained()) return true;
+			release_writer();
+			return false;
+		}
+
+		template<typename Rep, typename Period>
+		bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout)
+		{
+			return try_lock_until(std::chrono::steady_clock::now() + timeout);
+		}
+
+		template<typename Clock, typename Duration>
+		bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline)
+		{
+			if (!wait_until([this] { return claim(); }, deadline)) return false;
+			if (wait_until([this] { return drained(); }, deadline)) return true;
+
+			// 시간 안에 reader 가 다 빠지지 않았다 => flag 를 내리고 물러난 reader 를 깨운다
+			release_writer();
+			return false;
+		}
+
+		void unlock() { release_writer(); }
+
+		//-----------------------------------------------------------------------------------------
+		// 읽기 (공유)
+		//-----------------------------------------------------------------------------------------
+		void lock_shared()
+		{
+			while (!try_lock_shared()) {
+				wait([this] { return 0 == _writer.load(std::memory_order_acquire); });
+			}
+		}
+
+		bool try_lock_shared()
+		{
+			if (0 != _writer.load(std::memory_order_relaxed)) return false;
+
+			// slot 증가 => writer flag 확인 (writer 는 flag => slot 순서, 둘 다 seq_cst 라 한 쪽은 반드시 상대를 본다)
+			std::atomic<int32_t>& readers = slot();
+			readers.fetch_add(1, std::memory_order_seq_cst);
+			if (0 == _writer.load(std::memory_order_seq_cst)) return true;
+
+			// writer 가 먼저 왔다 => 물러난다 (slot 이 0 이 되기를 기다리는 writer 를 깨움)
+			readers.fetch_sub(1, std::memory_order_seq_cst);
+			wake();
+			return false;
+		}
+
+		template<typename Rep, typename Period>
+		bool try_lock_shared_for(const std::chrono::duration<Rep, Period>& timeout)
+		{
+			return try_lock_shared_until(std::chrono::steady_clock::now() + timeout);
+		}
+
+		template<typename Clock, typename Duration>
+		bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration>& deadline)
+		{
+			while (!try_lock_shared()) {
+				if (!wait_until([this] { return 0 == _writer.load(std::memory_order_acquire); }, deadline)) return false;
+			}
+			return true;
+		}
+
+		void unlock_shared()
+		{
+			slot().fetch_sub(1, std::memory_order_seq_cst);
+			wake();
+		}
+
+	private:
+		struct alignas(CacheLineSize) Slot
+		{
+			std::atomic<int32_t> readers{ 0 };
+		};
+
+		std::atomic<int32_t>& slot() noexcept { return _slots[detail::thread_slot() & _mask].readers; }
+
+		bool claim() noexcept
+		{
+			uint32_t expected = 0;
+			return _writer.compare_exchange_strong(expected, 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+
+		bool drained() const noexcept
+		{
+			for (size_t i = 0; i <= _mask; ++i) {
+				if (0 != _slots[i].readers.load(std::memory_order_seq_cst)) return false;
+			}
+			return true;
+		}
+
+		void release_writer()
+		{
+			_writer.store(0, std::memory_order_seq_cst);
+			wake();
+		}
+
+		// 상태를 바꾼 쪽이 부른다. 잠든 스레드가 없으면 mutex 도 건드리지 않는다
+		void wake()
+		{
+			if (0 == _sleepers.load(std::memory_order_seq_cst)) return;
+			{
+				std::lock_guard<std::mutex> lock(_park);
+			}
+			_parked.notify_all();
+		}
+
+		template<typename Ready>
+		void wait(Ready ready)
+		{
+			if (spin(ready)) return;
+
+			std::unique_lock<std::mutex> lock(_park);
+			_sleepers.fetch_add(1, std::memory_order_seq_cst);
+			while (!ready()) _parked.wait(lock);
+			_sleepers.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		template<typename Ready, typename Clock, typename Duration>
+		bool wait_until(Ready ready, const std::chrono::time_point<Clock, Duration>& deadline)
+		{
+			if (spin(ready)) return true;
+
+			std::unique_lock<std::mutex> lock(_park);
+			_sleepers.fetch_add(1, std::memory_order_seq_cst);
+			bool ok = ready();
+			while (!ok) {
+				const bool timeout = std::cv_status::timeout == _parked.wait_until(lock, deadline);
+				ok = ready();
+				if (timeout) break;
+			}
+			_sleepers.fetch_sub(1, std::memory_order_relaxed);
+			return ok;
+		}
+
+		template<typename Ready>
+		static bool spin(Ready& ready)
+		{
+			for (uint32_t i = 0; i < SpinCount; ++i) {
+				if (ready()) return true;
+				if (i < SpinCount / 2) LockFree::detail::cpu_relax();
+				else std::this_thread::yield();
+			}
+			return false;
+		}
+
+		Slot _slots[MaxSlots];
+		const size_t _mask;
+
+		// reader 는 읽기만 하고 writer/잠드는 스레드만 쓴다
+		alignas(CacheLineSize) std::atomic<uint32_t> _writer{ 0 };
+		std::atomic<uint32_t> _sleepers{ 0 };
+
+		alignas(CacheLineSize) std::mutex _park;
+		std::condition_variable _parked;
+	};
+
+	typedef BasicDistributedSharedMutex<> DistributedSharedMutex;
+
+	//=============================================================================================
+	// SharedValue<T> (seqlock)
+	//=============================================================================================
+	template<typename T>
+	class SharedValue
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "SharedValue<T> requires a trivially copyable T");
+
+	public:
+		SharedValue() : SharedValue(T()) {}
+		explicit SharedValue(const T& value) { write_words(value); }
+
+		SharedValue(const SharedValue&) = delete;
+		SharedValue& operator=(const SharedValue&) = delete;
+
+		// 쓰기와 겹치면 다시 읽는다 (writer 가 오래 멈춰 있으면 yield)
+		T load() const noexcept
+		{
+			for (uint32_t spins = 0;; ++spins) {
+				const uint32_t before = _sequence.load(std::memory_order_acquire);
+				if (0 == (before & 1)) {
+					T value;
+					read_words(value);
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (_sequence.load(std::memory_order_relaxed) == before) return value;
+				}
+				if (spins < 64) LockFree::detail::cpu_relax();
+				else std::this_thread::yield();
+			}
+		}
+
+		void store(const T& value)
+		{
+			std::lock_guard<std::mutex> lock(_writer);
+			publish(value);
+		}
+
+		// 읽고-고치고-쓰기 (writer 끼리 직렬화되므로 갱신이 사라지지 않는다)
+		template<typename Modify>
+		void update(Modify modify)
+		{
+			std::lock_guard<std::mutex> lock(_writer);
+			T value;
+			read_words(value);
+			modify(value);
+			publish(value);
+		}
+
+		uint32_t version() const noexcept { return _sequence.load(std::memory_order_acquire) >> 1; }
+
+	private:
+		typedef uintptr_t Word;     // 항상 lock-free 인 크기 (32-bit 에서 64-bit atomic 은 cmpxchg8b 로 읽어 line 을 쓴다)
+		static const size_t WordCount = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+		void publish(const T& value) noexcept
+		{
+			const uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+			_sequence.store(sequence + 1, std::memory_order_relaxed);       // 홀수 : 쓰는 중
+			std::atomic_thread_fence(std::memory_order_release);
+			write_words(value);
+			_sequence.store(sequence + 2, std::memory_order_release);
+		}
+
+		// 데이터 경합이 없도록 word 단위 relaxed atomic 으로 복사
+		void read_words(T& value) const noexcept
+		{
+			Word words[WordCount];
+			for (size_t i = 0; i < WordCount; ++i) words[i] = _words[i].load(std::memory_order_relaxed);
+			std::memcpy(&value, words, sizeof(T));
+		}
+
+		void write_words(const T& value) noexcept
+		{
+			Word words[WordCount] = {};
+			std::memcpy(words, &value, sizeof(T));
+			for (size_t i = 0; i < WordCount; ++i) _words[i].store(words[i], std::memory_order_relaxed);
+		}
+
+		alignas(CacheLineSize) std::atomic<uint32_t> _sequence{ 0 };
+		std::atomic<Word> _words[WordCount];
+
+		alignas(CacheLineSize) std::mutex _writer;
+	};
+}//Sync
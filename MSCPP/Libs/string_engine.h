@@ -0,0 +1,544 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file string_engine.h
+/// @brief 할당 없는 string_view 기반 split / join / trim / replace / format (header-only, C++14)
+///
+///   StringEngine::string_view
+///     - C++17 이상이면 std::string_view, 아니면 같은 이름/의미의 최소 구현(v140 프로젝트용)
+///
+///   split(input, ',')             : lazy token range. 토큰은 입력을 가리키는 string_view (std::string 생성 없음)
+///   split(input, "::")            : 여러 글자 구분자
+///   split_any(input, " \t,")      : 구분자 집합(strtok 과 같은 의미). SSE2면 16 byte씩 비교, 아니면 256-bit 표
+///     EmptyTokens::Keep (기본값)   : "1,,2" => "1" "" "2"
+///     EmptyTokens::Skip           : "1,,2" => "1" "2"
+///   trim / trim_left / trim_right : 앞뒤를 잘라낸 view 반환
+///   replace_all(in, from, to, out): 1st pass로 결과 길이를 계산해 한 번만 크기를 잡고 2nd pass로 복사
+///   join(parts, sep, out)         : 전체 길이를 먼저 계산해 한 번만 크기를 잡고 복사
+///   vformat_to / format_to        : 짧은 결과는 stack buffer, 긴 결과는 out 에 직접 vsnprintf (재시도는 모자랄 때만)
+///
+///   out 인자를 받는 함수는 out 의 용량을 재사용한다 => 루프에서 같은 버퍼를 넘기면 steady state에서 할당 0회
+///   token/trim 결과 view 는 입력 문자열이 살아 있는 동안만 유효하다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_MSVC_LANG)
+#define STRING_ENGINE_CPLUSPLUS _MSVC_LANG
+#else
+#define STRING_ENGINE_CPLUSPLUS __cplusplus
+#endif
+
+#if !defined(STRING_ENGINE_HAS_STD_STRING_VIEW)
+#if STRING_ENGINE_CPLUSPLUS >= 201703L
+#define STRING_ENGINE_HAS_STD_STRING_VIEW 1
+#else
+#define STRING_ENGINE_HAS_STD_STRING_VIEW 0
+#endif
+#endif
+
+#if !defined(STRING_ENGINE_HAS_SSE2)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_ENGINE_HAS_SSE2 1
+#else
+#define STRING_ENGINE_HAS_SSE2 0
+#endif
+#endif
+
+#if STRING_ENGINE_HAS_STD_STRING_VIEW
+#include <string_view>
+#endif
+
+#if STRING_ENGINE_HAS_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+
+namespace StringEngine
+{
+#if STRING_ENGINE_HAS_STD_STRING_VIEW
+	using std::string_view;
+#else
+	// std::string_view 중 이 모듈이 쓰는 부분만 (C++14)
+	class string_view
+	{
+	public:
+		using size_type = size_t;
+		using const_iterator = const char*;
+		static const size_type npos = size_type(-1);
+
+		string_view() noexcept : _data(nullptr), _size(0) {}
+		string_view(const char* s, size_type n) noexcept : _data(s), _size(n) {}
+		string_view(const char* s) noexcept : _data(s), _size(strlen(s)) {}
+		string_view(const std::string& s) noexcept : _data(s.data()), _size(s.size()) {}
+
+		const char* data() const noexcept { return _data; }
+		size_type size() const noexcept { return _size; }
+		size_type length() const noexcept { return _size; }
+		bool empty() const noexcept { return 0 == _size; }
+
+		const_iterator begin() const noexcept { return _data; }
+		const_iterator end() const noexcept { return _data + _size; }
+
+		char operator[](size_type i) const noexcept { return _data[i]; }
+		char front() const noexcept { return _data[0]; }
+		char back() const noexcept { return _data[_size - 1]; }
+
+		void remove_prefix(size_type n) noexcept { _data += n; _size -= n; }
+		void remove_suffix(size_type n) noexcept { _size -= n; }
+
+		string_view substr(size_type pos, size_type n = npos) const
+		{
+			if (pos > _size) throw std::out_of_range("string_view::substr");
+			return string_view(_data + pos, (n < _size - pos) ? n : _size - pos);
+		}
+
+		size_type find(char c, size_type pos = 0) const noexcept
+		{
+			if (pos >= _size) return npos;
+			const void* hit = memchr(_data + pos, static_cast<unsigned char>(c), _size - pos);
+			return hit ? static_cast<const char*>(hit) - _data : npos;
+		}
+
+		int compare(string_view other) const noexcept
+		{
+			const size_type n = (_size < other._size) ? _size : other._size;
+			const int r = n ? memcmp(_data, other._data, n) : 0;
+			if (r) return r;
+			return (_size < other._size) ? -1 : (_size > other._size) ? 1 : 0;
+		}
+
+	private:
+		const char* _data;
+		size_type _size;
+	};
+
+	inline bool operator==(string_view a, string_view b) noexcept { return a.size() == b.size() && 0 == a.compare(b); }
+	inline bool operator!=(string_view a, string_view b) noexcept { return !(a == b); }
+
+	inline std::ostream& operator<<(std::ostream& os, string_view s)
+	{
+		return os.write(s.data(), static_cast<std::streamsize>(s.size()));
+	}
+#endif
+
+	inline std::string to_string(string_view s) { return std::string(s.data(), s.size()); }
+
+	enum class EmptyTokens { Keep, Skip };
+
+	namespace detail
+	{
+		inline unsigned count_trailing_zeros(unsigned mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return static_cast<unsigned>(index);
+#else
+			return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+		}
+	}
+
+	//=============================================================================================
+	// 구분자 탐색기 (Finder)
+	//   const char* find(first, last) const : [first, last) 에서 첫 구분자 위치, 없으면 last
+	//   size_t width() const                : 구분자 길이(다음 토큰 시작 = 구분자 위치 + width)
+	//=============================================================================================
+
+	// 한 글자 구분자 : memchr (CRT 구현이 SIMD로 되어 있다)
+	class CharFinder
+	{
+	public:
+		explicit CharFinder(char c) noexcept : _c(c) {}
+
+		const char* find(const char* first, const char* last) const noexcept
+		{
+			const void* hit = (first != last) ? memchr(first, static_cast<unsigned char>(_c), last - first) : nullptr;
+			return hit ? static_cast<const char*>(hit) : last;
+		}
+
+		size_t width() const noexcept { return 1; }
+
+	private:
+		char _c;
+	};
+
+	// 여러 글자 구분자 : 첫 글자를 memchr 로 찾은 뒤 나머지만 비교
+	//   빈 구분자는 "구분자 없음" (입력 전체가 토큰 하나)
+	class SubstrFinder
+	{
+	public:
+		explicit SubstrFinder(string_view needle) noexcept : _needle(needle) {}
+
+		const char* find(const char* first, const char* last) const noexcept
+		{
+			const size_t n = _needle.size();
+			if (0 == n) return last;
+
+			const unsigned char head = static_cast<unsigned char>(_needle[0]);
+			while (static_cast<size_t>(last - first) >= n) {
+				const void* hit = memchr(first, head, (last - first) - n + 1);
+				if (!hit) break;
+
+				const char* p = static_cast<const char*>(hit);
+				if (0 == memcmp(p + 1, _needle.data() + 1, n - 1)) return p;
+				first = p + 1;
+			}
+			return last;
+		}
+
+		size_t width() const noexcept { return _needle.size(); }
+
+	private:
+		string_view _needle;
+	};
+
+	// 구분자 집합 (strtok / find_first_of 와 같은 의미)
+	//   - SSE2 : 구분자가 MaxSimdDelimiters 개 이하이면 16 byte를 한 번에 읽어 구분자마다 cmpeq 후 OR
+	//   - 그 외 : 256-bit 표로 글자마다 O(1) 판정
+	class DelimiterSet
+	{
+	public:
+		static const size_t MaxSimdDelimiters = 8;
+
+		explicit DelimiterSet(string_view delimiters) noexcept : _count(0)
+		{
+			memset(_table, 0, sizeof(_table));
+			for (char c : delimiters) {
+				const unsigned char u = static_cast<unsigned char>(c);
+				if (contains(c)) continue;
+				_table[u >> 6] |= uint64_t(1) << (u & 63);
+#if STRING_ENGINE_HAS_SSE2
+				if (_count < MaxSimdDelimiters) _splat[_count] = _mm_set1_epi8(c);
+#endif
+				++_count;
+			}
+		}
+
+		bool contains(char c) const noexcept
+		{
+			const unsigned char u = static_cast<unsigned char>(c);
+			return 0 != (_table[u >> 6] & (uint64_t(1) << (u & 63)));
+		}
+
+		const char* find(const char* first, const char* last) const noexcept
+		{
+#if STRING_ENGINE_HAS_SSE2
+			if (_count <= MaxSimdDelimiters) {
+				while (last - first >= 16) {
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+					__m128i hit = _mm_setzero_si128();
+					for (size_t i = 0; i < _count; ++i) {
+						hit = _mm_or_si128(hit, _mm_cmpeq_epi8(chunk, _splat[i]));
+					}
+					const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+					if (mask) return first + detail::count_trailing_zeros(mask);
+					first += 16;
+				}
+			}
+#endif
+			for (; first != last; ++first) {
+				if (contains(*first)) return first;
+			}
+			return last;
+		}
+
+		size_t width() const noexcept { return 1; }
+
+	private:
+		uint64_t _table[4];
+		size_t _count;
+#if STRING_ENGINE_HAS_SSE2
+		__m128i _splat[MaxSimdDelimiters];
+#endif
+	};
+
+	//=============================================================================================
+	// SplitRange : 토큰을 하나씩 찾아 주는 lazy range (forward iterator, 토큰 = string_view)
+	//=============================================================================================
+	template<typename Finder>
+	class SplitRange
+	{
+	public:
+		class iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = string_view;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const string_view*;
+			using reference = string_view;
+
+			iterator() noexcept : _range(nullptr), _first(nullptr), _delim(nullptr), _done(true) {}
+
+			explicit iterator(const SplitRange* range) noexcept
+				: _range(range)
+				, _first(range->_first)
+				, _delim(range->_finder.find(range->_first, range->_last))
+				, _done(false)
+			{
+				skip_empty();
+			}
+
+			string_view operator*() const noexcept { return string_view(_first, static_cast<size_t>(_delim - _first)); }
+
+			iterator& operator++() noexcept
+			{
+				step();
+				skip_empty();
+				return *this;
+			}
+
+			iterator operator++(int) noexcept { iterator old = *this; ++*this; return old; }
+
+			bool operator==(const iterator& other) const noexcept
+			{
+				return _done == other._done && (_done || _first == other._first);
+			}
+			bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+
+		private:
+			void step() noexcept
+			{
+				if (_delim == _range->_last) {
+					_done = true;
+					return;
+				}
+				_first = _delim + _range->_finder.width();
+				_delim = _range->_finder.find(_first, _range->_last);
+			}
+
+			void skip_empty() noexcept
+			{
+				if (EmptyTokens::Skip != _range->_empty) return;
+				while (!_done && _first == _delim) step();
+			}
+
+			const SplitRange* _range;
+			const char* _first;     // 현재 토큰 시작
+			const char* _delim;     // 현재 토큰 끝(= 다음 구분자 위치 또는 입력 끝)
+			bool _done;
+		};
+
+		SplitRange(string_view input, Finder finder, EmptyTokens empty) noexcept
+			: _first(input.data())
+			, _last(input.data() + input.size())
+			, _finder(finder)
+			, _empty(empty)
+		{}
+
+		iterator begin() const noexcept { return iterator(this); }
+		iterator end() const noexcept { return iterator(); }
+
+		// 토큰을 out 에 모은다(out 의 용량 재사용, 토큰 문자열은 복사하지 않음)
+		template<typename Container>
+		void to(Container& out) const
+		{
+			out.clear();
+			for (string_view token : *this) out.push_back(token);
+		}
+
+		size_t count() const noexcept
+		{
+			size_t n = 0;
+			for (auto it = begin(); it != end(); ++it) ++n;
+			return n;
+		}
+
+	private:
+		const char* _first;
+		const char* _last;
+		Finder _finder;
+		EmptyTokens _empty;
+	};
+
+	inline SplitRange<CharFinder> split(string_view input, char delimiter, EmptyTokens empty = EmptyTokens::Keep) noexcept
+	{
+		return SplitRange<CharFinder>(input, CharFinder(delimiter), empty);
+	}
+
+	inline SplitRange<SubstrFinder> split(string_view input, string_view separator, EmptyTokens empty = EmptyTokens::Keep) noexcept
+	{
+		return SplitRange<SubstrFinder>(input, SubstrFinder(separator), empty);
+	}
+
+	// 구분자 문자열이 const char* 면 split(string_view) 보다 이쪽이 명확하도록 이름을 나눈다
+	inline SplitRange<DelimiterSet> split_any(string_view input, string_view delimiters, EmptyTokens empty = EmptyTokens::Keep) noexcept
+	{
+		return SplitRange<DelimiterSet>(input, DelimiterSet(delimiters), empty);
+	}
+
+	//=============================================================================================
+	// trim
+	//=============================================================================================
+	inline string_view trim_left(string_view s, string_view chars = " \t\r\n") noexcept
+	{
+		size_t i = 0;
+		while (i < s.size() && memchr(chars.data(), static_cast<unsigned char>(s[i]), chars.size())) ++i;
+		s.remove_prefix(i);
+		return s;
+	}
+
+	inline string_view trim_right(string_view s, string_view chars = " \t\r\n") noexcept
+	{
+		size_t n = s.size();
+		while (n > 0 && memchr(chars.data(), static_cast<unsigned char>(s[n - 1]), chars.size())) --n;
+		s.remove_suffix(s.size() - n);
+		return s;
+	}
+
+	inline string_view trim(string_view s, string_view chars = " \t\r\n") noexcept
+	{
+		return trim_right(trim_left(s, chars), chars);
+	}
+
+	//=============================================================================================
+	// replace_all : 결과 길이를 먼저 계산 => out 크기를 한 번만 잡고 한 번에 복사 (바꿀 때마다 뒤를 미는 일 없음)
+	//   반환값 = 바꾼 횟수. from 이 비어 있으면 input 을 그대로 복사
+	//=============================================================================================
+	inline size_t replace_all(string_view input, string_view from, string_view to, std::string& out)
+	{
+		out.clear();
+		if (from.empty()) {
+			out.append(input.data(), input.size());
+			return 0;
+		}
+
+		const SubstrFinder finder(from);
+		const char* first = input.data();
+		const char* last = input.data() + input.size();
+
+		// 1st pass : 길이가 같으면 결과 길이 = 입력 길이이므로 셀 필요 없음
+		size_t hits = 0;
+		if (from.size() != to.size()) {
+			for (const char* p = finder.find(first, last); p != last; p = finder.find(p + from.size(), last)) ++hits;
+		}
+		out.resize(input.size() - hits * from.size() + hits * to.size());
+
+		// 2nd pass
+		char* dst = &out[0];
+		size_t replaced = 0;
+		for (const char* p = first;;) {
+			const char* hit = finder.find(p, last);
+			memcpy(dst, p, hit - p);
+			dst += hit - p;
+			if (hit == last) break;
+
+			memcpy(dst, to.data(), to.size());
+			dst += to.size();
+			p = hit + from.size();
+			++replaced;
+		}
+		return replaced;
+	}
+
+	inline std::string replace_all(string_view input, string_view from, string_view to)
+	{
+		std::string out;
+		replace_all(input, from, to, out);
+		return out;
+	}
+
+	//=============================================================================================
+	// join : 전체 길이를 먼저 구해 out 크기를 한 번만 잡는다
+	//   parts : string_view 로 바꿀 수 있는 요소(std::string, const char*, string_view, SplitRange ...)의 range
+	//=============================================================================================
+	template<typename Range>
+	void join(const Range& parts, string_view separator, std::string& out)
+	{
+		size_t total = 0, count = 0;
+		for (const auto& part : parts) {
+			total += string_view(part).size();
+			++count;
+		}
+		if (count) total += separator.size() * (count - 1);
+
+		out.clear();
+		out.resize(total);
+		if (0 == total) return;
+
+		char* dst = &out[0];
+		bool first = true;
+		for (const auto& part : parts) {
+			if (!first) {
+				memcpy(dst, separator.data(), separator.size());
+				dst += separator.size();
+			}
+			first = false;
+
+			const string_view s(part);
+			memcpy(dst, s.data(), s.size());
+			dst += s.size();
+		}
+	}
+
+	template<typename Range>
+	std::string join(const Range& parts, string_view separator)
+	{
+		std::string out;
+		join(parts, separator, out);
+		return out;
+	}
+
+	//=============================================================================================
+	// format : vsnprintf 를 두 번 부르지 않는다
+	//   - out 용량이 StackBufferSize 이상이면 out 에 바로 쓴다(재사용 버퍼)
+	//   - 아니면 stack buffer 에 쓰고 복사(짧은 결과는 SSO 안에서 끝남)
+	//   - 결과가 더 길 때만 정확한 크기로 한 번 더
+	//=============================================================================================
+	static const size_t StackBufferSize = 256;
+
+	inline bool vformat_to(std::string& out, const char* format, va_list args)
+	{
+		va_list retry;
+		va_copy(retry, args);
+
+		char stackBuffer[StackBufferSize];
+		const bool direct = out.capacity() >= StackBufferSize;
+		if (direct) out.resize(out.capacity());
+
+		char* buffer = direct ? &out[0] : stackBuffer;
+		const size_t capacity = direct ? out.size() + 1 : StackBufferSize;  // std::string 은 size() 위치에 '\0' 자리가 있다
+
+		const int len = vsnprintf(buffer, capacity, format, args);
+		if (len < 0) {
+			va_end(retry);
+			out.clear();
+			return false;
+		}
+
+		if (static_cast<size_t>(len) < capacity) {
+			if (direct) out.resize(static_cast<size_t>(len));
+			else out.assign(stackBuffer, static_cast<size_t>(len));
+		}
+		else {
+			out.resize(static_cast<size_t>(len));
+			vsnprintf(&out[0], static_cast<size_t>(len) + 1, format, retry);
+		}
+
+		va_end(retry);
+		return true;
+	}
+
+	inline bool format_to(std::string& out, const char* format, ...)
+	{
+		va_list args;
+		va_start(args, format);
+		const bool ok = vformat_to(out, format, args);
+		va_end(args);
+		return ok;
+	}
+}//StringEngine
@@ -0,0 +1,549 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file task.h
+/// @brief 할당 없는 작업 제출용 부품 (header-only, C++14)
+///
+///   std::packaged_task + std::bind + std::function + std::future 로 작업 하나를 넘기면
+///   shared_ptr 제어 블록, function 의 heap 저장소, future 공유 상태가 각각 할당된다.
+///
+///   - Tasks::Task           : move-only void() callable. InlineSize(48 byte) 이하이고 nothrow move 면 inline 저장
+///                             (std::function 은 복사 가능해야 하고 작은 버퍼가 16 byte 정도라 대부분 heap)
+///   - Tasks::StateSlab      : Future/Promise 공유 상태용 고정 크기(BlockSize) block pool, pool 마다 하나
+///                             할당 = spin lock 안에서 free list pop, 반납 = lock-free push (반납 목록은 할당 쪽이 통째로 가져간다)
+///                             참조 카운트(살아 있는 block + 주인) => pool 이 먼저 사라져도 남은 Future 가 안전
+///   - Tasks::Promise<T> / Future<T>
+///                           : intrusive 참조 카운트 공유 상태(StateSlab 에서, 크면 operator new)
+///                             대기 = 잠깐 spin => futex(WaitOnAddress) (ring_queue.h 의 detail::futex_*)
+///                             get() 은 값/예외를 꺼내고 Future 를 비운다 (std::future 와 같음)
+///   - Tasks::Job<R, F>      : F 를 실행해 결과/예외를 Promise 로 넘기는 Task 본체
+///   - Tasks::TaskQueue      : Task 원형 buffer (가득 차면 2 배), steady state 에서 할당 없음. 동기화는 호출자 몫
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ring_queue.h"      // detail::futex_*, detail::round_up_pow2, detail::cpu_relax
+
+
+namespace Tasks
+{
+	//=============================================================================================
+	// Task
+	//=============================================================================================
+	class Task
+	{
+	public:
+		static const size_t InlineSize = 48;
+
+		Task() noexcept : _ops(nullptr) {}
+
+		template<typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Task>::value>::type>
+		Task(F&& f) : _ops(&Model<typename std::decay<F>::type>::Table)
+		{
+			Model<typename std::decay<F>::type>::construct(_storage, std::forward<F>(f));
+		}
+
+		Task(Task&& other) noexcept : _ops(other._ops)
+		{
+			if (_ops) {
+				_ops->move(_storage, other._storage);
+				other._ops = nullptr;
+			}
+		}
+
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other) {
+				reset();
+				if (other._ops) {
+					other._ops->move(_storage, other._storage);
+					_ops = other._ops;
+					other._ops = nullptr;
+				}
+			}
+			return *this;
+		}
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		~Task() { reset(); }
+
+		explicit operator bool() const noexcept { return nullptr != _ops; }
+
+		void operator()() { _ops->invoke(_storage); }
+
+		void reset() noexcept
+		{
+			if (_ops) {
+				_ops->destroy(_storage);
+				_ops = nullptr;
+			}
+		}
+
+	private:
+		struct Ops
+		{
+			void (*invoke)(void*);
+			void (*move)(void* to, void* from);         // from 은 파괴된다
+			void (*destroy)(void*);
+		};
+
+		template<typename F, bool Inline = (sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<F>::value)>
+		struct Model
+		{
+			static F& get(void* p) { return *static_cast<F*>(p); }
+
+			template<typename U>
+			static void construct(void* p, U&& f) { ::new (p) F(std::forward<U>(f)); }
+			static void invoke(void* p) { get(p)(); }
+			static void move(void* to, void* from) { ::new (to) F(std::move(get(from))); get(from).~F(); }
+			static void destroy(void* p) { get(p).~F(); }
+
+			static const Ops Table;
+		};
+
+		// 큰 callable : heap 에 두고 pointer 만 옮긴다
+		template<typename F>
+		struct Model<F, false>
+		{
+			static F*& get(void* p) { return *static_cast<F**>(p); }
+
+			template<typename U>
+			static void construct(void* p, U&& f) { ::new (p) F*(new F(std::forward<U>(f))); }
+			static void invoke(void* p) { (*get(p))(); }
+			static void move(void* to, void* from) { ::new (to) F*(get(from)); }
+			static void destroy(void* p) { delete get(p); }
+
+			static const Ops Table;
+		};
+
+		alignas(std::max_align_t) unsigned char _storage[InlineSize];
+		const Ops* _ops;
+	};
+
+	template<typename F, bool Inline>
+	const Task::Ops Task::Model<F, Inline>::Table = { &Model::invoke, &Model::move, &Model::destroy };
+
+	template<typename F>
+	const Task::Ops Task::Model<F, false>::Table = { &Model::invoke, &Model::move, &Model::destroy };
+
+	//=============================================================================================
+	// StateSlab
+	//=============================================================================================
+	class StateSlab
+	{
+	public:
+		static const size_t BlockSize = 128;
+		static const size_t BlocksPerChunk = 256;      // chunk 하나 = 32 KB
+
+		static StateSlab* create() { return new StateSlab(); }
+
+		// 주인(pool)이 손을 뗀다. 남은 block 이 모두 반납되면 스스로 지운다
+		void release() noexcept { unref(); }
+
+		void* allocate()
+		{
+			_refs.fetch_add(1, std::memory_order_relaxed);
+			while (_lock.exchange(true, std::memory_order_acquire)) LockFree::detail::cpu_relax();
+
+			Node* node = _free;
+			if (nullptr == node) node = _returned.exchange(nullptr, std::memory_order_acquire);
+			if (nullptr == node) {
+				try {
+					node = grow();
+				}
+				catch (...) {
+					_lock.store(false, std::memory_order_release);
+					unref();
+					throw;
+				}
+			}
+			_free = node->next;
+
+			_lock.store(false, std::memory_order_release);
+			return node;
+		}
+
+		void deallocate(void* p) noexcept
+		{
+			Node* node = static_cast<Node*>(p);
+			Node* head = _returned.load(std::memory_order_relaxed);
+			do {
+				node->next = head;
+			} while (!_returned.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+			unref();
+		}
+
+		// slab 이 없거나 block 보다 크면 operator new (할당/반납이 같은 기준이므로 크기만으로 구분된다)
+		static void* allocate(StateSlab* slab, size_t size)
+		{
+			return nullptr != slab && size <= BlockSize ? slab->allocate() : ::operator new(size);
+		}
+
+		static void deallocate(StateSlab* slab, void* p, size_t size) noexcept
+		{
+			if (nullptr != slab && size <= BlockSize) slab->deallocate(p);
+			else ::operator delete(p);
+		}
+
+	private:
+		union Node
+		{
+			Node* next;
+			alignas(std::max_align_t) unsigned char bytes[BlockSize];
+		};
+
+		StateSlab() : _free(nullptr), _refs(1), _lock(false), _returned(nullptr) {}
+		~StateSlab()
+		{
+			for (Node* chunk : _chunks) delete[] chunk;
+		}
+
+		Node* grow()
+		{
+			Node* chunk = new Node[BlocksPerChunk];
+			_chunks.push_back(chunk);
+			for (size_t i = 0; i + 1 < BlocksPerChunk; ++i) chunk[i].next = &chunk[i + 1];
+			chunk[BlocksPerChunk - 1].next = nullptr;
+			return chunk;
+		}
+
+		void unref() noexcept
+		{
+			if (1 == _refs.fetch_sub(1, std::memory_order_acq_rel)) delete this;
+		}
+
+		// 할당 쪽 (_lock 안에서만)
+		Node* _free;
+		std::vector<Node*> _chunks;
+
+		std::atomic<size_t> _refs;
+		std::atomic<bool> _lock;
+		std::atomic<Node*> _returned;      // 반납 목록 (push 만 CAS, pop 은 통째로 exchange => ABA 없음)
+	};
+
+	//=============================================================================================
+	// 공유 상태
+	//=============================================================================================
+	namespace detail
+	{
+		enum : uint32_t { Pending = 0, Ready = 1, Waiting = 2 };
+
+		struct StateBase
+		{
+			static const int SpinCount = 256;
+
+			std::atomic<uint32_t> refs{ 1 };
+			std::atomic<uint32_t> status{ Pending };
+			std::exception_ptr error;
+			StateSlab* slab = nullptr;
+			void (*destroy)(StateBase*) = nullptr;
+
+			void release() noexcept
+			{
+				if (1 == refs.fetch_sub(1, std::memory_order_acq_rel)) destroy(this);
+			}
+
+			bool ready() const noexcept { return 0 != (status.load(std::memory_order_acquire) & Ready); }
+
+			void publish() noexcept
+			{
+				if (Waiting & status.exchange(Ready, std::memory_order_acq_rel)) LockFree::detail::futex_wake_all(status);
+			}
+
+			void wait() noexcept
+			{
+				if (spin()) return;
+
+				uint32_t s = status.load(std::memory_order_acquire);
+				while (0 == (s & Ready)) {
+					if (0 == (s & Waiting) && !status.compare_exchange_weak(s, s | Waiting, std::memory_order_acquire)) continue;
+					LockFree::detail::futex_wait(status, s | Waiting);
+					s = status.load(std::memory_order_acquire);
+				}
+			}
+
+			bool wait_until(std::chrono::steady_clock::time_point deadline) noexcept
+			{
+				if (spin()) return true;
+
+				uint32_t s = status.load(std::memory_order_acquire);
+				while (0 == (s & Ready)) {
+					const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+					if (now >= deadline) return false;
+					if (0 == (s & Waiting) && !status.compare_exchange_weak(s, s | Waiting, std::memory_order_acquire)) continue;
+					LockFree::detail::futex_wait_for(status, s | Waiting, std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now));
+					s = status.load(std::memory_order_acquire);
+				}
+				return true;
+			}
+
+		private:
+			bool spin() const noexcept
+			{
+				for (int i = 0; i < SpinCount; ++i) {
+					if (ready()) return true;
+					LockFree::detail::cpu_relax();
+				}
+				return false;
+			}
+		};
+
+		template<typename T>
+		struct State : StateBase
+		{
+			static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned result types are not supported");
+
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type value;
+
+			T& get() noexcept { return *reinterpret_cast<T*>(&value); }
+
+			// Ready 이고 예외가 없으면 값이 만들어져 있다
+			static void destroy_state(StateBase* base) noexcept
+			{
+				State* self = static_cast<State*>(base);
+				if (self->ready() && !self->error) self->get().~T();
+				StateSlab* slab = self->slab;
+				self->~State();
+				StateSlab::deallocate(slab, self, sizeof(State));
+			}
+		};
+
+		template<>
+		struct State<void> : StateBase
+		{
+			static void destroy_state(StateBase* base) noexcept
+			{
+				State* self = static_cast<State*>(base);
+				StateSlab* slab = self->slab;
+				self->~State();
+				StateSlab::deallocate(slab, self, sizeof(State));
+			}
+		};
+
+		template<typename T>
+		State<T>* make_state(StateSlab* slab)
+		{
+			State<T>* state = ::new (StateSlab::allocate(slab, sizeof(State<T>))) State<T>();
+			state->slab = slab;
+			state->destroy = &State<T>::destroy_state;
+			return state;
+		}
+
+		template<typename T, typename... U>
+		void emplace(State<T>& state, U&&... v) { ::new (&state.value) T(std::forward<U>(v)...); }
+		inline void emplace(State<void>&) {}
+
+		template<typename T>
+		T take(State<T>& state) { return std::move(state.get()); }
+		inline void take(State<void>&) {}
+
+		struct Release
+		{
+			StateBase* state;
+			~Release() { state->release(); }
+		};
+	}
+
+	template<typename T> class Promise;
+
+	//=============================================================================================
+	// Future<T>
+	//=============================================================================================
+	template<typename T>
+	class Future
+	{
+	public:
+		Future() noexcept : _state(nullptr) {}
+		Future(Future&& other) noexcept : _state(other._state) { other._state = nullptr; }
+
+		Future& operator=(Future&& other) noexcept
+		{
+			if (this != &other) {
+				reset();
+				_state = other._state;
+				other._state = nullptr;
+			}
+			return *this;
+		}
+
+		Future(const Future&) = delete;
+		Future& operator=(const Future&) = delete;
+
+		~Future() { reset(); }
+
+		bool valid() const noexcept { return nullptr != _state; }
+		bool is_ready() const noexcept { return _state->ready(); }
+
+		void wait() const noexcept { _state->wait(); }
+
+		template<typename Rep, typename Period>
+		std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const noexcept
+		{
+			const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+			return _state->wait_until(deadline) ? std::future_status::ready : std::future_status::timeout;
+		}
+
+		// 값(또는 예외)을 꺼내고 Future 는 비워진다
+		T get()
+		{
+			detail::State<T>* state = _state;
+			_state = nullptr;
+			state->wait();
+
+			const detail::Release release = { state };
+			if (state->error) std::rethrow_exception(state->error);
+			return detail::take(*state);
+		}
+
+	private:
+		friend class Promise<T>;
+
+		explicit Future(detail::State<T>* state) noexcept : _state(state) {}
+
+		void reset() noexcept
+		{
+			if (_state) {
+				_state->release();
+				_state = nullptr;
+			}
+		}
+
+		detail::State<T>* _state;
+	};
+
+	//=============================================================================================
+	// Promise<T>
+	//=============================================================================================
+	template<typename T>
+	class Promise
+	{
+	public:
+		Promise() noexcept : _state(nullptr) {}
+		explicit Promise(StateSlab* slab) : _state(detail::make_state<T>(slab)) {}
+
+		Promise(Promise&& other) noexcept : _state(other._state) { other._state = nullptr; }
+
+		Promise& operator=(Promise&& other) noexcept
+		{
+			if (this != &other) {
+				abandon();
+				_state = other._state;
+				other._state = nullptr;
+			}
+			return *this;
+		}
+
+		Promise(const Promise&) = delete;
+		Promise& operator=(const Promise&) = delete;
+
+		// 값을 넣지 않고 사라지면 broken_promise
+		~Promise() { abandon(); }
+
+		// 한 번만 부른다
+		Future<T> get_future() noexcept
+		{
+			_state->refs.fetch_add(1, std::memory_order_relaxed);
+			return Future<T>(_state);
+		}
+
+		template<typename... U>
+		void set_value(U&&... v)
+		{
+			detail::emplace(*_state, std::forward<U>(v)...);
+			_state->publish();
+		}
+
+		void set_exception(std::exception_ptr error) noexcept
+		{
+			_state->error = error;
+			_state->publish();
+		}
+
+	private:
+		void abandon() noexcept
+		{
+			if (nullptr == _state) return;
+			if (!_state->ready()) set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+			_state->release();
+			_state = nullptr;
+		}
+
+		detail::State<T>* _state;
+	};
+
+	//=============================================================================================
+	// Job<R, F> : Task 에 넣는 본체
+	//=============================================================================================
+	template<typename R, typename F>
+	struct Job
+	{
+		Promise<R> promise;
+		F fn;
+
+		void operator()()
+		{
+			try {
+				run(std::is_void<R>());
+			}
+			catch (...) {
+				promise.set_exception(std::current_exception());
+			}
+		}
+
+	private:
+		void run(std::false_type) { promise.set_value(fn()); }
+		void run(std::true_type) { fn(); promise.set_value(); }
+	};
+
+	//=============================================================================================
+	// TaskQueue (단일 스레드용 원형 buffer, 호출자가 lock)
+	//=============================================================================================
+	class TaskQueue
+	{
+	public:
+		explicit TaskQueue(size_t capacity = 256) : _buffer(LockFree::detail::round_up_pow2(capacity)), _head(0), _size(0) {}
+
+		bool empty() const noexcept { return 0 == _size; }
+		size_t size() const noexcept { return _size; }
+
+		void push(Task&& task)
+		{
+			if (_size == _buffer.size()) grow();
+			_buffer[(_head + _size) & (_buffer.size() - 1)] = std::move(task);
+			++_size;
+		}
+
+		Task pop() noexcept
+		{
+			Task task = std::move(_buffer[_head]);
+			_head = (_head + 1) & (_buffer.size() - 1);
+			--_size;
+			return task;
+		}
+
+	private:
+		void grow()
+		{
+			std::vector<Task> bigger(_buffer.size() * 2);
+			for (size_t i = 0; i < _size; ++i) bigger[i] = std::move(_buffer[(_head + i) & (_buffer.size() - 1)]);
+			_buffer.swap(bigger);
+			_head = 0;
+		}
+
+		std::vector<Task> _buffer;
+		size_t _head;
+		size_t _size;
+	};
+}//Tasks
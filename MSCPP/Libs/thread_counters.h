@@ -0,0 +1,467 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file thread_counters.h
+/// @brief 스레드별 cache line 에 쌓는 이름 있는 counter / histogram registry (header-only, C++14)
+///
+///   Metrics::Registry
+///     - counter(name) / histogram(name, upper_bounds) : 실행 중 언제든 등록 (같은 이름이면 같은 handle)
+///     - Counter::add(n) / Histogram::record(v)
+///         스레드마다 따로 가진 page(64 cell = 512 B, cache line 정렬) 의 cell 에 더한다.
+///         cell 은 주인 스레드만 쓰므로 load + store 만 한다 (fetch_add 의 lock 접두사 / cache line 핑퐁 없음)
+///     - snapshot() : 살아 있는 스레드의 cell 합 + 종료한 스레드가 남긴 합 => Snapshot 구조체
+///     - 스레드가 끝나면(thread_local 소멸자) 그 스레드의 값을 registry 의 retired 합으로 옮기고 page 를 해제한다
+///     - Registry::global() : 프로세스 전체 기본 registry
+///
+///   비교
+///     C++/ThreadLocalStorage.cpp : TlsAlloc/TlsGetValue (Win32), __declspec(thread) => 여기서는 C++11 thread_local
+///     std::atomic<uint64_t>::fetch_add : 모든 스레드가 cache line 하나를 갱신
+///
+///   주의
+///     - 읽기(snapshot/value)는 registry mutex 안에서 스레드 수 x cell 수만큼 돈다 => 느린 경로
+///     - 값은 relaxed 로 읽으므로 스레드 사이의 counter 끼리는 같은 순간의 값이 아니다
+///     - registry 를 파괴할 때 다른 스레드가 그 handle 을 쓰고 있으면 안 된다
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "backoff.h"     // CacheLineSize
+#include "live_owners.h"
+
+
+namespace Metrics
+{
+	using LockFree::CacheLineSize;
+
+	class Registry;
+
+	//=============================================================================================
+	// Snapshot
+	//=============================================================================================
+	struct CounterValue
+	{
+		std::string name;
+		uint64_t value;
+	};
+
+	struct HistogramValue
+	{
+		std::string name;
+		std::vector<uint64_t> upper_bounds;     // bucket i : 값 <= upper_bounds[i] (앞 bucket 제외)
+		std::vector<uint64_t> buckets;          // upper_bounds.size() + 1 개, 마지막 = 가장 큰 경계 초과
+		uint64_t count;
+		uint64_t sum;
+	};
+
+	struct Snapshot
+	{
+		std::vector<CounterValue> counters;         // 등록 순서
+		std::vector<HistogramValue> histograms;
+		size_t live_threads = 0;                    // 이 registry 를 한 번이라도 쓴 살아 있는 스레드
+		size_t retired_threads = 0;                 // 값을 retired 합으로 옮기고 끝난 스레드
+
+		const CounterValue* find_counter(const std::string& name) const
+		{
+			for (const CounterValue& c : counters)
+				if (c.name == name) return &c;
+			return nullptr;
+		}
+
+		const HistogramValue* find_histogram(const std::string& name) const
+		{
+			for (const HistogramValue& h : histograms)
+				if (h.name == name) return &h;
+			return nullptr;
+		}
+	};
+
+	namespace detail
+	{
+		static const size_t PageCells = 64;                 // 512 B = cache line 8 개
+		static const size_t MaxPages = 64;                  // registry 당 cell 4096 개
+		static const uint32_t MaxBounds = PageCells - 2;    // histogram 하나가 page 하나 안에 (bucket + 1, sum)
+
+		struct Page
+		{
+			std::atomic<uint64_t> cells[PageCells];
+		};
+
+		//=========================================================================================
+		// 스레드 하나 x registry 하나. cell 은 주인 스레드만 쓰고 snapshot 은 읽기만 한다
+		//=========================================================================================
+		struct ThreadBlock
+		{
+			uint64_t owner_id;                  // registry id
+			Registry* registry;
+			std::atomic<Page*> pages[MaxPages];
+			void* raw[MaxPages];                // page 마다 정렬 전 pointer (C++14 new 는 64 B 정렬을 보장하지 않는다)
+
+			ThreadBlock(uint64_t id, Registry* r) noexcept
+				: owner_id(id)
+				, registry(r)
+			{
+				for (size_t i = 0; i < MaxPages; ++i) {
+					pages[i].store(nullptr, std::memory_order_relaxed);
+					raw[i] = nullptr;
+				}
+			}
+
+			~ThreadBlock()
+			{
+				for (size_t i = 0; i < MaxPages; ++i)
+					::operator delete(raw[i]);
+			}
+
+			ThreadBlock(const ThreadBlock&) = delete;
+			ThreadBlock& operator=(const ThreadBlock&) = delete;
+
+			// 주인 스레드 : page 가 없으면 만든다 (메모리 부족이면 nullptr)
+			std::atomic<uint64_t>* cell(uint32_t index) noexcept
+			{
+				Page* p = pages[index / PageCells].load(std::memory_order_relaxed);
+				if (!p) p = add_page(index / PageCells);
+				return p ? &p->cells[index % PageCells] : nullptr;
+			}
+
+			// 다른 스레드 : 아직 page 가 없으면 0
+			uint64_t read(uint32_t index) const noexcept
+			{
+				const Page* p = pages[index / PageCells].load(std::memory_order_acquire);
+				return p ? p->cells[index % PageCells].load(std::memory_order_relaxed) : 0;
+			}
+
+			Page* add_page(size_t i) noexcept
+			{
+				void* r = ::operator new(sizeof(Page) + CacheLineSize, std::nothrow);
+				if (!r) return nullptr;
+
+				// 앞뒤로 다른 할당과 cache line 을 나누지 않게 line 경계에서 시작 (크기도 line 의 배수)
+				void* aligned = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(r) + CacheLineSize - 1) & ~static_cast<uintptr_t>(CacheLineSize - 1));
+				Page* p = ::new (aligned) Page;
+				for (std::atomic<uint64_t>& c : p->cells)
+					c.store(0, std::memory_order_relaxed);
+
+				raw[i] = r;
+				pages[i].store(p, std::memory_order_release);
+				return p;
+			}
+
+			// 스레드 종료 (live lock 안, registry 가 살아 있을 때만) : 값을 registry 의 retired 합으로
+			inline void detach() noexcept;
+		};
+
+		// 스레드별 block 목록. 스레드가 끝날 때 registry 가 먼저 파괴됐으면 block 만 지운다
+		using ThreadBlocks = LiveOwners::ThreadItems<ThreadBlock>;
+
+		struct Metric
+		{
+			std::string name;
+			bool histogram;
+			uint32_t first;                     // 첫 cell
+			uint32_t cells;                     // counter 1, histogram = bucket 수 + 1 (sum)
+			std::vector<uint64_t> upper_bounds;
+		};
+	}
+
+	//=============================================================================================
+	// Counter / Histogram : 등록한 cell 번호만 든 handle (복사 가능, 모든 스레드가 같이 쓴다)
+	//=============================================================================================
+	class Counter
+	{
+	public:
+		Counter() noexcept = default;           // 빈 handle : add 는 아무것도 안 한다
+
+		inline void add(uint64_t n = 1) const noexcept;
+		inline uint64_t value() const;          // 모든 스레드 합 (느린 경로)
+
+		explicit operator bool() const noexcept { return _registry != nullptr; }
+
+	private:
+		friend class Registry;
+
+		Counter(Registry* registry, uint32_t cell) noexcept
+			: _registry(registry)
+			, _cell(cell)
+		{}
+
+		Registry* _registry = nullptr;
+		uint32_t _cell = 0;
+	};
+
+	class Histogram
+	{
+	public:
+		Histogram() noexcept = default;
+
+		inline void record(uint64_t value) const noexcept;
+
+		explicit operator bool() const noexcept { return _registry != nullptr; }
+
+	private:
+		friend class Registry;
+
+		Histogram(Registry* registry, const detail::Metric& metric) noexcept
+			: _registry(registry)
+			, _bounds(metric.upper_bounds.data())
+			, _boundCount(static_cast<uint32_t>(metric.upper_bounds.size()))
+			, _first(metric.first)
+		{}
+
+		Registry* _registry = nullptr;
+		const uint64_t* _bounds = nullptr;      // registry 의 Metric 이 소유 (registry 보다 오래 쓰면 안 된다)
+		uint32_t _boundCount = 0;
+		uint32_t _first = 0;
+	};
+
+	//=============================================================================================
+	// Registry
+	//=============================================================================================
+	class Registry
+	{
+	public:
+		Registry()
+			: _id(LiveOwners::next_id())
+		{
+			LiveOwners::insert(_id);
+		}
+
+		~Registry()
+		{
+			LiveOwners::erase(_id);
+			// 스레드의 block 은 그 스레드가 끝날 때(또는 다음 attach 때) 지운다
+		}
+
+		Registry(const Registry&) = delete;
+		Registry& operator=(const Registry&) = delete;
+
+		// 프로세스 전체 기본 registry (thread_local 소멸자가 쓰므로 일부러 해제하지 않는다)
+		static Registry& global()
+		{
+			static Registry* r = new Registry;
+			return *r;
+		}
+
+		// 같은 이름이면 같은 counter. cell 이 모자라거나 그 이름이 histogram 이면 빈 Counter
+		Counter counter(const std::string& name)
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			const detail::Metric* m = find_or_add(name, false, std::vector<uint64_t>());
+			return m ? Counter(this, m->first) : Counter();
+		}
+
+		// upper_bounds : bucket 경계 (정렬/중복 제거, 최대 detail::MaxBounds 개). 이미 있는 이름이면 처음 경계 그대로
+		Histogram histogram(const std::string& name, std::vector<uint64_t> upper_bounds)
+		{
+			std::sort(upper_bounds.begin(), upper_bounds.end());
+			upper_bounds.erase(std::unique(upper_bounds.begin(), upper_bounds.end()), upper_bounds.end());
+			if (upper_bounds.size() > detail::MaxBounds) return Histogram();
+
+			std::lock_guard<std::mutex> lock(_lock);
+			const detail::Metric* m = find_or_add(name, true, std::move(upper_bounds));
+			return m ? Histogram(this, *m) : Histogram();
+		}
+
+		// start, start * factor, ... count 개 (latency 용)
+		static std::vector<uint64_t> exponential_bounds(uint64_t start, uint64_t factor, size_t count)
+		{
+			std::vector<uint64_t> bounds;
+			for (uint64_t b = (std::max)(start, uint64_t(1)); bounds.size() < count; b *= (std::max)(factor, uint64_t(2)))
+				bounds.push_back(b);
+			return bounds;
+		}
+
+		Snapshot snapshot() const
+		{
+			Snapshot s;
+			std::lock_guard<std::mutex> lock(_lock);
+			s.live_threads = _blocks.size();
+			s.retired_threads = _retiredThreads;
+
+			for (const auto& m : _metrics) {
+				if (!m->histogram) {
+					s.counters.push_back(CounterValue{ m->name, sum(m->first) });
+					continue;
+				}
+
+				HistogramValue h{ m->name, m->upper_bounds, std::vector<uint64_t>(m->cells - 1), 0, 0 };
+				for (uint32_t i = 0; i + 1 < m->cells; ++i) {
+					h.buckets[i] = sum(m->first + i);
+					h.count += h.buckets[i];
+				}
+				h.sum = sum(m->first + m->cells - 1);
+				s.histograms.push_back(std::move(h));
+			}
+			return s;
+		}
+
+		uint64_t value(const Counter& c) const
+		{
+			if (c._registry != this) return 0;
+			std::lock_guard<std::mutex> lock(_lock);
+			return sum(c._cell);
+		}
+
+	private:
+		friend class Counter;
+		friend class Histogram;
+		friend struct detail::ThreadBlock;     // retire
+
+		//-----------------------------------------------------------------------------------------
+		// 빠른 경로 : 이 스레드의 block (마지막으로 쓴 registry 면 thread_local 하나 비교)
+		//-----------------------------------------------------------------------------------------
+		detail::ThreadBlock* local_block() noexcept
+		{
+			const detail::ThreadBlocks::Last& last = detail::ThreadBlocks::last();
+			return last.owner_id == _id ? last.item : attach();
+		}
+
+		void add(uint32_t cell, uint64_t n) noexcept
+		{
+			detail::ThreadBlock* b = local_block();
+			std::atomic<uint64_t>* c = b ? b->cell(cell) : nullptr;
+			if (c) c->store(c->load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+			else add_retired(cell, n);
+		}
+
+		// histogram : bucket 과 sum 은 같은 page
+		void add(uint32_t bucket, uint32_t sumCell, uint64_t value) noexcept
+		{
+			detail::ThreadBlock* b = local_block();
+			std::atomic<uint64_t>* c = b ? b->cell(bucket) : nullptr;
+			if (c) {
+				std::atomic<uint64_t>* s = c + (sumCell - bucket);
+				c->store(c->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				s->store(s->load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			}
+			else {
+				add_retired(bucket, 1);
+				add_retired(sumCell, value);
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// 느린 경로
+		//-----------------------------------------------------------------------------------------
+		detail::ThreadBlock* attach() noexcept
+		{
+			if (detail::ThreadBlocks::dead()) return nullptr;      // thread_local 소멸 중 (다른 thread_local 소멸자에서 add)
+
+			detail::ThreadBlocks& mine = detail::ThreadBlocks::local();
+			if (detail::ThreadBlock* b = mine.find(_id)) return b;
+
+			detail::ThreadBlock* b = new (std::nothrow) detail::ThreadBlock(_id, this);
+			if (!b) return nullptr;
+			if (!mine.add(b)) {
+				delete b;
+				return nullptr;
+			}
+			try {
+				std::lock_guard<std::mutex> lock(_lock);
+				_blocks.push_back(b);
+			}
+			catch (...) {
+				mine.remove(b);
+				delete b;
+				return nullptr;
+			}
+			return b;
+		}
+
+		void add_retired(uint32_t cell, uint64_t n) noexcept
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_retired[cell] += n;
+		}
+
+		// 스레드 종료 (live lock 안, registry 가 살아 있을 때만)
+		void retire(detail::ThreadBlock* b) noexcept
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			for (uint32_t cell = 0; cell < _nextCell; ++cell)
+				_retired[cell] += b->read(cell);
+			_blocks.erase(std::remove(_blocks.begin(), _blocks.end(), b), _blocks.end());
+			++_retiredThreads;
+		}
+
+		// _lock 안
+		uint64_t sum(uint32_t cell) const noexcept
+		{
+			uint64_t total = _retired[cell];
+			for (const detail::ThreadBlock* b : _blocks)
+				total += b->read(cell);
+			return total;
+		}
+
+		// _lock 안. 실패하면 nullptr
+		const detail::Metric* find_or_add(const std::string& name, bool histogram, std::vector<uint64_t> upper_bounds)
+		{
+			const auto it = _byName.find(name);
+			if (it != _byName.end()) {
+				const detail::Metric* m = _metrics[it->second].get();
+				return m->histogram == histogram ? m : nullptr;
+			}
+
+			// histogram 의 cell 은 page 하나 안에 (record 가 page 를 한 번만 찾게)
+			const uint32_t cells = histogram ? static_cast<uint32_t>(upper_bounds.size()) + 2 : 1;
+			uint32_t first = _nextCell;
+			if (first % detail::PageCells + cells > detail::PageCells)
+				first = static_cast<uint32_t>((first / detail::PageCells + 1) * detail::PageCells);
+			if (first + cells > detail::PageCells * detail::MaxPages) return nullptr;
+
+			std::unique_ptr<detail::Metric> m(new detail::Metric{ name, histogram, first, cells, std::move(upper_bounds) });
+			_retired.resize(first + cells, 0);
+			_byName.emplace(name, _metrics.size());
+			_metrics.push_back(std::move(m));
+			_nextCell = first + cells;
+			return _metrics.back().get();
+		}
+
+	private:
+		const uint64_t _id;
+
+		mutable std::mutex _lock;                                   // 등록, block 목록, retired 합
+		std::vector<std::unique_ptr<detail::Metric>> _metrics;     // Histogram handle 이 upper_bounds 를 가리키므로 pointer 로
+		std::unordered_map<std::string, size_t> _byName;
+		std::vector<detail::ThreadBlock*> _blocks;                  // 이 registry 를 쓴 살아 있는 스레드
+		std::vector<uint64_t> _retired;                             // cell 별 : 끝난 스레드가 남긴 합
+		uint32_t _nextCell = 0;
+		size_t _retiredThreads = 0;
+	};
+
+	//=============================================================================================
+	inline void Counter::add(uint64_t n) const noexcept
+	{
+		if (_registry) _registry->add(_cell, n);
+	}
+
+	inline uint64_t Counter::value() const
+	{
+		return _registry ? _registry->value(*this) : 0;
+	}
+
+	inline void Histogram::record(uint64_t value) const noexcept
+	{
+		if (!_registry) return;
+		const uint32_t bucket = static_cast<uint32_t>(std::lower_bound(_bounds, _bounds + _boundCount, value) - _bounds);
+		_registry->add(_first + bucket, _first + _boundCount + 1, value);
+	}
+
+	namespace detail
+	{
+		inline void ThreadBlock::detach() noexcept
+		{
+			registry->retire(this);
+		}
+	}
+}//Metrics
@@ -0,0 +1,151 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file timestamp.h
+/// @brief 스레드별 캐시를 쓰는 할당 없는 timestamp 포맷터 (header-only, C++14)
+///
+///   "YYYY-MM-DD HH:MM:SS[.fff|.ffffff|.fffffffff]"   (Time::getTimeStamp 와 같은 모양 + 소수 초)
+///
+///   Timestamp::format(tp, buf, size, Precision, Zone)
+///     - 호출자 buffer 에 쓰고 길이('\0' 제외)를 반환, buffer 가 작거나 변환 실패면 0
+///     - "YYYY-MM-DD HH:MM:" prefix 는 thread_local 캐시 (Zone 별)
+///       => 같은 분(minute) 안에서는 gmtime/localtime 호출 없이 초/소수 초 숫자만 다시 쓴다
+///     - 분이 바뀔 때만 gmtime_s/localtime_s(gmtime_r/localtime_r) 로 prefix 를 다시 만든다
+///       (캐시 = [분 시작 time_t, +60) 구간 => Local 의 DST 전환도 분 경계에서 반영됨)
+///   Timestamp::format_now(buf, size, ...) : system_clock::now() 로 format
+///
+///   - lock / 공유 상태 없음 (캐시는 스레드별), std::string / heap 할당 없음
+///   - Local 캐시는 TZ 가 바뀌어도(_tzset, putenv) 다음 분까지는 이전 offset 을 쓴다
+///   - 연도 0000 ~ 9999 만 지원(그 밖은 0 반환)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+
+namespace Timestamp
+{
+	enum class Precision { Seconds = 0, Milliseconds = 3, Microseconds = 6, Nanoseconds = 9 };
+	enum class Zone { Utc = 0, Local = 1 };
+
+	static const size_t PrefixLength = 17;      // "YYYY-MM-DD HH:MM:"
+	static const size_t MaxLength = 29;         // "YYYY-MM-DD HH:MM:SS.nnnnnnnnn"
+	static const size_t BufferSize = MaxLength + 1;
+
+	inline size_t length(Precision precision) noexcept
+	{
+		const size_t digits = static_cast<size_t>(precision);
+		return PrefixLength + 2 + (digits ? 1 + digits : 0);
+	}
+
+	namespace detail
+	{
+		// "00" ~ "99"
+		inline const char* two_digits(unsigned v) noexcept
+		{
+			static const char table[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+			return table + v * 2;
+		}
+
+		inline bool to_tm(std::time_t t, Zone zone, std::tm& out) noexcept
+		{
+#if defined(_WIN32)
+			return 0 == (Zone::Utc == zone ? gmtime_s(&out, &t) : localtime_s(&out, &t));
+#else
+			return nullptr != (Zone::Utc == zone ? gmtime_r(&t, &out) : localtime_r(&t, &out));
+#endif
+		}
+
+		struct PrefixCache
+		{
+			int64_t start = LLONG_MIN;      // 캐시된 분의 시작(epoch 초). [start, start + 60) 이면 prefix 재사용
+			char prefix[PrefixLength];
+		};
+
+		inline PrefixCache& cache(Zone zone) noexcept
+		{
+			static thread_local PrefixCache caches[2];
+			return caches[static_cast<int>(zone)];
+		}
+
+		inline bool render_prefix(PrefixCache& c, int64_t seconds, Zone zone) noexcept
+		{
+			std::tm tm;
+			if (!to_tm(static_cast<std::time_t>(seconds), zone, tm)) return false;
+
+			const int year = tm.tm_year + 1900;
+			if (year < 0 || year > 9999) return false;
+
+			char* p = c.prefix;
+			memcpy(p + 0, two_digits(static_cast<unsigned>(year / 100)), 2);
+			memcpy(p + 2, two_digits(static_cast<unsigned>(year % 100)), 2);
+			p[4] = '-';
+			memcpy(p + 5, two_digits(static_cast<unsigned>(tm.tm_mon + 1)), 2);
+			p[7] = '-';
+			memcpy(p + 8, two_digits(static_cast<unsigned>(tm.tm_mday)), 2);
+			p[10] = ' ';
+			memcpy(p + 11, two_digits(static_cast<unsigned>(tm.tm_hour)), 2);
+			p[13] = ':';
+			memcpy(p + 14, two_digits(static_cast<unsigned>(tm.tm_min)), 2);
+			p[16] = ':';
+
+			c.start = seconds - (tm.tm_sec > 59 ? 59 : tm.tm_sec);     // 윤초(60)는 59로
+			return true;
+		}
+	}
+
+	inline size_t format(std::chrono::system_clock::time_point tp, char* buffer, size_t size,
+		Precision precision = Precision::Microseconds, Zone zone = Zone::Utc) noexcept
+	{
+		static const uint32_t Pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+		const size_t len = length(precision);
+		if (!buffer || size < len + 1) return 0;
+
+		// floor 로 초/소수 초 분리 (1970 이전도 소수 초가 음수가 되지 않게)
+		//   전체를 nanoseconds 로 바꾸면 int64 범위(약 1678 ~ 2262년)를 넘으므로 (MSVC system_clock 은 100ns 단위)
+		//   초 단위로 먼저 자르고 1 초 미만 나머지만 nanoseconds 로 바꾼다
+		const auto since_epoch = tp.time_since_epoch();
+		auto whole = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);    // 0 쪽으로 자름
+		if (whole > since_epoch) whole -= std::chrono::seconds(1);
+		const int64_t seconds = whole.count();
+		const int64_t fraction = std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - whole).count();
+
+		detail::PrefixCache& c = detail::cache(zone);
+		if (seconds < c.start || seconds >= c.start + 60) {
+			if (!detail::render_prefix(c, seconds, zone)) return 0;
+		}
+
+		memcpy(buffer, c.prefix, PrefixLength);
+		memcpy(buffer + PrefixLength, detail::two_digits(static_cast<unsigned>(seconds - c.start)), 2);
+
+		const int digits = static_cast<int>(precision);
+		if (digits) {
+			buffer[PrefixLength + 2] = '.';
+
+			// 뒤에서부터 2자리씩
+			uint32_t f = static_cast<uint32_t>(fraction) / Pow10[9 - digits];
+			char* p = buffer + len;
+			int n = digits;
+			for (; n >= 2; n -= 2) {
+				p -= 2;
+				memcpy(p, detail::two_digits(f % 100), 2);
+				f /= 100;
+			}
+			if (n) *--p = static_cast<char>('0' + f % 10);
+		}
+
+		buffer[len] = '\0';
+		return len;
+	}
+
+	inline size_t format_now(char* buffer, size_t size,
+		Precision precision = Precision::Microseconds, Zone zone = Zone::Utc) noexcept
+	{
+		return format(std::chrono::system_clock::now(), buffer, size, precision, zone);
+	}
+}//Timestamp
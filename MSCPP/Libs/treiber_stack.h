@@ -0,0 +1,116 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file treiber_stack.h
+/// @brief 안전한 메모리 회수를 갖춘 lock-free Treiber stack (header-only, C++14)
+///
+///   TreiberStack<T, Reclaimer, Backoff>
+///     - push : 새 노드를 head에 CAS (release)
+///     - pop  : Reclaimer::Guard로 head를 보호한 뒤 next를 읽고 CAS, 떼어 낸 노드는 retire
+///     - 보호 중인 노드는 해제/재사용되지 않으므로 같은 주소가 다시 head가 되는 ABA가 생기지 않음
+///     - CAS 실패 시 Backoff::pause() 후 재시도
+///
+///   Reclaimer = HazardPointers     (기본값, 미회수 노드 수 상한 보장)
+///             | EpochReclamation   (읽기 경로가 더 싸다)
+///   Backoff   = ExponentialBackoff (기본값) | NoBackoff
+///
+///   한 번만 시도하는 try_push_node / try_pop_node 는 파생 클래스(EliminationStack)용으로 열어 둔다.
+///   소멸자는 남은 노드를 직접 해제한다. 소멸 시점에 다른 스레드가 사용 중이면 안 된다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <utility>
+
+#include "reclamation.h"
+#include "backoff.h"
+
+
+namespace LockFree
+{
+	template<typename T, typename Reclaimer = HazardPointers, typename Backoff = ExponentialBackoff>
+	class TreiberStack
+	{
+	public:
+		using value_type = T;
+		using reclaimer_type = Reclaimer;
+
+		TreiberStack() : _head(nullptr) {}
+
+		~TreiberStack()
+		{
+			Node* n = _head.load(std::memory_order_relaxed);
+			while (n) {
+				Node* next = n->next;
+				delete n;
+				n = next;
+			}
+		}
+
+		TreiberStack(const TreiberStack&) = delete;
+		TreiberStack& operator=(const TreiberStack&) = delete;
+
+		void push(const T& value) { push_node(new Node(value)); }
+		void push(T&& value) { push_node(new Node(std::move(value))); }
+
+		template<typename... Args>
+		void emplace(Args&&... args) { push_node(new Node(std::forward<Args>(args)...)); }
+
+		bool pop(T& out)
+		{
+			Backoff backoff;
+			Node* node;
+			for (;;) {
+				const Attempt a = try_pop_node(node);
+				if (Attempt::Done == a) break;
+				if (Attempt::Empty == a) return false;
+				backoff.pause();
+			}
+			out = std::move(node->value);
+			Reclaimer::retire(node);
+			return true;
+		}
+
+		bool empty() const { return nullptr == _head.load(std::memory_order_acquire); }
+
+	protected:
+		struct Node
+		{
+			T value;
+			Node* next = nullptr;
+
+			template<typename... Args>
+			explicit Node(Args&&... args) : value(std::forward<Args>(args)...) {}
+		};
+
+		enum class Attempt { Done, Empty, Contended };
+
+		void push_node(Node* n)
+		{
+			Backoff backoff;
+			while (!try_push_node(n)) backoff.pause();
+		}
+
+		bool try_push_node(Node* n)
+		{
+			n->next = _head.load(std::memory_order_relaxed);
+			return _head.compare_exchange_strong(n->next, n, std::memory_order_release, std::memory_order_relaxed);
+		}
+
+		// Done이면 node의 소유권이 호출자에게 넘어온다(값을 꺼낸 뒤 Reclaimer::retire 할 것)
+		Attempt try_pop_node(Node*& node)
+		{
+			typename Reclaimer::Guard guard;
+			node = guard.protect(_head);
+			if (nullptr == node) return Attempt::Empty;
+
+			// node는 보호 중이므로 next를 읽어도 안전
+			Node* next = node->next;
+			if (_head.compare_exchange_strong(node, next, std::memory_order_acquire, std::memory_order_relaxed)) {
+				return Attempt::Done;
+			}
+			return Attempt::Contended;
+		}
+
+		std::atomic<Node*> _head;
+	};
+}//LockFree
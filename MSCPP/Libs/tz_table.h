@@ -0,0 +1,534 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file tz_table.h
+/// @brief TZif(/usr/share/zoneinfo) 를 한 번 읽어 만든 전이(transition) 표로 UTC <-> local 대량 변환 (header-only, C++14)
+///
+///   mktime / setenv("TZ") / localtime 은 값마다 CRT 전역 TZ 상태를 거치므로 느리고,
+///   TZ 를 바꾸는 순간 다른 스레드의 변환 결과가 섞인다.
+///   여기서는 zone 마다 정렬된 [UTC 시작 시각 -> offset] 배열을 한 번 만들고, 이후에는 읽기만 한다.
+///
+///   TzTable::Zone
+///     - TZif v1/v2+ 파싱 (v2 이상이면 64-bit 블록 사용)
+///     - 마지막 전이 이후는 footer 의 POSIX TZ 규칙(ex. "EST5EDT,M3.2.0,M11.1.0")으로 ExpandUntilYear 까지 미리 펼침
+///       => slim TZif 도 변환 경로는 배열 검색뿐
+///     - offset_at(utc)          : 분기 없는(cmov) 이진 검색
+///     - to_local(utc) / to_utc(local)
+///     - to_local(in, out, n) / to_utc(in, out, n)
+///         직전 값이 속한 구간 [begin, end) 을 기억해 두고 그 안이면 검색 생략
+///         (이벤트 timestamp 는 대부분 같은 DST 구간에 몰려 있으므로 거의 비교 2번으로 끝남)
+///     - 생성 후 불변(const) => 여러 스레드가 같은 Zone 으로 동시에 변환해도 안전 (lock 없음)
+///
+///   TzTable::ZoneCache
+///     - 이름 -> shared_ptr<const Zone>, 처음 요청할 때 한 번만 파일을 읽는다 (mutex 는 get() 에서만)
+///     - root 기본값 : 환경 변수 TZDIR, 없으면 /usr/share/zoneinfo
+///       (Windows 에는 zoneinfo 가 없으므로 IANA tzdata 를 zic 로 빌드한 디렉터리를 지정)
+///
+///   to_utc 에서 local 시각이 두 번 있는 구간(DST 종료)은 앞의 것, 없는 구간(DST 시작)은 전이 전 offset 으로 해석
+///   윤초(TZif leap second 레코드)는 무시 (POSIX time_t 와 같은 의미)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace TzTable
+{
+	struct LocalTimeType
+	{
+		int32_t offset = 0;         // UTC 기준 초 (동쪽 +)
+		bool dst = false;
+		std::string abbreviation;   // "KST", "EDT", ...
+	};
+
+	namespace detail
+	{
+		// 1970-01-01 기준 일 수 (proleptic Gregorian)
+		inline int64_t days_from_civil(int64_t y, unsigned m, unsigned d) noexcept
+		{
+			y -= m <= 2;
+			const int64_t era = (y >= 0 ? y : y - 399) / 400;
+			const unsigned yoe = static_cast<unsigned>(y - era * 400);
+			const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+			const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+			return era * 146097 + static_cast<int64_t>(doe) - 719468;
+		}
+
+		inline int64_t year_of(int64_t seconds) noexcept
+		{
+			int64_t z = (seconds >= 0 ? seconds : seconds - 86399) / 86400 + 719468;
+			const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+			const unsigned doe = static_cast<unsigned>(z - era * 146097);
+			const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+			const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+			const unsigned mp = (5 * doy + 2) / 153;
+			return static_cast<int64_t>(yoe) + era * 400 + (mp >= 10 ? 1 : 0);
+		}
+
+		inline bool is_leap(int64_t y) noexcept { return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0; }
+
+		inline unsigned days_in_month(int64_t y, unsigned m) noexcept
+		{
+			static const unsigned Days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+			return (2 == m && is_leap(y)) ? 29 : Days[m - 1];
+		}
+
+		inline int64_t read_be(const uint8_t* p, int bytes) noexcept
+		{
+			uint64_t v = 0;
+			for (int i = 0; i < bytes; ++i) v = (v << 8) | p[i];
+			if (4 == bytes) return static_cast<int32_t>(static_cast<uint32_t>(v));
+			return static_cast<int64_t>(v);
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// POSIX TZ 문자열 (TZif footer)
+		//   std offset [dst [offset] [,rule,rule]]
+		//   rule = Jn | n | Mm.w.d [/time]
+		//-----------------------------------------------------------------------------------------
+		struct PosixRule
+		{
+			enum class Kind { Julian1, Julian0, MonthWeekDay } kind = Kind::MonthWeekDay;
+			int day = 0, week = 0, month = 0;
+			int32_t time = 2 * 3600;        // 기본 02:00:00 (전이 직전 local 시각 기준)
+		};
+
+		struct PosixTz
+		{
+			LocalTimeType std;
+			LocalTimeType dst;
+			bool hasDst = false;
+			PosixRule start, end;
+		};
+
+		class PosixParser
+		{
+		public:
+			explicit PosixParser(const std::string& s) : _p(s.c_str()), _end(s.c_str() + s.size()) {}
+
+			bool parse(PosixTz& tz)
+			{
+				if (!name(tz.std.abbreviation) || !offset(tz.std.offset)) return false;
+				tz.std.offset = -tz.std.offset;     // POSIX 는 서쪽이 + => TZif 방향(동쪽 +)으로
+				if (_p == _end) return true;
+
+				tz.hasDst = true;
+				tz.dst.dst = true;
+				if (!name(tz.dst.abbreviation)) return false;
+				tz.dst.offset = tz.std.offset + 3600;
+				if (_p != _end && ',' != *_p) {
+					if (!offset(tz.dst.offset)) return false;
+					tz.dst.offset = -tz.dst.offset;
+				}
+
+				if (_p == _end) {
+					// 규칙 생략 => POSIX 기본값(미국 규칙)
+					tz.start.month = 3; tz.start.week = 2; tz.start.day = 0;
+					tz.end.month = 11; tz.end.week = 1; tz.end.day = 0;
+					return true;
+				}
+				return ',' == *_p++ && rule(tz.start) && ',' == *_p++ && rule(tz.end) && _p == _end;
+			}
+
+		private:
+			bool name(std::string& out)
+			{
+				const char* b = _p;
+				if (_p != _end && '<' == *_p) {
+					b = ++_p;
+					while (_p != _end && '>' != *_p) ++_p;
+					if (_p == _end) return false;
+					out.assign(b, _p++);
+					return true;
+				}
+				while (_p != _end && ((*_p >= 'A' && *_p <= 'Z') || (*_p >= 'a' && *_p <= 'z'))) ++_p;
+				out.assign(b, _p);
+				return out.size() >= 3;
+			}
+
+			bool number(int& v)
+			{
+				if (_p == _end || *_p < '0' || *_p > '9') return false;
+				v = 0;
+				while (_p != _end && *_p >= '0' && *_p <= '9') v = v * 10 + (*_p++ - '0');
+				return true;
+			}
+
+			// [+-]hh[:mm[:ss]] => 초
+			bool offset(int32_t& out)
+			{
+				int sign = 1;
+				if (_p != _end && ('+' == *_p || '-' == *_p)) sign = ('-' == *_p++) ? -1 : 1;
+
+				int h = 0, m = 0, s = 0;
+				if (!number(h)) return false;
+				if (_p != _end && ':' == *_p) { ++_p; if (!number(m)) return false; }
+				if (_p != _end && ':' == *_p) { ++_p; if (!number(s)) return false; }
+				out = sign * (h * 3600 + m * 60 + s);
+				return true;
+			}
+
+			bool rule(PosixRule& r)
+			{
+				if (_p == _end) return false;
+				if ('M' == *_p) {
+					++_p;
+					r.kind = PosixRule::Kind::MonthWeekDay;
+					if (!number(r.month) || '.' != *_p++ || !number(r.week) || '.' != *_p++ || !number(r.day)) return false;
+					if (r.month < 1 || r.month > 12 || r.week < 1 || r.week > 5 || r.day > 6) return false;
+				}
+				else if ('J' == *_p) {
+					++_p;
+					r.kind = PosixRule::Kind::Julian1;
+					if (!number(r.day) || r.day < 1 || r.day > 365) return false;
+				}
+				else {
+					r.kind = PosixRule::Kind::Julian0;
+					if (!number(r.day) || r.day > 365) return false;
+				}
+
+				if (_p != _end && '/' == *_p) {
+					++_p;
+					return offset(r.time);      // v3: 음수/24시 초과 허용
+				}
+				return true;
+			}
+
+			const char* _p;
+			const char* _end;
+		};
+
+		// year 년 rule 의 local 시각(1970 기준 초, 전이 직전 offset 의 local)
+		inline int64_t rule_local_time(const PosixRule& r, int64_t year) noexcept
+		{
+			int64_t day = 0;
+			switch (r.kind) {
+			case PosixRule::Kind::Julian1:     // 1..365, 2/29 는 세지 않음
+				day = days_from_civil(year, 1, 1) + r.day - 1;
+				if (is_leap(year) && r.day >= 60) ++day;
+				break;
+			case PosixRule::Kind::Julian0:     // 0..365, 2/29 포함
+				day = days_from_civil(year, 1, 1) + r.day;
+				break;
+			case PosixRule::Kind::MonthWeekDay: {
+				const int64_t first = days_from_civil(year, static_cast<unsigned>(r.month), 1);
+				const int weekdayOfFirst = static_cast<int>(((first % 7) + 11) % 7);      // 1970-01-01 = 목(4)
+				int mday = 1 + (r.day - weekdayOfFirst + 7) % 7 + (r.week - 1) * 7;
+				const int mdays = static_cast<int>(days_in_month(year, static_cast<unsigned>(r.month)));
+				while (mday > mdays) mday -= 7;     // week 5 = 마지막 주
+				day = first + mday - 1;
+				break;
+			}
+			}
+			return day * 86400 + r.time;
+		}
+	}
+
+	//=============================================================================================
+	// Zone : 컴파일된 전이 표 (불변)
+	//=============================================================================================
+	class Zone
+	{
+	public:
+		static const int ExpandUntilYear = 2200;      // footer 규칙을 미리 펼치는 마지막 연도(이후는 마지막 offset 유지)
+
+		// TZif 바이트열 => Zone (형식이 잘못되었으면 nullptr)
+		static std::shared_ptr<const Zone> parse(const uint8_t* data, size_t size, std::string name = std::string())
+		{
+			std::shared_ptr<Zone> zone(new Zone());
+			zone->_name = std::move(name);
+			if (!zone->parse_tzif(data, size)) return nullptr;
+			return zone;
+		}
+
+		static std::shared_ptr<const Zone> load(const std::string& path, std::string name = std::string())
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file) return nullptr;
+
+			const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			return parse(bytes.data(), bytes.size(), name.empty() ? path : std::move(name));
+		}
+
+		const std::string& name() const noexcept { return _name; }
+		size_t transition_count() const noexcept { return _utc.size() - 1; }
+
+		//-----------------------------------------------------------------------------------------
+		// UTC => local
+		//-----------------------------------------------------------------------------------------
+		int32_t offset_at(int64_t utc) const noexcept { return _offset[index_of(utc)]; }
+
+		const LocalTimeType& type_at(int64_t utc) const noexcept { return _types[_type[index_of(utc)]]; }
+
+		int64_t to_local(int64_t utc) const noexcept { return utc + offset_at(utc); }
+
+		void to_local(const int64_t* utc, int64_t* local, size_t count) const noexcept
+		{
+			size_t i = 0;
+			int64_t begin = _utc[0], end = next_of(0);
+			int32_t offset = _offset[0];
+
+			for (size_t k = 0; k < count; ++k) {
+				const int64_t t = utc[k];
+				if (t < begin || t >= end) {
+					i = index_of(t);
+					begin = _utc[i];
+					end = next_of(i);
+					offset = _offset[i];
+				}
+				local[k] = t + offset;
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// local => UTC
+		//   하루 앞뒤의 offset 두 개로 후보를 만들고, 그 UTC 에서 실제 offset 이 맞는 쪽을 택함
+		//   (offset 변화는 하루보다 작다)
+		//-----------------------------------------------------------------------------------------
+		int64_t to_utc(int64_t local) const noexcept
+		{
+			const int32_t before = offset_at(local - 86400);
+			const int32_t after = offset_at(local + 86400);
+			if (before == after) return local - before;
+
+			const int64_t a = local - before;
+			const int64_t b = local - after;
+			const bool aValid = offset_at(a) == before;
+			const bool bValid = offset_at(b) == after;
+			if (aValid && bValid) return a < b ? a : b;     // 겹치는 구간 => 이른 쪽
+			if (bValid) return b;
+			return a;                                       // 없는 구간(또는 a 만 유효) => 전이 전 offset
+		}
+
+		void to_utc(const int64_t* local, int64_t* utc, size_t count) const noexcept
+		{
+			// 직전 값과 같은 구간이고 구간 경계에서 하루 이상 떨어져 있으면 offset 재사용
+			int64_t begin = 1, end = 0;     // 빈 구간
+			int32_t offset = 0;
+
+			for (size_t k = 0; k < count; ++k) {
+				const int64_t t = local[k];
+				if (t >= begin && t < end) {
+					utc[k] = t - offset;
+					continue;
+				}
+
+				const int64_t u = to_utc(t);
+				utc[k] = u;
+
+				const size_t i = index_of(u);
+				offset = _offset[i];
+				begin = sat_add(_utc[i], 86400 + static_cast<int64_t>(offset));
+				end = sat_add(next_of(i), static_cast<int64_t>(offset) - 86400);
+			}
+		}
+
+	private:
+		Zone() = default;
+
+		static int64_t sat_add(int64_t a, int64_t b) noexcept
+		{
+			if (b > 0 && a > std::numeric_limits<int64_t>::max() - b) return std::numeric_limits<int64_t>::max();
+			if (b < 0 && a < std::numeric_limits<int64_t>::min() - b) return std::numeric_limits<int64_t>::min();
+			return a + b;
+		}
+
+		int64_t next_of(size_t i) const noexcept
+		{
+			return (i + 1 < _utc.size()) ? _utc[i + 1] : std::numeric_limits<int64_t>::max();
+		}
+
+		// _utc[i] <= t 인 마지막 i (_utc[0] = INT64_MIN 이므로 항상 존재)
+		//   비교 결과로 base 만 옮기는 형태 => 컴파일러가 cmov 로 만든다
+		size_t index_of(int64_t t) const noexcept
+		{
+			const int64_t* base = _utc.data();
+			size_t n = _utc.size();
+			while (n > 1) {
+				const size_t half = n / 2;
+				base = (base[half] <= t) ? base + half : base;
+				n -= half;
+			}
+			return static_cast<size_t>(base - _utc.data());
+		}
+
+		void push(int64_t utc, uint16_t type)
+		{
+			if (_offset.size() && _offset.back() == _types[type].offset && _types[_type.back()].dst == _types[type].dst
+				&& _types[_type.back()].abbreviation == _types[type].abbreviation) {
+				return;     // 바뀌는 것이 없는 전이는 버린다
+			}
+			_utc.push_back(utc);
+			_offset.push_back(_types[type].offset);
+			_type.push_back(type);
+		}
+
+		uint16_t add_type(const LocalTimeType& t)
+		{
+			for (size_t i = 0; i < _types.size(); ++i) {
+				if (_types[i].offset == t.offset && _types[i].dst == t.dst && _types[i].abbreviation == t.abbreviation) {
+					return static_cast<uint16_t>(i);
+				}
+			}
+			_types.push_back(t);
+			return static_cast<uint16_t>(_types.size() - 1);
+		}
+
+		bool parse_tzif(const uint8_t* data, size_t size)
+		{
+			struct Header { int64_t isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt; };
+
+			auto header = [&](size_t at, Header& h) {
+				if (size < at + 44 || 0 != memcmp(data + at, "TZif", 4)) return false;
+				const uint8_t* c = data + at + 20;
+				h.isutcnt = detail::read_be(c + 0, 4);
+				h.isstdcnt = detail::read_be(c + 4, 4);
+				h.leapcnt = detail::read_be(c + 8, 4);
+				h.timecnt = detail::read_be(c + 12, 4);
+				h.typecnt = detail::read_be(c + 16, 4);
+				h.charcnt = detail::read_be(c + 20, 4);
+				return h.typecnt > 0 && h.typecnt <= 256 && h.timecnt >= 0 && h.charcnt >= 0 && h.leapcnt >= 0
+					&& h.isutcnt >= 0 && h.isstdcnt >= 0;
+			};
+			auto block_size = [](const Header& h, int timeBytes) {
+				return static_cast<size_t>(h.timecnt * timeBytes + h.timecnt + h.typecnt * 6 + h.charcnt
+					+ h.leapcnt * (timeBytes + 4) + h.isstdcnt + h.isutcnt);
+			};
+
+			Header h;
+			if (!header(0, h)) return false;
+
+			size_t at = 44;
+			int timeBytes = 4;
+			const uint8_t version = data[4];
+			if (version >= '2') {
+				// v1 블록은 건너뛰고 64-bit 블록 사용
+				at += block_size(h, 4);
+				if (!header(at, h)) return false;
+				at += 44;
+				timeBytes = 8;
+			}
+			if (size < at + block_size(h, timeBytes)) return false;
+
+			const uint8_t* times = data + at;
+			const uint8_t* indices = times + h.timecnt * timeBytes;
+			const uint8_t* ttinfo = indices + h.timecnt;
+			const uint8_t* chars = ttinfo + h.typecnt * 6;
+
+			std::vector<uint16_t> typeMap(static_cast<size_t>(h.typecnt));
+			for (int64_t i = 0; i < h.typecnt; ++i) {
+				const uint8_t* e = ttinfo + i * 6;
+				LocalTimeType t;
+				t.offset = static_cast<int32_t>(detail::read_be(e, 4));
+				t.dst = 0 != e[4];
+				const size_t idx = e[5];
+				if (idx >= static_cast<size_t>(h.charcnt)) return false;
+				t.abbreviation.assign(reinterpret_cast<const char*>(chars + idx),
+					strnlen(reinterpret_cast<const char*>(chars + idx), static_cast<size_t>(h.charcnt) - idx));
+				typeMap[static_cast<size_t>(i)] = add_type(t);
+			}
+
+			// 첫 전이 이전 = type 0 (RFC 8536)
+			push(std::numeric_limits<int64_t>::min(), typeMap[0]);
+			for (int64_t i = 0; i < h.timecnt; ++i) {
+				const uint8_t idx = indices[i];
+				if (idx >= h.typecnt) return false;
+				const int64_t t = detail::read_be(times + i * timeBytes, timeBytes);
+				if (t <= _utc.back() && _utc.size() > 1) return false;     // 정렬되어 있어야 함
+				push(t, typeMap[idx]);
+			}
+
+			// footer : "\n<POSIX TZ>\n"
+			if (8 == timeBytes) {
+				const size_t footer = at + block_size(h, 8);
+				if (footer < size && '\n' == data[footer]) {
+					const char* b = reinterpret_cast<const char*>(data + footer + 1);
+					const char* e = static_cast<const char*>(memchr(b, '\n', size - footer - 1));
+					if (e && e != b) expand_footer(std::string(b, e));
+				}
+			}
+			return true;
+		}
+
+		void expand_footer(const std::string& tz)
+		{
+			detail::PosixTz posix;
+			if (!detail::PosixParser(tz).parse(posix)) return;
+
+			if (!posix.hasDst) return;     // 마지막 전이의 type 이 그대로 이어진다
+
+			const uint16_t stdType = add_type(posix.std);
+			const int64_t last = _utc.back();
+
+			const uint16_t dstType = add_type(posix.dst);
+			const int64_t firstYear = (_utc.size() > 1) ? detail::year_of(last) : 1970;
+			for (int64_t y = firstYear; y <= ExpandUntilYear; ++y) {
+				int64_t start = detail::rule_local_time(posix.start, y) - posix.std.offset;    // 표준시 기준 local
+				int64_t end = detail::rule_local_time(posix.end, y) - posix.dst.offset;        // DST 기준 local
+
+				// 남반구(시작 > 종료)는 연초가 DST
+				const int64_t first = start < end ? start : end;
+				const int64_t second = start < end ? end : start;
+				const uint16_t firstType = start < end ? dstType : stdType;
+				const uint16_t secondType = start < end ? stdType : dstType;
+				if (first > last) push(first, firstType);
+				if (second > last) push(second, secondType);
+			}
+		}
+
+		std::string _name;
+		std::vector<int64_t> _utc;          // 구간 시작(UTC 초), [0] = INT64_MIN
+		std::vector<int32_t> _offset;       // 구간 offset (검색 경로용으로 따로 둠)
+		std::vector<uint16_t> _type;        // 구간 => _types index
+		std::vector<LocalTimeType> _types;
+	};
+
+	//=============================================================================================
+	// ZoneCache : 이름 => Zone, 파일은 zone 마다 한 번만 읽는다
+	//=============================================================================================
+	class ZoneCache
+	{
+	public:
+		explicit ZoneCache(std::string root = default_root()) : _root(std::move(root)) {}
+
+		// 없는 zone 이면 nullptr (실패도 캐시)
+		std::shared_ptr<const Zone> get(const std::string& name)
+		{
+			std::lock_guard<std::mutex> lock(_m);
+			auto it = _zones.find(name);
+			if (it != _zones.end()) return it->second;
+
+			if (name.empty() || name.find("..") != std::string::npos) return _zones[name] = nullptr;
+			return _zones[name] = Zone::load(_root + "/" + name, name);
+		}
+
+		const std::string& root() const noexcept { return _root; }
+
+		static ZoneCache& instance()
+		{
+			static ZoneCache cache;
+			return cache;
+		}
+
+		static std::string default_root()
+		{
+			const char* dir = getenv("TZDIR");
+			return (dir && *dir) ? dir : "/usr/share/zoneinfo";
+		}
+
+	private:
+		std::string _root;
+		std::mutex _m;
+		std::map<std::string, std::shared_ptr<const Zone>> _zones;
+	};
+}//TzTable
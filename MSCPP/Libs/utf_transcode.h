@@ -0,0 +1,1441 @@
+﻿#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+/// @file utf_transcode.h
+/// @brief UTF-8 / UTF-16 / UTF-32 검증 + 변환 (SIMD kernel + scalar fallback, header-only, C++14)
+///
+///   MultiByteToWideChar / WideCharToMultiByte 는 (길이 조회 -> 변환) 두 번을 돌고 Windows 전용,
+///   wstring_convert 는 C++17 에서 deprecated. 여기서는 플랫폼과 무관하게 같은 결과를 낸다.
+///
+///   kernel (실행 시점에 한 번 고르고, set_kernel 로 바꿀 수 있음)
+///     Avx2 / Sse41 : x86 (GCC/Clang 은 target attribute, MSVC 는 그대로) => 빌드 옵션(-mavx2) 필요 없음
+///     Neon         : AArch64
+///     Scalar       : 그 외 (8 byte 단위 ASCII 건너뛰기 + 한 글자씩)
+///
+///   검증하면서 변환 (validate-while-converting)
+///     UTF-8 입력은 64 byte 창 단위로
+///       - 전부 ASCII        => 그대로 넓혀서 저장
+///       - SIMD 검증 통과    => 창 안의 완결된 글자만 검사 없이 디코드 (Keiser-Lemire lookup 검증)
+///       - 오류              => 그 창부터 scalar 로 다시 읽어 정확한 위치/종류를 Result 로 돌려준다
+///     UTF-16 입력은 16 unit 창 단위로 ASCII / BMP(서로게이트 없음) / 그 외 로 나눈다
+///
+///   출력 길이 예측 (*_length_from_*) : 입력을 한 번만 훑는 정확한 값 (올바른 입력 가정)
+///     utf16_length_from_utf8 = (continuation 이 아닌 byte 수) + (4 byte lead 수)
+///     utf8_length_from_utf16 = n + (>= 0x80) + (>= 0x800) - (서로게이트 unit 수)
+///
+///   스트리밍 : Utf8Decoder<CharT> / Utf8Encoder<CharT>
+///     chunk 경계에 걸린 글자(최대 3 byte / high surrogate 1개)를 들고 있다가 다음 chunk 와 이어 붙인다.
+///
+///   오류는 예외 대신 Result { error, read, written } 로 돌려준다.
+///     read = 오류가 난 글자의 시작 위치(입력 unit), written = 그때까지 쓴 출력 unit 수
+///   wchar_t 는 크기(2 = UTF-16, 4 = UTF-32)로 해석한다.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if !defined(UTF_TRANSCODE_HAS_X86)
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define UTF_TRANSCODE_HAS_X86 1
+#else
+#define UTF_TRANSCODE_HAS_X86 0
+#endif
+#endif
+
+#if !defined(UTF_TRANSCODE_HAS_NEON)
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define UTF_TRANSCODE_HAS_NEON 1
+#else
+#define UTF_TRANSCODE_HAS_NEON 0
+#endif
+#endif
+
+#if UTF_TRANSCODE_HAS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define UTF_TRANSCODE_TARGET_SSE41
+#define UTF_TRANSCODE_TARGET_AVX2
+#else
+#define UTF_TRANSCODE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define UTF_TRANSCODE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if UTF_TRANSCODE_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+
+namespace Utf
+{
+	enum class Kernel { Scalar, Sse41, Avx2, Neon };
+
+	enum class Error
+	{
+		None,
+		HeaderBits,         // 0xF8 이상 lead byte
+		TooShort,           // continuation byte 부족
+		TooLong,            // lead 없는 continuation byte
+		Overlong,           // 더 짧게 쓸 수 있는 인코딩
+		TooLarge,           // U+10FFFF 초과
+		Surrogate,          // UTF-8/32 안의 서로게이트, UTF-16 의 짝 없는 서로게이트
+		Truncated,          // 입력 끝에서 글자가 끊김 (스트리밍이면 다음 chunk 를 기다리면 된다)
+		OutputTooSmall,
+	};
+
+	struct Result
+	{
+		Error error = Error::None;
+		size_t read = 0;        // 입력 unit (오류면 오류 글자의 시작 위치)
+		size_t written = 0;     // 출력 unit
+
+		Result() = default;
+		Result(Error e, size_t r, size_t w) : error(e), read(r), written(w) {}
+
+		bool ok() const noexcept { return Error::None == error; }
+	};
+
+	inline const char* to_string(Error e) noexcept
+	{
+		switch (e) {
+		case Error::None: return "ok";
+		case Error::HeaderBits: return "invalid lead byte";
+		case Error::TooShort: return "missing continuation byte";
+		case Error::TooLong: return "unexpected continuation byte";
+		case Error::Overlong: return "overlong encoding";
+		case Error::TooLarge: return "code point above U+10FFFF";
+		case Error::Surrogate: return "invalid surrogate";
+		case Error::Truncated: return "truncated sequence";
+		case Error::OutputTooSmall: return "output buffer too small";
+		}
+		return "unknown";
+	}
+
+	namespace detail
+	{
+		//=========================================================================================
+		// scalar : 한 글자 decode / encode
+		//=========================================================================================
+		inline size_t utf8_sequence_length(uint8_t lead) noexcept
+		{
+			return lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+		}
+
+		// in[i] 에서 한 글자 => cp, len
+		inline Error decode_unit(const uint8_t* in, size_t n, size_t i, uint32_t& cp, size_t& len) noexcept
+		{
+			const uint32_t b0 = in[i];
+			if (b0 < 0x80) { cp = b0; len = 1; return Error::None; }
+			if (b0 < 0xC0) return Error::TooLong;
+			if (b0 >= 0xF8) return Error::HeaderBits;
+
+			len = utf8_sequence_length(static_cast<uint8_t>(b0));
+			const size_t avail = n - i;
+			for (size_t k = 1; k < len; ++k) {
+				if (k >= avail) return Error::Truncated;
+				if (0x80 != (in[i + k] & 0xC0)) return Error::TooShort;
+			}
+
+			switch (len) {
+			case 2:
+				cp = ((b0 & 0x1F) << 6) | (in[i + 1] & 0x3F);
+				if (cp < 0x80) return Error::Overlong;
+				break;
+			case 3:
+				cp = ((b0 & 0x0F) << 12) | ((in[i + 1] & 0x3Fu) << 6) | (in[i + 2] & 0x3F);
+				if (cp < 0x800) return Error::Overlong;
+				if (cp >= 0xD800 && cp <= 0xDFFF) return Error::Surrogate;
+				break;
+			default:
+				cp = ((b0 & 0x07) << 18) | ((in[i + 1] & 0x3Fu) << 12) | ((in[i + 2] & 0x3Fu) << 6) | (in[i + 3] & 0x3F);
+				if (cp < 0x10000) return Error::Overlong;
+				if (cp > 0x10FFFF) return Error::TooLarge;
+				break;
+			}
+			return Error::None;
+		}
+
+		inline Error decode_unit(const char16_t* in, size_t n, size_t i, uint32_t& cp, size_t& len) noexcept
+		{
+			cp = in[i];
+			len = 1;
+			if (cp < 0xD800 || cp > 0xDFFF) return Error::None;
+			if (cp >= 0xDC00) return Error::Surrogate;
+			if (i + 1 >= n) return Error::Truncated;
+
+			const uint32_t lo = in[i + 1];
+			if (lo < 0xDC00 || lo > 0xDFFF) return Error::Surrogate;
+			cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+			len = 2;
+			return Error::None;
+		}
+
+		inline Error decode_unit(const char32_t* in, size_t, size_t i, uint32_t& cp, size_t& len) noexcept
+		{
+			cp = in[i];
+			len = 1;
+			if (cp > 0x10FFFF) return Error::TooLarge;
+			if (cp >= 0xD800 && cp <= 0xDFFF) return Error::Surrogate;
+			return Error::None;
+		}
+
+		inline size_t encoded_units(const uint8_t*, uint32_t cp) noexcept { return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4; }
+		inline size_t encoded_units(const char16_t*, uint32_t cp) noexcept { return cp < 0x10000 ? 1 : 2; }
+		inline size_t encoded_units(const char32_t*, uint32_t) noexcept { return 1; }
+
+		inline void encode(uint8_t* out, uint32_t cp, size_t units) noexcept
+		{
+			switch (units) {
+			case 1:
+				out[0] = static_cast<uint8_t>(cp);
+				break;
+			case 2:
+				out[0] = static_cast<uint8_t>(0xC0 | (cp >> 6));
+				out[1] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+				break;
+			case 3:
+				out[0] = static_cast<uint8_t>(0xE0 | (cp >> 12));
+				out[1] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+				out[2] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+				break;
+			default:
+				out[0] = static_cast<uint8_t>(0xF0 | (cp >> 18));
+				out[1] = static_cast<uint8_t>(0x80 | ((cp >> 12) & 0x3F));
+				out[2] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+				out[3] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+				break;
+			}
+		}
+
+		inline void encode(char16_t* out, uint32_t cp, size_t units) noexcept
+		{
+			if (1 == units) {
+				out[0] = static_cast<char16_t>(cp);
+				return;
+			}
+			cp -= 0x10000;
+			out[0] = static_cast<char16_t>(0xD800 + (cp >> 10));
+			out[1] = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+		}
+
+		inline void encode(char32_t* out, uint32_t cp, size_t) noexcept { out[0] = static_cast<char32_t>(cp); }
+
+		//-----------------------------------------------------------------------------------------
+		// ASCII 연속 구간 (검사 없이 그대로 복사)
+		//-----------------------------------------------------------------------------------------
+		template<typename Out>
+		inline void ascii_run(const uint8_t* in, size_t n, size_t& i, Out* out, size_t cap, size_t& w) noexcept
+		{
+			while (n - i >= 8 && cap - w >= 8) {
+				uint64_t v;
+				memcpy(&v, in + i, 8);
+				if (0 != (v & 0x8080808080808080ull)) break;
+				for (size_t k = 0; k < 8; ++k) out[w + k] = static_cast<Out>(in[i + k]);
+				i += 8;
+				w += 8;
+			}
+		}
+
+		template<typename In, typename Out>
+		inline void ascii_run(const In* in, size_t n, size_t& i, Out* out, size_t cap, size_t& w) noexcept
+		{
+			while (i < n && w < cap && in[i] < 0x80) out[w++] = static_cast<Out>(in[i++]);
+		}
+
+		// 검사하면서 변환 : in[i..n) => out[w..cap)
+		template<typename In, typename Out>
+		inline Result transcode_checked(const In* in, size_t n, size_t i, Out* out, size_t cap, size_t w) noexcept
+		{
+			while (i < n) {
+				ascii_run(in, n, i, out, cap, w);
+				if (i == n) break;
+
+				uint32_t cp;
+				size_t len;
+				const Error e = decode_unit(in, n, i, cp, len);
+				if (Error::None != e) return Result(e, i, w);
+
+				const size_t units = encoded_units(out, cp);
+				if (cap - w < units) return Result(Error::OutputTooSmall, i, w);
+				encode(out + w, cp, units);
+				w += units;
+				i += len;
+			}
+			return Result(Error::None, i, w);
+		}
+
+		template<typename In>
+		inline Result validate_checked(const In* in, size_t n, size_t i) noexcept
+		{
+			while (i < n) {
+				uint32_t cp;
+				size_t len;
+				const Error e = decode_unit(in, n, i, cp, len);
+				if (Error::None != e) return Result(e, i, 0);
+				i += len;
+			}
+			return Result(Error::None, i, 0);
+		}
+
+		//-----------------------------------------------------------------------------------------
+		// 검증이 끝난 UTF-8 창 디코드 (검사 없음)
+		//   분기 없이(cmov) 길이를 고르는 방식은 i += len 이 load -> 표 -> add 로 이어지는 의존 사슬이 되어
+		//   한글/ASCII 가 섞인 입력에서 오히려 2 배 이상 느렸다. 분기 예측이 다음 글자를 미리 읽게 두는 편이 낫다
+		//-----------------------------------------------------------------------------------------
+		template<typename Out>
+		inline size_t decode_valid(const uint8_t* p, size_t n, Out* out) noexcept
+		{
+			size_t i = 0, w = 0;
+			while (i < n) {
+				const uint32_t b0 = p[i];
+				uint32_t cp;
+				if (b0 < 0x80) {
+					out[w++] = static_cast<Out>(b0);
+					++i;
+					continue;
+				}
+				if (b0 < 0xE0) {
+					cp = ((b0 & 0x1F) << 6) | (p[i + 1] & 0x3F);
+					i += 2;
+				}
+				else if (b0 < 0xF0) {
+					cp = ((b0 & 0x0F) << 12) | ((p[i + 1] & 0x3Fu) << 6) | (p[i + 2] & 0x3F);
+					i += 3;
+				}
+				else {
+					cp = ((b0 & 0x07) << 18) | ((p[i + 1] & 0x3Fu) << 12) | ((p[i + 2] & 0x3Fu) << 6) | (p[i + 3] & 0x3F);
+					i += 4;
+				}
+				const size_t units = encoded_units(out, cp);
+				encode(out + w, cp, units);
+				w += units;
+			}
+			return w;
+		}
+
+		// p[0..n) 중 끝에서 끊긴 글자를 뺀 길이 (검증된 창은 항상 글자 경계에서 시작)
+		inline size_t complete_prefix(const uint8_t* p, size_t n) noexcept
+		{
+			for (size_t k = 1; k <= 3 && k <= n; ++k) {
+				const uint8_t b = p[n - k];
+				if (b < 0x80) return n;
+				if (b >= 0xC0) return utf8_sequence_length(b) > k ? n - k : n;
+			}
+			return n;
+		}
+
+		//=========================================================================================
+		// SIMD kernel
+		//   창 크기 : UTF-8 64 byte, UTF-16 16 unit
+		//   valid64 : 창이 글자 경계에서 시작한다고 보고(prev = 0) 창 안에서 끝나는 글자만 검사
+		//             (창 끝에서 끊긴 글자는 complete_prefix 로 빼고 다음 창에서 다시 본다)
+		//
+		//   Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte" (lookup 방식)
+		//     이전 byte 의 상/하위 nibble, 현재 byte 의 상위 nibble 로 표 3개를 찾아 AND
+		//     => 0 이 아니면 TOO_SHORT/TOO_LONG/OVERLONG/SURROGATE/TOO_LARGE 중 하나
+		//     3/4 byte 글자의 3, 4 번째 continuation 은 prev2/prev3 로 따로 확인
+		//=========================================================================================
+		enum : uint8_t
+		{
+			TOO_SHORT = 1 << 0,
+			TOO_LONG = 1 << 1,
+			OVERLONG_3 = 1 << 2,
+			TOO_LARGE = 1 << 3,
+			SURROGATE = 1 << 4,
+			OVERLONG_2 = 1 << 5,
+			TOO_LARGE_1000 = 1 << 6,
+			OVERLONG_4 = 1 << 6,
+			TWO_CONTS = 1 << 7,
+			CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS,
+		};
+
+		// [0] byte_1_high, [1] byte_1_low, [2] byte_2_high
+		alignas(16) static const uint8_t Utf8Lookup[3][16] = {
+			{
+				TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,     // 0xxx : ASCII
+				TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,                                         // 10xx : continuation
+				TOO_SHORT | OVERLONG_2,                                                             // 1100
+				TOO_SHORT,                                                                          // 1101
+				TOO_SHORT | OVERLONG_3 | SURROGATE,                                                 // 1110
+				TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,                                // 1111
+			},
+			{
+				CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,                                       // ____0000
+				CARRY | OVERLONG_2,                                                                 // ____0001
+				CARRY, CARRY,                                                                       // ____001_
+				CARRY | TOO_LARGE,                                                                  // ____0100
+				CARRY | TOO_LARGE | TOO_LARGE_1000,                                                 // ____0101
+				CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,             // ____011_
+				CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,             // ____1___
+				CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,                                     // ____1101
+				CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+			},
+			{
+				TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,   // 0xxx
+				TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,       // 1000
+				TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,                         // 1001
+				TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,                          // 101_
+				TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+				TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,                                         // 11xx
+			},
+		};
+
+		//-----------------------------------------------------------------------------------------
+		// UTF-16(BMP) => UTF-8 압축 표
+		//   unit 4개를 dword 하나씩으로 펴서 [lead, cont, cont, 0] 을 만든 뒤 글자별 길이(1~3)만큼만 남기고 당긴다
+		//   index = (>= 0x80 인 unit 의 bit 4개) | (>= 0x800 인 unit 의 bit 4개) << 4
+		//   shuffle 의 0x80 은 pshufb / tbl 모두 0 을 넣는다
+		//-----------------------------------------------------------------------------------------
+		struct Utf16PackTable
+		{
+			alignas(16) uint8_t shuffle[256][16];
+			uint8_t length[256];
+
+			Utf16PackTable() noexcept
+			{
+				for (int index = 0; index < 256; ++index) {
+					int w = 0;
+					for (int k = 0; k < 4; ++k) {
+						const int units = 1 + ((index >> k) & 1) + ((index >> (k + 4)) & 1);
+						for (int b = 0; b < units; ++b) shuffle[index][w++] = static_cast<uint8_t>(4 * k + b);
+					}
+					for (int b = w; b < 16; ++b) shuffle[index][b] = 0x80;
+					length[index] = static_cast<uint8_t>(w);
+				}
+			}
+		};
+
+		inline const Utf16PackTable& utf16_pack_table() noexcept
+		{
+			static const Utf16PackTable table;
+			return table;
+		}
+
+#if UTF_TRANSCODE_HAS_X86
+		//-----------------------------------------------------------------------------------------
+		// SSE4.1 (pshufb 는 SSSE3, ptest 는 SSE4.1)
+		//-----------------------------------------------------------------------------------------
+		struct Sse41
+		{
+			UTF_TRANSCODE_TARGET_SSE41 static bool ascii64(const uint8_t* p) noexcept
+			{
+				const __m128i a = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)));
+				const __m128i b = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)));
+				return 0 == _mm_movemask_epi8(_mm_or_si128(a, b));
+			}
+
+			UTF_TRANSCODE_TARGET_SSE41 static __m128i check16(__m128i in, __m128i prev) noexcept
+			{
+				const __m128i low = _mm_set1_epi8(0x0F);
+				const __m128i t1h = _mm_load_si128(reinterpret_cast<const __m128i*>(Utf8Lookup[0]));
+				const __m128i t1l = _mm_load_si128(reinterpret_cast<const __m128i*>(Utf8Lookup[1]));
+				const __m128i t2h = _mm_load_si128(reinterpret_cast<const __m128i*>(Utf8Lookup[2]));
+
+				const __m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+				const __m128i b1h = _mm_shuffle_epi8(t1h, _mm_and_si128(_mm_srli_epi16(prev1, 4), low));
+				const __m128i b1l = _mm_shuffle_epi8(t1l, _mm_and_si128(prev1, low));
+				const __m128i b2h = _mm_shuffle_epi8(t2h, _mm_and_si128(_mm_srli_epi16(in, 4), low));
+				const __m128i special = _mm_and_si128(_mm_and_si128(b1h, b1l), b2h);
+
+				const __m128i third = _mm_subs_epu8(_mm_alignr_epi8(in, prev, 14), _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+				const __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(in, prev, 13), _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+				const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+				return _mm_xor_si128(must23, special);
+			}
+
+			UTF_TRANSCODE_TARGET_SSE41 static bool valid64(const uint8_t* p) noexcept
+			{
+				__m128i prev = _mm_setzero_si128();
+				__m128i error = _mm_setzero_si128();
+				for (int k = 0; k < 4; ++k) {
+					const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+					error = _mm_or_si128(error, check16(in, prev));
+					prev = in;
+				}
+				return 0 != _mm_testz_si128(error, error);
+			}
+
+			UTF_TRANSCODE_TARGET_SSE41 static void widen64(const uint8_t* p, char16_t* out) noexcept
+			{
+				for (int k = 0; k < 64; k += 16) {
+					const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), _mm_cvtepu8_epi16(in));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 8), _mm_cvtepu8_epi16(_mm_srli_si128(in, 8)));
+				}
+			}
+
+			UTF_TRANSCODE_TARGET_SSE41 static void widen64(const uint8_t* p, char32_t* out) noexcept
+			{
+				for (int k = 0; k < 64; k += 16) {
+					const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), _mm_cvtepu8_epi32(in));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 4), _mm_cvtepu8_epi32(_mm_srli_si128(in, 4)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 8), _mm_cvtepu8_epi32(_mm_srli_si128(in, 8)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 12), _mm_cvtepu8_epi32(_mm_srli_si128(in, 12)));
+				}
+			}
+
+			// 0 = ASCII, 1 = 서로게이트 없음, 2 = 서로게이트 있음
+			UTF_TRANSCODE_TARGET_SSE41 static int classify16(const char16_t* p) noexcept
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8));
+				if (_mm_testz_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)))) return 0;
+
+				const __m128i mask = _mm_set1_epi16(static_cast<short>(0xF800));
+				const __m128i surrogate = _mm_set1_epi16(static_cast<short>(0xD800));
+				const __m128i s = _mm_or_si128(_mm_cmpeq_epi16(_mm_and_si128(a, mask), surrogate), _mm_cmpeq_epi16(_mm_and_si128(b, mask), surrogate));
+				return _mm_testz_si128(s, s) ? 1 : 2;
+			}
+
+			UTF_TRANSCODE_TARGET_SSE41 static void narrow16(const char16_t* p, uint8_t* out) noexcept
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(a, b));
+			}
+
+			// BMP unit 4개(dword) => UTF-8, 16 byte 를 쓰고 유효한 길이를 돌려준다
+			UTF_TRANSCODE_TARGET_SSE41 static size_t encode4(__m128i c, uint8_t* out, const Utf16PackTable& t) noexcept
+			{
+				const __m128i m6 = _mm_set1_epi32(0x3F);
+				const __m128i cont = _mm_set1_epi32(0x80);
+				const __m128i last = _mm_or_si128(_mm_and_si128(c, m6), cont);
+				const __m128i middle = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 6), m6), cont);
+				const __m128i two = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(c, 6), _mm_set1_epi32(0xC0)), _mm_slli_epi32(last, 8));
+				const __m128i three = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(c, 12), _mm_set1_epi32(0xE0)),
+					_mm_or_si128(_mm_slli_epi32(middle, 8), _mm_slli_epi32(last, 16)));
+
+				const __m128i ge80 = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7F));
+				const __m128i ge800 = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7FF));
+				const __m128i bytes = _mm_blendv_epi8(c, _mm_blendv_epi8(two, three, ge800), ge80);
+
+				const int index = _mm_movemask_ps(_mm_castsi128_ps(ge80)) | (_mm_movemask_ps(_mm_castsi128_ps(ge800)) << 4);
+				const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[index]));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(bytes, shuffle));
+				return t.length[index];
+			}
+
+			// 서로게이트가 없는 16 unit => UTF-8 (최대 48 byte, 마지막 store 때문에 52 byte 까지 쓴다)
+			UTF_TRANSCODE_TARGET_SSE41 static size_t encode16(const char16_t* p, uint8_t* out, const Utf16PackTable& t) noexcept
+			{
+				size_t w = 0;
+				for (int k = 0; k < 16; k += 8) {
+					const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+					w += encode4(_mm_cvtepu16_epi32(x), out + w, t);
+					w += encode4(_mm_unpackhi_epi16(x, _mm_setzero_si128()), out + w, t);
+				}
+				return w;
+			}
+
+			// byte 카운터는 255 번마다 psadbw 로 비운다
+			UTF_TRANSCODE_TARGET_SSE41 static size_t count_utf8(const uint8_t* p, size_t n, size_t& leads, size_t& fours) noexcept
+			{
+				const __m128i notCont = _mm_set1_epi8(-65);      // signed > 0xBF(-65) => continuation 아님
+				const __m128i f0 = _mm_set1_epi8(static_cast<char>(0xF0));
+				const __m128i zero = _mm_setzero_si128();
+
+				size_t i = 0;
+				while (n - i >= 16) {
+					__m128i accLead = zero, accFour = zero;
+					for (size_t b = (std::min)((n - i) / 16, static_cast<size_t>(255)); b > 0; --b, i += 16) {
+						const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+						accLead = _mm_sub_epi8(accLead, _mm_cmpgt_epi8(x, notCont));
+						accFour = _mm_sub_epi8(accFour, _mm_cmpeq_epi8(_mm_max_epu8(x, f0), x));
+					}
+					const __m128i sl = _mm_sad_epu8(accLead, zero);
+					const __m128i sf = _mm_sad_epu8(accFour, zero);
+					leads += static_cast<size_t>(_mm_extract_epi16(sl, 0) + _mm_extract_epi16(sl, 4));
+					fours += static_cast<size_t>(_mm_extract_epi16(sf, 0) + _mm_extract_epi16(sf, 4));
+				}
+				return i;
+			}
+
+			UTF_TRANSCODE_TARGET_SSE41 static size_t count_utf16(const char16_t* p, size_t n, size_t& ascii, size_t& below800, size_t& surrogates) noexcept
+			{
+				const __m128i m80 = _mm_set1_epi16(static_cast<short>(0xFF80));
+				const __m128i m800 = _mm_set1_epi16(static_cast<short>(0xF800));
+				const __m128i d800 = _mm_set1_epi16(static_cast<short>(0xD800));
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i minusOne = _mm_set1_epi16(-1);
+
+				size_t i = 0;
+				while (n - i >= 8) {
+					__m128i accA = zero, accB = zero, accS = zero;
+					for (size_t b = (std::min)((n - i) / 8, static_cast<size_t>(16384)); b > 0; --b, i += 8) {
+						const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+						const __m128i hi = _mm_and_si128(x, m800);
+						accA = _mm_add_epi16(accA, _mm_cmpeq_epi16(_mm_and_si128(x, m80), zero));
+						accB = _mm_add_epi16(accB, _mm_cmpeq_epi16(hi, zero));
+						accS = _mm_add_epi16(accS, _mm_cmpeq_epi16(hi, d800));
+					}
+					ascii += hsum_negative(_mm_madd_epi16(accA, minusOne));
+					below800 += hsum_negative(_mm_madd_epi16(accB, minusOne));
+					surrogates += hsum_negative(_mm_madd_epi16(accS, minusOne));
+				}
+				return i;
+			}
+
+			UTF_TRANSCODE_TARGET_SSE41 static size_t hsum_negative(__m128i v) noexcept
+			{
+				v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+				v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+				return static_cast<size_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(v)));
+			}
+		};
+
+		//-----------------------------------------------------------------------------------------
+		// AVX2 (32 byte, pshufb 표는 두 lane 에 복제)
+		//-----------------------------------------------------------------------------------------
+		struct Avx2
+		{
+			UTF_TRANSCODE_TARGET_AVX2 static __m256i table(int k) noexcept
+			{
+				return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Utf8Lookup[k])));
+			}
+
+			// prev 의 끝 N byte 를 앞에 붙인 in (lane 경계를 넘어서)
+			template<int N>
+			UTF_TRANSCODE_TARGET_AVX2 static __m256i prev_bytes(__m256i in, __m256i prev) noexcept
+			{
+				return _mm256_alignr_epi8(in, _mm256_permute2x128_si256(prev, in, 0x21), 16 - N);
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static bool ascii64(const uint8_t* p) noexcept
+			{
+				const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+				return 0 == _mm256_movemask_epi8(_mm256_or_si256(a, b));
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static __m256i check32(__m256i in, __m256i prev) noexcept
+			{
+				const __m256i low = _mm256_set1_epi8(0x0F);
+
+				const __m256i prev1 = prev_bytes<1>(in, prev);
+				const __m256i b1h = _mm256_shuffle_epi8(table(0), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low));
+				const __m256i b1l = _mm256_shuffle_epi8(table(1), _mm256_and_si256(prev1, low));
+				const __m256i b2h = _mm256_shuffle_epi8(table(2), _mm256_and_si256(_mm256_srli_epi16(in, 4), low));
+				const __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+
+				const __m256i third = _mm256_subs_epu8(prev_bytes<2>(in, prev), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+				const __m256i fourth = _mm256_subs_epu8(prev_bytes<3>(in, prev), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+				const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+				return _mm256_xor_si256(must23, special);
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static bool valid64(const uint8_t* p) noexcept
+			{
+				const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+				const __m256i error = _mm256_or_si256(check32(a, _mm256_setzero_si256()), check32(b, a));
+				return 0 != _mm256_testz_si256(error, error);
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static void widen64(const uint8_t* p, char16_t* out) noexcept
+			{
+				for (int k = 0; k < 64; k += 16) {
+					const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_cvtepu8_epi16(in));
+				}
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static void widen64(const uint8_t* p, char32_t* out) noexcept
+			{
+				for (int k = 0; k < 64; k += 16) {
+					const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_cvtepu8_epi32(in));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(in, 8)));
+				}
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static int classify16(const char16_t* p) noexcept
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				if (_mm256_testz_si256(x, _mm256_set1_epi16(static_cast<short>(0xFF80)))) return 0;
+
+				const __m256i s = _mm256_cmpeq_epi16(_mm256_and_si256(x, _mm256_set1_epi16(static_cast<short>(0xF800))), _mm256_set1_epi16(static_cast<short>(0xD800)));
+				return _mm256_testz_si256(s, s) ? 1 : 2;
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static void narrow16(const char16_t* p, uint8_t* out) noexcept
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1)));
+			}
+
+			// unit 8개를 128-bit lane 2개(4개씩)로 나눠 압축
+			UTF_TRANSCODE_TARGET_AVX2 static size_t encode16(const char16_t* p, uint8_t* out, const Utf16PackTable& t) noexcept
+			{
+				const __m256i m6 = _mm256_set1_epi32(0x3F);
+				const __m256i cont = _mm256_set1_epi32(0x80);
+
+				size_t w = 0;
+				for (int k = 0; k < 16; k += 8) {
+					const __m256i c = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k)));
+					const __m256i last = _mm256_or_si256(_mm256_and_si256(c, m6), cont);
+					const __m256i middle = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(c, 6), m6), cont);
+					const __m256i two = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0xC0)), _mm256_slli_epi32(last, 8));
+					const __m256i three = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(c, 12), _mm256_set1_epi32(0xE0)),
+						_mm256_or_si256(_mm256_slli_epi32(middle, 8), _mm256_slli_epi32(last, 16)));
+
+					const __m256i ge80 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7F));
+					const __m256i ge800 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7FF));
+					const __m256i bytes = _mm256_blendv_epi8(c, _mm256_blendv_epi8(two, three, ge800), ge80);
+
+					const int m80 = _mm256_movemask_ps(_mm256_castsi256_ps(ge80));
+					const int m800 = _mm256_movemask_ps(_mm256_castsi256_ps(ge800));
+					const int lo = (m80 & 0xF) | ((m800 & 0xF) << 4);
+					const int hi = (m80 >> 4) | (m800 & 0xF0);
+					const __m256i shuffle = _mm256_inserti128_si256(
+						_mm256_castsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[lo]))),
+						_mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[hi])), 1);
+					const __m256i packed = _mm256_shuffle_epi8(bytes, shuffle);
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + w), _mm256_castsi256_si128(packed));
+					w += t.length[lo];
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + w), _mm256_extracti128_si256(packed, 1));
+					w += t.length[hi];
+				}
+				return w;
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static size_t hsum_sad(__m256i v) noexcept
+			{
+				const __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+				return static_cast<size_t>(_mm_extract_epi16(s, 0) + _mm_extract_epi16(s, 4));
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static size_t hsum_negative(__m256i v) noexcept
+			{
+				__m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+				s = _mm_add_epi32(s, _mm_srli_si128(s, 8));
+				s = _mm_add_epi32(s, _mm_srli_si128(s, 4));
+				return static_cast<size_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(s)));
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static size_t count_utf8(const uint8_t* p, size_t n, size_t& leads, size_t& fours) noexcept
+			{
+				const __m256i notCont = _mm256_set1_epi8(-65);
+				const __m256i f0 = _mm256_set1_epi8(static_cast<char>(0xF0));
+				const __m256i zero = _mm256_setzero_si256();
+
+				size_t i = 0;
+				while (n - i >= 32) {
+					__m256i accLead = zero, accFour = zero;
+					for (size_t b = (std::min)((n - i) / 32, static_cast<size_t>(255)); b > 0; --b, i += 32) {
+						const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+						accLead = _mm256_sub_epi8(accLead, _mm256_cmpgt_epi8(x, notCont));
+						accFour = _mm256_sub_epi8(accFour, _mm256_cmpeq_epi8(_mm256_max_epu8(x, f0), x));
+					}
+					leads += hsum_sad(_mm256_sad_epu8(accLead, zero));
+					fours += hsum_sad(_mm256_sad_epu8(accFour, zero));
+				}
+				return i;
+			}
+
+			UTF_TRANSCODE_TARGET_AVX2 static size_t count_utf16(const char16_t* p, size_t n, size_t& ascii, size_t& below800, size_t& surrogates) noexcept
+			{
+				const __m256i m80 = _mm256_set1_epi16(static_cast<short>(0xFF80));
+				const __m256i m800 = _mm256_set1_epi16(static_cast<short>(0xF800));
+				const __m256i d800 = _mm256_set1_epi16(static_cast<short>(0xD800));
+				const __m256i zero = _mm256_setzero_si256();
+				const __m256i minusOne = _mm256_set1_epi16(-1);
+
+				size_t i = 0;
+				while (n - i >= 16) {
+					__m256i accA = zero, accB = zero, accS = zero;
+					for (size_t b = (std::min)((n - i) / 16, static_cast<size_t>(16384)); b > 0; --b, i += 16) {
+						const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+						const __m256i hi = _mm256_and_si256(x, m800);
+						accA = _mm256_add_epi16(accA, _mm256_cmpeq_epi16(_mm256_and_si256(x, m80), zero));
+						accB = _mm256_add_epi16(accB, _mm256_cmpeq_epi16(hi, zero));
+						accS = _mm256_add_epi16(accS, _mm256_cmpeq_epi16(hi, d800));
+					}
+					ascii += hsum_negative(_mm256_madd_epi16(accA, minusOne));
+					below800 += hsum_negative(_mm256_madd_epi16(accB, minusOne));
+					surrogates += hsum_negative(_mm256_madd_epi16(accS, minusOne));
+				}
+				return i;
+			}
+		};
+#endif // UTF_TRANSCODE_HAS_X86
+
+#if UTF_TRANSCODE_HAS_NEON
+		//-----------------------------------------------------------------------------------------
+		// NEON (AArch64 : tbl, 가로 합/최대 명령 사용)
+		//-----------------------------------------------------------------------------------------
+		struct Neon
+		{
+			static bool ascii64(const uint8_t* p) noexcept
+			{
+				const uint8x16_t a = vorrq_u8(vld1q_u8(p), vld1q_u8(p + 16));
+				const uint8x16_t b = vorrq_u8(vld1q_u8(p + 32), vld1q_u8(p + 48));
+				return vmaxvq_u8(vorrq_u8(a, b)) < 0x80;
+			}
+
+			static uint8x16_t check16(uint8x16_t in, uint8x16_t prev) noexcept
+			{
+				const uint8x16_t low = vdupq_n_u8(0x0F);
+				const uint8x16_t prev1 = vextq_u8(prev, in, 15);
+				const uint8x16_t b1h = vqtbl1q_u8(vld1q_u8(Utf8Lookup[0]), vshrq_n_u8(prev1, 4));
+				const uint8x16_t b1l = vqtbl1q_u8(vld1q_u8(Utf8Lookup[1]), vandq_u8(prev1, low));
+				const uint8x16_t b2h = vqtbl1q_u8(vld1q_u8(Utf8Lookup[2]), vshrq_n_u8(in, 4));
+				const uint8x16_t special = vandq_u8(vandq_u8(b1h, b1l), b2h);
+
+				const uint8x16_t third = vqsubq_u8(vextq_u8(prev, in, 14), vdupq_n_u8(0xE0 - 0x80));
+				const uint8x16_t fourth = vqsubq_u8(vextq_u8(prev, in, 13), vdupq_n_u8(0xF0 - 0x80));
+				const uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+				return veorq_u8(must23, special);
+			}
+
+			static bool valid64(const uint8_t* p) noexcept
+			{
+				uint8x16_t prev = vdupq_n_u8(0);
+				uint8x16_t error = vdupq_n_u8(0);
+				for (int k = 0; k < 4; ++k) {
+					const uint8x16_t in = vld1q_u8(p + 16 * k);
+					error = vorrq_u8(error, check16(in, prev));
+					prev = in;
+				}
+				return 0 == vmaxvq_u8(error);
+			}
+
+			static void widen64(const uint8_t* p, char16_t* out) noexcept
+			{
+				uint16_t* o = reinterpret_cast<uint16_t*>(out);
+				for (int k = 0; k < 64; k += 16) {
+					const uint8x16_t in = vld1q_u8(p + k);
+					vst1q_u16(o + k, vmovl_u8(vget_low_u8(in)));
+					vst1q_u16(o + k + 8, vmovl_high_u8(in));
+				}
+			}
+
+			static void widen64(const uint8_t* p, char32_t* out) noexcept
+			{
+				uint32_t* o = reinterpret_cast<uint32_t*>(out);
+				for (int k = 0; k < 64; k += 16) {
+					const uint8x16_t in = vld1q_u8(p + k);
+					const uint16x8_t lo = vmovl_u8(vget_low_u8(in));
+					const uint16x8_t hi = vmovl_high_u8(in);
+					vst1q_u32(o + k, vmovl_u16(vget_low_u16(lo)));
+					vst1q_u32(o + k + 4, vmovl_high_u16(lo));
+					vst1q_u32(o + k + 8, vmovl_u16(vget_low_u16(hi)));
+					vst1q_u32(o + k + 12, vmovl_high_u16(hi));
+				}
+			}
+
+			static int classify16(const char16_t* p) noexcept
+			{
+				const uint16_t* q = reinterpret_cast<const uint16_t*>(p);
+				const uint16x8_t a = vld1q_u16(q);
+				const uint16x8_t b = vld1q_u16(q + 8);
+				if (vmaxvq_u16(vorrq_u16(a, b)) < 0x80) return 0;
+
+				const uint16x8_t mask = vdupq_n_u16(0xF800);
+				const uint16x8_t surrogate = vdupq_n_u16(0xD800);
+				const uint16x8_t s = vorrq_u16(vceqq_u16(vandq_u16(a, mask), surrogate), vceqq_u16(vandq_u16(b, mask), surrogate));
+				return 0 == vmaxvq_u16(s) ? 1 : 2;
+			}
+
+			static void narrow16(const char16_t* p, uint8_t* out) noexcept
+			{
+				const uint16_t* q = reinterpret_cast<const uint16_t*>(p);
+				vst1q_u8(out, vcombine_u8(vmovn_u16(vld1q_u16(q)), vmovn_u16(vld1q_u16(q + 8))));
+			}
+
+			static size_t encode4(uint32x4_t c, uint8_t* out, const Utf16PackTable& t) noexcept
+			{
+				const uint32x4_t m6 = vdupq_n_u32(0x3F);
+				const uint32x4_t cont = vdupq_n_u32(0x80);
+				const uint32x4_t last = vorrq_u32(vandq_u32(c, m6), cont);
+				const uint32x4_t middle = vorrq_u32(vandq_u32(vshrq_n_u32(c, 6), m6), cont);
+				const uint32x4_t two = vorrq_u32(vorrq_u32(vshrq_n_u32(c, 6), vdupq_n_u32(0xC0)), vshlq_n_u32(last, 8));
+				const uint32x4_t three = vorrq_u32(vorrq_u32(vshrq_n_u32(c, 12), vdupq_n_u32(0xE0)),
+					vorrq_u32(vshlq_n_u32(middle, 8), vshlq_n_u32(last, 16)));
+
+				const uint32x4_t ge80 = vcgtq_u32(c, vdupq_n_u32(0x7F));
+				const uint32x4_t ge800 = vcgtq_u32(c, vdupq_n_u32(0x7FF));
+				const uint32x4_t bytes = vbslq_u32(ge80, vbslq_u32(ge800, three, two), c);
+
+				static const uint32_t bits[4] = { 1, 2, 4, 8 };
+				const uint32x4_t weight = vld1q_u32(bits);
+				const uint32_t index = vaddvq_u32(vandq_u32(ge80, weight)) | (vaddvq_u32(vandq_u32(ge800, weight)) << 4);
+				vst1q_u8(out, vqtbl1q_u8(vreinterpretq_u8_u32(bytes), vld1q_u8(t.shuffle[index])));
+				return t.length[index];
+			}
+
+			static size_t encode16(const char16_t* p, uint8_t* out, const Utf16PackTable& t) noexcept
+			{
+				const uint16_t* q = reinterpret_cast<const uint16_t*>(p);
+				size_t w = 0;
+				for (int k = 0; k < 16; k += 8) {
+					const uint16x8_t x = vld1q_u16(q + k);
+					w += encode4(vmovl_u16(vget_low_u16(x)), out + w, t);
+					w += encode4(vmovl_high_u16(x), out + w, t);
+				}
+				return w;
+			}
+
+			static size_t count_utf8(const uint8_t* p, size_t n, size_t& leads, size_t& fours) noexcept
+			{
+				size_t i = 0;
+				while (n - i >= 16) {
+					uint8x16_t accLead = vdupq_n_u8(0), accFour = vdupq_n_u8(0);
+					for (size_t b = (std::min)((n - i) / 16, static_cast<size_t>(255)); b > 0; --b, i += 16) {
+						const uint8x16_t x = vld1q_u8(p + i);
+						accLead = vsubq_u8(accLead, vcgtq_s8(vreinterpretq_s8_u8(x), vdupq_n_s8(-65)));
+						accFour = vsubq_u8(accFour, vcgeq_u8(x, vdupq_n_u8(0xF0)));
+					}
+					leads += vaddlvq_u8(accLead);
+					fours += vaddlvq_u8(accFour);
+				}
+				return i;
+			}
+
+			static size_t count_utf16(const char16_t* p, size_t n, size_t& ascii, size_t& below800, size_t& surrogates) noexcept
+			{
+				const uint16_t* q = reinterpret_cast<const uint16_t*>(p);
+				size_t i = 0;
+				while (n - i >= 8) {
+					uint16x8_t accA = vdupq_n_u16(0), accB = vdupq_n_u16(0), accS = vdupq_n_u16(0);
+					for (size_t b = (std::min)((n - i) / 8, static_cast<size_t>(65535)); b > 0; --b, i += 8) {
+						const uint16x8_t x = vld1q_u16(q + i);
+						accA = vsubq_u16(accA, vcltq_u16(x, vdupq_n_u16(0x80)));
+						accB = vsubq_u16(accB, vcltq_u16(x, vdupq_n_u16(0x800)));
+						accS = vsubq_u16(accS, vceqq_u16(vandq_u16(x, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800)));
+					}
+					ascii += vaddlvq_u16(accA);
+					below800 += vaddlvq_u16(accB);
+					surrogates += vaddlvq_u16(accS);
+				}
+				return i;
+			}
+		};
+#endif // UTF_TRANSCODE_HAS_NEON
+
+		//=========================================================================================
+		// SIMD 창 단위 driver (Isa = Sse41 / Avx2 / Neon)
+		//=========================================================================================
+		template<typename Isa>
+		inline Result validate_utf8_simd(const uint8_t* in, size_t n) noexcept
+		{
+			size_t i = 0;
+			while (n - i >= 64) {
+				const uint8_t* p = in + i;
+				if (Isa::ascii64(p)) { i += 64; continue; }
+				if (!Isa::valid64(p)) break;        // 이 창 안에 오류 => scalar 로 정확한 위치
+				i += complete_prefix(p, 64);
+			}
+			return validate_checked(in, n, i);
+		}
+
+		template<typename Isa, typename Out>
+		inline Result utf8_to_simd(const uint8_t* in, size_t n, Out* out, size_t cap) noexcept
+		{
+			size_t i = 0, w = 0;
+			while (n - i >= 64 && cap - w >= 64) {       // 64 byte 는 64 unit 을 넘지 않는다
+				const uint8_t* p = in + i;
+				if (Isa::ascii64(p)) {
+					Isa::widen64(p, out + w);
+					i += 64;
+					w += 64;
+					continue;
+				}
+				if (!Isa::valid64(p)) break;
+				const size_t end = complete_prefix(p, 64);
+				w += decode_valid(p, end, out + w);
+				i += end;
+			}
+			return transcode_checked(in, n, i, out, cap, w);
+		}
+
+		template<typename Isa>
+		inline Result utf16_to_utf8_simd(const char16_t* in, size_t n, uint8_t* out, size_t cap) noexcept
+		{
+			const Utf16PackTable& table = utf16_pack_table();
+			size_t i = 0, w = 0;
+			while (n - i >= 16 && cap - w >= 48 + 4) {   // 16 unit 은 48 byte 를 넘지 않는다 (+4 : encode16 의 마지막 store)
+				const char16_t* p = in + i;
+				const int kind = Isa::classify16(p);
+				if (0 == kind) {
+					Isa::narrow16(p, out + w);
+					i += 16;
+					w += 16;
+					continue;
+				}
+				if (1 == kind) {
+					w += Isa::encode16(p, out + w, table);
+					i += 16;
+					continue;
+				}
+
+				// 서로게이트가 있는 창만 scalar (창 끝의 high surrogate 는 다음 창에서)
+				const Result r = transcode_checked(in, i + 16, i, out, cap, w);
+				if (!r.ok() && !(Error::Truncated == r.error && i + 16 < n)) return r;
+				i = r.read;
+				w = r.written;
+			}
+			return transcode_checked(in, n, i, out, cap, w);
+		}
+
+		template<typename Isa>
+		inline Result validate_utf16_simd(const char16_t* in, size_t n) noexcept
+		{
+			size_t i = 0;
+			while (n - i >= 16) {
+				const int kind = Isa::classify16(in + i);
+				if (kind < 2) { i += 16; continue; }
+
+				const Result r = validate_checked(in, i + 16, i);
+				if (!r.ok() && !(Error::Truncated == r.error && i + 16 < n)) return r;
+				i = r.read;
+			}
+			return validate_checked(in, n, i);
+		}
+
+		template<typename Isa>
+		inline void count_utf8_simd(const uint8_t* p, size_t n, size_t& leads, size_t& fours) noexcept
+		{
+			for (size_t i = Isa::count_utf8(p, n, leads, fours); i < n; ++i) {
+				leads += (p[i] & 0xC0) != 0x80;
+				fours += p[i] >= 0xF0;
+			}
+		}
+
+		inline size_t utf8_length_from_utf16_scalar(const char16_t* p, size_t n) noexcept
+		{
+			size_t bytes = 0;
+			for (size_t i = 0; i < n; ++i) {
+				const uint32_t c = p[i];
+				bytes += 1 + (c >= 0x80) + (c >= 0x800) - ((c & 0xF800) == 0xD800);
+			}
+			return bytes;
+		}
+
+		template<typename Isa>
+		inline size_t utf8_length_from_utf16_simd(const char16_t* p, size_t n) noexcept
+		{
+			size_t ascii = 0, below800 = 0, surrogates = 0;
+			for (size_t i = Isa::count_utf16(p, n, ascii, below800, surrogates); i < n; ++i) {
+				ascii += p[i] < 0x80;
+				below800 += p[i] < 0x800;
+				surrogates += (p[i] & 0xF800) == 0xD800;
+			}
+			// n + (>= 0x80) + (>= 0x800) - 서로게이트 (짝 = 3 + 3 - 2 = 4 byte)
+			return n + (n - ascii) + (n - below800) - surrogates;
+		}
+
+		//=========================================================================================
+		// kernel 선택
+		//=========================================================================================
+		inline Kernel detect_kernel() noexcept
+		{
+#if UTF_TRANSCODE_HAS_NEON
+			return Kernel::Neon;
+#elif UTF_TRANSCODE_HAS_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+			int r[4];
+			__cpuid(r, 0);
+			const int maxLeaf = r[0];
+			__cpuid(r, 1);
+			const bool sse41 = 0 != (r[2] & (1 << 19));
+			const bool osxsave = 0 != (r[2] & (1 << 27));
+			const bool avx = 0 != (r[2] & (1 << 28));
+			bool avx2 = false;
+			if (maxLeaf >= 7 && osxsave && avx && 6 == (_xgetbv(0) & 6)) {     // OS 가 ymm 상태를 저장하는지
+				__cpuidex(r, 7, 0);
+				avx2 = 0 != (r[1] & (1 << 5));
+			}
+#else
+			__builtin_cpu_init();
+			const bool sse41 = 0 != __builtin_cpu_supports("sse4.1");
+			const bool avx2 = 0 != __builtin_cpu_supports("avx2");
+#endif
+			return avx2 ? Kernel::Avx2 : sse41 ? Kernel::Sse41 : Kernel::Scalar;
+#else
+			return Kernel::Scalar;
+#endif
+		}
+
+		inline std::atomic<int>& kernel_slot() noexcept
+		{
+			static std::atomic<int> slot(static_cast<int>(detect_kernel()));
+			return slot;
+		}
+
+		template<typename CharT>
+		using unicode_t = typename std::conditional<2 == sizeof(CharT), char16_t, char32_t>::type;
+
+		template<typename CharT>
+		inline const unicode_t<CharT>* as_unicode(const CharT* p) noexcept { return reinterpret_cast<const unicode_t<CharT>*>(p); }
+
+		template<typename CharT>
+		inline unicode_t<CharT>* as_unicode(CharT* p) noexcept { return reinterpret_cast<unicode_t<CharT>*>(p); }
+	}
+
+	//=============================================================================================
+	// kernel
+	//=============================================================================================
+	inline Kernel best_kernel() noexcept
+	{
+		static const Kernel best = detail::detect_kernel();
+		return best;
+	}
+
+	inline Kernel active_kernel() noexcept { return static_cast<Kernel>(detail::kernel_slot().load(std::memory_order_relaxed)); }
+
+	inline bool is_supported(Kernel k) noexcept
+	{
+		const Kernel best = best_kernel();
+		return Kernel::Scalar == k || best == k || (Kernel::Sse41 == k && Kernel::Avx2 == best);
+	}
+
+	// benchmark / 비교용. 지원하지 않는 kernel 이면 false (바꾸지 않음)
+	inline bool set_kernel(Kernel k) noexcept
+	{
+		if (!is_supported(k)) return false;
+		detail::kernel_slot().store(static_cast<int>(k), std::memory_order_relaxed);
+		return true;
+	}
+
+	inline const char* kernel_name(Kernel k) noexcept
+	{
+		switch (k) {
+		case Kernel::Scalar: return "scalar";
+		case Kernel::Sse41: return "sse4.1";
+		case Kernel::Avx2: return "avx2";
+		case Kernel::Neon: return "neon";
+		}
+		return "unknown";
+	}
+
+#if UTF_TRANSCODE_HAS_X86 && UTF_TRANSCODE_HAS_NEON
+#error "utf_transcode.h: x86 and NEON at the same time"
+#endif
+
+	// kernel 별로 같은 함수를 부른다 : UTF_TRANSCODE_DISPATCH(detail::func, args...)
+#if UTF_TRANSCODE_HAS_X86
+#define UTF_TRANSCODE_DISPATCH(simd, scalar, ...)                                                       \
+		switch (active_kernel()) {                                                                      \
+		case Kernel::Avx2: return simd<detail::Avx2>(__VA_ARGS__);                                      \
+		case Kernel::Sse41: return simd<detail::Sse41>(__VA_ARGS__);                                    \
+		default: return scalar;                                                                         \
+		}
+#elif UTF_TRANSCODE_HAS_NEON
+#define UTF_TRANSCODE_DISPATCH(simd, scalar, ...)                                                       \
+		if (Kernel::Neon == active_kernel()) return simd<detail::Neon>(__VA_ARGS__);                    \
+		return scalar;
+#else
+#define UTF_TRANSCODE_DISPATCH(simd, scalar, ...)                                                       \
+		return scalar;
+#endif
+
+	//=============================================================================================
+	// 검증
+	//=============================================================================================
+	inline Result validate_utf8(const char* in, size_t n) noexcept
+	{
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+		UTF_TRANSCODE_DISPATCH(detail::validate_utf8_simd, detail::validate_checked(p, n, 0), p, n)
+	}
+
+	inline Result validate_utf16(const char16_t* in, size_t n) noexcept
+	{
+		UTF_TRANSCODE_DISPATCH(detail::validate_utf16_simd, detail::validate_checked(in, n, 0), in, n)
+	}
+
+	inline Result validate_utf32(const char32_t* in, size_t n) noexcept { return detail::validate_checked(in, n, 0); }
+
+	//=============================================================================================
+	// 출력 길이 (올바른 입력 가정, 입력 1 pass)
+	//=============================================================================================
+	inline size_t utf32_length_from_utf8(const char* in, size_t n) noexcept
+	{
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+		size_t leads = 0, fours = 0;
+		switch (active_kernel()) {
+#if UTF_TRANSCODE_HAS_X86
+		case Kernel::Avx2: detail::count_utf8_simd<detail::Avx2>(p, n, leads, fours); return leads;
+		case Kernel::Sse41: detail::count_utf8_simd<detail::Sse41>(p, n, leads, fours); return leads;
+#endif
+#if UTF_TRANSCODE_HAS_NEON
+		case Kernel::Neon: detail::count_utf8_simd<detail::Neon>(p, n, leads, fours); return leads;
+#endif
+		default:
+			for (size_t i = 0; i < n; ++i) leads += (p[i] & 0xC0) != 0x80;
+			return leads;
+		}
+	}
+
+	inline size_t utf16_length_from_utf8(const char* in, size_t n) noexcept
+	{
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+		size_t leads = 0, fours = 0;
+		switch (active_kernel()) {
+#if UTF_TRANSCODE_HAS_X86
+		case Kernel::Avx2: detail::count_utf8_simd<detail::Avx2>(p, n, leads, fours); break;
+		case Kernel::Sse41: detail::count_utf8_simd<detail::Sse41>(p, n, leads, fours); break;
+#endif
+#if UTF_TRANSCODE_HAS_NEON
+		case Kernel::Neon: detail::count_utf8_simd<detail::Neon>(p, n, leads, fours); break;
+#endif
+		default:
+			for (size_t i = 0; i < n; ++i) {
+				leads += (p[i] & 0xC0) != 0x80;
+				fours += p[i] >= 0xF0;
+			}
+			break;
+		}
+		return leads + fours;       // 4 byte 글자 = 서로게이트 쌍
+	}
+
+	inline size_t utf8_length_from_utf16(const char16_t* in, size_t n) noexcept
+	{
+		UTF_TRANSCODE_DISPATCH(detail::utf8_length_from_utf16_simd, detail::utf8_length_from_utf16_scalar(in, n), in, n)
+	}
+
+	inline size_t utf32_length_from_utf16(const char16_t* in, size_t n) noexcept
+	{
+		size_t lows = 0;
+		for (size_t i = 0; i < n; ++i) lows += (in[i] & 0xFC00) == 0xDC00;
+		return n - lows;
+	}
+
+	inline size_t utf8_length_from_utf32(const char32_t* in, size_t n) noexcept
+	{
+		size_t bytes = 0;
+		for (size_t i = 0; i < n; ++i) bytes += 1 + (in[i] >= 0x80) + (in[i] >= 0x800) + (in[i] >= 0x10000);
+		return bytes;
+	}
+
+	inline size_t utf16_length_from_utf32(const char32_t* in, size_t n) noexcept
+	{
+		size_t units = n;
+		for (size_t i = 0; i < n; ++i) units += in[i] >= 0x10000;
+		return units;
+	}
+
+	//=============================================================================================
+	// 변환 (out 에 cap unit 까지, 넘치면 OutputTooSmall)
+	//=============================================================================================
+	inline Result convert_utf8_to_utf16(const char* in, size_t n, char16_t* out, size_t cap) noexcept
+	{
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+		UTF_TRANSCODE_DISPATCH(detail::utf8_to_simd, detail::transcode_checked(p, n, 0, out, cap, 0), p, n, out, cap)
+	}
+
+	inline Result convert_utf8_to_utf32(const char* in, size_t n, char32_t* out, size_t cap) noexcept
+	{
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+		UTF_TRANSCODE_DISPATCH(detail::utf8_to_simd, detail::transcode_checked(p, n, 0, out, cap, 0), p, n, out, cap)
+	}
+
+	inline Result convert_utf16_to_utf8(const char16_t* in, size_t n, char* out, size_t cap) noexcept
+	{
+		uint8_t* o = reinterpret_cast<uint8_t*>(out);
+		UTF_TRANSCODE_DISPATCH(detail::utf16_to_utf8_simd, detail::transcode_checked(in, n, 0, o, cap, 0), in, n, o, cap)
+	}
+
+	inline Result convert_utf32_to_utf8(const char32_t* in, size_t n, char* out, size_t cap) noexcept
+	{
+		return detail::transcode_checked(in, n, 0, reinterpret_cast<uint8_t*>(out), cap, 0);
+	}
+
+	inline Result convert_utf16_to_utf32(const char16_t* in, size_t n, char32_t* out, size_t cap) noexcept
+	{
+		return detail::transcode_checked(in, n, 0, out, cap, 0);
+	}
+
+	inline Result convert_utf32_to_utf16(const char32_t* in, size_t n, char16_t* out, size_t cap) noexcept
+	{
+		return detail::transcode_checked(in, n, 0, out, cap, 0);
+	}
+
+#undef UTF_TRANSCODE_DISPATCH
+
+	//---------------------------------------------------------------------------------------------
+	// wide(CharT = char16_t / char32_t / wchar_t) <-> UTF-8
+	//---------------------------------------------------------------------------------------------
+	inline size_t length_from_utf8(const char* in, size_t n, char16_t*) noexcept { return utf16_length_from_utf8(in, n); }
+	inline size_t length_from_utf8(const char* in, size_t n, char32_t*) noexcept { return utf32_length_from_utf8(in, n); }
+	inline size_t utf8_length(const char16_t* in, size_t n) noexcept { return utf8_length_from_utf16(in, n); }
+	inline size_t utf8_length(const char32_t* in, size_t n) noexcept { return utf8_length_from_utf32(in, n); }
+	inline Result convert_from_utf8(const char* in, size_t n, char16_t* out, size_t cap) noexcept { return convert_utf8_to_utf16(in, n, out, cap); }
+	inline Result convert_from_utf8(const char* in, size_t n, char32_t* out, size_t cap) noexcept { return convert_utf8_to_utf32(in, n, out, cap); }
+	inline Result convert_to_utf8(const char16_t* in, size_t n, char* out, size_t cap) noexcept { return convert_utf16_to_utf8(in, n, out, cap); }
+	inline Result convert_to_utf8(const char32_t* in, size_t n, char* out, size_t cap) noexcept { return convert_utf32_to_utf8(in, n, out, cap); }
+
+	// out 뒤에 덧붙인다 (길이를 먼저 정확히 재서 한 번만 크기를 잡음). 오류면 out 은 오류 앞까지만 늘어난다
+	template<typename CharT>
+	inline Result append_from_utf8(const char* in, size_t n, std::basic_string<CharT>& out)
+	{
+		using U = detail::unicode_t<CharT>;
+		const size_t old = out.size();
+		out.resize(old + length_from_utf8(in, n, static_cast<U*>(nullptr)));
+
+		const Result r = convert_from_utf8(in, n, detail::as_unicode(&out[0]) + old, out.size() - old);
+		out.resize(old + r.written);
+		return r;
+	}
+
+	template<typename CharT>
+	inline Result append_to_utf8(const CharT* in, size_t n, std::string& out)
+	{
+		const size_t old = out.size();
+		out.resize(old + utf8_length(detail::as_unicode(in), n));
+
+		const Result r = convert_to_utf8(detail::as_unicode(in), n, &out[0] + old, out.size() - old);
+		out.resize(old + r.written);
+		return r;
+	}
+
+	// 오류면 빈 문자열 (Unicode::utf8_to_wstr 와 같은 의미)
+	inline std::wstring to_wstring(const std::string& utf8)
+	{
+		std::wstring out;
+		if (!append_from_utf8(utf8.data(), utf8.size(), out).ok()) out.clear();
+		return out;
+	}
+
+	inline std::u16string to_u16string(const std::string& utf8)
+	{
+		std::u16string out;
+		if (!append_from_utf8(utf8.data(), utf8.size(), out).ok()) out.clear();
+		return out;
+	}
+
+	inline std::u32string to_u32string(const std::string& utf8)
+	{
+		std::u32string out;
+		if (!append_from_utf8(utf8.data(), utf8.size(), out).ok()) out.clear();
+		return out;
+	}
+
+	template<typename CharT>
+	inline std::string to_utf8(const std::basic_string<CharT>& wide)
+	{
+		std::string out;
+		if (!append_to_utf8(wide.data(), wide.size(), out).ok()) out.clear();
+		return out;
+	}
+
+	// UTF-8 BOM(EF BB BF) 이 있으면 건너뛴다
+	inline bool skip_bom(const char*& p, size_t& n) noexcept
+	{
+		if (n >= 3 && 0 == memcmp(p, "\xEF\xBB\xBF", 3)) {
+			p += 3;
+			n -= 3;
+			return true;
+		}
+		return false;
+	}
+
+	//=============================================================================================
+	// 스트리밍 (파일을 chunk 로 읽고/쓰기)
+	//   Result::read 는 스트림 처음부터의 위치(오류면 오류 글자의 시작)
+	//=============================================================================================
+	template<typename CharT>
+	class Utf8Decoder
+	{
+	public:
+		// last = true 면 끝에 남은 끊긴 글자는 Truncated
+		Result decode(const char* p, size_t n, std::basic_string<CharT>& out, bool last = false)
+		{
+			const size_t before = out.size();
+			size_t i = 0;
+
+			if (_carryLen) {
+				const size_t need = detail::utf8_sequence_length(static_cast<uint8_t>(_carry[0]));
+				while (_carryLen < need && i < n && 0x80 == (static_cast<uint8_t>(p[i]) & 0xC0)) _carry[_carryLen++] = p[i++];
+				if (_carryLen < need) {
+					if (i == n && !last) return Result(Error::None, _consumed, 0);     // 다음 chunk 를 기다림
+					if (i < n) _carry[_carryLen++] = p[i];      // 글자를 끊은 byte 까지 넣어 한 번에 변환할 때와 같은 오류를 낸다
+				}
+
+				const Result r = append_from_utf8(_carry, _carryLen, out);
+				if (!r.ok()) return Result(r.error, _consumed, out.size() - before);
+				_consumed += _carryLen;
+				_carryLen = 0;
+			}
+
+			const size_t end = last ? n : i + detail::complete_prefix(reinterpret_cast<const uint8_t*>(p + i), n - i);
+			const Result r = append_from_utf8(p + i, end - i, out);
+			if (!r.ok()) {
+				// 뒤에 남긴 글자는 lead byte 로 시작하므로, 앞에서 끊긴 글자는 continuation 이 모자란 것
+				const Error e = (Error::Truncated == r.error && end < n) ? Error::TooShort : r.error;
+				return Result(e, _consumed + r.read, out.size() - before);
+			}
+			_consumed += end - i;
+
+			_carryLen = n - end;
+			if (_carryLen) memcpy(_carry, p + end, _carryLen);
+			return Result(Error::None, _consumed, out.size() - before);
+		}
+
+		Result finish(std::basic_string<CharT>& out) { return decode(nullptr, 0, out, true); }
+
+		size_t consumed() const noexcept { return _consumed; }
+		void reset() noexcept { _carryLen = 0; _consumed = 0; }
+
+	private:
+		char _carry[4] = {};
+		size_t _carryLen = 0;
+		size_t _consumed = 0;
+	};
+
+	template<typename CharT>
+	class Utf8Encoder
+	{
+	public:
+		Result encode(const CharT* p, size_t n, std::string& out, bool last = false)
+		{
+			const size_t before = out.size();
+			size_t i = 0;
+
+			if (_hasCarry) {
+				if (0 == n) {
+					if (last) return Result(Error::Truncated, _consumed, 0);
+					return Result(Error::None, _consumed, 0);
+				}
+				const CharT pair[2] = { _carry, p[0] };
+				const Result r = append_to_utf8(pair, 2, out);
+				if (!r.ok()) return Result(r.error, _consumed, out.size() - before);
+				_consumed += 2;
+				_hasCarry = false;
+				i = 1;
+			}
+
+			size_t end = n;
+			if (2 == sizeof(CharT) && !last && end > i && (static_cast<uint32_t>(p[end - 1]) & 0xFC00) == 0xD800) --end;     // high surrogate 는 다음 chunk 와
+
+			const Result r = append_to_utf8(p + i, end - i, out);
+			if (!r.ok()) return Result(r.error, _consumed + r.read, out.size() - before);
+			_consumed += end - i;
+
+			if (end < n) {
+				_carry = p[end];
+				_hasCarry = true;
+			}
+			return Result(Error::None, _consumed, out.size() - before);
+		}
+
+		Result finish(std::string& out) { return encode(nullptr, 0, out, true); }
+
+		size_t consumed() const noexcept { return _consumed; }
+		void reset() noexcept { _hasCarry = false; _consumed = 0; }
+
+	private:
+		CharT _carry = 0;
+		bool _hasCarry = false;
+		size_t _consumed = 0;
+	};
+}//Utf
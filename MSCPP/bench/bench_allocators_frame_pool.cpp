@@ -0,0 +1,68 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_allocators_frame_pool.cpp
+/// @brief suite bench_allocators : C++143/CoroutineWithThreadPool.cpp 의 FramePool (size-class, 스레드별 캐시)
+///
+///   데모 .cpp 를 그대로 include 한다(unity build, C++20).
+///   BM_FramePool      : FramePool::allocate / deallocate (Arg = 요청 크기)
+///   BM_OperatorNew    : 같은 크기를 ::operator new / delete 로
+///   BM_FramePool_CrossThread : 생산 스레드가 할당, 소비 스레드가 해제 (코루틴 프레임의 전형적인 수명)
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++143/CoroutineWithThreadPool.cpp"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+    using TaskWithThreadPool::FramePool;
+
+    constexpr int Batch = 64;
+
+    void BM_FramePool(benchmark::State& state)
+    {
+        const size_t size = static_cast<size_t>(state.range(0));
+        void* blocks[Batch];
+
+        for (auto _ : state) {
+            for (int i = 0; i < Batch; ++i) blocks[i] = FramePool::allocate(size);
+            benchmark::DoNotOptimize(blocks);
+            for (int i = 0; i < Batch; ++i) FramePool::deallocate(blocks[i], size);
+        }
+        state.SetItemsProcessed(state.iterations() * Batch);
+    }
+    BENCHMARK(BM_FramePool)->RangeMultiplier(4)->Range(64, 4096)->ThreadRange(1, 4)->UseRealTime();
+
+    void BM_OperatorNew(benchmark::State& state)
+    {
+        const size_t size = static_cast<size_t>(state.range(0));
+        void* blocks[Batch];
+
+        for (auto _ : state) {
+            for (int i = 0; i < Batch; ++i) blocks[i] = ::operator new(size);
+            benchmark::DoNotOptimize(blocks);
+            for (int i = 0; i < Batch; ++i) ::operator delete(blocks[i]);
+        }
+        state.SetItemsProcessed(state.iterations() * Batch);
+    }
+    BENCHMARK(BM_OperatorNew)->RangeMultiplier(4)->Range(64, 4096)->ThreadRange(1, 4)->UseRealTime();
+
+    void BM_FramePool_CrossThread(benchmark::State& state)
+    {
+        constexpr size_t Size = 256;
+
+        LockFree::BlockingMpmcQueue<void*> handoff(1024);
+        std::thread consumer([&handoff] {
+            void* p = nullptr;
+            while (handoff.pop(p)) FramePool::deallocate(p, Size);
+        });
+
+        for (auto _ : state) {
+            for (int i = 0; i < Batch; ++i) handoff.push(FramePool::allocate(Size));
+        }
+
+        handoff.close();
+        consumer.join();
+        state.SetItemsProcessed(state.iterations() * Batch);
+    }
+    BENCHMARK(BM_FramePool_CrossThread)->UseRealTime();
+}
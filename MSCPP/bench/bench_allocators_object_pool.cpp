@@ -0,0 +1,143 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_allocators_object_pool.cpp
+/// @brief suite bench_allocators : C++14/Memory_add.cpp 의 ObjectPool (free list + mutex)
+///                                    vs Libs/object_pool.h 의 Pooling::ObjectPool (thread magazine + depot)
+///
+///   데모 .cpp 를 그대로 include 한다(unity build).
+///   BM_ObjectPool_Acquire   : Acquire -> unique_ptr 소멸(Release) 왕복
+///   BM_MagazinePool_Acquire : 같은 것을 Pooling::ObjectPool 로
+///   BM_MakeUnique_Event     : 같은 객체를 std::make_unique 로 (new/delete 기준)
+///   Batch 개를 잡고 있다가 한꺼번에 반환 => free list/힙이 비어 있는 상태만 재는 것을 피한다
+///
+///   BM_CrossThread<Pool>    : 스레드 2 개가 한 쌍 (짝수 = 생산자 Acquire, 홀수 = 소비자 Release)
+///                             SpscRing 으로 raw pointer 를 넘기고 소비자 쪽에서 PooledPtr 로 되살려 반환
+///                             => 할당한 스레드와 해제한 스레드가 항상 다르다
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++14/Memory_add.cpp"
+
+#include "ring_queue.h"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	using Memory_AddFeature::Event;
+	using EventPool = Memory_AddFeature::ObjectPool<Event>;
+	using MagazinePool = Pooling::ObjectPool<Event>;
+
+	const int Batch = 64;
+
+	void BM_ObjectPool_Acquire(benchmark::State& state)
+	{
+		static EventPool pool;      // ->Threads(n) 에서 모든 스레드가 같은 풀을 공유
+
+		std::vector<EventPool::PooledPtr> held;
+		held.reserve(Batch);
+
+		for (auto _ : state) {
+			for (int i = 0; i < Batch; ++i) held.push_back(pool.Acquire(i, i));
+			held.clear();
+		}
+		state.SetItemsProcessed(state.iterations() * Batch);
+	}
+	BENCHMARK(BM_ObjectPool_Acquire)->ThreadRange(1, 4)->UseRealTime();
+
+	void BM_MagazinePool_Acquire(benchmark::State& state)
+	{
+		static MagazinePool pool;
+
+		std::vector<MagazinePool::PooledPtr> held;
+		held.reserve(Batch);
+
+		for (auto _ : state) {
+			for (int i = 0; i < Batch; ++i) held.push_back(pool.Acquire(i, i));
+			held.clear();
+		}
+		state.SetItemsProcessed(state.iterations() * Batch);
+	}
+	BENCHMARK(BM_MagazinePool_Acquire)->ThreadRange(1, 4)->UseRealTime();
+
+	void BM_MakeUnique_Event(benchmark::State& state)
+	{
+		std::vector<std::unique_ptr<Event>> held;
+		held.reserve(Batch);
+
+		for (auto _ : state) {
+			for (int i = 0; i < Batch; ++i) held.push_back(std::make_unique<Event>(i, i));
+			held.clear();
+		}
+		state.SetItemsProcessed(state.iterations() * Batch);
+	}
+	BENCHMARK(BM_MakeUnique_Event)->ThreadRange(1, 4)->UseRealTime();
+
+	//---------------------------------------------------------------------------------------------
+	// 생산자/소비자 : 다른 스레드에서 해제
+	//---------------------------------------------------------------------------------------------
+	struct MutexPoolTraits
+	{
+		static EventPool& pool() { static EventPool p; return p; }
+		static Event* acquire(int i) { return pool().Acquire(i, i).release(); }
+		static void release(Event* e) { EventPool::PooledPtr(e, EventPool::PoolDeleter{ &pool() }); }
+	};
+
+	struct MagazinePoolTraits
+	{
+		static MagazinePool& pool() { static MagazinePool p; return p; }
+		static Event* acquire(int i) { return pool().Acquire(i, i).release(); }
+		static void release(Event* e) { MagazinePool::PooledPtr(e, MagazinePool::PoolDeleter{ &pool() }); }
+	};
+
+	struct NewDeleteTraits
+	{
+		static Event* acquire(int i) { return new Event(i, i); }
+		static void release(Event* e) { delete e; }
+	};
+
+	using EventRing = LockFree::SpscRing<Event*>;
+
+	// 스레드 0 이 측정 전에 쌍마다 ring 을 만들고 끝나면 지운다 (모든 스레드의 반복 수는 같다)
+	std::vector<std::unique_ptr<EventRing>>& cross_thread_rings()
+	{
+		static std::vector<std::unique_ptr<EventRing>> rings;
+		return rings;
+	}
+
+	template<typename Traits>
+	void BM_CrossThread(benchmark::State& state)
+	{
+		auto& rings = cross_thread_rings();
+		if (0 == state.thread_index()) {
+			rings.clear();
+			for (int i = 0; i < state.threads() / 2; ++i) rings.emplace_back(new EventRing(Batch * 4));
+		}
+
+		const bool producer = 0 == state.thread_index() % 2;
+		const int pair = state.thread_index() / 2;
+
+		for (auto _ : state) {
+			EventRing& ring = *rings[pair];
+			if (producer) {
+				for (int i = 0; i < Batch; ++i) {
+					Event* e = Traits::acquire(i);
+					while (!ring.try_push(e)) std::this_thread::yield();
+				}
+			}
+			else {
+				Event* e = nullptr;
+				for (int i = 0; i < Batch; ++i) {
+					while (!ring.try_pop(e)) std::this_thread::yield();
+					Traits::release(e);
+				}
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * Batch);
+
+		if (0 == state.thread_index()) {
+			rings.clear();
+		}
+	}
+	BENCHMARK_TEMPLATE(BM_CrossThread, MutexPoolTraits)->ThreadRange(2, 8)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_CrossThread, MagazinePoolTraits)->ThreadRange(2, 8)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_CrossThread, NewDeleteTraits)->ThreadRange(2, 8)->UseRealTime();
+}
@@ -0,0 +1,112 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_byte_order.cpp
+/// @brief suite bench_byte_order : C++/ByteOrder.cpp + Libs/byte_order.h 의 byte order 변환
+///
+///   데모 .cpp 를 그대로 include 한다(unity build).
+///
+///   BM_Swap<T, Kernel>   : uint16/32/64 배열 대량 swap (bytes/sec), 16 KB (L1) ~ 16 MB (메모리)
+///                          Scalar = 원소마다 byteswap (htonl 을 한 번씩 부르는 것과 같은 코드)
+///   BM_Writer_Record     : TradeRecord(36 byte) 를 BigEndianWriter 로 연속 직렬화
+///   BM_Reader_Record     : 같은 buffer 를 BigEndianReader 로 역직렬화
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++/ByteOrder.cpp"
+
+#include <numeric>
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	// 지원하지 않는 kernel 이면 건너뛰고, 끝나면 원래 kernel 로 돌려 놓는다
+	struct KernelScope
+	{
+		Endian::Kernel previous = Endian::active_kernel();
+		bool ok;
+
+		explicit KernelScope(Endian::Kernel k) : ok(Endian::set_kernel(k)) {}
+		~KernelScope() { Endian::set_kernel(previous); }
+	};
+
+	template<typename T, Endian::Kernel K>
+	void BM_Swap(benchmark::State& state)
+	{
+		KernelScope scope(K);
+		if (!scope.ok) {
+			state.SkipWithError("kernel not supported on this CPU");
+			return;
+		}
+
+		const size_t n = static_cast<size_t>(state.range(0)) / sizeof(T);
+		std::vector<T> in(n), out(n);
+		std::iota(in.begin(), in.end(), static_cast<T>(1));
+
+		for (auto _ : state) {
+			Endian::byteswap(in.data(), out.data(), n);
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(n * sizeof(T)));
+	}
+
+#define BYTE_ORDER_BENCH_KERNELS(T)                                                                     \
+	BENCHMARK_TEMPLATE(BM_Swap, T, Endian::Kernel::Scalar)->Range(16 << 10, 16 << 20);                  \
+	BENCHMARK_TEMPLATE(BM_Swap, T, Endian::Kernel::Ssse3)->Range(16 << 10, 16 << 20);                   \
+	BENCHMARK_TEMPLATE(BM_Swap, T, Endian::Kernel::Avx2)->Range(16 << 10, 16 << 20);                    \
+	BENCHMARK_TEMPLATE(BM_Swap, T, Endian::Kernel::Neon)->Range(16 << 10, 16 << 20);
+
+	BYTE_ORDER_BENCH_KERNELS(uint16_t)
+	BYTE_ORDER_BENCH_KERNELS(uint32_t)
+	BYTE_ORDER_BENCH_KERNELS(uint64_t)
+
+#undef BYTE_ORDER_BENCH_KERNELS
+
+	//------------------------------------------------------------------------------------------------
+	// record 직렬화 (1024 개 = 36 KB)
+	//------------------------------------------------------------------------------------------------
+	const size_t RecordCount = 1024;
+
+	ByteOrder::TradeRecord sample_record(size_t i)
+	{
+		ByteOrder::TradeRecord r = { 1, 0, 1000000 + i, static_cast<int32_t>(i * 7), static_cast<double>(i) / 4, "KRW/USD" };
+		return r;
+	}
+
+	void BM_Writer_Record(benchmark::State& state)
+	{
+		std::vector<ByteOrder::TradeRecord> records;
+		for (size_t i = 0; i < RecordCount; ++i) records.push_back(sample_record(i));
+		std::vector<uint8_t> wire(RecordCount * ByteOrder::TradeRecord::WireSize);
+
+		for (auto _ : state) {
+			for (size_t i = 0; i < RecordCount; ++i) {
+				records[i].serialize(&wire[i * ByteOrder::TradeRecord::WireSize], ByteOrder::TradeRecord::WireSize);
+			}
+			benchmark::DoNotOptimize(wire.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(RecordCount));
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(wire.size()));
+	}
+	BENCHMARK(BM_Writer_Record);
+
+	void BM_Reader_Record(benchmark::State& state)
+	{
+		std::vector<uint8_t> wire(RecordCount * ByteOrder::TradeRecord::WireSize);
+		for (size_t i = 0; i < RecordCount; ++i) {
+			sample_record(i).serialize(&wire[i * ByteOrder::TradeRecord::WireSize], ByteOrder::TradeRecord::WireSize);
+		}
+		std::vector<ByteOrder::TradeRecord> records(RecordCount);
+
+		for (auto _ : state) {
+			for (size_t i = 0; i < RecordCount; ++i) {
+				records[i].deserialize(&wire[i * ByteOrder::TradeRecord::WireSize], ByteOrder::TradeRecord::WireSize);
+			}
+			benchmark::DoNotOptimize(records.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(RecordCount));
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(wire.size()));
+	}
+	BENCHMARK(BM_Reader_Record);
+}
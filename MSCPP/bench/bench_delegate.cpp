@@ -0,0 +1,187 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_delegate.cpp
+/// @brief suite bench_delegate : Libs/delegate.h 의 Delegates::Delegate / function_ref 호출 비용
+///
+///   데모 .cpp 를 그대로 include 한다(unity build).
+///   대상 = Accumulator::add(int) 를 서로 다른 객체 Count 개에 묶은 콜백 배열을 한 바퀴 호출 (간접 호출이 inline 되지 않게)
+///
+///   BM_Invoke_Direct          : acc.add(x) 직접 호출 (기준)
+///   BM_Invoke_VirtualCallback : C++/CallbackAndDelegate.cpp 의 DelegateAbstractInterfaceStyle::Delegate (new MethodCallback + virtual invoke)
+///   BM_Invoke_StdFunction     : std::function<int(int)> 에 [acc] 람다
+///   BM_Invoke_Delegate        : Delegates::Delegate<int(int)> 에 같은 람다 (내장 버퍼)
+///   BM_Invoke_DelegateBind    : DELEGATE_BIND(&Accumulator::add, acc) => stub 안에서 add 직접 호출
+///   BM_Invoke_FunctionRef     : function_ref<int(int)> 로 람다 참조
+///
+///   BM_Construct_*            : 24 B 캡처 람다로 콜백 Count 개 생성/소멸 (std::function 은 16 B 초과 => heap)
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++/CallbackAndDelegate.cpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	struct Accumulator
+	{
+		int64_t sum = 0;
+
+		int add(int x)
+		{
+			sum += x;
+			return x;
+		}
+	};
+
+	const int Count = 64;
+
+	using VirtualDelegate = CallbackAndDelegate::DelegateAbstractInterfaceStyle::Delegate<int, int>;
+
+	//---------------------------------------------------------------------------------------------
+	// 호출
+	//---------------------------------------------------------------------------------------------
+	void BM_Invoke_Direct(benchmark::State& state)
+	{
+		std::vector<Accumulator> accs(Count);
+
+		for (auto _ : state) {
+			for (int i = 0; i < Count; ++i) benchmark::DoNotOptimize(accs[i].add(i));
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Invoke_Direct);
+
+	void BM_Invoke_VirtualCallback(benchmark::State& state)
+	{
+		std::vector<Accumulator> accs(Count);
+		std::vector<std::unique_ptr<VirtualDelegate>> callbacks;     // 복사하면 Callback 을 두 번 delete 하므로 pointer 로 보관
+		for (auto& acc : accs) callbacks.emplace_back(new VirtualDelegate(&acc, &Accumulator::add));
+
+		for (auto _ : state) {
+			for (int i = 0; i < Count; ++i) benchmark::DoNotOptimize((*callbacks[i])(i));
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Invoke_VirtualCallback);
+
+	void BM_Invoke_StdFunction(benchmark::State& state)
+	{
+		std::vector<Accumulator> accs(Count);
+		std::vector<std::function<int(int)>> callbacks;
+		for (auto& acc : accs) callbacks.emplace_back([a = &acc](int x) { return a->add(x); });
+
+		for (auto _ : state) {
+			for (int i = 0; i < Count; ++i) benchmark::DoNotOptimize(callbacks[i](i));
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Invoke_StdFunction);
+
+	void BM_Invoke_Delegate(benchmark::State& state)
+	{
+		std::vector<Accumulator> accs(Count);
+		std::vector<Delegates::Delegate<int(int)>> callbacks;
+		for (auto& acc : accs) callbacks.emplace_back([a = &acc](int x) { return a->add(x); });
+
+		for (auto _ : state) {
+			for (int i = 0; i < Count; ++i) benchmark::DoNotOptimize(callbacks[i](i));
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Invoke_Delegate);
+
+	void BM_Invoke_DelegateBind(benchmark::State& state)
+	{
+		std::vector<Accumulator> accs(Count);
+		std::vector<Delegates::Delegate<int(int)>> callbacks;
+		for (auto& acc : accs) callbacks.push_back(DELEGATE_BIND(&Accumulator::add, &acc));
+
+		for (auto _ : state) {
+			for (int i = 0; i < Count; ++i) benchmark::DoNotOptimize(callbacks[i](i));
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Invoke_DelegateBind);
+
+	void BM_Invoke_FunctionRef(benchmark::State& state)
+	{
+		struct AddTo
+		{
+			Accumulator* a;
+			int operator()(int x) const { return a->add(x); }
+		};
+
+		std::vector<Accumulator> accs(Count);
+		std::vector<AddTo> targets;
+		for (auto& acc : accs) targets.push_back(AddTo{ &acc });
+		std::vector<Delegates::function_ref<int(int)>> callbacks(targets.begin(), targets.end());
+
+		for (auto _ : state) {
+			for (int i = 0; i < Count; ++i) benchmark::DoNotOptimize(callbacks[i](i));
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Invoke_FunctionRef);
+
+	//---------------------------------------------------------------------------------------------
+	// 생성/소멸 : [acc, scale, bias] (24 B) 캡처
+	//---------------------------------------------------------------------------------------------
+	template<typename Callbacks>
+	void construct_callbacks(Callbacks& callbacks, std::vector<Accumulator>& accs)
+	{
+		for (int i = 0; i < Count; ++i) {
+			Accumulator* a = &accs[i];
+			const int64_t scale = i, bias = -i;
+			callbacks.emplace_back([a, scale, bias](int x) { return a->add(static_cast<int>(x * scale + bias)); });
+		}
+	}
+
+	void BM_Construct_VirtualCallback(benchmark::State& state)
+	{
+		std::vector<Accumulator> accs(Count);
+		std::vector<std::unique_ptr<VirtualDelegate>> callbacks;
+		callbacks.reserve(Count);
+
+		for (auto _ : state) {
+			for (auto& acc : accs) callbacks.emplace_back(new VirtualDelegate(&acc, &Accumulator::add));
+			benchmark::DoNotOptimize(callbacks.data());
+			callbacks.clear();
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Construct_VirtualCallback);
+
+	void BM_Construct_StdFunction(benchmark::State& state)
+	{
+		std::vector<Accumulator> accs(Count);
+		std::vector<std::function<int(int)>> callbacks;
+		callbacks.reserve(Count);
+
+		for (auto _ : state) {
+			construct_callbacks(callbacks, accs);
+			benchmark::DoNotOptimize(callbacks.data());
+			callbacks.clear();
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Construct_StdFunction);
+
+	void BM_Construct_Delegate(benchmark::State& state)
+	{
+		std::vector<Accumulator> accs(Count);
+		std::vector<Delegates::Delegate<int(int)>> callbacks;
+		callbacks.reserve(Count);
+
+		for (auto _ : state) {
+			construct_callbacks(callbacks, accs);
+			benchmark::DoNotOptimize(callbacks.data());
+			callbacks.clear();
+		}
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(BM_Construct_Delegate);
+}
@@ -0,0 +1,284 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_enum_reflect.cpp
+/// @brief suite bench_enum_reflect : C++/EnumToString.h 매크로 변환 vs Libs/enum_reflect.h 컴파일 시간 완전 해시 표
+///
+///   같은 ENUM_BEGIN/ENUM/ENUM_END 목록(Colors.h 방식)을 EnumToString.h / EnumReflect.h 로 각각 펼친다.
+///   enum 크기 16 / 512 (이름 = 접두사 + 2 진수, 길이 같음 => strcmp 가 접두사만큼 돈다)
+///
+///   BM_FromString<Traits>      : 모든 이름을 섞은 순서로 변환 (Macro = strcmp 선형 탐색, Reflect = hash 1 번 + 비교 1 번,
+///                                UnorderedMap = std::unordered_map<std::string, E> 런타임 표)
+///   BM_FromStringMiss<Traits>  : 없는 이름 (Macro 는 끝까지 돈다)
+///   BM_ToString<Traits>        : 값 => 이름 (Macro = 배열 index, Reflect dense = 범위 검사 + index)
+///   BM_ToString_Sparse         : 값이 띄엄띄엄인 512 개 enum (값 hash 표)
+///   BM_FlagsToString / BM_FlagsFromString : 16 bit flag enum, 무작위 mask <=> "A|C|..."
+///////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+// 2^k 개 이름 : p##0..., p##1... (ENUM 은 펼치는 시점의 정의를 쓴다)
+#define BENCH_ENUM_2(p)   ENUM(p##0), ENUM(p##1)
+#define BENCH_ENUM_4(p)   BENCH_ENUM_2(p##0), BENCH_ENUM_2(p##1)
+#define BENCH_ENUM_8(p)   BENCH_ENUM_4(p##0), BENCH_ENUM_4(p##1)
+#define BENCH_ENUM_16(p)  BENCH_ENUM_8(p##0), BENCH_ENUM_8(p##1)
+#define BENCH_ENUM_32(p)  BENCH_ENUM_16(p##0), BENCH_ENUM_16(p##1)
+#define BENCH_ENUM_64(p)  BENCH_ENUM_32(p##0), BENCH_ENUM_32(p##1)
+#define BENCH_ENUM_128(p) BENCH_ENUM_64(p##0), BENCH_ENUM_64(p##1)
+#define BENCH_ENUM_256(p) BENCH_ENUM_128(p##0), BENCH_ENUM_128(p##1)
+#define BENCH_ENUM_512(p) BENCH_ENUM_256(p##0), BENCH_ENUM_256(p##1)
+
+#define BENCH_ENUM(typ, count) ENUM_BEGIN(typ) BENCH_ENUM_##count(typ##_) ENUM_END(typ)
+
+// 1 : enum 선언
+#include "../C++/EnumMacro.h"
+BENCH_ENUM(Macro16, 16)
+BENCH_ENUM(Macro512, 512)
+BENCH_ENUM(Reflect16, 16)
+BENCH_ENUM(Reflect512, 512)
+
+// 2 : 이름 배열 + strcmp
+#include "../C++/EnumToString.h"
+BENCH_ENUM(Macro16, 16)
+BENCH_ENUM(Macro512, 512)
+
+// 3 : 완전 해시 표
+#include "../C++/EnumReflect.h"
+BENCH_ENUM(Reflect16, 16)
+BENCH_ENUM(Reflect512, 512)
+
+// 값이 띄엄띄엄인 512 개 : Reflect512 이름 + 값 i * 7919 + 13
+enum class SparseValue : int64_t {};
+
+struct SparseEntries
+{
+	EnumReflect::Entry<SparseValue> entries[512];
+};
+
+constexpr SparseEntries make_sparse_entries()
+{
+	SparseEntries s = {};
+	for (size_t i = 0; i < 512; ++i)
+		s.entries[i] = { Reflect512_Entries[i].name, static_cast<SparseValue>(static_cast<int64_t>(i) * 7919 + 13) };
+	return s;
+}
+
+inline constexpr SparseEntries SparseValue_Source = make_sparse_entries();
+ENUM_REFLECT_TABLE(SparseValue, SparseValue_Source.entries)
+
+// 16 bit flag
+enum class Flag16 : uint32_t {};
+
+struct FlagEntries
+{
+	EnumReflect::Entry<Flag16> entries[16];
+};
+
+constexpr FlagEntries make_flag_entries()
+{
+	FlagEntries f = {};
+	for (size_t i = 0; i < 16; ++i)
+		f.entries[i] = { Reflect16_Entries[i].name, static_cast<Flag16>(1u << i) };
+	return f;
+}
+
+inline constexpr FlagEntries Flag16_Source = make_flag_entries();
+ENUM_REFLECT_TABLE(Flag16, Flag16_Source.entries)
+
+
+namespace
+{
+	const size_t Batch = 1024;
+
+	template<typename E, size_t N>
+	struct MacroTraits
+	{
+		using Enum = E;
+		static const size_t Count = N;
+	};
+
+	struct Macro16Traits : MacroTraits<Macro16, 16>
+	{
+		static const char* to_string(Macro16 v) { return Macro16_ToString(v); }
+		static bool from_string(const std::string& s, Macro16& out) { return Macro16_FromString(s.c_str(), out); }
+	};
+
+	struct Macro512Traits : MacroTraits<Macro512, 512>
+	{
+		static const char* to_string(Macro512 v) { return Macro512_ToString(v); }
+		static bool from_string(const std::string& s, Macro512& out) { return Macro512_FromString(s.c_str(), out); }
+	};
+
+	struct Reflect16Traits : MacroTraits<Reflect16, 16>
+	{
+		static std::string_view to_string(Reflect16 v) { return Reflect16_ToString(v); }
+		static bool from_string(const std::string& s, Reflect16& out) { return Reflect16_FromString(s, out); }
+	};
+
+	struct Reflect512Traits : MacroTraits<Reflect512, 512>
+	{
+		static std::string_view to_string(Reflect512 v) { return Reflect512_ToString(v); }
+		static bool from_string(const std::string& s, Reflect512& out) { return Reflect512_FromString(s, out); }
+	};
+
+	struct UnorderedMap512Traits : MacroTraits<Reflect512, 512>
+	{
+		static std::string_view to_string(Reflect512 v) { return Reflect512_ToString(v); }
+
+		static bool from_string(const std::string& s, Reflect512& out)
+		{
+			static const std::unordered_map<std::string, Reflect512> map = [] {
+				std::unordered_map<std::string, Reflect512> m;
+				for (const auto& e : Reflect512_Entries) m.emplace(std::string(e.name), e.value);
+				return m;
+			}();
+
+			const auto it = map.find(s);
+			if (it == map.end()) return false;
+			out = it->second;
+			return true;
+		}
+	};
+
+	// 0 ~ Count-1 을 섞어 Batch 개
+	template<typename Traits>
+	std::vector<typename Traits::Enum> shuffled_values()
+	{
+		std::mt19937 rng(42);
+		std::vector<typename Traits::Enum> values(Batch);
+		for (size_t i = 0; i < Batch; ++i)
+			values[i] = static_cast<typename Traits::Enum>(i % Traits::Count);
+		std::shuffle(values.begin(), values.end(), rng);
+		return values;
+	}
+
+	template<typename Traits>
+	std::vector<std::string> shuffled_names()
+	{
+		std::vector<std::string> names;
+		for (auto v : shuffled_values<Traits>())
+			names.emplace_back(Traits::to_string(v));
+		return names;
+	}
+
+	//=============================================================================================
+	template<typename Traits>
+	void BM_FromString(benchmark::State& state)
+	{
+		const std::vector<std::string> names = shuffled_names<Traits>();
+		for (auto _ : state) {
+			for (const std::string& name : names) {
+				typename Traits::Enum value;
+				bool found = Traits::from_string(name, value);
+				benchmark::DoNotOptimize(found);
+				benchmark::DoNotOptimize(value);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * names.size());
+	}
+	BENCHMARK_TEMPLATE(BM_FromString, Macro16Traits);
+	BENCHMARK_TEMPLATE(BM_FromString, Reflect16Traits);
+	BENCHMARK_TEMPLATE(BM_FromString, Macro512Traits);
+	BENCHMARK_TEMPLATE(BM_FromString, Reflect512Traits);
+	BENCHMARK_TEMPLATE(BM_FromString, UnorderedMap512Traits);
+
+	template<typename Traits>
+	void BM_FromStringMiss(benchmark::State& state)
+	{
+		// 있는 이름의 마지막 글자만 바꾼다 (접두사가 같아 strcmp 가 끝까지 비교)
+		std::vector<std::string> names = shuffled_names<Traits>();
+		for (std::string& name : names) name.back() = 'x';
+
+		for (auto _ : state) {
+			for (const std::string& name : names) {
+				typename Traits::Enum value;
+				bool found = Traits::from_string(name, value);
+				benchmark::DoNotOptimize(found);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * names.size());
+	}
+	BENCHMARK_TEMPLATE(BM_FromStringMiss, Macro512Traits);
+	BENCHMARK_TEMPLATE(BM_FromStringMiss, Reflect512Traits);
+	BENCHMARK_TEMPLATE(BM_FromStringMiss, UnorderedMap512Traits);
+
+	template<typename Traits>
+	void BM_ToString(benchmark::State& state)
+	{
+		const auto values = shuffled_values<Traits>();
+		for (auto _ : state) {
+			for (auto v : values) {
+				auto name = Traits::to_string(v);
+				benchmark::DoNotOptimize(name);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * values.size());
+	}
+	BENCHMARK_TEMPLATE(BM_ToString, Macro512Traits);
+	BENCHMARK_TEMPLATE(BM_ToString, Reflect512Traits);
+
+	void BM_ToString_Sparse(benchmark::State& state)
+	{
+		std::vector<SparseValue> values;
+		for (auto v : shuffled_values<Reflect512Traits>())
+			values.push_back(SparseValue_Source.entries[static_cast<size_t>(v)].value);
+
+		for (auto _ : state) {
+			for (auto v : values) {
+				std::string_view name = EnumReflect::to_string(v);
+				benchmark::DoNotOptimize(name);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * values.size());
+	}
+	BENCHMARK(BM_ToString_Sparse);
+
+	//---------------------------------------------------------------------------------------------
+	std::vector<Flag16> random_masks()
+	{
+		std::mt19937 rng(7);
+		std::vector<Flag16> masks(Batch);
+		for (Flag16& m : masks) m = static_cast<Flag16>(rng() & 0xFFFF);
+		return masks;
+	}
+
+	void BM_FlagsToString(benchmark::State& state)
+	{
+		const std::vector<Flag16> masks = random_masks();
+		std::string text;
+		for (auto _ : state) {
+			for (Flag16 m : masks) {
+				EnumReflect::flags_to_string(m, text);
+				benchmark::DoNotOptimize(text.data());
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * masks.size());
+	}
+	BENCHMARK(BM_FlagsToString);
+
+	void BM_FlagsFromString(benchmark::State& state)
+	{
+		std::vector<std::string> texts;
+		for (Flag16 m : random_masks()) {
+			texts.emplace_back();
+			EnumReflect::flags_to_string(m, texts.back());
+		}
+
+		for (auto _ : state) {
+			for (const std::string& text : texts) {
+				Flag16 m{};
+				bool ok = EnumReflect::flags_from_string(text, m);
+				benchmark::DoNotOptimize(ok);
+				benchmark::DoNotOptimize(m);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * texts.size());
+	}
+	BENCHMARK(BM_FlagsFromString);
+}
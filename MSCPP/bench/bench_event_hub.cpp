@@ -0,0 +1,243 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_event_hub.cpp
+/// @brief suite bench_event_hub : Libs/event_hub.h 의 Events::EventHub vs C++142/Memory_add.cpp 의 CallbackHub 패턴
+///
+///   Arg 0 = 구독자 수 (1k / 10k), 처리량 = 콜백 호출 수/초
+///
+///   BM_Fire_CallbackHubWeak  : vector<std::function<void()>> + [weak] { if (auto s = weak.lock()) ... } (CallbackHub 그대로)
+///   BM_Fire_EventHub         : EventHub<int> 에 일반 콜백 (Delegate, weak 없음)
+///   BM_Fire_EventHubWeak     : EventHub<int>::subscribe(shared_ptr, &T::Method) (호출마다 lock, 만료 시 일괄 제거)
+///   BM_Fire_EventHubScoped   : subscribe_scoped (객체가 ScopedSubscription 을 들고, 파괴 시 grace period 대기) => fire 에 lock 없음
+///   BM_Fire_EventHubParallel : fire_parallel 로 CustomThreadPool(C++11/AsyncAndFuture.cpp) 에 1024 개씩 분산
+///
+///   BM_Fire_Shared<Hub>      : 여러 스레드가 같은 허브에 fire, 스레드 0 은 매 반복 구독 1 개 추가/제거 (churn)
+///     MutexHub = CallbackHub + std::mutex (thread-safe 로 만든 가장 단순한 형태)
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++11/AsyncAndFuture.cpp"
+
+#include "event_hub.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	struct Listener : std::enable_shared_from_this<Listener>
+	{
+		int id = 0;
+
+		void OnEvent(int value) { benchmark::DoNotOptimize(value + id); }
+	};
+
+	std::vector<std::shared_ptr<Listener>> make_listeners(size_t count)
+	{
+		std::vector<std::shared_ptr<Listener>> listeners(count);
+		for (size_t i = 0; i < count; ++i) {
+			listeners[i] = std::make_shared<Listener>();
+			listeners[i]->id = static_cast<int>(i);
+		}
+		return listeners;
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 기준 : C++142/Memory_add.cpp 의 CallbackHub (+ 여러 스레드용 mutex)
+	//---------------------------------------------------------------------------------------------
+	class MutexHub
+	{
+	public:
+		using Callback = std::function<void(int)>;
+
+		void RegisterCallback(Callback cb)
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_callbacks.push_back(std::move(cb));
+		}
+
+		void UnregisterLast()
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_callbacks.pop_back();
+		}
+
+		void FireAll(int value)
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			for (auto& cb : _callbacks) cb(value);
+		}
+
+	private:
+		std::mutex _lock;
+		std::vector<Callback> _callbacks;
+	};
+
+	auto weak_listener_callback(const std::shared_ptr<Listener>& listener)
+	{
+		std::weak_ptr<Listener> weak = listener;
+		return [weak](int value) {
+			if (auto self = weak.lock()) self->OnEvent(value);
+		};
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 한 스레드에서 fire
+	//---------------------------------------------------------------------------------------------
+	void BM_Fire_CallbackHubWeak(benchmark::State& state)
+	{
+		auto listeners = make_listeners(static_cast<size_t>(state.range(0)));
+		std::vector<std::function<void(int)>> callbacks;
+		for (auto& listener : listeners) {
+			std::weak_ptr<Listener> weak = listener;
+			callbacks.emplace_back([weak](int value) {
+				if (auto self = weak.lock()) self->OnEvent(value);
+			});
+		}
+
+		int value = 0;
+		for (auto _ : state) {
+			++value;
+			for (auto& cb : callbacks) cb(value);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Fire_CallbackHubWeak)->Arg(1000)->Arg(10000);
+
+	void BM_Fire_EventHub(benchmark::State& state)
+	{
+		auto listeners = make_listeners(static_cast<size_t>(state.range(0)));
+		Events::EventHub<int> hub;
+		for (auto& listener : listeners) {
+			Listener* p = listener.get();
+			hub.subscribe([p](int value) { p->OnEvent(value); });
+		}
+
+		int value = 0;
+		for (auto _ : state) hub.fire(++value);
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Fire_EventHub)->Arg(1000)->Arg(10000);
+
+	void BM_Fire_EventHubWeak(benchmark::State& state)
+	{
+		auto listeners = make_listeners(static_cast<size_t>(state.range(0)));
+		Events::EventHub<int> hub;
+		for (auto& listener : listeners) hub.subscribe(listener, &Listener::OnEvent);
+
+		int value = 0;
+		for (auto _ : state) hub.fire(++value);
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Fire_EventHubWeak)->Arg(1000)->Arg(10000);
+
+	struct ScopedListener
+	{
+		Listener listener;
+		Events::ScopedSubscription subscription;      // 마지막 멤버 => 먼저 구독 해제
+
+		explicit ScopedListener(Events::EventHub<int>& hub, int id)
+		{
+			listener.id = id;
+			Listener* p = &listener;
+			subscription = hub.subscribe_scoped([p](int value) { p->OnEvent(value); });
+		}
+	};
+
+	void BM_Fire_EventHubScoped(benchmark::State& state)
+	{
+		Events::EventHub<int> hub;
+		std::vector<std::unique_ptr<ScopedListener>> listeners;
+		for (int i = 0; i < state.range(0); ++i) listeners.emplace_back(new ScopedListener(hub, i));
+
+		int value = 0;
+		for (auto _ : state) hub.fire(++value);
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+
+		listeners.clear();
+	}
+	BENCHMARK(BM_Fire_EventHubScoped)->Arg(1000)->Arg(10000);
+
+	void BM_Fire_EventHubParallel(benchmark::State& state)
+	{
+		auto listeners = make_listeners(static_cast<size_t>(state.range(0)));
+		Events::EventHub<int> hub;
+		for (auto& listener : listeners) {
+			Listener* p = listener.get();
+			hub.subscribe([p](int value) { p->OnEvent(value); });
+		}
+		AsyncAndFuture::CustomThreadPool pool((std::max)(2u, std::thread::hardware_concurrency()));
+
+		int value = 0;
+		for (auto _ : state) hub.fire_parallel(pool, ++value);
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Fire_EventHubParallel)->Arg(1000)->Arg(10000)->UseRealTime();
+
+	//---------------------------------------------------------------------------------------------
+	// 여러 스레드가 같은 허브에 fire + 스레드 0 의 구독 churn
+	//   허브는 함수 static 으로 공유하고 스레드 0 이 측정 전후로 만들고 비운다
+	//---------------------------------------------------------------------------------------------
+	struct MutexHubTraits
+	{
+		using Hub = MutexHub;
+
+		static void subscribe(Hub& hub, const std::shared_ptr<Listener>& listener) { hub.RegisterCallback(weak_listener_callback(listener)); }
+		static void churn(Hub& hub, const std::shared_ptr<Listener>& listener)
+		{
+			hub.RegisterCallback(weak_listener_callback(listener));
+			hub.UnregisterLast();
+		}
+		static void fire(Hub& hub, int value) { hub.FireAll(value); }
+	};
+
+	struct EventHubTraits
+	{
+		using Hub = Events::EventHub<int>;
+
+		static void subscribe(Hub& hub, const std::shared_ptr<Listener>& listener) { hub.subscribe(listener, &Listener::OnEvent); }
+		static void churn(Hub& hub, const std::shared_ptr<Listener>& listener) { hub.unsubscribe(hub.subscribe(listener, &Listener::OnEvent)); }
+		static void fire(Hub& hub, int value) { hub.fire(value); }
+	};
+
+	template<typename Traits>
+	struct SharedHub
+	{
+		std::vector<std::shared_ptr<Listener>> listeners;
+		typename Traits::Hub hub;
+
+		static std::unique_ptr<SharedHub>& instance()
+		{
+			static std::unique_ptr<SharedHub> s;
+			return s;
+		}
+	};
+
+	template<typename Traits>
+	void BM_Fire_Shared(benchmark::State& state)
+	{
+		auto& shared = SharedHub<Traits>::instance();
+		if (0 == state.thread_index()) {
+			shared.reset(new SharedHub<Traits>());
+			shared->listeners = make_listeners(static_cast<size_t>(state.range(0)));
+			for (auto& listener : shared->listeners) Traits::subscribe(shared->hub, listener);
+		}
+
+		const bool churn = 0 == state.thread_index() && state.threads() > 1;
+		int value = 0;
+		for (auto _ : state) {
+			if (churn) Traits::churn(shared->hub, shared->listeners[0]);
+			Traits::fire(shared->hub, ++value);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+
+		if (0 == state.thread_index()) {
+			shared.reset();
+		}
+	}
+	BENCHMARK_TEMPLATE(BM_Fire_Shared, MutexHubTraits)->Arg(10000)->ThreadRange(1, 4)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_Fire_Shared, EventHubTraits)->Arg(10000)->ThreadRange(1, 4)->UseRealTime();
+}
@@ -0,0 +1,160 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_generator.cpp
+/// @brief suite bench_generator : Libs/generator.h 의 Coro::Generator<T> 로 트리 전위 순회
+///
+///   트리 = 완전 이진 트리 (노드 2^depth - 1 개), Arg 0 = depth
+///
+///   BM_Preorder_Recursive       : 재귀 함수 (C++/RecursiveToNonRecurcive.cpp 의 preorder_traverse_recursive)
+///   BM_Preorder_ExplicitStack   : 명시적 stack (같은 파일의 preorder_traverse_non_recursive : right, left 순으로 push)
+///                                 원본은 전역 stack[100] + printf 라 알고리즘만 옮겨 왔다.
+///   BM_Preorder_GeneratorLoop   : Generator 안에서 "for (n : preorder(child)) co_yield n;" => 원소당 O(depth) resume
+///   BM_Preorder_GeneratorNested : co_yield elements_of(preorder(child)) => leaf 를 직접 resume, 원소당 O(1)
+///   BM_Preorder_GeneratorArena  : GeneratorNested + coroutine frame 을 std::pmr::unsynchronized_pool_resource 에서 (allocator_arg)
+///////////////////////////////////////////////////////////////////////////////
+#include "generator.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	struct node
+	{
+		int key;
+		node* left;
+		node* right;
+	};
+
+	std::vector<node> make_tree(int depth)
+	{
+		const size_t count = (size_t(1) << depth) - 1;
+		std::vector<node> nodes(count);
+		for (size_t i = 0; i < count; ++i) {
+			nodes[i].key = static_cast<int>(i);
+			nodes[i].left = 2 * i + 1 < count ? &nodes[2 * i + 1] : nullptr;
+			nodes[i].right = 2 * i + 2 < count ? &nodes[2 * i + 2] : nullptr;
+		}
+		return nodes;
+	}
+
+	void preorder_recursive(const node* t, int64_t& sum)
+	{
+		if (nullptr == t) return;
+		sum += t->key;
+		preorder_recursive(t->left, sum);
+		preorder_recursive(t->right, sum);
+	}
+
+	int64_t preorder_explicit_stack(const node* t, std::vector<const node*>& stack)
+	{
+		int64_t sum = 0;
+		stack.clear();
+		stack.push_back(t);
+		while (!stack.empty()) {
+			t = stack.back();
+			stack.pop_back();
+			if (nullptr != t) {
+				sum += t->key;
+				stack.push_back(t->right);
+				stack.push_back(t->left);
+			}
+		}
+		return sum;
+	}
+
+	Coro::Generator<const node&> preorder_loop(const node* t)
+	{
+		if (nullptr == t) co_return;
+		co_yield *t;
+		for (const node& n : preorder_loop(t->left)) co_yield n;
+		for (const node& n : preorder_loop(t->right)) co_yield n;
+	}
+
+	Coro::Generator<const node&> preorder_nested(const node* t)
+	{
+		if (nullptr == t) co_return;
+		co_yield *t;
+		co_yield Coro::elements_of(preorder_nested(t->left));
+		co_yield Coro::elements_of(preorder_nested(t->right));
+	}
+
+	using Arena = std::pmr::polymorphic_allocator<std::byte>;
+
+	Coro::Generator<const node&> preorder_arena(std::allocator_arg_t, Arena arena, const node* t)
+	{
+		if (nullptr == t) co_return;
+		co_yield *t;
+		co_yield Coro::elements_of(preorder_arena(std::allocator_arg, arena, t->left));
+		co_yield Coro::elements_of(preorder_arena(std::allocator_arg, arena, t->right));
+	}
+
+	template<typename Traverse>
+	void run(benchmark::State& state, Traverse traverse)
+	{
+		const std::vector<node> tree = make_tree(static_cast<int>(state.range(0)));
+		const int64_t expected = static_cast<int64_t>(tree.size()) * static_cast<int64_t>(tree.size() - 1) / 2;
+
+		for (auto _ : state) {
+			const int64_t sum = traverse(&tree[0]);
+			if (sum != expected) {
+				state.SkipWithError("wrong traversal");
+				return;
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tree.size()));
+	}
+
+	void BM_Preorder_Recursive(benchmark::State& state)
+	{
+		run(state, [](const node* root) {
+			int64_t sum = 0;
+			preorder_recursive(root, sum);
+			return sum;
+		});
+	}
+	BENCHMARK(BM_Preorder_Recursive)->DenseRange(8, 20, 4);
+
+	void BM_Preorder_ExplicitStack(benchmark::State& state)
+	{
+		std::vector<const node*> stack;
+		run(state, [&](const node* root) { return preorder_explicit_stack(root, stack); });
+	}
+	BENCHMARK(BM_Preorder_ExplicitStack)->DenseRange(8, 20, 4);
+
+	void BM_Preorder_GeneratorLoop(benchmark::State& state)
+	{
+		run(state, [](const node* root) {
+			int64_t sum = 0;
+			for (const node& n : preorder_loop(root)) sum += n.key;
+			return sum;
+		});
+	}
+	BENCHMARK(BM_Preorder_GeneratorLoop)->DenseRange(8, 20, 4);
+
+	void BM_Preorder_GeneratorNested(benchmark::State& state)
+	{
+		run(state, [](const node* root) {
+			int64_t sum = 0;
+			for (const node& n : preorder_nested(root)) sum += n.key;
+			return sum;
+		});
+	}
+	BENCHMARK(BM_Preorder_GeneratorNested)->DenseRange(8, 20, 4);
+
+	void BM_Preorder_GeneratorArena(benchmark::State& state)
+	{
+		// frame 크기가 모두 같아 해제된 frame 이 pool 에서 바로 재사용된다
+		std::pmr::unsynchronized_pool_resource arena;
+		run(state, [&](const node* root) {
+			int64_t sum = 0;
+			for (const node& n : preorder_arena(std::allocator_arg, &arena, root)) sum += n.key;
+			return sum;
+		});
+	}
+	BENCHMARK(BM_Preorder_GeneratorArena)->DenseRange(8, 20, 4);
+}
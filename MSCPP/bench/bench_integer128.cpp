@@ -0,0 +1,235 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_integer128.cpp
+/// @brief suite bench_integer128 : C++/Integer128.cpp + Libs/int128.h 의 128-bit 연산 처리량
+///
+///   데모 .cpp 를 그대로 include 한다(unity build).
+///   비교 대상 Naive = uint64_t 두 개로 직접 짠 흔한 구현
+///     mul : 32-bit 조각 schoolbook, div : bit 마다 shift-subtract (128 회), 문자열 : 자리마다 %10 / 10
+///
+///   BM_Mul_<Wide|Naive>       : 128 x 128 -> 128 (1024 개 배열)
+///   BM_Div64_<Wide|Naive>     : 128 / 64-bit 제수 (고정 소수점 환산에서 흔한 경우)
+///   BM_Div128_<Wide|Naive>    : 128 / 128-bit 제수
+///   BM_Format_<Wide|Naive>    : 10 진수 문자열 (값 크기 = 2^range 근처), Wide 는 10^19 조각
+///   BM_Parse_Wide             : from_chars (39 자리 근처)
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++/Integer128.cpp"
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	//------------------------------------------------------------------------------------------------
+	// Naive : 특별한 것 없이 uint64_t 두 개로
+	//------------------------------------------------------------------------------------------------
+	struct Naive
+	{
+		uint64_t lo;
+		uint64_t hi;
+	};
+
+	Naive naive_mul(Naive a, Naive b)
+	{
+		const uint64_t a0 = a.lo & 0xFFFFFFFFu, a1 = a.lo >> 32;
+		const uint64_t b0 = b.lo & 0xFFFFFFFFu, b1 = b.lo >> 32;
+		const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+		const uint64_t middle = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+		Naive r;
+		r.lo = (middle << 32) | (p00 & 0xFFFFFFFFu);
+		r.hi = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32) + a.lo * b.hi + a.hi * b.lo;
+		return r;
+	}
+
+	bool naive_less(Naive a, Naive b) { return a.hi != b.hi ? a.hi < b.hi : a.lo < b.lo; }
+
+	// 몫의 bit 하나씩 (128 회)
+	Naive naive_divmod(Naive u, Naive v, Naive& rem)
+	{
+		Naive q = { 0, 0 };
+		Naive r = { 0, 0 };
+		for (int i = 127; i >= 0; --i) {
+			r.hi = (r.hi << 1) | (r.lo >> 63);
+			r.lo = (r.lo << 1) | ((i >= 64 ? u.hi >> (i - 64) : u.lo >> i) & 1);
+			if (!naive_less(r, v)) {
+				r.hi = r.hi - v.hi - (r.lo < v.lo ? 1 : 0);
+				r.lo -= v.lo;
+				if (i >= 64) q.hi |= 1ull << (i - 64);
+				else q.lo |= 1ull << i;
+			}
+		}
+		rem = r;
+		return q;
+	}
+
+	size_t naive_to_chars(char* buf, Naive v)
+	{
+		char tmp[40];
+		char* p = tmp + sizeof(tmp);
+		const Naive ten = { 10, 0 };
+		do {
+			Naive r;
+			v = naive_divmod(v, ten, r);
+			*--p = static_cast<char>('0' + r.lo);
+		} while (0 != (v.lo | v.hi));
+		const size_t n = static_cast<size_t>(tmp + sizeof(tmp) - p);
+		memcpy(buf, p, n);
+		return n;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// 입력 (bits = 값의 대략적인 크기)
+	//------------------------------------------------------------------------------------------------
+	const size_t Count = 1024;
+
+	std::vector<Wide::uint128> random_values(int bits, uint64_t seed)
+	{
+		std::mt19937_64 rng(seed);
+		std::vector<Wide::uint128> values;
+		for (size_t i = 0; i < Count; ++i) {
+			const Wide::uint128 v = Wide::uint128::make(rng(), rng()) >> (128 - bits);
+			values.push_back(v ? v : Wide::uint128(1));
+		}
+		return values;
+	}
+
+	Naive to_naive(Wide::uint128 v)
+	{
+		const Naive n = { v.low(), v.high() };
+		return n;
+	}
+
+	std::vector<Naive> to_naive(const std::vector<Wide::uint128>& values)
+	{
+		std::vector<Naive> out;
+		for (const Wide::uint128& v : values) out.push_back(to_naive(v));
+		return out;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// 곱셈
+	//------------------------------------------------------------------------------------------------
+	void BM_Mul_Wide(benchmark::State& state)
+	{
+		const std::vector<Wide::uint128> a = random_values(128, 1), b = random_values(128, 2);
+		std::vector<Wide::uint128> out(Count);
+		for (auto _ : state) {
+			for (size_t i = 0; i < Count; ++i) out[i] = a[i] * b[i];
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Count));
+	}
+	BENCHMARK(BM_Mul_Wide);
+
+	void BM_Mul_Naive(benchmark::State& state)
+	{
+		const std::vector<Naive> a = to_naive(random_values(128, 1)), b = to_naive(random_values(128, 2));
+		std::vector<Naive> out(Count);
+		for (auto _ : state) {
+			for (size_t i = 0; i < Count; ++i) out[i] = naive_mul(a[i], b[i]);
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Count));
+	}
+	BENCHMARK(BM_Mul_Naive);
+
+	//------------------------------------------------------------------------------------------------
+	// 나눗셈 (range(0) = 제수 bit 수)
+	//------------------------------------------------------------------------------------------------
+	void BM_Div_Wide(benchmark::State& state)
+	{
+		const std::vector<Wide::uint128> a = random_values(128, 3), b = random_values(static_cast<int>(state.range(0)), 4);
+		std::vector<Wide::uint128> out(Count);
+		for (auto _ : state) {
+			for (size_t i = 0; i < Count; ++i) out[i] = a[i] / b[i];
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Count));
+	}
+	BENCHMARK(BM_Div_Wide)->Arg(64)->Arg(100);
+
+	void BM_Div_Naive(benchmark::State& state)
+	{
+		const std::vector<Naive> a = to_naive(random_values(128, 3)), b = to_naive(random_values(static_cast<int>(state.range(0)), 4));
+		std::vector<Naive> out(Count);
+		for (auto _ : state) {
+			for (size_t i = 0; i < Count; ++i) {
+				Naive r;
+				out[i] = naive_divmod(a[i], b[i], r);
+			}
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Count));
+	}
+	BENCHMARK(BM_Div_Naive)->Arg(64)->Arg(100);
+
+	// 고정 소수점 환산 : a * b / c (64-bit)
+	void BM_MulDiv_Wide(benchmark::State& state)
+	{
+		std::mt19937_64 rng(5);
+		std::vector<uint64_t> a(Count), b(Count), out(Count);
+		for (size_t i = 0; i < Count; ++i) {
+			a[i] = rng() >> 4;
+			b[i] = rng() >> 36;
+		}
+		for (auto _ : state) {
+			for (size_t i = 0; i < Count; ++i) out[i] = Wide::mul_div(a[i], b[i], 100000000ull);
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Count));
+	}
+	BENCHMARK(BM_MulDiv_Wide);
+
+	//------------------------------------------------------------------------------------------------
+	// 문자열 (range(0) = 값 bit 수 : 64 => 20 자리, 128 => 39 자리)
+	//------------------------------------------------------------------------------------------------
+	void BM_Format_Wide(benchmark::State& state)
+	{
+		const std::vector<Wide::uint128> values = random_values(static_cast<int>(state.range(0)), 6);
+		char buf[64];
+		size_t i = 0;
+		for (auto _ : state) {
+			const Wide::to_chars_result r = Wide::to_chars(buf, buf + sizeof(buf), values[i++ & (Count - 1)]);
+			benchmark::DoNotOptimize(r.ptr);
+			benchmark::DoNotOptimize(buf);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Format_Wide)->Arg(64)->Arg(96)->Arg(128);
+
+	void BM_Format_Naive(benchmark::State& state)
+	{
+		const std::vector<Naive> values = to_naive(random_values(static_cast<int>(state.range(0)), 6));
+		char buf[64];
+		size_t i = 0;
+		for (auto _ : state) {
+			const size_t n = naive_to_chars(buf, values[i++ & (Count - 1)]);
+			benchmark::DoNotOptimize(n);
+			benchmark::DoNotOptimize(buf);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Format_Naive)->Arg(64)->Arg(96)->Arg(128);
+
+	void BM_Parse_Wide(benchmark::State& state)
+	{
+		std::vector<std::string> texts;
+		for (const Wide::uint128& v : random_values(128, 7)) texts.push_back(Wide::to_string(v));
+		size_t i = 0;
+		for (auto _ : state) {
+			const std::string& text = texts[i++ & (Count - 1)];
+			Wide::uint128 v;
+			const Wide::from_chars_result r = Wide::from_chars(text.data(), text.data() + text.size(), v);
+			benchmark::DoNotOptimize(r.ptr);
+			benchmark::DoNotOptimize(v);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Parse_Wide);
+}
@@ -0,0 +1,222 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_locale.cpp
+/// @brief suite bench_locale : C++/Locale.cpp 의 locale 별 숫자 포맷/파싱/대소문자 (1 ~ 16 스레드)
+///
+///   데모 .cpp 를 그대로 include 한다(unity build). locale 은 모든 스레드가 같은 것(German numpunct: "1.234.567,89")
+///
+///   BM_Ostream_<Int|Double>        : 값마다 ostringstream 생성 + imbue + << (formatter 가 흔히 하는 방식)
+///   BM_OstreamReuse_<Int|Double>   : 스레드마다 imbue 한 stream 하나를 str("") 로 재사용
+///   BM_Snapshot_<Int|Double>       : Libs/locale_snapshot.h format (표 조회, facet/lock 없음)
+///   BM_ToChars_Int                 : grouping 없는 std::to_chars (하한선, C++17)
+///   BM_Istream_Double / BM_Snapshot_ParseDouble : "1.234.567,89" 파싱
+///   BM_Ctype_ToLower / BM_Snapshot_ToLower     : 64 글자 wstring, 글자마다 use_facet<ctype<wchar_t>> vs 표
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++/Locale.cpp"
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	const std::locale& german()
+	{
+		static const std::locale loc(std::locale::classic(), new Locale::GermanNumPunct<char>());
+		return loc;
+	}
+
+	const LocaleSnapshot::Table& german_table()
+	{
+		static const LocaleSnapshot::Table table = LocaleSnapshot::capture(german());
+		return table;
+	}
+
+	// 스레드마다 다른 값 (같은 값이면 분기 예측/캐시가 비현실적으로 좋아진다)
+	struct Values
+	{
+		std::vector<long long> ints;
+		std::vector<double> doubles;
+
+		explicit Values(int seed)
+		{
+			std::mt19937_64 rng(static_cast<uint64_t>(seed));
+			for (int i = 0; i < 1024; ++i) {
+				ints.push_back(static_cast<long long>(rng() >> (rng() % 48)) - (1LL << 20));
+				doubles.push_back(static_cast<double>(rng() % 100000000000ull) / 100.0);
+			}
+		}
+	};
+
+	//------------------------------------------------------------------------------------------------
+	// 정수
+	//------------------------------------------------------------------------------------------------
+	void BM_Ostream_Int(benchmark::State& state)
+	{
+		const Values values(state.thread_index());
+		size_t i = 0;
+		for (auto _ : state) {
+			std::ostringstream os;
+			os.imbue(german());
+			os << values.ints[i++ & 1023];
+			benchmark::DoNotOptimize(os.str());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Ostream_Int)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_OstreamReuse_Int(benchmark::State& state)
+	{
+		const Values values(state.thread_index());
+		std::ostringstream os;
+		os.imbue(german());
+		size_t i = 0;
+		for (auto _ : state) {
+			os.str(std::string());
+			os << values.ints[i++ & 1023];
+			benchmark::DoNotOptimize(os.str());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_OstreamReuse_Int)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_Snapshot_Int(benchmark::State& state)
+	{
+		const Values values(state.thread_index());
+		const LocaleSnapshot::Table& table = german_table();
+		char buf[64];
+		size_t i = 0;
+		for (auto _ : state) {
+			const size_t n = LocaleSnapshot::format(buf, sizeof(buf), values.ints[i++ & 1023], table);
+			benchmark::DoNotOptimize(n);
+			benchmark::DoNotOptimize(buf);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Snapshot_Int)->ThreadRange(1, 16)->UseRealTime();
+
+#if LOCALE_SNAPSHOT_HAS_TO_CHARS
+	void BM_ToChars_Int(benchmark::State& state)
+	{
+		const Values values(state.thread_index());
+		char buf[64];
+		size_t i = 0;
+		for (auto _ : state) {
+			const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), values.ints[i++ & 1023]);
+			benchmark::DoNotOptimize(r.ptr);
+			benchmark::DoNotOptimize(buf);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_ToChars_Int)->ThreadRange(1, 16)->UseRealTime();
+#endif
+
+	//------------------------------------------------------------------------------------------------
+	// 실수 (고정 소수점 2 자리)
+	//------------------------------------------------------------------------------------------------
+	void BM_Ostream_Double(benchmark::State& state)
+	{
+		const Values values(state.thread_index());
+		size_t i = 0;
+		for (auto _ : state) {
+			std::ostringstream os;
+			os.imbue(german());
+			os << std::fixed << std::setprecision(2) << values.doubles[i++ & 1023];
+			benchmark::DoNotOptimize(os.str());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Ostream_Double)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_OstreamReuse_Double(benchmark::State& state)
+	{
+		const Values values(state.thread_index());
+		std::ostringstream os;
+		os.imbue(german());
+		os << std::fixed << std::setprecision(2);
+		size_t i = 0;
+		for (auto _ : state) {
+			os.str(std::string());
+			os << values.doubles[i++ & 1023];
+			benchmark::DoNotOptimize(os.str());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_OstreamReuse_Double)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_Snapshot_Double(benchmark::State& state)
+	{
+		const Values values(state.thread_index());
+		const LocaleSnapshot::Table& table = german_table();
+		char buf[64];
+		size_t i = 0;
+		for (auto _ : state) {
+			const size_t n = LocaleSnapshot::format(buf, sizeof(buf), values.doubles[i++ & 1023], 2, table);
+			benchmark::DoNotOptimize(n);
+			benchmark::DoNotOptimize(buf);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Snapshot_Double)->ThreadRange(1, 16)->UseRealTime();
+
+	//------------------------------------------------------------------------------------------------
+	// 파싱
+	//------------------------------------------------------------------------------------------------
+	const std::string GermanNumber = "1.234.567,89";
+
+	void BM_Istream_Double(benchmark::State& state)
+	{
+		for (auto _ : state) {
+			std::istringstream is(GermanNumber);
+			is.imbue(german());
+			double v = 0;
+			is >> v;
+			benchmark::DoNotOptimize(v);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Istream_Double)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_Snapshot_ParseDouble(benchmark::State& state)
+	{
+		const LocaleSnapshot::Table& table = german_table();
+		for (auto _ : state) {
+			double v = 0;
+			benchmark::DoNotOptimize(LocaleSnapshot::parse(GermanNumber, v, table));
+			benchmark::DoNotOptimize(v);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Snapshot_ParseDouble)->ThreadRange(1, 16)->UseRealTime();
+
+	//------------------------------------------------------------------------------------------------
+	// 대소문자 (Locale::try_lower 처럼 글자마다 facet 을 거치는 경우)
+	//------------------------------------------------------------------------------------------------
+	const std::wstring MixedCase = L"HELLo, wORLD! The Quick Brown Fox Jumps Over The Lazy Dog 0123";
+
+	void BM_Ctype_ToLower(benchmark::State& state)
+	{
+		const std::locale loc = german();
+		std::wstring s = MixedCase;
+		for (auto _ : state) {
+			s = MixedCase;
+			for (wchar_t& c : s) c = std::use_facet<std::ctype<wchar_t>>(loc).tolower(c);
+			benchmark::DoNotOptimize(&s[0]);
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(MixedCase.size()));
+	}
+	BENCHMARK(BM_Ctype_ToLower)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_Snapshot_ToLower(benchmark::State& state)
+	{
+		const LocaleSnapshot::Table& table = german_table();
+		std::wstring s = MixedCase;
+		for (auto _ : state) {
+			s = MixedCase;
+			LocaleSnapshot::to_lower(&s[0], &s[0] + s.size(), table);
+			benchmark::DoNotOptimize(&s[0]);
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(MixedCase.size()));
+	}
+	BENCHMARK(BM_Snapshot_ToLower)->ThreadRange(1, 16)->UseRealTime();
+}
@@ -0,0 +1,118 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_lockfree_stacks.cpp
+/// @brief suite bench_lockfree_stacks : Libs/ 의 lock-free stack 구현 비교
+///
+///   모든 스레드가 하나의 stack에 push/pop을 섞어 호출 (경합 완화 기법별 확장성)
+///     BM_Stack<Stack>/push:50 : 연산마다 push/pop 을 무작위로 50/50
+///     BM_Stack<Stack>/push:90 : push 90 %, pop 10 % (stack 이 계속 자라므로 스레드별로 넣은 몫이
+///                               MaxSurplus 를 넘으면 측정을 멈추고 그만큼 pop)
+///   ->ThreadRange(1, 64) 로 경합 정도를 바꿔 가며 측정 (코어 수보다 많은 스레드는 time-slice)
+///
+///   MutexStack 은 비교 기준(std::mutex + std::vector)
+///////////////////////////////////////////////////////////////////////////////
+#include <stdint.h>
+
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "backoff.h"     // detail::fast_rand
+#include "treiber_stack.h"
+#include "elimination_stack.h"
+#include "flat_combining.h"
+
+
+namespace
+{
+	template<typename T>
+	class MutexStack
+	{
+	public:
+		void push(const T& value)
+		{
+			std::lock_guard<std::mutex> lock(_m);
+			_items.push_back(value);
+		}
+
+		bool pop(T& out)
+		{
+			std::lock_guard<std::mutex> lock(_m);
+			if (_items.empty()) return false;
+			out = _items.back();
+			_items.pop_back();
+			return true;
+		}
+
+	private:
+		std::mutex _m;
+		std::vector<T> _items;
+	};
+
+	// google benchmark 는 ->Threads(n) 일 때 같은 함수를 n개 스레드에서 동시에 실행한다
+	//   => stack 은 함수 static 으로 공유하고, 스레드 0 이 측정 전후로 만들고 비운다
+	//   EliminationStack / FlatCombiningStack 은 alignas(CacheLineSize) 멤버가 있어 정렬 할당
+	template<typename Stack>
+	struct SharedStack
+	{
+		static LockFree::CacheAlignedPtr<Stack>& instance()
+		{
+			static LockFree::CacheAlignedPtr<Stack> s;
+			return s;
+		}
+	};
+
+	const int64_t MaxSurplus = 1 << 16;     // 스레드별 (push - 성공한 pop) 상한
+
+	// range(0) = push 비율 (%)
+	template<typename Stack>
+	void BM_Stack(benchmark::State& state)
+	{
+		auto& stack = SharedStack<Stack>::instance();
+		if (0 == state.thread_index()) {
+			stack = LockFree::make_cache_aligned<Stack>();
+			for (int i = 0; i < 1024; ++i) stack->push(i);   // 처음부터 비어 있지 않게
+		}
+
+		const uint32_t pushPercent = static_cast<uint32_t>(state.range(0));
+		int value = 0;
+		int64_t surplus = 0;
+		for (auto _ : state) {
+			if (LockFree::detail::fast_rand() % 100 < pushPercent) {
+				stack->push(value);
+				++surplus;
+			}
+			else if (stack->pop(value)) {
+				--surplus;
+			}
+
+			if (surplus > MaxSurplus) {
+				state.PauseTiming();
+				for (; surplus > 0; --surplus) stack->pop(value);
+				state.ResumeTiming();
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations());
+
+		if (0 == state.thread_index()) {
+			stack.reset();
+		}
+	}
+
+	using HazardTreiber = LockFree::TreiberStack<int, LockFree::HazardPointers>;
+	using EpochTreiber = LockFree::TreiberStack<int, LockFree::EpochReclamation>;
+	using NoBackoffTreiber = LockFree::TreiberStack<int, LockFree::HazardPointers, LockFree::NoBackoff>;
+	using Elimination = LockFree::EliminationStack<int>;
+	using FlatCombining = LockFree::FlatCombiningStack<int>;
+}
+
+#define MSCPP_BENCH_STACK(Stack) \
+	BENCHMARK_TEMPLATE(BM_Stack, Stack)->ArgName("push")->Arg(50)->Arg(90)->ThreadRange(1, 64)->UseRealTime()
+
+MSCPP_BENCH_STACK(MutexStack<int>);
+MSCPP_BENCH_STACK(HazardTreiber);
+MSCPP_BENCH_STACK(EpochTreiber);
+MSCPP_BENCH_STACK(NoBackoffTreiber);
+MSCPP_BENCH_STACK(Elimination);
+MSCPP_BENCH_STACK(FlatCombining);
@@ -0,0 +1,101 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_rw_lock.cpp
+/// @brief suite bench_rw_lock : Libs/rw_lock.h 읽기 위주 공유 상태의 읽기 확장성 (1 ~ 64 스레드)
+///
+///   데모 C++142/Mutex_add.cpp 를 그대로 include 한다(unity build).
+///   모든 스레드가 같은 Config(32 byte) 하나를 읽고, 1000 번 중 range(0) 번은 쓴다
+///     range(0) = 1 / 10 / 100  => 쓰기 0.1% / 1% / 10%
+///
+///   BM_Lock<std::shared_mutex>            : lock_shared 마다 reader 수 cache line 을 모든 스레드가 갱신
+///   BM_Lock<Sync::DistributedSharedMutex> : 스레드별 reader slot (읽기끼리 line 공유 없음)
+///   BM_SeqLock                            : Sync::SharedValue<Config> (읽기는 공유 메모리에 쓰지 않음)
+///   items_per_second 가 스레드 수에 비례해 늘어나는지(=읽기 확장)를 본다
+///   읽은 checksum 이 나머지 셋의 합과 다르면(찢어진 읽기) 그 benchmark 는 SkipWithError 로 실패
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++142/Mutex_add.cpp"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	struct Config
+	{
+		uint64_t version;
+		uint64_t limit;
+		uint64_t timeout;
+		uint64_t checksum;      // 나머지 셋의 합 (찢어진 읽기 검출)
+	};
+
+	Config make_config(uint64_t version)
+	{
+		const Config c = { version, version * 2, version * 3, version * 6 };
+		return c;
+	}
+
+	bool consistent(const Config& c)
+	{
+		return c.checksum == c.version + c.limit + c.timeout;
+	}
+
+	template<typename Lock>
+	struct Guarded
+	{
+		Lock lock;
+		Config config = make_config(0);
+	};
+
+	template<typename Lock>
+	void BM_Lock(benchmark::State& state)
+	{
+		static Guarded<Lock> shared;
+		const uint64_t writes = static_cast<uint64_t>(state.range(0));
+		uint64_t i = static_cast<uint64_t>(state.thread_index()) * 7919;
+		uint64_t sum = 0;
+
+		for (auto _ : state) {
+			if (++i % 1000 < writes) {
+				std::unique_lock<Lock> lock(shared.lock);
+				shared.config = make_config(shared.config.version + 1);
+			}
+			else {
+				std::shared_lock<Lock> lock(shared.lock);
+				const Config c = shared.config;
+				if (!consistent(c)) {
+					state.SkipWithError("torn read");
+					break;
+				}
+				sum += c.checksum - c.limit;
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_TEMPLATE(BM_Lock, std::shared_mutex)->Arg(1)->Arg(10)->Arg(100)->ThreadRange(1, 64)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_Lock, Sync::DistributedSharedMutex)->Arg(1)->Arg(10)->Arg(100)->ThreadRange(1, 64)->UseRealTime();
+
+	void BM_SeqLock(benchmark::State& state)
+	{
+		static Sync::SharedValue<Config> shared(make_config(0));
+		const uint64_t writes = static_cast<uint64_t>(state.range(0));
+		uint64_t i = static_cast<uint64_t>(state.thread_index()) * 7919;
+		uint64_t sum = 0;
+
+		for (auto _ : state) {
+			if (++i % 1000 < writes) {
+				shared.update([](Config& c) { c = make_config(c.version + 1); });
+			}
+			else {
+				const Config c = shared.load();
+				if (!consistent(c)) {
+					state.SkipWithError("torn read");
+					break;
+				}
+				sum += c.checksum - c.limit;
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_SeqLock)->Arg(1)->Arg(10)->Arg(100)->ThreadRange(1, 64)->UseRealTime();
+}
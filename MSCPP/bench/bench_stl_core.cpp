@@ -0,0 +1,194 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_stl_core.cpp
+/// @brief suite bench_stl_core : Libs/Lib-DLL-Explicit plugin 의 stl_core_* C ABI 를 모듈 경계 너머로 호출
+///
+///   plugin(mscpp_plugin_explicit) 을 dlopen/LoadLibrary 로 올리고 plugin_get_api_v 가 준 PluginApi 함수 pointer 로만 부른다.
+///   Arg 0 = 원소 수 (1K ~ 64K int)
+///
+///   BM_Plugin_Push        : stl_push 를 원소마다 (호출 N 번)
+///   BM_Plugin_PushN       : stl_push_n 한 번 (ABI 1.1)
+///   BM_Plugin_GetValues   : stl_get_values 크기 질의 + 복사 (호출 2 번)
+///   BM_Plugin_AllocValues : stl_alloc_values 로 호출자 heap 에 한 번에 복사 + stl_release (호출자 할당자로 해제, ABI 1.1)
+///   BM_Plugin_ViewValues  : stl_view_values 로 빌려서 호출자가 직접 읽는다 (복사 없음, 원소 전체를 합산, ABI 1.1)
+///   BM_Plugin_Sum         : stl_sum (SSE2/NEON)
+///////////////////////////////////////////////////////////////////////////////
+#include <windows.h>         // Linux 에서는 Libs/Portable (__declspec(dllexport) 대체)
+
+#include "abi_common.h"
+#include "dll-explicit-api.h"
+
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	// 프로세스 동안 한 번 올려 두고 내리지 않는다
+	const PluginApi* plugin()
+	{
+		static PluginApi api;
+		static const bool loaded = [] {
+#if defined(_WIN32)
+			HMODULE module = LoadLibraryA(MSCPP_PLUGIN_PATH);
+			auto get_api = module ? reinterpret_cast<plugin_get_api_v_fn>(GetProcAddress(module, "plugin_get_api_v")) : nullptr;
+#else
+			void* module = dlopen(MSCPP_PLUGIN_PATH, RTLD_NOW | RTLD_LOCAL);
+			auto get_api = module ? reinterpret_cast<plugin_get_api_v_fn>(dlsym(module, "plugin_get_api_v")) : nullptr;
+#endif
+			return get_api && get_api(&api, sizeof(api));
+		}();
+		return loaded && api.abi.abi_minor >= 1 ? &api : nullptr;
+	}
+
+	std::vector<int> make_values(size_t n)
+	{
+		std::vector<int> values(n);
+		std::iota(values.begin(), values.end(), 1);
+		return values;
+	}
+
+	void BM_Plugin_Push(benchmark::State& state)
+	{
+		const PluginApi* api = plugin();
+		if (!api) {
+			state.SkipWithError("plugin load failed");
+			return;
+		}
+
+		const std::vector<int> values = make_values(static_cast<size_t>(state.range(0)));
+		for (auto _ : state) {
+			StlHandle* h = api->stl_create(1);
+			for (int v : values) api->stl_push(h, v);
+			benchmark::DoNotOptimize(api->stl_count(h));
+			api->stl_destroy(h);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+	}
+	BENCHMARK(BM_Plugin_Push)->Range(1 << 10, 64 << 10);
+
+	void BM_Plugin_PushN(benchmark::State& state)
+	{
+		const PluginApi* api = plugin();
+		if (!api) {
+			state.SkipWithError("plugin load failed");
+			return;
+		}
+
+		const std::vector<int> values = make_values(static_cast<size_t>(state.range(0)));
+		for (auto _ : state) {
+			StlHandle* h = api->stl_create(1);
+			api->stl_push_n(h, values.data(), values.size());
+			benchmark::DoNotOptimize(api->stl_count(h));
+			api->stl_destroy(h);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+	}
+	BENCHMARK(BM_Plugin_PushN)->Range(1 << 10, 64 << 10);
+
+	void BM_Plugin_GetValues(benchmark::State& state)
+	{
+		const PluginApi* api = plugin();
+		if (!api) {
+			state.SkipWithError("plugin load failed");
+			return;
+		}
+
+		StlHandle* h = api->stl_create(1);
+		for (int v : make_values(static_cast<size_t>(state.range(0)))) api->stl_push(h, v);
+
+		std::vector<int> out;
+		for (auto _ : state) {
+			size_t need = 0;
+			api->stl_get_values(h, nullptr, 0, &need);
+			out.resize(need);
+			api->stl_get_values(h, out.data(), out.size(), nullptr);
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int)));
+		api->stl_destroy(h);
+	}
+	BENCHMARK(BM_Plugin_GetValues)->Range(1 << 10, 64 << 10);
+
+	void BM_Plugin_AllocValues(benchmark::State& state)
+	{
+		const PluginApi* api = plugin();
+		if (!api) {
+			state.SkipWithError("plugin load failed");
+			return;
+		}
+
+		StlHandle* h = api->stl_create(1);
+		const std::vector<int> values = make_values(static_cast<size_t>(state.range(0)));
+		api->stl_push_n(h, values.data(), values.size());
+
+		StlAllocator host = {
+			[](void*, size_t bytes) { return std::malloc(bytes); },
+			[](void*, void* p) { std::free(p); },
+			nullptr
+		};
+		api->stl_set_allocator(h, &host);
+
+		for (auto _ : state) {
+			size_t count = 0;
+			int* copy = api->stl_alloc_values(h, &count);
+			benchmark::DoNotOptimize(copy);
+			benchmark::ClobberMemory();
+			api->stl_release(h, copy);
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int)));
+		api->stl_destroy(h);
+	}
+	BENCHMARK(BM_Plugin_AllocValues)->Range(1 << 10, 64 << 10);
+
+	void BM_Plugin_ViewValues(benchmark::State& state)
+	{
+		const PluginApi* api = plugin();
+		if (!api) {
+			state.SkipWithError("plugin load failed");
+			return;
+		}
+
+		StlHandle* h = api->stl_create(1);
+		const std::vector<int> values = make_values(static_cast<size_t>(state.range(0)));
+		api->stl_push_n(h, values.data(), values.size());
+
+		// 호출 1 번으로 pointer/길이만 받고, 빌린 원소를 호출자 쪽에서 모두 읽는다 (bytes = 실제로 읽은 양)
+		for (auto _ : state) {
+			const int* data = nullptr;
+			size_t count = 0;
+			api->stl_view_values(h, &data, &count);
+			uint32_t sum = std::accumulate(data, data + count, 0u);
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int)));
+		api->stl_destroy(h);
+	}
+	BENCHMARK(BM_Plugin_ViewValues)->Range(1 << 10, 64 << 10);
+
+	void BM_Plugin_Sum(benchmark::State& state)
+	{
+		const PluginApi* api = plugin();
+		if (!api) {
+			state.SkipWithError("plugin load failed");
+			return;
+		}
+
+		StlHandle* h = api->stl_create(1);
+		for (int v : make_values(static_cast<size_t>(state.range(0)))) api->stl_push(h, v);
+
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(api->stl_sum(h));
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int)));
+		api->stl_destroy(h);
+	}
+	BENCHMARK(BM_Plugin_Sum)->Range(1 << 10, 64 << 10);
+}
@@ -0,0 +1,394 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_string_helpers.cpp
+/// @brief suite bench_string_helpers : C++/StringHelper.cpp 의 split / join / replace / trim / Format
+///                                    vs Libs/string_engine.h (string_view, 할당 없는 경로)
+///
+///   데모 .cpp 를 그대로 include 한다(unity build).
+///   입력 : "field<n>" 토큰을 ':' 로 이은 문자열, 크기 1 KB ~ 100 MB (Arg = bytes, 빈 토큰 없음)
+///          => 모든 split 변형이 같은 토큰 목록을 만든다 (istream_iterator_3 만 공백 구분 입력 사용)
+///   처리량은 입력 byte 기준(bytes_per_second)
+///
+///   100 MB 입력에서 std::string 토큰 방식은 토큰 수 x 32 byte 이상을 할당하므로 메모리가 1 GB 가까이 필요하다.
+///   --benchmark_filter 로 크기/변형을 골라 실행할 수 있다. ex) --benchmark_filter='Split.*/bytes:1048576'
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++/StringHelper.cpp"
+
+#include <map>
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	using namespace StringHelper;
+	namespace SE = StringEngine;
+
+	const std::string& make_input(size_t bytes, char delimiter)
+	{
+		static std::map<std::pair<size_t, char>, std::string> cache;     // 100 MB 입력을 매번 만들지 않도록
+
+		std::string& line = cache[std::make_pair(bytes, delimiter)];
+		if (line.empty()) {
+			line.reserve(bytes + 16);
+			for (unsigned i = 0; line.size() < bytes; ++i) {
+				if (i) line += delimiter;
+				line += "field";
+				line += std::to_string((i * 7919u) % 100000u);
+			}
+		}
+		return line;
+	}
+
+	void input_sizes(benchmark::internal::Benchmark* b)
+	{
+		b->ArgName("bytes");
+		for (int64_t bytes : { int64_t(1) << 10, int64_t(64) << 10, int64_t(1) << 20, int64_t(16) << 20, int64_t(100) << 20 }) {
+			b->Arg(bytes);
+		}
+	}
+
+	// O(입력 x 치환 횟수) 인 변형은 1 MB 이상에서 한 번도 끝나지 않으므로 64 KB까지만
+	void small_input_sizes(benchmark::internal::Benchmark* b)
+	{
+		b->ArgName("bytes")->Arg(int64_t(1) << 10)->Arg(int64_t(64) << 10);
+	}
+
+	template<typename Split>
+	void run_split(benchmark::State& state, char delimiter, Split&& split)
+	{
+		const std::string& input = make_input(static_cast<size_t>(state.range(0)), delimiter);
+		std::vector<std::string> tokens;
+
+		size_t count = 0;
+		for (auto _ : state) {
+			tokens.clear();
+			split(input, tokens);
+			count = tokens.size();
+			benchmark::DoNotOptimize(tokens.data());
+		}
+
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+		state.counters["tokens"] = double(count);
+	}
+
+	//=============================================================================================
+	// split : 기존 변형 (토큰마다 std::string)
+	//=============================================================================================
+	void BM_Split_CStyle(benchmark::State& state)
+	{
+		run_split(state, ':', [](const std::string& in, std::vector<std::string>& out) { split(in.c_str(), ':', out); });
+	}
+	BENCHMARK(BM_Split_CStyle)->Apply(input_sizes);
+
+	// strtok_s 가 입력을 고치므로 매 반복 복사본을 만든다(복사 비용 포함)
+	void BM_Split_CStyleStrtokS(benchmark::State& state)
+	{
+		std::vector<char> copy;
+		char delimiters[] = ":";
+		run_split(state, ':', [&](const std::string& in, std::vector<std::string>& out) {
+			copy.assign(in.c_str(), in.c_str() + in.size() + 1);
+			split(copy.data(), delimiters, out);
+		});
+	}
+	BENCHMARK(BM_Split_CStyleStrtokS)->Apply(input_sizes);
+
+	void BM_Split_IStreamIterator1(benchmark::State& state)
+	{
+		run_split(state, ':', [](const std::string& in, std::vector<std::string>& out) { split_by_istream_iterator_1(in, out); });
+	}
+	BENCHMARK(BM_Split_IStreamIterator1)->Apply(input_sizes);
+
+	void BM_Split_IStreamIterator2(benchmark::State& state)
+	{
+		run_split(state, ':', [](const std::string& in, std::vector<std::string>& out) { split_by_istream_iterator_2(in, out); });
+	}
+	BENCHMARK(BM_Split_IStreamIterator2)->Apply(input_sizes);
+
+	void BM_Split_IStreamIterator3(benchmark::State& state)
+	{
+		run_split(state, ' ', [](const std::string& in, std::vector<std::string>& out) { split_by_istream_iterator_3(in, out); });
+	}
+	BENCHMARK(BM_Split_IStreamIterator3)->Apply(input_sizes);
+
+	void BM_Split_StringStream(benchmark::State& state)
+	{
+		run_split(state, ':', [](const std::string& in, std::vector<std::string>& out) { out = split_by_stringstream(in, ':'); });
+	}
+	BENCHMARK(BM_Split_StringStream)->Apply(input_sizes);
+
+	void BM_Split_IStringStream(benchmark::State& state)
+	{
+		run_split(state, ':', [](const std::string& in, std::vector<std::string>& out) { out = split_by_istringstream(in, ':'); });
+	}
+	BENCHMARK(BM_Split_IStringStream)->Apply(input_sizes);
+
+	void BM_Split_Find(benchmark::State& state)
+	{
+		run_split(state, ':', [](const std::string& in, std::vector<std::string>& out) { split_by_find(in, ':', out); });
+	}
+	BENCHMARK(BM_Split_Find)->Apply(input_sizes);
+
+	void BM_Split_Strtok(benchmark::State& state)
+	{
+		run_split(state, ':', [](const std::string& in, std::vector<std::string>& out) { split_by_strtok(in, ":", out); });
+	}
+	BENCHMARK(BM_Split_Strtok)->Apply(input_sizes);
+
+	void BM_Split_StrtokS(benchmark::State& state)
+	{
+		run_split(state, ':', [](const std::string& in, std::vector<std::string>& out) { split_by_strtok_s(in, ":", out); });
+	}
+	BENCHMARK(BM_Split_StrtokS)->Apply(input_sizes);
+
+	void BM_Split_FindFirstOf(benchmark::State& state)
+	{
+		const std::string delimiters(":");
+		run_split(state, ':', [&](const std::string& in, std::vector<std::string>& out) { split_by_find_first_of(in, delimiters, out); });
+	}
+	BENCHMARK(BM_Split_FindFirstOf)->Apply(input_sizes);
+
+	void BM_Split_FindFirstNotOf(benchmark::State& state)
+	{
+		const std::string delimiters(":");
+		run_split(state, ':', [&](const std::string& in, std::vector<std::string>& out) { split_by_find_first_not_of(in, delimiters, out); });
+	}
+	BENCHMARK(BM_Split_FindFirstNotOf)->Apply(input_sizes);
+
+	//=============================================================================================
+	// split : StringEngine (토큰 = string_view)
+	//=============================================================================================
+
+	// lazy range 를 훑기만 (토큰 저장 없음)
+	void BM_Split_Engine_Lazy(benchmark::State& state)
+	{
+		const std::string& input = make_input(static_cast<size_t>(state.range(0)), ':');
+
+		size_t count = 0;
+		for (auto _ : state) {
+			count = 0;
+			for (SE::string_view token : SE::split(input, ':')) {
+				benchmark::DoNotOptimize(token.data());
+				++count;
+			}
+		}
+
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+		state.counters["tokens"] = double(count);
+	}
+	BENCHMARK(BM_Split_Engine_Lazy)->Apply(input_sizes);
+
+	// vector<string_view> 에 모으기 (capacity 재사용 => 두 번째 반복부터 할당 없음)
+	template<bool Any>
+	void BM_Split_Engine_Collect(benchmark::State& state)
+	{
+		const std::string& input = make_input(static_cast<size_t>(state.range(0)), ':');
+		std::vector<SE::string_view> tokens;
+
+		for (auto _ : state) {
+			if (Any) SE::split_any(input, ":").to(tokens);
+			else SE::split(input, ':').to(tokens);
+			benchmark::DoNotOptimize(tokens.data());
+		}
+
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+		state.counters["tokens"] = double(tokens.size());
+	}
+	BENCHMARK_TEMPLATE(BM_Split_Engine_Collect, false)->Apply(input_sizes);
+	BENCHMARK_TEMPLATE(BM_Split_Engine_Collect, true)->Apply(input_sizes);
+
+	// 구분자 집합 (strtok / find_first_of 대응)
+	void BM_Split_Engine_AnyOf(benchmark::State& state)
+	{
+		const std::string& input = make_input(static_cast<size_t>(state.range(0)), ':');
+		std::vector<SE::string_view> tokens;
+
+		for (auto _ : state) {
+			SE::split_any(input, ":;, \t", SE::EmptyTokens::Skip).to(tokens);
+			benchmark::DoNotOptimize(tokens.data());
+		}
+
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+		state.counters["tokens"] = double(tokens.size());
+	}
+	BENCHMARK(BM_Split_Engine_AnyOf)->Apply(input_sizes);
+
+	//=============================================================================================
+	// join
+	//=============================================================================================
+	struct JoinInput
+	{
+		std::vector<std::string> words;
+		std::vector<char*> list;
+		std::vector<char> buffer;
+
+		explicit JoinInput(size_t bytes)
+		{
+			split_by_find(make_input(bytes, ':'), ':', words);
+			for (auto& w : words) list.push_back(&w[0]);
+			buffer.resize(bytes + words.size() * 2 + 16);
+		}
+	};
+
+	void BM_Join_CStyleChar(benchmark::State& state)
+	{
+		JoinInput in(static_cast<size_t>(state.range(0)));
+		for (auto _ : state) {
+			join(in.list.data(), static_cast<int>(in.list.size()), ':', in.buffer.data());
+			benchmark::DoNotOptimize(in.buffer.data());
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Join_CStyleChar)->Apply(input_sizes);
+
+	void BM_Join_CStyleString(benchmark::State& state)
+	{
+		JoinInput in(static_cast<size_t>(state.range(0)));
+		char delimiters[] = ", ";
+		for (auto _ : state) {
+			join(in.list.data(), static_cast<int>(in.list.size()), delimiters, in.buffer.data());
+			benchmark::DoNotOptimize(in.buffer.data());
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Join_CStyleString)->Apply(input_sizes);
+
+	void BM_Join_OStringStream(benchmark::State& state)
+	{
+		JoinInput in(static_cast<size_t>(state.range(0)));
+		const std::string delimiters(", ");
+		std::string joined;
+		for (auto _ : state) {
+			join_by_vector(in.words, delimiters, joined);
+			benchmark::DoNotOptimize(joined.data());
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Join_OStringStream)->Apply(input_sizes);
+
+	void BM_Join_Engine(benchmark::State& state)
+	{
+		JoinInput in(static_cast<size_t>(state.range(0)));
+		std::string joined;
+		for (auto _ : state) {
+			SE::join(in.words, ", ", joined);
+			benchmark::DoNotOptimize(joined.data());
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Join_Engine)->Apply(input_sizes);
+
+	// split 결과(view)를 바로 join : 중간 std::string 없음
+	void BM_Join_Engine_FromSplit(benchmark::State& state)
+	{
+		const std::string& input = make_input(static_cast<size_t>(state.range(0)), ':');
+		std::string joined;
+		for (auto _ : state) {
+			SE::join(SE::split(input, ':'), ", ", joined);
+			benchmark::DoNotOptimize(joined.data());
+		}
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+	}
+	BENCHMARK(BM_Join_Engine_FromSplit)->Apply(input_sizes);
+
+	//=============================================================================================
+	// replace all : "field" => "f" (토큰마다 1회)
+	//=============================================================================================
+	void BM_Replace_CStyle(benchmark::State& state)
+	{
+		std::string input = make_input(static_cast<size_t>(state.range(0)), ':');
+		std::vector<char> output(input.size() + 1);
+		for (auto _ : state) {
+			string_replace(&input[0], "field", "f", output.data(), output.size());
+			benchmark::DoNotOptimize(output.data());
+		}
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+	}
+	BENCHMARK(BM_Replace_CStyle)->Apply(input_sizes);
+
+	// string_replace() 데모의 "replace all" 블록 (find + std::string::replace, 치환마다 뒤쪽을 다시 민다)
+	void BM_Replace_FindReplace(benchmark::State& state)
+	{
+		const std::string& input = make_input(static_cast<size_t>(state.range(0)), ':');
+		const std::string from = "field";
+		const std::string to = "f";
+		for (auto _ : state) {
+			std::string result = input;
+			std::string::size_type pos = 0;
+			std::string::size_type offset = 0;
+			while ((pos = result.find(from, offset)) != std::string::npos) {
+				result.replace(result.begin() + pos, result.begin() + pos + from.size(), to);
+				offset = pos + to.size();
+			}
+			benchmark::DoNotOptimize(result.data());
+		}
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+	}
+	BENCHMARK(BM_Replace_FindReplace)->Apply(small_input_sizes);
+
+	void BM_Replace_Engine(benchmark::State& state)
+	{
+		const std::string& input = make_input(static_cast<size_t>(state.range(0)), ':');
+		std::string output;
+		for (auto _ : state) {
+			SE::replace_all(input, "field", "f", output);
+			benchmark::DoNotOptimize(output.data());
+		}
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+	}
+	BENCHMARK(BM_Replace_Engine)->Apply(input_sizes);
+
+	// 길이가 같은 치환 : 1st pass(개수 세기) 생략
+	void BM_Replace_Engine_SameLength(benchmark::State& state)
+	{
+		const std::string& input = make_input(static_cast<size_t>(state.range(0)), ':');
+		std::string output;
+		for (auto _ : state) {
+			SE::replace_all(input, "field", "FIELD", output);
+			benchmark::DoNotOptimize(output.data());
+		}
+		state.SetBytesProcessed(state.iterations() * int64_t(input.size()));
+	}
+	BENCHMARK(BM_Replace_Engine_SameLength)->Apply(input_sizes);
+
+	//=============================================================================================
+	// trim / format (입력 크기 무관)
+	//=============================================================================================
+	void BM_Trim(benchmark::State& state)
+	{
+		const std::string input("   2018-1-12 12:22:45   ");
+		const std::string blank(" ");
+		std::string output;
+		for (auto _ : state) {
+			string_trim_left_right(input, blank, output);
+			benchmark::DoNotOptimize(output.data());
+		}
+	}
+	BENCHMARK(BM_Trim);
+
+	void BM_Trim_Engine(benchmark::State& state)
+	{
+		const std::string input("   2018-1-12 12:22:45   ");
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(SE::trim(input, " "));
+		}
+	}
+	BENCHMARK(BM_Trim_Engine);
+
+	void BM_Format(benchmark::State& state)
+	{
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(Format("%s-%d-%.3f", "id", 12345, 3.14159));
+		}
+	}
+	BENCHMARK(BM_Format);
+
+	void BM_Format_Engine(benchmark::State& state)
+	{
+		std::string line;
+		for (auto _ : state) {
+			SE::format_to(line, "%s-%d-%.3f", "id", 12345, 3.14159);
+			benchmark::DoNotOptimize(line.data());
+		}
+	}
+	BENCHMARK(BM_Format_Engine);
+}
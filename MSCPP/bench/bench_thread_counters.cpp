@@ -0,0 +1,106 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_thread_counters.cpp
+/// @brief suite bench_thread_counters : Libs/thread_counters.h 스레드별 counter 증가 비용 (1 ~ 64 스레드)
+///
+///   데모 C++14/Thread_add.cpp 를 그대로 include 한다(unity build).
+///
+///   BM_Increment<SharedAtomic>     : 모든 스레드가 std::atomic<uint64_t> 하나에 fetch_add (cache line 하나를 공유)
+///   BM_Increment<PerThreadAtomic>  : 스레드별 cache line 에 fetch_add (공유는 없고 lock 접두사 RMW 만)
+///   BM_Increment<RegistryCounter>  : Metrics::Counter::add (thread_local block 의 cell 에 load + store)
+///   BM_HistogramRecord             : Metrics::Histogram::record (경계 16 개 이분 탐색 + bucket/sum 두 cell)
+///   BM_Snapshot                    : counter range(0) 개 snapshot (읽기 쪽, 살아 있는 스레드 1 개)
+///   items_per_second 가 스레드 수에 비례해 늘어나는지(=쓰기 확장)를 본다
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++14/Thread_add.cpp"
+
+#include <cstdint>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	const int MaxThreads = 64;
+
+	struct SharedAtomic
+	{
+		static std::atomic<uint64_t>& value()
+		{
+			static std::atomic<uint64_t> v{ 0 };
+			return v;
+		}
+
+		static void add(int) { value().fetch_add(1, std::memory_order_relaxed); }
+	};
+
+	struct PerThreadAtomic
+	{
+		struct Slot
+		{
+			std::atomic<uint64_t> value{ 0 };
+			char _pad[LockFree::CacheLineSize - sizeof(std::atomic<uint64_t>)];
+		};
+
+		// 배열 시작도 line 경계에 (static 저장소의 alignas 는 C++14 에서도 지켜진다)
+		struct alignas(LockFree::CacheLineSize) Slots
+		{
+			Slot slots[MaxThreads];
+		};
+
+		static void add(int thread)
+		{
+			static Slots s;
+			s.slots[thread].value.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+
+	struct RegistryCounter
+	{
+		static void add(int)
+		{
+			static const Metrics::Counter counter = Metrics::Registry::global().counter("bench.increment");
+			counter.add();
+		}
+	};
+
+	template<typename Target>
+	void BM_Increment(benchmark::State& state)
+	{
+		const int thread = state.thread_index();
+		for (auto _ : state)
+			Target::add(thread);
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_TEMPLATE(BM_Increment, SharedAtomic)->ThreadRange(1, MaxThreads)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_Increment, PerThreadAtomic)->ThreadRange(1, MaxThreads)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_Increment, RegistryCounter)->ThreadRange(1, MaxThreads)->UseRealTime();
+
+	void BM_HistogramRecord(benchmark::State& state)
+	{
+		static const Metrics::Histogram histogram =
+			Metrics::Registry::global().histogram("bench.latency", Metrics::Registry::exponential_bounds(1, 2, 16));
+
+		uint64_t v = static_cast<uint64_t>(state.thread_index()) * 7919;
+		for (auto _ : state) {
+			histogram.record(v & 0xFFFF);
+			v = v * 6364136223846793005ull + 1442695040888963407ull;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_HistogramRecord)->ThreadRange(1, MaxThreads)->UseRealTime();
+
+	void BM_Snapshot(benchmark::State& state)
+	{
+		Metrics::Registry registry;
+		for (int64_t i = 0; i < state.range(0); ++i)
+			registry.counter("c" + std::to_string(i)).add();
+
+		for (auto _ : state) {
+			Metrics::Snapshot s = registry.snapshot();
+			benchmark::DoNotOptimize(s.counters.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Snapshot)->Arg(16)->Arg(256)->Arg(4096);
+}
@@ -0,0 +1,67 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_thread_pools_coroutine.cpp
+/// @brief suite bench_thread_pools : C++143/CoroutineWithThreadPool.cpp 의 SimpleThreadPool
+///
+///   데모 .cpp 를 그대로 include 한다(unity build, C++20).
+///
+///   BM_SimpleThreadPool_CoAwaitResume : 워커당 TasksPerWorker개 코루틴이 co_await 로 Iterations번 재스케줄
+///     Arg 0 = Mode (0: SharedQueue, 1: WorkStealing, 2: RingQueue)
+///     Arg 1 = 워커 스레드 수
+///   BM_SimpleThreadPool_FanOut        : Width개 Task를 하나씩 co_await vs WhenAll 한 번 (WorkStealing)
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++143/CoroutineWithThreadPool.cpp"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+    using namespace TaskWithThreadPool;
+
+    void BM_SimpleThreadPool_CoAwaitResume(benchmark::State& state)
+    {
+        constexpr int TasksPerWorker = 16;
+        constexpr int Iterations = 1000;
+
+        const auto mode = static_cast<SimpleThreadPool::Mode>(state.range(0));
+        const size_t workers = static_cast<size_t>(state.range(1));
+        SimpleThreadPool pool(workers, mode);
+
+        std::vector<Task<void>> tasks;
+        tasks.reserve(workers * TasksPerWorker);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < workers * TasksPerWorker; ++i) {
+                tasks.push_back(resume_loop(pool, Iterations));
+            }
+            for (auto& t : tasks) t.wait();
+            tasks.clear();
+        }
+
+        pool.shutdown();
+
+        // +1: initial_suspend 후 시작 resume
+        state.SetItemsProcessed(state.iterations() * int64_t(workers * TasksPerWorker) * (Iterations + 1));
+        state.SetLabel(mode_name(mode));
+    }
+
+    template<Task<void> (*FanOut)(SimpleThreadPool&, int)>
+    void BM_SimpleThreadPool_FanOut(benchmark::State& state)
+    {
+        const int width = static_cast<int>(state.range(0));
+        SimpleThreadPool pool(std::max(2u, std::thread::hardware_concurrency()), SimpleThreadPool::Mode::WorkStealing);
+
+        FanOut(pool, width).wait();     // warm-up (FramePool / 큐 버퍼)
+
+        for (auto _ : state) {
+            FanOut(pool, width).wait();
+        }
+
+        pool.shutdown();
+        state.SetItemsProcessed(state.iterations() * width);
+    }
+}
+
+BENCHMARK(BM_SimpleThreadPool_CoAwaitResume)->ArgsProduct({ { 0, 1, 2 }, { 1, 2, 4 } })->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SimpleThreadPool_FanOut, &fan_out_one_by_one)->Arg(1000)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SimpleThreadPool_FanOut, &fan_out_when_all)->Arg(1000)->UseRealTime();
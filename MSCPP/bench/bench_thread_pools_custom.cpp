@@ -0,0 +1,128 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_thread_pools_custom.cpp
+/// @brief suite bench_thread_pools : C++11/AsyncAndFuture.cpp 의 CustomThreadPool
+///
+///   데모 .cpp 를 그대로 include 해서(unity build) 측정 대상 코드를 복사하지 않는다.
+///   (데모의 Test()/system("pause") 는 호출하지 않는다)
+///
+///   BM_CustomThreadPool_RoundTrip : submit 1회 + future.get() 1회 (hand-off 지연)
+///   BM_CustomThreadPool_Batch     : Batch개 submit 후 전부 get (처리량)
+///   BM_CustomThreadPool_Schedule*  : 위와 같지만 schedule (Tasks::Task + slab 공유 상태, 할당 없음)
+///   BM_CustomThreadPool_SubmitBulk : Batch개를 submit_bulk 한 번 (lock 1회 + wake-up 1회) 후 get 1회
+///     Arg 0 = HandOff (0: Lock - mutex + condition_variable 큐, 1: Ring - lock-free MPMC ring)
+///     Arg 1 = 워커 스레드 수
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++11/AsyncAndFuture.cpp"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	using AsyncAndFuture::CustomThreadPool;
+	using LockFree::HandOff;
+
+	const char* handoff_name(HandOff handoff)
+	{
+		return HandOff::Ring == handoff ? "ring" : "lock";
+	}
+
+	void BM_CustomThreadPool_RoundTrip(benchmark::State& state)
+	{
+		const HandOff handoff = static_cast<HandOff>(state.range(0));
+		CustomThreadPool pool(static_cast<size_t>(state.range(1)), handoff);
+
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(pool.submit([](int x) { return x + 1; }, 1).get());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+		state.SetLabel(handoff_name(handoff));
+	}
+
+	void BM_CustomThreadPool_Batch(benchmark::State& state)
+	{
+		const int Batch = 1024;
+
+		const HandOff handoff = static_cast<HandOff>(state.range(0));
+		CustomThreadPool pool(static_cast<size_t>(state.range(1)), handoff);
+
+		std::vector<std::future<int>> futures;
+		futures.reserve(Batch);
+
+		for (auto _ : state) {
+			for (int i = 0; i < Batch; ++i) {
+				futures.push_back(pool.submit([](int x) { return x + 1; }, i));
+			}
+			for (auto& f : futures) {
+				benchmark::DoNotOptimize(f.get());
+			}
+			futures.clear();
+		}
+
+		state.SetItemsProcessed(state.iterations() * Batch);
+		state.SetLabel(handoff_name(handoff));
+	}
+
+	void BM_CustomThreadPool_ScheduleRoundTrip(benchmark::State& state)
+	{
+		const HandOff handoff = static_cast<HandOff>(state.range(0));
+		CustomThreadPool pool(static_cast<size_t>(state.range(1)), handoff);
+
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(pool.schedule([](int x) { return x + 1; }, 1).get());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+		state.SetLabel(handoff_name(handoff));
+	}
+
+	void BM_CustomThreadPool_ScheduleBatch(benchmark::State& state)
+	{
+		const int Batch = 1024;
+
+		const HandOff handoff = static_cast<HandOff>(state.range(0));
+		CustomThreadPool pool(static_cast<size_t>(state.range(1)), handoff);
+
+		std::vector<Tasks::Future<int>> futures;
+		futures.reserve(Batch);
+
+		for (auto _ : state) {
+			for (int i = 0; i < Batch; ++i) {
+				futures.push_back(pool.schedule([](int x) { return x + 1; }, i));
+			}
+			for (auto& f : futures) {
+				benchmark::DoNotOptimize(f.get());
+			}
+			futures.clear();
+		}
+
+		state.SetItemsProcessed(state.iterations() * Batch);
+		state.SetLabel(handoff_name(handoff));
+	}
+
+	void BM_CustomThreadPool_SubmitBulk(benchmark::State& state)
+	{
+		const int Batch = 1024;
+
+		const HandOff handoff = static_cast<HandOff>(state.range(0));
+		CustomThreadPool pool(static_cast<size_t>(state.range(1)), handoff);
+
+		std::vector<int> items(Batch, 1);
+		std::atomic<int> sum(0);
+
+		for (auto _ : state) {
+			pool.submit_bulk(items, [&sum](int x) { sum.fetch_add(x, std::memory_order_relaxed); }).get();
+		}
+		benchmark::DoNotOptimize(sum.load());
+
+		state.SetItemsProcessed(state.iterations() * Batch);
+		state.SetLabel(handoff_name(handoff));
+	}
+}
+
+BENCHMARK(BM_CustomThreadPool_RoundTrip)->ArgsProduct({ { 0, 1 }, { 1, 2, 4 } })->UseRealTime();
+BENCHMARK(BM_CustomThreadPool_Batch)->ArgsProduct({ { 0, 1 }, { 1, 2, 4 } })->UseRealTime();
+BENCHMARK(BM_CustomThreadPool_ScheduleRoundTrip)->ArgsProduct({ { 0, 1 }, { 1, 2, 4 } })->UseRealTime();
+BENCHMARK(BM_CustomThreadPool_ScheduleBatch)->ArgsProduct({ { 0, 1 }, { 1, 2, 4 } })->UseRealTime();
+BENCHMARK(BM_CustomThreadPool_SubmitBulk)->ArgsProduct({ { 0, 1 }, { 1, 2, 4 } })->UseRealTime();
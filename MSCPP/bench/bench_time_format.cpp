@@ -0,0 +1,301 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_time_format.cpp
+/// @brief suite bench_time_format : C++/Time.cpp 의 timestamp 변환/포맷 경로
+///
+///   데모 .cpp 를 그대로 include 한다(unity build). Win32 time zone API 부분은 _WIN32 에서만 빌드된다.
+///
+///   BM_GetTimeStamp      : time() + gmtime_s + strftime (Time::getTimeStamp 그대로)
+///   BM_GmTime / LocalTime : time_t -> tm 변환만 (thread-safe *_s vs 공유 버퍼 버전)
+///   BM_Strftime / PutTime : tm -> 문자열 포맷만
+///   BM_MkGmTime          : tm -> time_t 역변환
+///
+///   logging hot path : now() -> "YYYY-MM-DD HH:MM:SS.ffffff" 를 호출자 buffer 에 (1 ~ 16 스레드)
+///   BM_Now_Timestamp<Precision> : Libs/timestamp.h (스레드별 prefix 캐시, 초/소수 초만 다시 씀)
+///   BM_Now_Strftime            : gmtime_s + strftime + 소수 초 snprintf
+///   BM_Now_StdFormat           : std::format_to_n("{:%F %T}", floor<microseconds>(now)) (C++20 <format> 이 있을 때만)
+///
+///   bulk UTC -> local (1M timestamps, 스레드마다 자기 구간)
+///   BM_Bulk_TzTable<Sorted>    : Libs/tz_table.h span 변환 (sorted = 이벤트 로그 순서, random = 20년 범위 무작위)
+///   BM_Bulk_TzTable_ToUtc      : 역변환 (local -> UTC)
+///   BM_Bulk_LocalTimeR         : 값마다 localtime_s (TZ 는 미리 한 번 설정)
+///   BM_Bulk_MkTime             : 값마다 mktime (local tm -> UTC)
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++/Time.cpp"
+
+#include <random>
+
+#if defined(__has_include)
+#if __has_include(<format>)
+#include <format>
+#endif
+#endif
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+	using namespace Time;
+
+	const std::time_t SampleTime = 1700000000;     // 2023-11-14 22:13:20 UTC
+
+	void BM_GetTimeStamp(benchmark::State& state)
+	{
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(getTimeStamp());
+		}
+	}
+	BENCHMARK(BM_GetTimeStamp)->ThreadRange(1, 4)->UseRealTime();
+
+	void BM_GmTime_Safe(benchmark::State& state)
+	{
+		std::tm tm{};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(safe_gmtime(SampleTime, tm));
+		}
+	}
+	BENCHMARK(BM_GmTime_Safe);
+
+	void BM_GmTime_Unsafe(benchmark::State& state)
+	{
+		std::tm tm{};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(unsafe_gmtime(SampleTime, tm));
+		}
+	}
+	BENCHMARK(BM_GmTime_Unsafe);
+
+	void BM_LocalTime_Safe(benchmark::State& state)
+	{
+		std::tm tm{};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(safe_localtime(SampleTime, tm));
+		}
+	}
+	BENCHMARK(BM_LocalTime_Safe)->ThreadRange(1, 4)->UseRealTime();
+
+	void BM_LocalTime_Unsafe(benchmark::State& state)
+	{
+		std::tm tm{};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(unsafe_localtime(SampleTime, tm));
+		}
+	}
+	BENCHMARK(BM_LocalTime_Unsafe);
+
+	void BM_Strftime(benchmark::State& state)
+	{
+		std::tm tm{};
+		safe_gmtime(SampleTime, tm);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(format_tm(tm, "%Y-%m-%d %H:%M:%S"));
+		}
+	}
+	BENCHMARK(BM_Strftime);
+
+	void BM_PutTime(benchmark::State& state)
+	{
+		std::tm tm{};
+		safe_gmtime(SampleTime, tm);
+		for (auto _ : state) {
+			std::ostringstream os;
+			os << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+			benchmark::DoNotOptimize(os.str());
+		}
+	}
+	BENCHMARK(BM_PutTime);
+
+	void BM_MkGmTime(benchmark::State& state)
+	{
+		std::tm tm{};
+		safe_gmtime(SampleTime, tm);
+		for (auto _ : state) {
+			std::tm copy = tm;
+			benchmark::DoNotOptimize(mkgmtime(&copy));
+		}
+	}
+	BENCHMARK(BM_MkGmTime);
+
+	//=============================================================================================
+	// logging hot path (호출자 buffer, 할당 없음)
+	//=============================================================================================
+	template<Timestamp::Precision P>
+	void BM_Now_Timestamp(benchmark::State& state)
+	{
+		char buf[Timestamp::BufferSize];
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(Timestamp::format_now(buf, sizeof(buf), P));
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_TEMPLATE(BM_Now_Timestamp, Timestamp::Precision::Seconds)->ThreadRange(1, 16)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_Now_Timestamp, Timestamp::Precision::Milliseconds)->ThreadRange(1, 16)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_Now_Timestamp, Timestamp::Precision::Microseconds)->ThreadRange(1, 16)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_Now_Timestamp, Timestamp::Precision::Nanoseconds)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_Now_Timestamp_Local(benchmark::State& state)
+	{
+		char buf[Timestamp::BufferSize];
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(Timestamp::format_now(buf, sizeof(buf), Timestamp::Precision::Microseconds, Timestamp::Zone::Local));
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Now_Timestamp_Local)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_Now_Strftime(benchmark::State& state)
+	{
+		char buf[Timestamp::BufferSize];
+		for (auto _ : state) {
+			const auto now = std::chrono::system_clock::now();
+			const auto us = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+
+			std::tm tm{};
+			safe_gmtime(static_cast<std::time_t>(us / 1000000), tm);
+			const size_t n = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+			snprintf(buf + n, sizeof(buf) - n, ".%06d", static_cast<int>(us % 1000000));
+			benchmark::DoNotOptimize(buf);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Now_Strftime)->ThreadRange(1, 16)->UseRealTime();
+
+#if defined(__cpp_lib_format) && defined(__cpp_lib_chrono) && __cpp_lib_chrono >= 201907L
+	void BM_Now_StdFormat(benchmark::State& state)
+	{
+		char buf[Timestamp::BufferSize];
+		for (auto _ : state) {
+			const auto now = std::chrono::floor<std::chrono::microseconds>(std::chrono::system_clock::now());
+			const auto r = std::format_to_n(buf, sizeof(buf) - 1, "{:%F %T}", now);
+			*r.out = '\0';
+			benchmark::DoNotOptimize(buf);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Now_StdFormat)->ThreadRange(1, 16)->UseRealTime();
+#endif
+
+	//=============================================================================================
+	// bulk UTC <-> local
+	//=============================================================================================
+	const char* const BulkZone = "America/New_York";
+	const size_t BulkCount = 1 << 20;
+
+	const std::vector<std::int64_t>& bulk_input(bool sorted)
+	{
+		static const auto make = [](bool sort) {
+			std::mt19937_64 rng(42);
+			std::uniform_int_distribution<std::int64_t> dist(1420070400, 2051222400);     // 2015 ~ 2035
+			std::vector<std::int64_t> v(BulkCount);
+			for (auto& t : v) t = dist(rng);
+			if (sort) std::sort(v.begin(), v.end());
+			return v;
+		};
+		static const std::vector<std::int64_t> sortedInput = make(true);
+		static const std::vector<std::int64_t> randomInput = make(false);
+		return sorted ? sortedInput : randomInput;
+	}
+
+	// 스레드마다 입력의 자기 몫만 변환 (처리량 = 전체 timestamp / 초)
+	template<bool Sorted>
+	void BM_Bulk_TzTable(benchmark::State& state)
+	{
+		auto zone = TzTable::ZoneCache::instance().get(BulkZone);
+		if (!zone) {
+			state.SkipWithError("zoneinfo not found");
+			return;
+		}
+
+		const auto& in = bulk_input(Sorted);
+		const size_t chunk = in.size() / state.threads();
+		const std::int64_t* first = in.data() + chunk * state.thread_index();
+		std::vector<std::int64_t> out(chunk);
+
+		for (auto _ : state) {
+			zone->to_local(first, out.data(), chunk);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * chunk);
+	}
+	BENCHMARK_TEMPLATE(BM_Bulk_TzTable, true)->ThreadRange(1, 16)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_Bulk_TzTable, false)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_Bulk_TzTable_ToUtc(benchmark::State& state)
+	{
+		auto zone = TzTable::ZoneCache::instance().get(BulkZone);
+		if (!zone) {
+			state.SkipWithError("zoneinfo not found");
+			return;
+		}
+
+		const auto& in = bulk_input(true);
+		const size_t chunk = in.size() / state.threads();
+		std::vector<std::int64_t> local(chunk), out(chunk);
+		zone->to_local(in.data() + chunk * state.thread_index(), local.data(), chunk);
+
+		for (auto _ : state) {
+			zone->to_utc(local.data(), out.data(), chunk);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * chunk);
+	}
+	BENCHMARK(BM_Bulk_TzTable_ToUtc)->ThreadRange(1, 16)->UseRealTime();
+
+	// CRT 경로 : TZ 는 측정 전에 한 번만 바꾼다 (값마다 바꾸면 다른 스레드와 섞임)
+	void set_bulk_tz(benchmark::State& state)
+	{
+		if (0 == state.thread_index()) {
+			Time::setenv("TZ", BulkZone, 1);
+			_tzset();
+		}
+	}
+
+	void BM_Bulk_LocalTimeR(benchmark::State& state)
+	{
+		set_bulk_tz(state);
+
+		const auto& in = bulk_input(true);
+		const size_t chunk = in.size() / state.threads();
+		const std::int64_t* first = in.data() + chunk * state.thread_index();
+		std::vector<std::int64_t> out(chunk);
+
+		for (auto _ : state) {
+			for (size_t i = 0; i < chunk; ++i) {
+				std::tm tm{};
+				safe_localtime((std::time_t)first[i], tm);
+				out[i] = (std::int64_t)mkgmtime(&tm);
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * chunk);
+	}
+	BENCHMARK(BM_Bulk_LocalTimeR)->ThreadRange(1, 16)->UseRealTime();
+
+	void BM_Bulk_MkTime(benchmark::State& state)
+	{
+		set_bulk_tz(state);
+
+		const auto& in = bulk_input(true);
+		const size_t chunk = in.size() / state.threads();
+		std::vector<std::tm> local(chunk);
+		for (size_t i = 0; i < chunk; ++i) {
+			safe_gmtime((std::time_t)(in[chunk * state.thread_index() + i] - 5 * 3600), local[i]);
+		}
+		std::vector<std::int64_t> out(chunk);
+
+		for (auto _ : state) {
+			for (size_t i = 0; i < chunk; ++i) {
+				std::tm tm = local[i];
+				tm.tm_isdst = -1;
+				out[i] = (std::int64_t)std::mktime(&tm);
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * chunk);
+	}
+	BENCHMARK(BM_Bulk_MkTime)->ThreadRange(1, 16)->UseRealTime();
+}
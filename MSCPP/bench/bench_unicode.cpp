@@ -0,0 +1,220 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file bench_unicode.cpp
+/// @brief suite bench_unicode : Libs/utf_transcode.h 검증/변환 처리량 (kernel 별) vs std::codecvt
+///
+///   C++/Unicode.cpp 는 atlstr.h(MFC) 를 쓰므로 include 하지 않고, 거기서 쓰던 변환 경로를 대신 잰다.
+///
+///   입력 (각각 약 1 MB, UTF-8)
+///     Ascii  : 영문 + 코드 (ASCII 100%)
+///     Korean : 이 저장소 소스의 한글 주석 줄 (MSCPP_SOURCE_DIR 의 UTF-8 파일에서 추출, 없으면 합성)
+///     Emoji  : 4 byte 이모지 + 공백 (UTF-16 서로게이트 쌍)
+///
+///   BM_Validate<Corpus, Kernel>          : validate_utf8
+///   BM_Utf16Length<Corpus, Kernel>       : utf16_length_from_utf8 (출력 길이 예측)
+///   BM_Utf8ToUtf16<Corpus, Kernel>       : 길이 예측 + 검증하면서 변환 (append_from_utf8)
+///   BM_Utf16ToUtf8<Corpus, Kernel>       : 역방향
+///   BM_Codecvt_Utf8ToUtf16<Corpus>       : std::wstring_convert<codecvt_utf8_utf16<char16_t>> (예전 경로)
+///   처리량은 입력 byte 기준(bytes_per_second, GB/s)
+///////////////////////////////////////////////////////////////////////////////
+#include "utf_transcode.h"
+
+#include <codecvt>
+#include <fstream>
+#include <locale>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#if !defined(MSCPP_SOURCE_DIR)
+#define MSCPP_SOURCE_DIR "."
+#endif
+
+
+namespace
+{
+	enum class Corpus { Ascii, Korean, Emoji };
+
+	const size_t CorpusBytes = 1 << 20;
+
+	void repeat_to(std::string& s, size_t bytes)
+	{
+		const std::string unit = s;
+		while (s.size() < bytes) s += unit;
+	}
+
+	std::string make_ascii()
+	{
+		std::string s;
+		std::mt19937 rng(1);
+		static const char* const Words[] = { "int", "return", "const", "std::string", "value", "for", "(size_t i = 0; i < n; ++i)", "{", "}", "template<typename T>", "buffer", "Result" };
+		while (s.size() < CorpusBytes) {
+			s += Words[rng() % (sizeof(Words) / sizeof(Words[0]))];
+			s += (0 == rng() % 8) ? '\n' : ' ';
+		}
+		return s;
+	}
+
+	// 저장소 소스의 한글 주석 줄 (UTF-8 이 아닌 CP949 파일은 validate 로 걸러진다)
+	std::string make_korean()
+	{
+		static const char* const Files[] = {
+			"/C++/Time.cpp", "/C++/ThreadLocalStorage.cpp", "/C++11/DCAS.cpp",
+			"/Libs/string_engine.h", "/Libs/timestamp.h", "/Libs/tz_table.h", "/Libs/utf_transcode.h",
+			"/Libs/reclamation.h", "/Libs/treiber_stack.h", "/Libs/flat_combining.h",
+		};
+
+		std::string s;
+		for (const char* file : Files) {
+			std::ifstream in(std::string(MSCPP_SOURCE_DIR) + file, std::ios::binary);
+			std::string line;
+			while (std::getline(in, line)) {
+				const size_t comment = line.find("//");
+				if (std::string::npos == comment) continue;
+
+				const char* p = line.data() + comment;
+				const size_t n = line.size() - comment;
+				if (!Utf::validate_utf8(p, n).ok() || Utf::utf32_length_from_utf8(p, n) == n) continue;     // 깨졌거나 ASCII 뿐
+				s.append(p, n);
+				s += '\n';
+			}
+		}
+
+		if (s.empty()) {
+			// 소스가 없으면 한글 음절 + 공백
+			std::mt19937 rng(2);
+			std::u32string u;
+			for (int i = 0; i < 4096; ++i) u += (0 == rng() % 4) ? U' ' : static_cast<char32_t>(0xAC00 + rng() % 11172);
+			s = Utf::to_utf8(u);
+		}
+		repeat_to(s, CorpusBytes);
+		return s;
+	}
+
+	std::string make_emoji()
+	{
+		std::mt19937 rng(3);
+		std::u32string u;
+		for (int i = 0; i < 4096; ++i) u += (0 == rng() % 3) ? U' ' : static_cast<char32_t>(0x1F300 + rng() % 0x300);
+		std::string s = Utf::to_utf8(u);
+		repeat_to(s, CorpusBytes);
+		return s;
+	}
+
+	const std::string& corpus(Corpus c)
+	{
+		static const std::string ascii = make_ascii();
+		static const std::string korean = make_korean();
+		static const std::string emoji = make_emoji();
+		return Corpus::Ascii == c ? ascii : Corpus::Korean == c ? korean : emoji;
+	}
+
+	const std::u16string& corpus16(Corpus c)
+	{
+		static const std::u16string ascii = Utf::to_u16string(corpus(Corpus::Ascii));
+		static const std::u16string korean = Utf::to_u16string(corpus(Corpus::Korean));
+		static const std::u16string emoji = Utf::to_u16string(corpus(Corpus::Emoji));
+		return Corpus::Ascii == c ? ascii : Corpus::Korean == c ? korean : emoji;
+	}
+
+	// 측정 동안만 kernel 을 바꾼다
+	class KernelScope
+	{
+	public:
+		explicit KernelScope(Utf::Kernel k) : _ok(Utf::set_kernel(k)) {}
+		~KernelScope() { Utf::set_kernel(Utf::best_kernel()); }
+		bool ok() const { return _ok; }
+
+	private:
+		bool _ok;
+	};
+
+#define UTF_BENCH_KERNEL_SCOPE(state, K)                               \
+	KernelScope scope(K);                                              \
+	if (!scope.ok()) {                                                 \
+		state.SkipWithError("kernel not supported on this CPU");       \
+		return;                                                        \
+	}
+
+	template<Corpus C, Utf::Kernel K>
+	void BM_Validate(benchmark::State& state)
+	{
+		UTF_BENCH_KERNEL_SCOPE(state, K)
+		const std::string& in = corpus(C);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(Utf::validate_utf8(in.data(), in.size()));
+		}
+		state.SetBytesProcessed(state.iterations() * in.size());
+	}
+
+	template<Corpus C, Utf::Kernel K>
+	void BM_Utf16Length(benchmark::State& state)
+	{
+		UTF_BENCH_KERNEL_SCOPE(state, K)
+		const std::string& in = corpus(C);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(Utf::utf16_length_from_utf8(in.data(), in.size()));
+		}
+		state.SetBytesProcessed(state.iterations() * in.size());
+	}
+
+	template<Corpus C, Utf::Kernel K>
+	void BM_Utf8ToUtf16(benchmark::State& state)
+	{
+		UTF_BENCH_KERNEL_SCOPE(state, K)
+		const std::string& in = corpus(C);
+		std::u16string out;
+		for (auto _ : state) {
+			out.clear();
+			benchmark::DoNotOptimize(Utf::append_from_utf8(in.data(), in.size(), out));
+			benchmark::ClobberMemory();
+		}
+		state.SetBytesProcessed(state.iterations() * in.size());
+	}
+
+	template<Corpus C, Utf::Kernel K>
+	void BM_Utf16ToUtf8(benchmark::State& state)
+	{
+		UTF_BENCH_KERNEL_SCOPE(state, K)
+		const std::u16string& in = corpus16(C);
+		std::string out;
+		for (auto _ : state) {
+			out.clear();
+			benchmark::DoNotOptimize(Utf::append_to_utf8(in.data(), in.size(), out));
+			benchmark::ClobberMemory();
+		}
+		state.SetBytesProcessed(state.iterations() * in.size() * sizeof(char16_t));
+	}
+
+	template<Corpus C>
+	void BM_Codecvt_Utf8ToUtf16(benchmark::State& state)
+	{
+		const std::string& in = corpus(C);
+		std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(convert.from_bytes(in));
+		}
+		state.SetBytesProcessed(state.iterations() * in.size());
+	}
+
+#define UTF_BENCH_KERNELS(bm, corpus)                                                  \
+	BENCHMARK_TEMPLATE(bm, corpus, Utf::Kernel::Scalar);                               \
+	BENCHMARK_TEMPLATE(bm, corpus, Utf::Kernel::Sse41);                                \
+	BENCHMARK_TEMPLATE(bm, corpus, Utf::Kernel::Avx2);                                 \
+	BENCHMARK_TEMPLATE(bm, corpus, Utf::Kernel::Neon)
+
+#define UTF_BENCH_CORPORA(bm)                                                          \
+	UTF_BENCH_KERNELS(bm, Corpus::Ascii);                                              \
+	UTF_BENCH_KERNELS(bm, Corpus::Korean);                                             \
+	UTF_BENCH_KERNELS(bm, Corpus::Emoji)
+
+	UTF_BENCH_CORPORA(BM_Validate);
+	UTF_BENCH_CORPORA(BM_Utf16Length);
+	UTF_BENCH_CORPORA(BM_Utf8ToUtf16);
+	UTF_BENCH_CORPORA(BM_Utf16ToUtf8);
+
+	BENCHMARK_TEMPLATE(BM_Codecvt_Utf8ToUtf16, Corpus::Ascii);
+	BENCHMARK_TEMPLATE(BM_Codecvt_Utf8ToUtf16, Corpus::Korean);
+	BENCHMARK_TEMPLATE(BM_Codecvt_Utf8ToUtf16, Corpus::Emoji);
+}
@@ -0,0 +1,100 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file test_event_hub_fire_parallel.cpp
+/// @brief Libs/event_hub.h : fire_parallel 이 pool 작업을 기다리는 동안 epoch guard 를 잡고 있지 않은지 검증
+///
+///   작업자 1 개 CustomThreadPool(C++11/AsyncAndFuture.cpp) 에서 다른 작업이 ScopedSubscription 을 파괴
+///   (=> EpochReclamation::synchronize) 하는 동안 fire_parallel 을 부른다. guard 를 쥔 채 기다리면 서로를 기다려 멈춘다.
+///   그 밖에 chunk 마다 구독자가 정확히 한 번씩 불리는지, 콜백 예외가 호출자에게 전달되는지 확인한다.
+///   하나라도 실패하면 exit code 1 (멈추면 ctest TIMEOUT)
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++11/AsyncAndFuture.cpp"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "event_hub.h"
+
+
+namespace
+{
+	using Hub = Events::EventHub<int>;
+
+	bool scoped_destroy_on_worker(Hub& hub, AsyncAndFuture::CustomThreadPool& pool, std::atomic<long>& calls)
+	{
+		std::unique_ptr<Events::ScopedSubscription> scoped(new Events::ScopedSubscription(hub.subscribe_scoped(Hub::Callback([](int) {}))));
+
+		// 작업자를 먼저 붙잡아 두고, fire_parallel 이 guard 안에 들어간 뒤 구독을 파괴
+		std::atomic<bool> firing{ false };
+		auto destroyed = pool.submit([&scoped, &firing] {
+			while (!firing.load(std::memory_order_acquire)) std::this_thread::yield();
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			scoped.reset();
+		});
+
+		calls.store(0);
+		firing.store(true, std::memory_order_release);
+		hub.fire_parallel(pool, 1);
+		destroyed.get();
+
+		const bool ok = calls.load() == 64 && hub.size() == 64;
+		std::cout << "[scoped destroy on worker] calls=" << calls.load() << " size=" << hub.size()
+			<< (ok ? " OK" : " FAILED") << std::endl;
+		return ok;
+	}
+
+	bool every_subscriber_once(Hub& hub, AsyncAndFuture::CustomThreadPool& pool, std::atomic<long>& calls)
+	{
+		const int Fires = 1000;
+
+		calls.store(0);
+		for (int i = 0; i < Fires; ++i) hub.fire_parallel(pool, i);
+
+		const bool ok = calls.load() == 64L * Fires;
+		std::cout << "[every subscriber once] calls=" << calls.load() << " expected=" << 64L * Fires
+			<< (ok ? " OK" : " FAILED") << std::endl;
+		return ok;
+	}
+
+	bool exception_reaches_caller(Hub& hub, AsyncAndFuture::CustomThreadPool& pool)
+	{
+		const Events::SubscriptionId id = hub.subscribe(Hub::Callback([](int v) {
+			if (v < 0) throw std::runtime_error("callback failed");
+		}));
+
+		bool caught = false;
+		try {
+			hub.fire_parallel(pool, -1);
+		}
+		catch (const std::runtime_error&) {
+			caught = true;
+		}
+		hub.unsubscribe(id);
+
+		std::cout << "[exception reaches caller] " << (caught ? "OK" : "FAILED") << std::endl;
+		return caught;
+	}
+}
+
+
+int main()
+{
+	AsyncAndFuture::CustomThreadPool pool(1);
+
+	Events::HubOptions options;
+	options.parallel_chunk = 4;     // 64 구독자 => chunk 16 개
+	Hub hub(options);
+
+	std::atomic<long> calls{ 0 };
+	for (int i = 0; i < 64; ++i)
+		hub.subscribe(Hub::Callback([&calls](int) { calls.fetch_add(1, std::memory_order_relaxed); }));
+
+	bool ok = true;
+	ok &= scoped_destroy_on_worker(hub, pool, calls);
+	ok &= every_subscriber_once(hub, pool, calls);
+	ok &= exception_reaches_caller(hub, pool);
+
+	return ok ? 0 : 1;
+}
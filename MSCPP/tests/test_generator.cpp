@@ -0,0 +1,208 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file test_generator.cpp
+/// @brief Libs/generator.h Coro::Generator 와 co_yield elements_of 동작 검증
+///
+///   - 중첩 elements_of : 재귀 Generator(트리 전위 순회) 와 일반 range(vector) 위임, 원소 순서
+///   - 예외 : 안쪽 Generator 예외가 co_yield elements_of 지점에서 다시 던져지는지(잡고 계속 낼 수 있는지),
+///            아무도 잡지 않으면 여러 단계를 지나 반복자 ++ 를 부른 쪽으로 오는지
+///   - 일찍 파괴 : 중첩 도중 반복을 멈추고 Generator 를 파괴하면 모든 frame 의 지역 객체가 소멸하는지
+///   하나라도 실패하면 exit code 1 (MSCPP_SANITIZE=address 면 frame 누수도 드러난다)
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "generator.h"
+
+
+namespace
+{
+	bool check(const char* name, bool ok)
+	{
+		std::cout << "[" << name << "] " << (ok ? "OK" : "FAILED") << std::endl;
+		return ok;
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 중첩 elements_of
+	//---------------------------------------------------------------------------------------------
+	struct Node
+	{
+		int value;
+		std::vector<Node> children;
+	};
+
+	// 전위 순회 : 자식 subtree 는 재귀 Generator 로 위임
+	Coro::Generator<int> preorder(const Node& node)
+	{
+		co_yield node.value;
+		for (const Node& child : node.children)
+			co_yield Coro::elements_of(preorder(child));
+	}
+
+	Coro::Generator<int> tail()
+	{
+		co_yield 20;
+		co_yield 21;
+	}
+
+	Coro::Generator<int> mixed(const std::vector<int>& values)
+	{
+		co_yield 0;
+		co_yield Coro::elements_of(values);     // Generator 가 아닌 range
+		co_yield Coro::elements_of(tail());     // 다시 Generator
+		co_yield 99;
+	}
+
+	// depth 단계로 중첩된 뒤 leaf 에서 하나만 낸다
+	Coro::Generator<int> chain(int depth)
+	{
+		if (depth == 0) {
+			co_yield 42;
+			co_return;
+		}
+		co_yield Coro::elements_of(chain(depth - 1));
+	}
+
+	bool nested_elements_of()
+	{
+		const Node tree{ 1, { Node{ 2, { Node{ 3, {} }, Node{ 4, {} } } }, Node{ 5, { Node{ 6, { Node{ 7, {} } } } } } } };
+		std::vector<int> seen;
+		for (int v : preorder(tree)) seen.push_back(v);
+		bool ok = check("elements_of tree", seen == std::vector<int>{ 1, 2, 3, 4, 5, 6, 7 });
+
+		const std::vector<int> values{ 10, 11, 12 };
+		seen.clear();
+		for (int v : mixed(values)) seen.push_back(v);
+		ok &= check("elements_of range + generator", seen == std::vector<int>{ 0, 10, 11, 12, 20, 21, 99 });
+
+		seen.clear();
+		for (int v : chain(1000)) seen.push_back(v);
+		ok &= check("elements_of depth 1000", seen == std::vector<int>{ 42 });
+		return ok;
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 예외 전달
+	//---------------------------------------------------------------------------------------------
+	Coro::Generator<int> failing(int before)
+	{
+		for (int i = 0; i < before; ++i) co_yield i;
+		throw std::runtime_error("leaf failed");
+	}
+
+	// 안쪽 예외를 elements_of 지점에서 잡고 계속 낸다
+	Coro::Generator<int> recovering()
+	{
+		bool caught = false;
+		try {
+			co_yield Coro::elements_of(failing(2));
+		}
+		catch (const std::runtime_error&) {
+			caught = true;                      // handler 안에서는 co_yield 불가
+		}
+		if (caught) co_yield -1;
+		co_yield 100;
+	}
+
+	// 잡지 않고 그대로 통과
+	Coro::Generator<int> passing(int depth)
+	{
+		co_yield depth;
+		if (depth == 0)
+			co_yield Coro::elements_of(failing(1));
+		else
+			co_yield Coro::elements_of(passing(depth - 1));
+		co_yield -2;                            // 오면 안 된다
+	}
+
+	bool exception_propagation()
+	{
+		std::vector<int> seen;
+		for (int v : recovering()) seen.push_back(v);
+		bool ok = check("exception caught at elements_of", seen == std::vector<int>{ 0, 1, -1, 100 });
+
+		seen.clear();
+		bool rethrown = false;
+		try {
+			for (int v : passing(3)) seen.push_back(v);
+		}
+		catch (const std::runtime_error&) {
+			rethrown = true;
+		}
+		ok &= check("exception reaches iterator", rethrown && seen == std::vector<int>{ 3, 2, 1, 0, 0 });
+
+		// 첫 원소 전에 던지면 begin() 에서
+		rethrown = false;
+		try {
+			Coro::Generator<int> g = failing(0);
+			(void)g.begin();
+		}
+		catch (const std::runtime_error&) {
+			rethrown = true;
+		}
+		ok &= check("exception from begin", rethrown);
+		return ok;
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 일찍 파괴
+	//---------------------------------------------------------------------------------------------
+	int live_locals = 0;
+
+	struct Local
+	{
+		Local() { ++live_locals; }
+		~Local() { --live_locals; }
+		Local(const Local&) = delete;
+		Local& operator=(const Local&) = delete;
+	};
+
+	Coro::Generator<int> guarded(int depth)
+	{
+		Local local;
+		co_yield depth;
+		if (depth > 0) co_yield Coro::elements_of(guarded(depth - 1));
+		for (int i = 0; i < 3; ++i) co_yield 1000 + i;
+	}
+
+	bool early_destruction()
+	{
+		int peak = 0;
+		int count = 0;
+		{
+			Coro::Generator<int> g = guarded(4);
+			for (int v : g) {
+				(void)v;
+				if (live_locals > peak) peak = live_locals;
+				if (++count == 6) break;        // leaf 에서 1000 을 낸 직후 : 다섯 frame 모두 살아 있음
+			}
+		}
+		bool ok = check("early destruction (nested)", peak == 5 && live_locals == 0);
+
+		// 시작도 하지 않고 파괴 (initial_suspend 라 Local 이 만들어지지 않는다)
+		{
+			Coro::Generator<int> g = guarded(2);
+		}
+		ok &= check("destroy before begin", live_locals == 0);
+
+		// 끝까지 돈 경우
+		count = 0;
+		for (int v : guarded(2)) {
+			(void)v;
+			++count;
+		}
+		ok &= check("run to completion", live_locals == 0 && count == 3 + 3 * 3);
+		return ok;
+	}
+}
+
+
+int main()
+{
+	bool ok = true;
+	ok &= nested_elements_of();
+	ok &= exception_propagation();
+	ok &= early_destruction();
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,310 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file test_object_pool.cpp
+/// @brief Libs/object_pool.h : 스레드 사이 반환, 스레드 종료, 동시 사용 중 trim
+///
+///   - 스레드 사이 반환 : 생산자가 Acquire 한 객체를 소비자가 Release. 값이 그대로 오고, round 를 거듭해도 chunk 가 늘지 않는지
+///   - 풀이 살아 있는 동안 스레드 종료 : thread cache 의 magazine 이 depot 으로 돌아와 trim() 으로 chunk 를 돌려받는지,
+///                                      다른 스레드가 다시 빌려도 chunk 가 늘지 않는지
+///   - 풀이 먼저 파괴된 뒤 스레드 종료 : 죽은 cache 를 건드리지 않는지, 같은 스레드가 새 풀을 써도 되는지 (ASan 으로 확인)
+///   - thread_local 소멸자에서 Release (thread cache 가 이미 소멸) : orphan 경로
+///   - 여러 스레드가 Acquire/Release 하는 동안 trim() : 같은 slot 이 두 번 나가지 않고, 끝나면 chunk 하나만 남는지
+///   하나라도 실패하면 exit code 1
+///////////////////////////////////////////////////////////////////////////////
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "object_pool.h"
+
+
+namespace
+{
+	struct Item
+	{
+		uint64_t v[8];      // 64 B
+
+		explicit Item(uint64_t value = 0)
+		{
+			for (uint64_t& x : v) x = value;
+		}
+
+		bool holds(uint64_t value) const
+		{
+			for (uint64_t x : v)
+				if (x != value) return false;
+			return true;
+		}
+	};
+
+	using Pool = Pooling::ObjectPool<Item>;
+
+	bool check(const char* name, bool ok)
+	{
+		std::cout << "[" << name << "] " << (ok ? "OK" : "FAILED") << std::endl;
+		return ok;
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 스레드 사이 반환 : 생산자 Acquire => 소비자 Release
+	//---------------------------------------------------------------------------------------------
+	bool cross_thread_release()
+	{
+		const size_t Batch = 20000;
+		const int Rounds = 20;
+
+		Pool pool;
+		std::mutex lock;
+		std::condition_variable ready;
+		std::deque<std::vector<Pool::PooledPtr>> queue;
+		bool done = false;
+
+		std::atomic<bool> values_ok{ true };
+		std::atomic<size_t> released{ 0 };
+		std::thread consumer([&] {
+			uint64_t expected = 0;
+			for (;;) {
+				std::vector<Pool::PooledPtr> batch;
+				{
+					std::unique_lock<std::mutex> guard(lock);
+					ready.wait(guard, [&] { return done || !queue.empty(); });
+					if (queue.empty()) break;
+					batch = std::move(queue.front());
+					queue.pop_front();
+				}
+				for (auto& p : batch) {
+					if (!p->holds(expected++)) values_ok = false;
+				}
+				const size_t n = batch.size();
+				batch.clear();      // 이 스레드의 cache 로 반환
+				released += n;
+			}
+		});
+
+		size_t first_round_chunks = 0;
+		uint64_t next = 0;
+		for (int round = 0; round < Rounds; ++round) {
+			std::vector<Pool::PooledPtr> batch;
+			batch.reserve(Batch);
+			for (size_t i = 0; i < Batch; ++i) batch.push_back(pool.Acquire(next++));
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				queue.push_back(std::move(batch));
+			}
+			ready.notify_one();
+
+			// 소비자가 따라올 때까지 기다린다 => 살아 있는 객체는 많아야 Batch 개
+			while (released.load() < next) std::this_thread::yield();
+			if (round == 0) first_round_chunks = pool.chunk_count();
+		}
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			done = true;
+		}
+		ready.notify_one();
+		consumer.join();
+
+		const size_t last_round_chunks = pool.chunk_count();
+		std::cout << "[cross-thread release] chunks " << first_round_chunks << " -> " << last_round_chunks << std::endl;
+		return check("cross-thread release values", values_ok && released.load() == Batch * Rounds)
+			& check("cross-thread release chunks", last_round_chunks <= first_round_chunks + 1);
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 풀이 살아 있는 동안 스레드 종료
+	//---------------------------------------------------------------------------------------------
+	bool thread_exit_with_live_pool()
+	{
+		const size_t PerThread = 10000;
+		const int Threads = 4;
+
+		Pool pool;
+		std::atomic<int> filled{ 0 };
+		auto churn = [&pool, &filled, PerThread, Threads] {
+			std::vector<Pool::PooledPtr> batch;
+			for (size_t i = 0; i < PerThread; ++i) batch.push_back(pool.Acquire(i));
+			// 모두 채울 때까지 쥐고 있는다 => 두 번 모두 살아 있는 객체 수가 Threads * PerThread
+			++filled;
+			while (filled.load() % Threads) std::this_thread::yield();
+			batch.clear();      // magazine 은 이 스레드 cache 에 남은 채로 종료
+		};
+
+		std::vector<std::thread> workers;
+		for (int i = 0; i < Threads; ++i) workers.emplace_back(churn);
+		for (auto& t : workers) t.join();
+		workers.clear();
+
+		const size_t peak = pool.chunk_count();
+		pool.trim();
+		const size_t after = pool.chunk_count();
+		bool ok = check("thread exit returns magazines", after == 1 && peak > 1);
+
+		// 다른 스레드가 다시 빌린다 : depot / 돌아온 slot 을 먼저 쓴다
+		for (int i = 0; i < Threads; ++i) workers.emplace_back(churn);
+		for (auto& t : workers) t.join();
+		ok &= check("reuse after thread exit", pool.chunk_count() <= peak);
+
+		// 객체를 쥔 채 끝난 스레드 : 다른 스레드(main)가 나중에 반환
+		std::vector<Pool::PooledPtr> kept;
+		std::thread holder([&] {
+			for (size_t i = 0; i < PerThread; ++i) kept.push_back(pool.Acquire(i));
+		});
+		holder.join();
+		bool values = true;
+		for (size_t i = 0; i < kept.size(); ++i) values &= kept[i]->holds(i);
+		kept.clear();
+		pool.flush_thread_cache();
+		pool.trim();
+		ok &= check("release after owner thread exit", values && pool.chunk_count() == 1);
+		return ok;
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 풀이 먼저 파괴된 뒤 스레드 종료
+	//---------------------------------------------------------------------------------------------
+	bool thread_exit_after_pool_destroyed()
+	{
+		std::mutex lock;
+		std::condition_variable cv;
+		int step = 0;
+		auto wait_for = [&](int s) {
+			std::unique_lock<std::mutex> guard(lock);
+			cv.wait(guard, [&] { return step >= s; });
+		};
+		auto advance = [&](int s) {
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				step = s;
+			}
+			cv.notify_all();
+		};
+
+		std::unique_ptr<Pool> first(new Pool);
+		std::unique_ptr<Pool> second;
+		bool values = true;
+
+		std::thread worker([&] {
+			{
+				std::vector<Pool::PooledPtr> batch;
+				for (uint64_t i = 0; i < 1000; ++i) batch.push_back(first->Acquire(i));
+			}
+			advance(1);
+			wait_for(2);    // main 이 first 를 파괴하고 second 를 만든다 (주소가 같을 수도 있다)
+
+			std::vector<Pool::PooledPtr> batch;
+			for (uint64_t i = 0; i < 1000; ++i) batch.push_back(second->Acquire(i + 7));
+			for (uint64_t i = 0; i < 1000; ++i) values &= batch[i]->holds(i + 7);
+			batch.clear();
+			advance(3);
+			wait_for(4);    // second 도 파괴된 뒤 종료 : 두 풀의 cache 모두 detach 없이 지운다
+		});
+
+		wait_for(1);
+		first.reset();
+		second.reset(new Pool);
+		advance(2);
+		wait_for(3);
+		second.reset();
+		advance(4);
+		worker.join();
+
+		return check("thread exit after pool destroyed", values);
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// thread_local 소멸자에서 Release : thread cache 가 먼저 소멸 => orphan list
+	//---------------------------------------------------------------------------------------------
+	struct LateRelease
+	{
+		std::vector<Pool::PooledPtr> items;
+	};
+
+	bool release_from_thread_local_destructor()
+	{
+		Pool pool;
+		std::set<const Item*> orphaned;
+		std::thread worker([&pool, &orphaned] {
+			// thread cache(첫 Acquire 에서 생성) 보다 먼저 만들어 => 나중에 소멸
+			static thread_local LateRelease late;
+			late.items.reserve(100);
+			for (uint64_t i = 0; i < 100; ++i) {
+				late.items.push_back(pool.Acquire(i));
+				orphaned.insert(late.items.back().get());
+			}
+		});
+		worker.join();
+
+		// 다음에 빌리는 스레드는 depot 의 magazine, orphan slot 순서로 받는다
+		size_t reused = 0;
+		std::thread reader([&pool, &orphaned, &reused] {
+			std::vector<Pool::PooledPtr> batch;
+			for (uint64_t i = 0; i < 200; ++i) batch.push_back(pool.Acquire(i));
+			for (auto& p : batch) reused += orphaned.count(p.get());
+		});
+		reader.join();
+		return check("release from thread_local destructor", reused == orphaned.size());
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// 여러 스레드가 쓰는 동안 trim
+	//---------------------------------------------------------------------------------------------
+	bool trim_under_concurrent_use()
+	{
+		const int Threads = 4;
+		const int Rounds = 200;
+		const size_t Batch = 2000;
+
+		Pooling::PoolOptions options;
+		options.high_water = 4;     // 자동 trim 도 같이 돈다
+		Pool pool(options);
+
+		std::atomic<bool> values_ok{ true };
+		std::atomic<bool> stop{ false };
+		std::vector<std::thread> workers;
+		for (int t = 0; t < Threads; ++t) {
+			workers.emplace_back([&, t] {
+				std::vector<Pool::PooledPtr> batch;
+				for (int round = 0; round < Rounds; ++round) {
+					const uint64_t tag = (static_cast<uint64_t>(t) << 32) | static_cast<uint64_t>(round);
+					for (size_t i = 0; i < Batch; ++i) batch.push_back(pool.Acquire(tag));
+					std::this_thread::yield();
+					for (auto& p : batch) {
+						if (!p->holds(tag)) values_ok = false;      // 다른 스레드에게도 나간 slot
+					}
+					batch.clear();
+				}
+			});
+		}
+		std::thread trimmer([&] {
+			while (!stop.load()) {
+				pool.trim();
+				std::this_thread::yield();
+			}
+		});
+		for (auto& t : workers) t.join();
+		stop = true;
+		trimmer.join();
+
+		pool.trim();
+		return check("trim under concurrent use", values_ok && pool.chunk_count() == 1);
+	}
+}
+
+
+int main()
+{
+	bool ok = true;
+	ok &= cross_thread_release();
+	ok &= thread_exit_with_live_pool();
+	ok &= thread_exit_after_pool_destroyed();
+	ok &= release_from_thread_local_destructor();
+	ok &= trim_under_concurrent_use();
+	return ok ? 0 : 1;
+}
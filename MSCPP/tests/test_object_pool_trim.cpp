@@ -0,0 +1,144 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file test_object_pool_trim.cpp
+/// @brief Libs/object_pool.h : high_water 자동 trim 의 비용과 chunk 수
+///
+///   chunk 마다 객체 하나를 붙잡아 둔 채(그 chunk 는 해제할 수 없다) Batch 개 Acquire/Release 를 Rounds 번
+///     - high_water = 8 이 high_water = 0 (trim 없음) 보다 눈에 띄게 느리지 않은지 (trim 이 같은 magazine 을 되풀이해 세지 않음)
+///     - round 를 거듭해도 chunk 수가 늘지 않는지 (trim 중에도 새 chunk 를 자르지 않음)
+///   붙잡은 객체 없이 전부 반환하면
+///     - 자동 trim 만으로 대부분의 chunk 가 OS 로 돌아가는지
+///     - flush_thread_cache() + trim() 뒤에는 current chunk 하나만 남고, 다시 빌리면 돌아온 slot 부터 쓰는지
+///   하나라도 실패하면 exit code 1
+///////////////////////////////////////////////////////////////////////////////
+#include <stdint.h>
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "object_pool.h"
+
+
+namespace
+{
+	struct Item
+	{
+		uint64_t v[8];      // 64 B => chunk 하나에 1023 개
+	};
+
+	using Pool = Pooling::ObjectPool<Item>;
+
+	const size_t Batch = 200000;
+	const int Rounds = 20;
+
+	uintptr_t chunk_of(const void* p)
+	{
+		return reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(Pooling::detail::ChunkSize - 1);
+	}
+
+	Pooling::PoolOptions with_high_water(size_t highWater)
+	{
+		Pooling::PoolOptions options;
+		options.high_water = highWater;
+		return options;
+	}
+
+	struct ChurnResult
+	{
+		double seconds;
+		size_t first_round_chunks;
+		size_t last_round_chunks;
+	};
+
+	ChurnResult churn_with_pinned(size_t highWater)
+	{
+		Pool pool(with_high_water(highWater));
+
+		// chunk 마다 하나씩 남기고 반환
+		std::vector<Pool::PooledPtr> pinned, batch;
+		batch.reserve(Batch);
+		for (size_t i = 0; i < Batch; ++i) batch.push_back(pool.Acquire());
+		std::set<uintptr_t> chunks;
+		for (auto& p : batch) {
+			if (chunks.insert(chunk_of(p.get())).second) pinned.push_back(std::move(p));
+		}
+		batch.clear();
+
+		ChurnResult r = { 0, 0, 0 };
+		const auto start = std::chrono::steady_clock::now();
+		for (int round = 0; round < Rounds; ++round) {
+			for (size_t i = 0; i < Batch; ++i) batch.push_back(pool.Acquire());
+			batch.clear();
+			if (round == 0) r.first_round_chunks = pool.chunk_count();
+		}
+		r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		r.last_round_chunks = pool.chunk_count();
+		return r;
+	}
+
+	bool trim_cost_and_chunk_growth()
+	{
+		const ChurnResult off = churn_with_pinned(0);
+		const ChurnResult on = churn_with_pinned(8);
+
+		const bool fast = on.seconds < off.seconds * 10 + 0.5;
+		const bool bounded = on.last_round_chunks <= on.first_round_chunks && on.last_round_chunks <= off.last_round_chunks;
+
+		std::cout << "[pinned churn] high_water=0 " << off.seconds * 1000 << " ms, chunks " << off.last_round_chunks
+			<< " / high_water=8 " << on.seconds * 1000 << " ms, chunks " << on.first_round_chunks << " -> " << on.last_round_chunks
+			<< " " << (fast && bounded ? "OK" : "FAILED") << std::endl;
+		return fast && bounded;
+	}
+
+	bool release_returns_chunks()
+	{
+		bool ok = true;
+
+		// 자동 trim : depot 에 남는 magazine(high_water / 2) 과 thread cache 몫의 chunk 만 남는다
+		{
+			Pool pool(with_high_water(8));
+			std::vector<Pool::PooledPtr> batch;
+			for (size_t i = 0; i < Batch; ++i) batch.push_back(pool.Acquire());
+			const size_t peak = pool.chunk_count();
+			batch.clear();
+			const size_t after = pool.chunk_count();
+
+			const bool released = after * 4 <= peak;
+			std::cout << "[auto trim] chunks " << peak << " -> " << after << " " << (released ? "OK" : "FAILED") << std::endl;
+			ok &= released;
+		}
+
+		// 수동 trim : 모두 depot 으로 보낸 뒤 trim() => current chunk 만 남는다
+		{
+			Pool pool;
+			std::vector<Pool::PooledPtr> batch;
+			for (size_t i = 0; i < Batch; ++i) batch.push_back(pool.Acquire());
+			const size_t peak = pool.chunk_count();
+			batch.clear();
+			pool.flush_thread_cache();
+			const size_t released = pool.trim();
+			const size_t after = pool.chunk_count();
+
+			const bool all = after == 1 && released == peak - 1;
+			std::cout << "[trim] chunks " << peak << " -> " << after << " (released " << released << ") " << (all ? "OK" : "FAILED") << std::endl;
+			ok &= all;
+
+			// 해제한 chunk 만큼만 다시 만든다 (current chunk 에 돌아온 slot 을 먼저 쓴다)
+			for (size_t i = 0; i < Batch; ++i) batch.push_back(pool.Acquire());
+			const bool reused = pool.chunk_count() <= peak;
+			std::cout << "[reuse after trim] chunks " << pool.chunk_count() << " " << (reused ? "OK" : "FAILED") << std::endl;
+			ok &= reused;
+		}
+		return ok;
+	}
+}
+
+
+int main()
+{
+	bool ok = true;
+	ok &= trim_cost_and_chunk_growth();
+	ok &= release_returns_chunks();
+	return ok ? 0 : 1;
+}
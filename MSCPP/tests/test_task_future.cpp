@@ -0,0 +1,139 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file test_task_future.cpp
+/// @brief Libs/task.h Tasks::Future/Promise 와 CustomThreadPool::schedule / submit_bulk (C++11/AsyncAndFuture.cpp) 동작 검증
+///
+///   - schedule : 값 전달, 작업 예외가 get() 에서 다시 던져지는지, get() 뒤 Future 가 비는지
+///   - Promise  : 값 없이 사라지면 get() 이 future_error(broken_promise), 값이 없는 동안 wait_for 는 timeout
+///   - submit_bulk : 빈 range 는 바로 준비, 원소마다 정확히 한 번, 예외가 나도 나머지 원소는 돌고 처음 예외 하나만 전달
+///   - pool 보다 오래 사는 Future (slab 참조 카운트)
+///   Lock / Ring hand-off 모두. 하나라도 실패하면 exit code 1
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++11/AsyncAndFuture.cpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+	using AsyncAndFuture::CustomThreadPool;
+
+	bool check(const char* name, bool ok)
+	{
+		std::cout << "[" << name << "] " << (ok ? "OK" : "FAILED") << std::endl;
+		return ok;
+	}
+
+	bool schedule_value_and_exception(LockFree::HandOff handoff)
+	{
+		CustomThreadPool pool(2, handoff);
+
+		Tasks::Future<int> square = pool.schedule([](int x) { return x * x; }, 12);
+		const bool value = square.get() == 144 && !square.valid();
+
+		Tasks::Future<int> failing = pool.schedule([]() -> int { throw std::runtime_error("job failed"); });
+		bool rethrown = false;
+		try {
+			failing.get();
+		}
+		catch (const std::runtime_error&) {
+			rethrown = true;
+		}
+
+		return check("schedule value", value) & check("schedule exception", rethrown && !failing.valid());
+	}
+
+	bool broken_promise()
+	{
+		Tasks::Future<int> future;
+		{
+			Tasks::Promise<int> promise(nullptr);
+			future = promise.get_future();
+			const bool pending = future.wait_for(std::chrono::milliseconds(10)) == std::future_status::timeout && !future.is_ready();
+			if (!check("wait_for timeout", pending)) return false;
+		}
+
+		bool broken = false;
+		try {
+			future.get();
+		}
+		catch (const std::future_error& e) {
+			broken = e.code() == std::future_errc::broken_promise;
+		}
+		return check("broken_promise", broken);
+	}
+
+	bool submit_bulk_cases(LockFree::HandOff handoff)
+	{
+		CustomThreadPool pool(2, handoff);
+		bool ok = true;
+
+		// 빈 range : 작업 없이 바로 준비
+		std::vector<int> none;
+		Tasks::Future<void> empty = pool.submit_bulk(none, [](int) {});
+		bool emptyOk = empty.is_ready();
+		try {
+			empty.get();
+		}
+		catch (...) {
+			emptyOk = false;
+		}
+		ok &= check("submit_bulk empty range", emptyOk);
+
+		// 원소마다 정확히 한 번
+		std::vector<int> values(1000);
+		for (int i = 0; i < 1000; ++i) values[i] = i;
+		std::unique_ptr<std::atomic<int>[]> seen(new std::atomic<int>[values.size()]);
+		for (size_t i = 0; i < values.size(); ++i) seen[i].store(0);
+		pool.submit_bulk(values, [&seen](int v) { seen[v].fetch_add(1); }).get();
+		bool once = true;
+		for (size_t i = 0; i < values.size(); ++i) once &= seen[i].load() == 1;
+		ok &= check("submit_bulk each element once", once);
+
+		// 일부 원소가 던져도 나머지는 돌고 예외는 하나만
+		std::atomic<int> calls{ 0 };
+		Tasks::Future<void> failing = pool.submit_bulk(values, [&calls](int v) {
+			calls.fetch_add(1);
+			if (v % 100 == 7) throw std::runtime_error("element failed");
+		});
+		bool rethrown = false;
+		try {
+			failing.get();
+		}
+		catch (const std::runtime_error&) {
+			rethrown = true;
+		}
+		ok &= check("submit_bulk exception", rethrown && calls.load() == 1000);
+		return ok;
+	}
+
+	bool future_outlives_pool()
+	{
+		Tasks::Future<int> future;
+		{
+			CustomThreadPool pool(1);
+			future = pool.schedule([] { return 7; });
+			future.wait();
+		}
+		return check("future outlives pool", future.get() == 7);
+	}
+}
+
+
+int main()
+{
+	bool ok = true;
+	for (LockFree::HandOff handoff : { LockFree::HandOff::Lock, LockFree::HandOff::Ring }) {
+		std::cout << (handoff == LockFree::HandOff::Lock ? "-- Lock" : "-- Ring") << std::endl;
+		ok &= schedule_value_and_exception(handoff);
+		ok &= submit_bulk_cases(handoff);
+	}
+	ok &= broken_promise();
+	ok &= future_outlives_pool();
+	return ok ? 0 : 1;
+}
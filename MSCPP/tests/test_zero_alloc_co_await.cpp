@@ -0,0 +1,89 @@
+﻿///////////////////////////////////////////////////////////////////////////////
+/// @file test_zero_alloc_co_await.cpp
+/// @brief C++143/CoroutineWithThreadPool.cpp : co_await 한 번에 일반 힙 할당이 0 회인지 검증
+///
+///   데모 .cpp 를 그대로 include 한다(unity build, C++20).
+///   전역 operator new 를 교체해 g_countHeapAllocs 가 켜져 있는 동안의 호출만 센다.
+///   (전역 교체는 링크되는 모든 코드에 영향을 주므로 데모/bench 와 분리된 실행 파일로 둔다)
+///
+///   코루틴 프레임/대기 슬롯은 FramePool, 실행 큐는 handle 주소 링 버퍼 => steady state 에서 0 회
+///   모드(SharedQueue / RingQueue / WorkStealing) 중 하나라도 0 이 아니면 실패(exit code 1)
+///////////////////////////////////////////////////////////////////////////////
+#include "../C++143/CoroutineWithThreadPool.cpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+
+namespace
+{
+    using namespace TaskWithThreadPool;
+
+    std::atomic<bool> g_countHeapAllocs{ false };
+    std::atomic<uint64_t> g_heapAllocs{ 0 };
+
+    Task<int> leaf_value([[maybe_unused]] SimpleThreadPool& pool, int v) {
+        co_return v;
+    }
+
+    Task<uint64_t> count_allocs_in_co_await_loop([[maybe_unused]] SimpleThreadPool& pool, int iterations) {
+        // 측정 구간을 워커에서 시작/종료해 호출 스레드의 Task 생성/파괴는 제외
+        g_heapAllocs.store(0, std::memory_order_relaxed);
+        g_countHeapAllocs.store(true, std::memory_order_release);
+
+        long long sum = 0;
+        for (int i = 0; i < iterations; ++i) {
+            sum += co_await leaf_value(pool, i);    // 프레임 생성 + 스케줄 + co_await + 재개 + 파괴
+        }
+
+        g_countHeapAllocs.store(false, std::memory_order_release);
+        if (sum != (long long)iterations * (iterations - 1) / 2) throw std::runtime_error("bad sum");
+        co_return g_heapAllocs.load(std::memory_order_relaxed);
+    }
+}
+
+//=================================================================================================
+// 전역 operator new/delete 교체 (할당 횟수 측정용, 동작은 malloc/free와 동일)
+//=================================================================================================
+void* operator new(std::size_t size) {
+    if (g_countHeapAllocs.load(std::memory_order_relaxed)) {
+        g_heapAllocs.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (size == 0) size = 1;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+// operator new 도 malloc 이라 짝이 맞지만, GCC 는 inline 된 delete 의 free 를 new 식과 짝지어 경고한다
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+//=================================================================================================
+int main() {
+    constexpr int Iterations = 100000;
+
+    int failures = 0;
+    for (auto mode : { SimpleThreadPool::Mode::SharedQueue, SimpleThreadPool::Mode::RingQueue, SimpleThreadPool::Mode::WorkStealing }) {
+        SimpleThreadPool pool(2, mode);
+
+        count_allocs_in_co_await_loop(pool, 10000).wait();  // warm-up: 프레임 풀/큐 버퍼를 채워 둠
+
+        const uint64_t allocs = count_allocs_in_co_await_loop(pool, Iterations).Result();
+        std::cout << "[" << mode_name(mode) << "]"
+                  << " co_await x " << Iterations << " : heap allocations = " << allocs
+                  << (allocs == 0 ? "" : "  <= FAIL") << "\n";
+        if (allocs != 0) ++failures;
+    }
+
+    return failures == 0 ? 0 : 1;
+}